@@ -0,0 +1,137 @@
+/**
+ * @file debug/thread_runtime_stats.h
+ * Per-thread and per-ISR runtime statistics
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_THREAD_RUNTIME_STATS_H_
+#define ZEPHYR_INCLUDE_DEBUG_THREAD_RUNTIME_STATS_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Thread runtime statistics
+ * @defgroup thread_runtime_stats Thread runtime statistics
+ * @ingroup debugging_apis
+ * @{
+ */
+
+/** Runtime statistics of a single thread. */
+struct k_thread_runtime_stats {
+	/** Total cycles spent executing the thread since it was created. */
+	u64_t execution_cycles;
+
+	/** Cycles spent executing the thread in the last complete window. */
+	u64_t window_cycles;
+
+	/** Length of the last complete window in cycles. */
+	u64_t window_length;
+
+	/** Number of times the thread has been switched in. */
+	u32_t switch_count;
+
+	/** Thread utilisation in the last complete window, in percent. */
+	u32_t window_percent;
+};
+
+/** Runtime statistics of a single interrupt line. */
+struct isr_runtime_stats {
+	/** Total cycles spent in the interrupt service routine. */
+	u64_t execution_cycles;
+
+	/** Longest single execution of the ISR in cycles. */
+	u32_t max_cycles;
+
+	/** Number of times the interrupt was serviced. */
+	u32_t count;
+};
+
+/** System-wide runtime statistics. */
+struct cpu_runtime_stats {
+	/** Cycles spent in the idle thread. */
+	u64_t idle_cycles;
+
+	/** Cycles spent in non-idle threads, excluding interrupts. */
+	u64_t thread_cycles;
+
+	/** Cycles spent in interrupt service routines. */
+	u64_t isr_cycles;
+
+	/** Cycles spent in the scheduler between switch out and switch in. */
+	u64_t sched_cycles;
+
+	/** Length of the last complete window in cycles. */
+	u64_t window_length;
+
+	/** Non-idle CPU utilisation in the last complete window, in percent. */
+	u32_t window_percent;
+};
+
+/**
+ * @brief Get runtime statistics of a thread.
+ *
+ * Statistics of the currently running thread include the cycles it has
+ * consumed up to the moment of the call.
+ *
+ * @param thread Thread to query.
+ * @param stats  Pointer to the structure to fill.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p thread or @p stats is NULL.
+ */
+__syscall int k_thread_runtime_stats_get(k_tid_t thread,
+					 struct k_thread_runtime_stats *stats);
+
+/**
+ * @brief Get system-wide runtime statistics.
+ *
+ * @param stats Pointer to the structure to fill.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p stats is NULL.
+ */
+__syscall int k_cpu_runtime_stats_get(struct cpu_runtime_stats *stats);
+
+/**
+ * @brief Get runtime statistics of an interrupt line.
+ *
+ * On ARM Cortex-M, lines 0 to CONFIG_NUM_IRQS - 1 are the external
+ * interrupts and line CONFIG_NUM_IRQS collects the core exceptions. On
+ * architectures that cannot identify the active interrupt line all
+ * interrupts are accounted to line 0.
+ *
+ * @param irq   Interrupt line number.
+ * @param stats Pointer to the structure to fill.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p irq is out of range or @p stats is NULL.
+ */
+int isr_runtime_stats_get(unsigned int irq, struct isr_runtime_stats *stats);
+
+/**
+ * @brief Get the number of interrupt lines tracked.
+ *
+ * @return Number of valid @p irq values for isr_runtime_stats_get().
+ */
+unsigned int isr_runtime_stats_lines(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/thread_runtime_stats.h>
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_THREAD_RUNTIME_STATS_H_ */
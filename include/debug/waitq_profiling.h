@@ -0,0 +1,128 @@
+/**
+ * @file debug/waitq_profiling.h
+ * Kernel object contention and wait time profiling
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_WAITQ_PROFILING_H_
+#define ZEPHYR_INCLUDE_DEBUG_WAITQ_PROFILING_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kernel object contention profiling
+ * @defgroup waitq_profiling Kernel object contention profiling
+ * @ingroup debugging_apis
+ * @{
+ */
+
+/** Wait time accumulated by one thread on a kernel object. */
+struct waitq_profile_thread {
+	/** Waiting thread, NULL if the slot is unused. */
+	const struct k_thread *thread;
+
+	/** Total cycles the thread spent waiting on the object. */
+	u64_t wait_cycles;
+
+	/** Number of times the thread waited on the object. */
+	u32_t count;
+};
+
+/** Contention profile of a kernel object. */
+struct waitq_profile {
+	/** Wait queue of the profiled object. */
+	const _wait_q_t *wait_q;
+
+	/** Number of times a thread blocked on the object. */
+	u32_t contentions;
+
+	/** Number of waits that ended with a timeout. */
+	u32_t timeouts;
+
+	/** Total cycles threads spent blocked on the object. */
+	u64_t total_wait_cycles;
+
+	/** Longest single wait in cycles. */
+	u32_t max_wait_cycles;
+
+	/** Threads with the longest accumulated wait, longest first. */
+	struct waitq_profile_thread top[CONFIG_WAITQ_PROFILING_TOP_THREADS];
+};
+
+/**
+ * @brief Callback used when iterating over profiled objects.
+ *
+ * @param profile   Profile of one object.
+ * @param user_data User data passed to waitq_profile_foreach().
+ */
+typedef void (*waitq_profile_cb_t)(const struct waitq_profile *profile,
+				   void *user_data);
+
+/**
+ * @brief Get the contention profile of a wait queue.
+ *
+ * @param wait_q  Wait queue of the kernel object.
+ * @param profile Pointer to the structure to fill.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if no thread ever blocked on the object, or its profile
+ *         was evicted.
+ */
+int waitq_profile_get(const _wait_q_t *wait_q, struct waitq_profile *profile);
+
+/**
+ * @brief Get the contention profile of a kernel object.
+ *
+ * Works with any kernel object that has a @a wait_q member, such as
+ * k_mutex, k_sem, k_queue, k_msgq or k_stack.
+ *
+ * @param obj     Pointer to the kernel object.
+ * @param profile Pointer to the structure to fill.
+ */
+#define K_OBJ_WAIT_PROFILE_GET(obj, profile) \
+	waitq_profile_get(&(obj)->wait_q, (profile))
+
+/**
+ * @brief Iterate over all profiled objects.
+ *
+ * The callback is invoked on a snapshot of each profile, without any lock
+ * held.
+ *
+ * @param cb        Callback invoked for each object.
+ * @param user_data User data passed to the callback.
+ */
+void waitq_profile_foreach(waitq_profile_cb_t cb, void *user_data);
+
+/**
+ * @brief Discard all recorded profiles.
+ */
+void waitq_profile_reset(void);
+
+/**
+ * @brief Get the number of profiles evicted since the last reset.
+ *
+ * When all slots are in use, the profile with the least accumulated wait
+ * time is discarded to make room for a newly contended object.
+ *
+ * @return Number of evicted profiles.
+ */
+u32_t waitq_profile_evictions(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_WAITQ_PROFILING_H_ */
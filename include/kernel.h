@@ -575,6 +575,26 @@ struct _thread_userspace_local_data {
 };
 #endif
 
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+/* Runtime accounting data of a thread, maintained by the CPU stats tracer */
+struct _thread_runtime_stats {
+	/* total cycles spent executing the thread */
+	u64_t execution_cycles;
+
+	/* cycles accumulated in the current window */
+	u64_t window_cycles;
+
+	/* cycles accumulated in the last complete window */
+	u64_t last_window_cycles;
+
+	/* window in which window_cycles was accumulated */
+	u32_t window_seq;
+
+	/* number of times the thread has been switched in */
+	u32_t switch_count;
+};
+#endif
+
 /**
  * @ingroup thread_apis
  * Thread Structure
@@ -629,6 +649,11 @@ struct k_thread {
 	struct _thread_stack_info stack_info;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+	/** Runtime statistics */
+	struct _thread_runtime_stats rt_stats;
+#endif
+
 #if defined(CONFIG_USERSPACE)
 	/** memory domain info of the thread */
 	struct _mem_domain_info mem_domain_info;
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ * @brief mcumgr command handler exporting binary statistics snapshots.
+ *
+ * The group answers a read of command STAT_SNAPSHOT_ID_READ with a CBOR map
+ * holding, besides the usual "rc" code:
+ *
+ * - "name": the statistics group name,
+ * - "n": the number of entries,
+ * - "v": a byte string of "n" little endian 64-bit values, in entry
+ *   declaration order.
+ *
+ * The request map holds the group "name" and an optional "reset" boolean
+ * zeroing the group as part of the same snapshot. Entry names do not
+ * change and can be fetched once with the regular stat show command.
+ */
+
+#ifndef ZEPHYR_INCLUDE_MGMT_STAT_SNAPSHOT_H_
+#define ZEPHYR_INCLUDE_MGMT_STAT_SNAPSHOT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Command ID of the snapshot read request. */
+#define STAT_SNAPSHOT_ID_READ 0
+
+/**
+ * @brief Registers the statistics snapshot command handler group.
+ */
+void stat_snapshot_register_group(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MGMT_STAT_SNAPSHOT_H_ */
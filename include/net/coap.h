@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <net/net_ip.h>
+#include <net/buf.h>
 
 #include <sys/slist.h>
 
@@ -170,6 +171,16 @@ typedef int (*coap_method_t)(struct coap_resource *resource,
 typedef void (*coap_notify_t)(struct coap_resource *resource,
 			      struct coap_observer *observer);
 
+/**
+ * @typedef coap_observer_send_t
+ * @brief Type of the callback sending a notification built once for all the
+ * observers of a resource, see coap_resource_notify_packet().
+ */
+typedef int (*coap_observer_send_t)(struct coap_resource *resource,
+				    struct coap_observer *observer,
+				    struct coap_packet *cpkt,
+				    void *user_data);
+
 /**
  * @brief Description of CoAP resource.
  *
@@ -196,6 +207,15 @@ struct coap_observer {
 	u8_t tkl;
 };
 
+/**
+ * @brief Where an option of a CoAP packet is, see CONFIG_COAP_OPTION_INDEX.
+ */
+struct coap_option_ref {
+	u16_t code; /* Option number */
+	u16_t offset; /* Offset of the option value in the packet data */
+	u16_t len; /* Option value length */
+};
+
 /**
  * @brief Representation of a CoAP Packet.
  */
@@ -206,6 +226,14 @@ struct coap_packet {
 	u8_t hdr_len; /* CoAP header length */
 	u16_t opt_len; /* Total options length (delta + len + value) */
 	u16_t delta; /* Used for delta calculation in CoAP packet */
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	/* Options found when the packet was parsed or built, looked up
+	 * by coap_find_options() instead of decoding the packet again.
+	 */
+	struct coap_option_ref opt_index[CONFIG_COAP_OPTION_INDEX_SIZE];
+	u8_t opt_count; /* Options in the index */
+	bool opt_indexed; /* All the options of the packet are in the index */
+#endif
 };
 
 struct coap_option {
@@ -442,6 +470,27 @@ int coap_packet_append_payload_marker(struct coap_packet *cpkt);
 int coap_packet_append_payload(struct coap_packet *cpkt, u8_t *payload,
 			       u16_t payload_len);
 
+/**
+ * @brief Complete a packet built in a network buffer
+ *
+ * The packet is built with coap_packet_init() in the tail room of @a buf,
+ * from net_buf_tail(buf). The length of @a buf is set to cover it and the
+ * payload fragments are chained after it, so the whole message can be
+ * sent with net_context_send_buf() without being copied into a network
+ * packet. The payload is not copied either: its buffers may refer to
+ * data of the application, allocated with net_buf_alloc_with_data().
+ * The payload marker is appended to the packet when there is a payload.
+ *
+ * @param cpkt Packet holding the header and the options
+ * @param buf Buffer the packet was built in
+ * @param payload Payload fragments, whose reference is given to @a buf,
+ * can be NULL
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_packet_buf_commit(struct coap_packet *cpkt, struct net_buf *buf,
+			   struct net_buf *payload);
+
 /**
  * @brief When a request is received, call the appropriate methods of
  * the matching resources.
@@ -785,6 +834,28 @@ void coap_reply_clear(struct coap_reply *reply);
  */
 int coap_resource_notify(struct coap_resource *resource);
 
+/**
+ * @brief Send the same notification to every registered observer.
+ *
+ * Instead of having the @a notify callback of the resource build a
+ * notification for each observer, @a cpkt is built once, with any token
+ * and message ID, and its Observe option set from the age of the resource,
+ * which the caller increments first as coap_resource_notify() does. The
+ * token of each observer and a new message ID are written into @a cpkt
+ * in place before @a send is called with it, so @a send copies the packet
+ * if it keeps it past its return, to retransmit it for instance.
+ *
+ * @param resource Resource that was updated
+ * @param cpkt Notification, with room for the longest token
+ * @param send Callback sending the notification to one observer
+ * @param user_data User data passed to @a send
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_resource_notify_packet(struct coap_resource *resource,
+				struct coap_packet *cpkt,
+				coap_observer_send_t send, void *user_data);
+
 /**
  * @brief Returns if this request is enabling observing a resource.
  *
@@ -399,6 +399,53 @@ static inline int dns_cancel_addr_info(u16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @typedef dns_resolve_cache_cb_t
+ * @brief Callback used when going through the DNS cache.
+ *
+ * @param query Name that was resolved.
+ * @param type Type of the query that was resolved.
+ * @param info Addresses the name resolved to.
+ * @param count Number of addresses, 0 if the name did not resolve.
+ * @param ttl Time in seconds before the entry expires.
+ * @param user_data User data given to dns_resolve_cache_foreach().
+ */
+typedef void (*dns_resolve_cache_cb_t)(const char *query,
+				       enum dns_query_type type,
+				       const struct dns_addrinfo *info,
+				       int count, u32_t ttl,
+				       void *user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Go through the names kept in the DNS cache.
+ *
+ * @param cb User supplied callback, called with the cache locked.
+ * @param user_data User supplied data
+ */
+void dns_resolve_cache_foreach(dns_resolve_cache_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove all the names kept in the DNS cache.
+ *
+ * @details The names are resolved again by the DNS servers the next time
+ * they are queried. This is typically done when the network the device
+ * is attached to changes.
+ */
+void dns_resolve_cache_flush(void);
+#else
+static inline void dns_resolve_cache_foreach(dns_resolve_cache_cb_t cb,
+					     void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+}
+
+static inline void dns_resolve_cache_flush(void)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @}
  */
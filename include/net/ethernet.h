@@ -126,6 +126,11 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload, the device cuts a TCP packet larger
+	 * than the MTU into segments of net_pkt_gso_size() bytes.
+	 */
+	ETHERNET_HW_TSO			= BIT(15),
 };
 
 /** @cond INTERNAL_HIDDEN */
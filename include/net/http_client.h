@@ -61,6 +61,25 @@ typedef int (*http_payload_cb_t)(int sock,
 				 struct http_request *req,
 				 void *user_data);
 
+/**
+ * @typedef http_chunk_cb_t
+ * @brief Callback used when the request body is sent in chunks. The body
+ * is sent with chunked transfer encoding, every chunk as soon as the
+ * callback hands it over, so its size need not be known up front.
+ *
+ * @param req HTTP request information
+ * @param data Set by the callback to the data of the next chunk. The data
+ *        must stay valid until the callback is called again.
+ * @param user_data User specified data specified in http_client_req()
+ *
+ * @return >0 length of the next chunk,
+ *         0  if the body is complete,
+ *         <0 if the request should be aborted with this error code.
+ */
+typedef int (*http_chunk_cb_t)(struct http_request *req,
+			       const u8_t **data,
+			       void *user_data);
+
 /**
  * @typedef http_header_cb_t
  * @brief Callback can be used if application wants to construct additional
@@ -235,6 +254,12 @@ struct http_request {
 	 */
 	http_payload_cb_t payload_cb;
 
+	/** User supplied callback function to call for the request body
+	 * when it is to be sent in chunks. Takes precedence over payload_cb
+	 * and payload.
+	 */
+	http_chunk_cb_t chunk_cb;
+
 	/** Payload, may be NULL */
 	const char *payload;
 
@@ -279,6 +304,69 @@ struct http_request {
 int http_client_req(int sock, struct http_request *req,
 		    s32_t timeout, void *user_data);
 
+/**
+ * @brief Send a HTTP request on a connection kept open to the server.
+ *
+ * @details An open connection to the server is reused if there is one,
+ * otherwise a connection is made. The request is sent right away, even if
+ * the responses to the earlier requests on the connection have not
+ * arrived yet, and the function returns without waiting for its response.
+ * Responses are processed by http_client_conn_input(), in the order the
+ * requests were sent. The response callback of the request gets the body
+ * as it arrives, in rsp->body_start and rsp->data_len, and is called with
+ * HTTP_DATA_FINAL when the response is complete. If the connection is
+ * lost before that, or the response is not complete within the timeout,
+ * it is called with HTTP_DATA_FINAL and rsp->message_complete not set.
+ * What was received of the response, such as rsp->http_status, is kept.
+ * As the responses come in order, a timeout closes the connection and
+ * ends the requests sent after the late one the same way.
+ *
+ * The request must stay valid until its response is complete. Its
+ * recv_buf is not used, and the protocol should be "HTTP/1.1" for the
+ * server to keep the connection open.
+ *
+ * @param addr Address of the server.
+ * @param addrlen Length of the address.
+ * @param req HTTP request information
+ * @param timeout Max time for the response to be complete, from when the
+ *        request is sent. The value is in milliseconds and cannot be 0.
+ *        Value NET_WAIT_FOREVER means no limit.
+ * @param user_data User specified data that is passed to the callbacks.
+ *
+ * @return 0 if the request was sent,
+ *         -EAGAIN if all the connections to the server have
+ *         CONFIG_HTTP_CLIENT_CONN_PIPELINE requests in flight and there is
+ *         no room for another connection, <0 on other errors.
+ */
+int http_client_conn_req(const struct sockaddr *addr, socklen_t addrlen,
+			 struct http_request *req, s32_t timeout,
+			 void *user_data);
+
+/**
+ * @brief Process the responses that have arrived on the open connections.
+ *
+ * @details Calls the response callbacks for the data that has arrived and
+ * closes the connections that have been idle for
+ * CONFIG_HTTP_CLIENT_CONN_IDLE_TIMEOUT, or that have a response later than
+ * the timeout of its request. The wait ends early when such a timeout
+ * expires.
+ *
+ * @param timeout How long to wait for data if none has arrived yet. The
+ *        value is in milliseconds. Value NET_WAIT_FOREVER means to wait
+ *        forever.
+ *
+ * @return <0 if error, >=0 number of requests completed
+ */
+int http_client_conn_input(s32_t timeout);
+
+/**
+ * @brief Close all the connections of the pool.
+ *
+ * @details The requests still in flight are completed as if the
+ * connection was lost.
+ */
+void http_client_conn_close_all(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -62,7 +62,10 @@ enum mqtt_evt_type {
 	/** Acknowledgment for published message with QoS 1. */
 	MQTT_EVT_PUBACK,
 
-	/** Reception confirmation for published message with QoS 2. */
+	/** Reception confirmation for published message with QoS 2. Not
+	 *  notified for the messages kept in @ref mqtt_client.inflight_buf,
+	 *  which the library releases itself.
+	 */
 	MQTT_EVT_PUBREC,
 
 	/** Release of published message with QoS 2. */
@@ -432,6 +435,28 @@ struct mqtt_transport {
 #endif
 };
 
+/** @brief QoS 1 or QoS 2 publication not acknowledged yet, see
+ *         @ref mqtt_client.inflight_buf.
+ */
+struct mqtt_inflight {
+	/** Encoded PUBLISH or PUBREL packet, sent again as is. */
+	u8_t *data;
+
+	/** Length of the packet, 0 if the entry is free. */
+	u32_t len;
+
+	/** Wall clock value (in milliseconds) of the last transmission. */
+	u32_t sent;
+
+	/** Message ID of the publication. */
+	u16_t message_id;
+
+	/** Packet is sent at the next occasion, without waiting for the
+	 *  retry timeout.
+	 */
+	u8_t due : 1;
+};
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -450,6 +475,21 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	u32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+	/** Internal. Publications not acknowledged yet. */
+	struct mqtt_inflight inflight[CONFIG_MQTT_INFLIGHT_MAX];
+
+	/** Internal. Last message ID allocated by the library. */
+	u16_t last_message_id;
+#endif
+
+#if defined(CONFIG_MQTT_WRITE_COALESCE)
+	/** Internal. Length of the packets in the transmit buffer not
+	 *  written to the transport yet.
+	 */
+	u32_t tx_pending;
+#endif
 };
 
 /**
@@ -506,6 +546,18 @@ struct mqtt_client {
 	/** Size of transmit buffer. */
 	u32_t tx_buf_size;
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+	/** Buffer keeping the QoS 1 and QoS 2 PUBLISH packets until they
+	 *  are acknowledged, split in CONFIG_MQTT_INFLIGHT_MAX equal parts.
+	 *  NULL leaves the acknowledgments and retransmissions to the
+	 *  application.
+	 */
+	u8_t *inflight_buf;
+
+	/** Size of the inflight buffer. */
+	u32_t inflight_buf_size;
+#endif
+
 	/** Keepalive interval for this client in seconds.
 	 *  Default is CONFIG_MQTT_KEEPALIVE.
 	 */
@@ -586,6 +638,16 @@ int mqtt_connect(struct mqtt_client *client);
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note With @ref mqtt_client.inflight_buf set, QoS 1 and QoS 2 messages are
+ *       kept by the library until acknowledged. A message_id of 0 lets the
+ *       library allocate it, the acknowledgment events report it. PUBREL is
+ *       sent by the library in answer to PUBREC, which is then not notified
+ *       to the application, so it must not call
+ *       @ref mqtt_publish_qos2_release for them. -EAGAIN is returned when
+ *       CONFIG_MQTT_INFLIGHT_MAX messages are already waiting for their
+ *       acknowledgment, -EMSGSIZE when the message does not fit its part of
+ *       the buffer.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish(struct mqtt_client *client,
@@ -621,7 +683,8 @@ int mqtt_publish_qos2_receive(struct mqtt_client *client,
 
 /**
  * @brief API used by client to request release of QoS2 publish message.
- *        Should be called on reception of @ref MQTT_EVT_PUBREC.
+ *        Should be called on reception of @ref MQTT_EVT_PUBREC, unless the
+ *        message is kept in @ref mqtt_client.inflight_buf.
  *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
@@ -717,6 +780,9 @@ int mqtt_abort(struct mqtt_client *client);
  *        makes it possible to respect the Keep Alive time agreed with the
  *        broker on connection. @ref mqtt_connect for details on Keep Alive
  *        time.
+ * @note  Also sends again the publications not acknowledged within
+ *        CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT and writes the packets
+ *        coalesced in the transmit buffer.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
@@ -728,6 +794,9 @@ int mqtt_live(struct mqtt_client *client);
  *
  * @param[in] client Client instance for which the procedure is requested.
  *
+ * @note Also accounts for the publications to send again and the packets
+ *       coalesced in the transmit buffer, @ref mqtt_live writes them.
+ *
  * @return Time in milliseconds until next keep alive message is expected to
  *         be sent. Function will return UINT32_MAX if keep alive messages are
  *         not enabled.
@@ -751,6 +820,34 @@ u32_t mqtt_keepalive_time_left(const struct mqtt_client *client);
  */
 int mqtt_input(struct mqtt_client *client);
 
+/**
+ * @brief Write the packets coalesced in the transmit buffer to the transport,
+ *        see CONFIG_MQTT_WRITE_COALESCE.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_flush(struct mqtt_client *client);
+
+#if defined(CONFIG_MQTT_INFLIGHT_SETTINGS)
+/**
+ * @brief Bring back the publications kept in settings, that were not
+ *        acknowledged before a reboot.
+ *
+ * @param[in] client Client instance for which the procedure is requested,
+ *                   with its inflight buffer set. Shall not be NULL.
+ *
+ * @note Shall be called before @ref mqtt_connect. The publications are sent
+ *       again once the broker resumes the session, so clean_session shall be
+ *       0. They are dropped otherwise.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_inflight_restore(struct mqtt_client *client);
+#endif
+
 /**
  * @brief Read the payload of the received PUBLISH message. This function should
  *        be called within the MQTT event handler, when MQTT PUBLISH message is
@@ -281,6 +281,11 @@ struct net_context {
 	/** TLS context information */
 	struct tls_context *tls;
 #endif /* CONFIG_NET_SOCKETS_SOCKOPT_TLS */
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** epoll instance entries watching this socket */
+	sys_slist_t epoll_items;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -304,6 +309,12 @@ struct net_context {
 #if defined(CONFIG_NET_CONTEXT_TXTIME)
 		bool txtime;
 #endif
+#if defined(CONFIG_NET_TCP2)
+		/** Send small TCP segments without waiting (no Nagle) */
+		bool tcp_nodelay;
+		/** Hold back partial TCP segments until uncorked */
+		bool tcp_cork;
+#endif
 #if defined(CONFIG_SOCKS)
 		struct {
 			struct sockaddr addr;
@@ -980,6 +991,36 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send the data of a network buffer without copying it.
+ *
+ * @details The buffer is put into the packet as is, so its data must stay
+ * valid until the stack releases its last reference to the buffer. For
+ * data that the caller owns, allocate the buffer with
+ * net_buf_alloc_with_data() from a pool whose destroy callback tells
+ * when the data can be reused. The reference passed in is consumed,
+ * also on failure. Only UDP and, with the experimental TCP stack, TCP
+ * contexts are supported. A UDP datagram is not cut to the MTU as the
+ * copying send does, one that does not fit fails with -EMSGSIZE.
+ *
+ * @param context The network context to use.
+ * @param buf The buffer (fragment chain) to send.
+ * @param dst_addr Destination address, NULL for the connected peer.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1049,6 +1090,8 @@ enum net_context_option {
 	NET_OPT_TIMESTAMP	= 2,
 	NET_OPT_TXTIME		= 3,
 	NET_OPT_SOCKS5		= 4,
+	NET_OPT_TCP_NODELAY	= 5,
+	NET_OPT_TCP_CORK	= 6,
 };
 
 /**
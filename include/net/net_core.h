@@ -84,6 +84,26 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver to push several received network
+ * packets up in the network stack at once. With CONFIG_NET_RX_BATCH the
+ * packets are processed as one batch by the RX thread.
+ *
+ * @details The scheduler is locked with k_sched_lock() while the packets
+ * are queued, so that the RX thread only runs once all of them are. This
+ * must therefore be called from a thread, such as the RX thread of the
+ * driver, not from an interrupt handler, which should use net_recv_data().
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Network packets in the order they were received.
+ * @param count Number of packets.
+ *
+ * @return Number of packets taken, <0 if error. The caller still owns the
+ * packets that were not taken. -EINVAL if called from an interrupt handler.
+ */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
 /**
  * @brief Send data to network.
  *
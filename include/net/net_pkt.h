@@ -129,7 +129,15 @@ struct net_pkt {
 	struct net_linkaddr lladdr_src;
 	struct net_linkaddr lladdr_dst;
 
-#if defined(CONFIG_NET_TCP1) || defined(CONFIG_NET_TCP2)
+#if defined(CONFIG_NET_ARP)
+	/* Hardware address of the next hop, copied from the ARP table
+	 * when the packet is sent, lladdr_dst then points here.
+	 */
+	u8_t arp_lladdr[6];
+#endif
+
+#if defined(CONFIG_NET_TCP1) || defined(CONFIG_NET_TCP2) || \
+	defined(CONFIG_NET_RX_BATCH) || defined(CONFIG_NET_IP_REASSEMBLY)
 	union {
 		sys_snode_t sent_list;
 
@@ -163,6 +171,17 @@ struct net_pkt {
 				 * Used only if defined(CONFIG_NET_ROUTE)
 				 */
 	u8_t family     : 3;	/* IPv4 vs IPv6 */
+	u8_t chksum_ok  : 1;	/* Transport checksum already verified, for
+				 * instance when received TCP segments were
+				 * merged.
+				 * Used only if defined(CONFIG_NET_GRO)
+				 */
+	u8_t l2_processed : 1;	/* Has the packet been through L2 already,
+				 * like a packet reassembled from fragments
+				 * that is fed back to the stack.
+				 * Used only if
+				 * defined(CONFIG_NET_IP_REASSEMBLY)
+				 */
 
 	union {
 		u8_t ipv4_auto_arp_msg : 1; /* Is this pkt IPv4 autoconf ARP
@@ -220,6 +239,25 @@ struct net_pkt {
 	u16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_GSO)
+	/* Size of the TCP segments a packet larger than the MTU is cut into
+	 * before it is sent, zero if the packet is sent as is.
+	 */
+	u16_t gso_size;
+#endif /* CONFIG_NET_GSO */
+
+#if defined(CONFIG_NET_UDP)
+	/* Sum of the data written by net_pkt_write_chksum() at the end of
+	 * the packet, so that it is not summed again by net_calc_chksum().
+	 */
+	u16_t data_chksum;
+	u16_t data_chksum_len;
+#endif /* CONFIG_NET_UDP */
+
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	u16_t ipv4_fragment_offset;	/* Fragment offset of this packet */
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #if defined(CONFIG_NET_IPV6)
 	/* Where is the start of the last header before payload data
 	 * in IPv6 packet. This is offset value from start of the IPv6
@@ -321,6 +359,27 @@ static inline void net_pkt_set_family(struct net_pkt *pkt, u8_t family)
 	pkt->family = family;
 }
 
+static inline bool net_pkt_chksum_ok(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_ok);
+}
+
+static inline void net_pkt_set_chksum_ok(struct net_pkt *pkt, bool ok)
+{
+	pkt->chksum_ok = ok;
+}
+
+static inline bool net_pkt_is_l2_processed(struct net_pkt *pkt)
+{
+	return !!(pkt->l2_processed);
+}
+
+static inline void net_pkt_set_l2_processed(struct net_pkt *pkt,
+					    bool is_l2_processed)
+{
+	pkt->l2_processed = is_l2_processed;
+}
+
 static inline bool net_pkt_is_gptp(struct net_pkt *pkt)
 {
 	return !!(pkt->gptp_pkt);
@@ -664,6 +723,33 @@ static inline void net_pkt_set_ipv6_fragment_id(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static inline u16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	return pkt->ipv4_fragment_offset;
+}
+
+static inline void net_pkt_set_ipv4_fragment_offset(struct net_pkt *pkt,
+						    u16_t offset)
+{
+	pkt->ipv4_fragment_offset = offset;
+}
+#else /* CONFIG_NET_IPV4_FRAGMENT */
+static inline u16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_offset(struct net_pkt *pkt,
+						    u16_t offset)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(offset);
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #if NET_TC_COUNT > 1
 static inline u8_t net_pkt_priority(struct net_pkt *pkt)
 {
@@ -820,6 +906,57 @@ static inline void net_pkt_set_txtime(struct net_pkt *pkt, u64_t txtime)
 }
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_GSO)
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t gso_size)
+{
+	pkt->gso_size = gso_size;
+}
+#else
+static inline u16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, u16_t gso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(gso_size);
+}
+#endif /* CONFIG_NET_GSO */
+
+#if defined(CONFIG_NET_UDP)
+static inline u16_t net_pkt_data_chksum(struct net_pkt *pkt)
+{
+	return pkt->data_chksum;
+}
+
+static inline u16_t net_pkt_data_chksum_len(struct net_pkt *pkt)
+{
+	return pkt->data_chksum_len;
+}
+#else
+static inline u16_t net_pkt_data_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline u16_t net_pkt_data_chksum_len(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_UDP */
+
 static inline size_t net_pkt_get_len(struct net_pkt *pkt)
 {
 	return net_buf_frags_len(pkt->frags);
@@ -1719,6 +1856,31 @@ int net_pkt_read_be32(struct net_pkt *pkt, u32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data into a net_pkt and sum it up on the way
+ *
+ * @details Like net_pkt_write(), the data must end up at the end of the
+ *          packet. Its sum is kept in the packet and used when the
+ *          transport checksum is computed, instead of reading the data
+ *          again. The transport header must have an even length.
+ *
+ * @param pkt    The network packet where to write
+ * @param data   Data to be written
+ * @param length Length of the data to be written
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+#if defined(CONFIG_NET_UDP)
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data,
+			 size_t length);
+#else
+static inline int net_pkt_write_chksum(struct net_pkt *pkt, const void *data,
+				       size_t length)
+{
+	return net_pkt_write(pkt, data, length);
+}
+#endif
+
 /* Write u8_t data into a net_pkt. */
 static inline int net_pkt_write_u8(struct net_pkt *pkt, u8_t data)
 {
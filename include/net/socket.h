@@ -26,6 +26,8 @@
 #include <net/net_ip.h>
 #include <net/dns_resolve.h>
 #include <net/socket_select.h>
+#include <net/socket_epoll.h>
+#include <net/socket_zerocopy.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -38,6 +40,14 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message of zsock_sendmmsg() and zsock_recvmmsg() */
+struct zsock_mmsghdr {
+	/** The message */
+	struct msghdr msg_hdr;
+	/** Number of bytes sent or received */
+	unsigned int msg_len;
+};
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -56,6 +66,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_PEEK 0x02
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
+/** zsock_recvmmsg: Do not wait for more once a message was received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -119,6 +131,22 @@ struct zsock_pollfd {
  *    - 1 - server
  */
 #define TLS_DTLS_ROLE 6
+/** Socket option to enable TLS session caching, so that a later connection
+ *  to the same peer can resume the session with an abbreviated handshake.
+ *  Clients keep the sessions they established, matched by peer address,
+ *  hostname and security tags. Servers keep their sessions in a session ID
+ *  cache and issue session tickets, as far as mbedTLS was built with them.
+ *  This option accepts and returns an integer:
+ *    - 0 - disabled
+ *    - 1 - enabled
+ *
+ *  If not set, sessions are not cached.
+ */
+#define TLS_SESSION_CACHE 7
+/** Write-only socket option to drop all the TLS sessions kept by clients.
+ *  The option value is ignored.
+ */
+#define TLS_SESSION_CACHE_PURGE 8
 
 /** @} */
 
@@ -131,6 +159,10 @@ struct zsock_pollfd {
 #define TLS_DTLS_ROLE_CLIENT 0 /**< Client role in a DTLS session. */
 #define TLS_DTLS_ROLE_SERVER 1 /**< Server role in a DTLS session. */
 
+/* Valid values for TLS_SESSION_CACHE option */
+#define TLS_SESSION_CACHE_DISABLED 0 /**< No TLS session caching. */
+#define TLS_SESSION_CACHE_ENABLED 1 /**< TLS session caching enabled. */
+
 struct zsock_addrinfo {
 	struct zsock_addrinfo *ai_next;
 	int ai_flags;
@@ -294,6 +326,26 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send several datagrams in one call
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for normative description. Each message is sent as with
+ * :c:func:`zsock_sendmsg()`, but the socket is looked up, and the system
+ * call made, only once for all of them.
+ * This function is also exposed as ``sendmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return the number of messages sent, 0 if @p vlen is 0, or -1 with errno
+ * set if none was
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -310,6 +362,30 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive several datagrams in one call
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for normative description. Each datagram is scattered over the
+ * ``msg_iov`` buffers of its message, and its source address stored in
+ * ``msg_name`` if set. Without ``ZSOCK_MSG_WAITFORONE`` the call waits
+ * for all ``vlen`` datagrams, unless it is non-blocking. There is no
+ * timeout argument, and ``ZSOCK_MSG_PEEK`` and ancillary data are not
+ * supported. Only native datagram sockets are supported, others fail
+ * with ``EOPNOTSUPP``.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return the number of messages received, 0 if @p vlen is 0, or -1 with
+ * errno set if none was
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -623,12 +699,24 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -703,6 +791,9 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
+
+#define mmsghdr zsock_mmsghdr
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -731,8 +822,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define SO_TIMESTAMPING 37
 
 /* Socket options for IPPROTO_TCP level */
-/** sockopt: Disable TCP buffering (ignored, for compatibility) */
+/** sockopt: Disable Nagle's algorithm, send small segments at once */
 #define TCP_NODELAY 1
+/** sockopt: Only send full segments until the option is cleared */
+#define TCP_CORK 3
 
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
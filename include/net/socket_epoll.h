@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Readiness events, the same values as the poll() ones */
+#define ZSOCK_EPOLLIN 1
+#define ZSOCK_EPOLLPRI 2
+#define ZSOCK_EPOLLOUT 4
+#define ZSOCK_EPOLLERR 8
+#define ZSOCK_EPOLLHUP 0x10
+
+/** Report the socket once when it becomes ready, not while it is ready */
+#define ZSOCK_EPOLLET BIT(31)
+/** Disable the socket after one event, until it is modified again */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+
+/* Operations of zsock_epoll_ctl() */
+#define ZSOCK_EPOLL_CTL_ADD 1
+#define ZSOCK_EPOLL_CTL_DEL 2
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	u32_t u32;
+	u64_t u64;
+} zsock_epoll_data_t;
+
+struct zsock_epoll_event {
+	u32_t events;
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/epoll_create.2.html>`__
+ * for normative description. ``flags`` must be 0. The instance is released
+ * with :c:func:`zsock_close()`.
+ * This function is also exposed as ``epoll_create1()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a socket of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for normative description. Only native network sockets can be added,
+ * other descriptors fail with ``EPERM``. A socket is removed from all the
+ * instances when it is closed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on the sockets of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <http://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for normative description. Unlike :c:func:`zsock_poll()`, the cost of
+ * a call does not depend on the number of sockets watched, but on the
+ * number of sockets ready. ``EPOLLHUP`` is reported once the peer closed
+ * the connection and all it sent has been read, ``EPOLLERR`` together
+ * with ``EPOLLHUP`` when the connection was reset or timed out. Both are
+ * reported whether asked for or not.
+ * This function is also exposed as ``epoll_wait()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define epoll_event zsock_epoll_event
+#define epoll_data_t zsock_epoll_data_t
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLPRI ZSOCK_EPOLLPRI
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLET ZSOCK_EPOLLET
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_ZEROCOPY_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_ZEROCOPY_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <sys/types.h>
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <net/net_ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Received data handed out by zsock_recv_zc() */
+struct zsock_zc_buf {
+	/** Start of the data, in the network buffer that holds it */
+	const void *data;
+	/** Length of the data */
+	size_t len;
+	/** Set if the rest of the same datagram follows */
+	bool more;
+};
+
+/**
+ * @brief Called when the stack no longer needs the data of a send
+ *
+ * @param buf The buffer given to zsock_sendto_zc()
+ * @param len Its length
+ * @param user_data The user data given to zsock_sendto_zc()
+ */
+typedef void (*zsock_zc_done_cb_t)(const void *buf, size_t len,
+				   void *user_data);
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * @rst
+ * Waits like :c:func:`zsock_recv()`, but instead of copying the data sets
+ * ``zc`` to the received data that is contiguous in the network buffer
+ * holding it. The data stays queued, and valid, until it is released with
+ * :c:func:`zsock_recv_zc_release()` or the socket is closed; calling
+ * this function again before that returns the same data. A datagram may
+ * be handed out in several parts, ``more`` is set on all but the last.
+ * Only ``ZSOCK_MSG_DONTWAIT`` is supported in ``flags``. Only native
+ * sockets are supported, others fail with ``EOPNOTSUPP``.
+ * Available if :option:`CONFIG_NET_SOCKETS_ZEROCOPY` is enabled.
+ * @endrst
+ *
+ * @return the length of the data, 0 at the end of a stream, or -1 with
+ * errno set on failure
+ */
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags);
+
+/**
+ * @brief Release data received with zsock_recv_zc()
+ *
+ * @details
+ * @rst
+ * Consumes the data, which must not be accessed anymore. For a stream
+ * socket the receive window opens by ``len``.
+ * @endrst
+ *
+ * @return 0 on success, -1 with errno set if zc is not the data at the
+ * head of the socket's queue
+ */
+int zsock_recv_zc_release(int sock, struct zsock_zc_buf *zc);
+
+/**
+ * @brief Send data without copying it
+ *
+ * @details
+ * @rst
+ * Like :c:func:`zsock_sendto()`, but the stack refers to ``buf`` instead
+ * of copying it. The buffer must not be changed until ``cb`` has been
+ * called, which happens once the data has been sent, or with TCP once it
+ * has been acknowledged, and only if this function succeeds. It may be
+ * called from a network thread, possibly before this function returns.
+ * TCP is supported with :option:`CONFIG_NET_TCP2` only. A UDP datagram
+ * larger than the MTU fails with ``EMSGSIZE``.
+ *
+ * A packet to an address of this host is not copied either, unless it
+ * goes through the loopback driver: the receiver gets the packet
+ * referring to ``buf``, and :c:func:`zsock_recv_zc()` hands out ``buf``
+ * itself. ``cb`` is then only called once the receiver has consumed the
+ * data, so the sender must not wait for it before the data is received.
+ * Available if :option:`CONFIG_NET_SOCKETS_ZEROCOPY` is enabled.
+ * @endrst
+ *
+ * @return the number of bytes queued, or -1 with errno set on failure
+ */
+ssize_t zsock_sendto_zc(int sock, const void *buf, size_t len, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen,
+			zsock_zc_done_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_ZEROCOPY_H_ */
@@ -160,7 +160,9 @@ int websocket_send_msg(int ws_sock, const u8_t *payload, size_t payload_len,
  * @param ws_sock Websocket id returned by websocket_connect().
  * @param buf Buffer where websocket data is read.
  * @param buf_len Length of the data buffer.
- * @param message_type Type of the message.
+ * @param message_type Type of the message. The frames that continue a
+ *        fragmented message report the type of its first frame, and
+ *        WEBSOCKET_FLAG_FINAL is set on the last one.
  * @param remaining How much there is data left in the message after this read.
  * @param timeout How long to try to receive the message.
  *        The value is in milliseconds. Value NET_WAIT_FOREVER means to wait
@@ -24,6 +24,9 @@ static inline int socket(int family, int type, int proto)
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
+
+#define mmsghdr zsock_mmsghdr
 
 static inline int shutdown(int sock, int how)
 {
@@ -74,6 +77,18 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int getsockopt(int sock, int level, int optname,
 			     void *optval, socklen_t *optlen)
 {
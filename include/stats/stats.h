@@ -46,13 +46,26 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * Groups incremented concurrently from several CPUs can be declared with
+ * STATS_PERCPU_SECT_START/END instead.  Such groups keep one copy of their
+ * entries per CPU, so an increment only touches memory owned by the
+ * incrementing CPU, and are aggregated on read by stats_get() and
+ * stats_snapshot().  Their entries must be updated with the STATS_PERCPU_*
+ * macros, named with STATS_PERCPU_NAME() and registered with
+ * STATS_PERCPU_INIT_AND_REG().
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
 #define ZEPHYR_INCLUDE_STATS_STATS_H_
 
 #include <stddef.h>
+#include <stdbool.h>
 #include <zephyr/types.h>
+#include <sys/util.h>
+#ifdef CONFIG_STATS
+#include <kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,11 +76,19 @@ struct stats_name_map {
 	const char *snm_name;
 } __attribute__((packed));
 
+/** The group keeps one copy of its entries per CPU. */
+#define STATS_HDR_F_PERCPU BIT(0)
+
+/** Alignment of the per-CPU copies of a group, at least a cache line. */
+#ifndef STATS_PERCPU_ALIGN
+#define STATS_PERCPU_ALIGN 64
+#endif
+
 struct stats_hdr {
 	const char *s_name;
 	u8_t s_size;
 	u16_t s_cnt;
-	u8_t s_pad1;
+	u8_t s_flags;
 #ifdef CONFIG_STATS_NAMES
 	const struct stats_name_map *s_map;
 	int s_map_cnt;
@@ -167,6 +188,140 @@ struct stats_hdr {
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
 
+/**
+ * @brief Begins a per-CPU stats group struct definition.
+ *
+ * @param group__               The stats group struct name.
+ */
+#define STATS_PERCPU_SECT_START(group__) \
+	STATS_SECT_DECL(group__) {	 \
+		struct stats_hdr s_hdr;	 \
+		struct {
+
+/**
+ * @brief Ends a per-CPU stats group struct definition.
+ *
+ * Each CPU's copy of the entries starts on a cache line of its own.
+ */
+#define STATS_PERCPU_SECT_END						\
+		u8_t s_cpu_end[0];					\
+	} __aligned(STATS_PERCPU_ALIGN) s_cpu[CONFIG_MP_NUM_CPUS];	\
+	}
+
+#ifdef CONFIG_SMP
+/* Sequence count of the per-CPU entries owned by a CPU, odd while they
+ * are being written.  Only the owning CPU increments them, only a reset
+ * writes them from another CPU.
+ */
+struct z_stats_cpu_seq {
+	atomic_t seq;
+} __aligned(STATS_PERCPU_ALIGN);
+
+extern struct z_stats_cpu_seq z_stats_cpu_seqs[CONFIG_MP_NUM_CPUS];
+
+static ALWAYS_INLINE void z_stats_cpu_write_begin(unsigned int cpu)
+{
+	atomic_t *seq = &z_stats_cpu_seqs[cpu].seq;
+	atomic_val_t val;
+
+	/* Wait out a reset from another CPU, never contended otherwise */
+	do {
+		val = atomic_get(seq) & ~1;
+	} while (!atomic_cas(seq, val, val + 1));
+}
+
+static ALWAYS_INLINE void z_stats_cpu_write_end(unsigned int cpu)
+{
+	atomic_inc(&z_stats_cpu_seqs[cpu].seq);
+}
+#endif
+
+/* Per-CPU entries are only incremented by their CPU, with interrupts
+ * locked.
+ */
+static ALWAYS_INLINE unsigned int z_stats_cpu_lock(unsigned int *cpu)
+{
+	unsigned int key = arch_irq_lock();
+
+#ifdef CONFIG_SMP
+	*cpu = arch_curr_cpu()->id;
+	z_stats_cpu_write_begin(*cpu);
+#else
+	*cpu = 0U;
+#endif
+
+	return key;
+}
+
+/* Lock the entries of the given CPU, to reset them from any CPU */
+static ALWAYS_INLINE unsigned int z_stats_cpu_lock_other(unsigned int cpu)
+{
+	unsigned int key = arch_irq_lock();
+
+#ifdef CONFIG_SMP
+	z_stats_cpu_write_begin(cpu);
+#else
+	ARG_UNUSED(cpu);
+#endif
+
+	return key;
+}
+
+static ALWAYS_INLINE void z_stats_cpu_unlock(unsigned int cpu,
+					     unsigned int key)
+{
+#ifdef CONFIG_SMP
+	z_stats_cpu_write_end(cpu);
+#else
+	ARG_UNUSED(cpu);
+#endif
+	arch_irq_unlock(key);
+}
+
+/**
+ * @brief Increases a per-CPU statistic entry by the specified amount.
+ *
+ * Only the copy of the entry owned by the current CPU is updated.  Safe to
+ * use from any context.  Compiled out if CONFIG_STATS is not defined.
+ *
+ * @param group__               The group containing the entry to increase.
+ * @param var__                 The statistic entry to increase.
+ * @param n__                   The amount to increase the statistic entry by.
+ */
+#define STATS_PERCPU_INCN(group__, var__, n__)				\
+	do {								\
+		unsigned int cpu__;					\
+		unsigned int key__ = z_stats_cpu_lock(&cpu__);		\
+									\
+		(group__).s_cpu[cpu__].var__ += (n__);			\
+		z_stats_cpu_unlock(cpu__, key__);			\
+	} while (false)
+
+/**
+ * @brief Increments a per-CPU statistic entry.
+ *
+ * @param group__               The group containing the entry to increase.
+ * @param var__                 The statistic entry to increase.
+ */
+#define STATS_PERCPU_INC(group__, var__) \
+	STATS_PERCPU_INCN(group__, var__, 1)
+
+/**
+ * @brief Sets a per-CPU statistic entry to zero on all CPUs.
+ *
+ * @param group__               The group containing the entry to clear.
+ * @param var__                 The statistic entry to clear.
+ */
+#define STATS_PERCPU_CLEAR(group__, var__)				\
+	do {								\
+		for (int i__ = 0; i__ < CONFIG_MP_NUM_CPUS; i__++) {	\
+			unsigned int key__ = z_stats_cpu_lock_other(i__); \
+									\
+			(group__).s_cpu[i__].var__ = 0;			\
+			z_stats_cpu_unlock(i__, key__);			\
+		}							\
+	} while (false)
+
 #define STATS_SIZE_16 (sizeof(u16_t))
 #define STATS_SIZE_32 (sizeof(u32_t))
 #define STATS_SIZE_64 (sizeof(u64_t))
@@ -197,6 +352,26 @@ struct stats_hdr {
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
+/**
+ * @brief Initializes and registers a per-CPU statistics group.
+ *
+ * @param group__               The per-CPU statistics group to initialize and
+ *                                  register.
+ * @param size__                The size of each entry in the statistics group,
+ *                                  in bytes.
+ * @param name__                The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_PERCPU_INIT_AND_REG(group__, size__, name__)		\
+	stats_percpu_init_and_reg(					\
+		&(group__).s_hdr,					\
+		(size__),						\
+		offsetof(__typeof__((group__).s_cpu[0]), s_cpu_end) /	\
+			(size__),					\
+		STATS_NAME_INIT_PARMS(group__),				\
+		(name__))
+
 /**
  * @brief Initializes a statistics group.
  *
@@ -259,6 +434,30 @@ int stats_init_and_reg(struct stats_hdr *hdr, u8_t size, u16_t cnt,
 		       const struct stats_name_map *map, u16_t map_cnt,
 		       const char *name);
 
+/**
+ * @brief Initializes and registers a per-CPU statistics group.
+ *
+ * Note: it is recommended to use the STATS_PERCPU_INIT_AND_REG macro
+ * instead of this function.
+ *
+ * @param hdr                   The header of the statistics group to
+ *                                  initialize and register.
+ * @param size                  The size of each individual statistics
+ *                                  element, in bytes.
+ * @param cnt                   The number of elements in the stats group,
+ *                                  for one CPU.
+ * @param map                   The mapping of stat offset to name.
+ * @param map_cnt               The number of items in the statistics map
+ * @param name                  The name of the statistics group to register.
+ *
+ * @return                      0 on success; negative error code on failure.
+ *
+ * @see STATS_PERCPU_INIT_AND_REG
+ */
+int stats_percpu_init_and_reg(struct stats_hdr *hdr, u8_t size, u16_t cnt,
+			      const struct stats_name_map *map, u16_t map_cnt,
+			      const char *name);
+
 /**
  * Zeroes the specified statistics group.
  *
@@ -266,6 +465,43 @@ int stats_init_and_reg(struct stats_hdr *hdr, u8_t size, u16_t cnt,
  */
 void stats_reset(struct stats_hdr *shdr);
 
+/**
+ * @brief Reads a statistic entry.
+ *
+ * Entries of per-CPU groups are summed over all CPUs.
+ *
+ * @param hdr                   The group containing the entry.
+ * @param off                   The offset of the entry, as passed to
+ *                                  stats_walk_fn.
+ *
+ * @return                      The value of the entry.
+ */
+u64_t stats_get(const struct stats_hdr *hdr, u16_t off);
+
+/**
+ * @brief Takes a snapshot of a statistics group.
+ *
+ * Entries of regular groups are read, and optionally zeroed, as a single
+ * operation with respect to increments done with STATS_INCN() on the
+ * calling CPU.
+ *
+ * The per-CPU copies of a per-CPU group are read through a sequence count,
+ * without holding off increments, so every entry is read whole, also a
+ * 64-bit one on a 32-bit CPU.  The entries are not all read at the same
+ * instant.  When zeroed, each CPU's copy is read and zeroed as one
+ * operation, so no increment is lost between the two.
+ *
+ * @param hdr                   The statistics group to read.
+ * @param values                Array receiving the entries, in declaration
+ *                                  order.
+ * @param cnt                   The number of elements of @a values.
+ * @param reset                 Zero the group once read.
+ *
+ * @return                      The number of entries stored in @a values.
+ */
+int stats_snapshot(struct stats_hdr *hdr, u64_t *values, u16_t cnt,
+		   bool reset);
+
 /** @typedef stats_walk_fn
  * @brief Function that gets applied to every stat entry during a walk.
  *
@@ -273,7 +509,10 @@ void stats_reset(struct stats_hdr *shdr);
  *                                  walked.
  * @param arg                   Optional argument.
  * @param name                  The name of the statistic entry to process
- * @param off                   The offset of the entry, from `hdr`.
+ * @param off                   The offset of the entry, from `hdr`.  For
+ *                                  a per-CPU group, `hdr` is a copy of
+ *                                  the group header and the entry holds
+ *                                  the sum of the CPUs' copies.
  *
  * @return                      0 if the walk should proceed;
  *                              nonzero to abort the walk.
@@ -352,6 +591,13 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_CLEAR(group__, var__)
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
 
+#define STATS_PERCPU_SECT_START(group__) STATS_SECT_START(group__)
+#define STATS_PERCPU_SECT_END STATS_SECT_END
+#define STATS_PERCPU_INCN(group__, var__, n__)
+#define STATS_PERCPU_INC(group__, var__)
+#define STATS_PERCPU_CLEAR(group__, var__)
+#define STATS_PERCPU_INIT_AND_REG(group__, size__, name__) (0)
+
 #endif /* !CONFIG_STATS */
 
 #ifdef CONFIG_STATS_NAMES
@@ -364,6 +610,9 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_NAME(sectname__, entry__)	\
 	{ offsetof(STATS_SECT_DECL(sectname__), entry__), #entry__ },
 
+#define STATS_PERCPU_NAME(sectname__, entry__) \
+	{ offsetof(STATS_SECT_DECL(sectname__), s_cpu[0].entry__), #entry__ },
+
 #define STATS_NAME_END(sectname__) }
 
 #define STATS_NAME_INIT_PARMS(name__)	    \
@@ -374,6 +623,7 @@ struct stats_hdr *stats_group_find(const char *name);
 
 #define STATS_NAME_START(name__)
 #define STATS_NAME(name__, entry__)
+#define STATS_PERCPU_NAME(name__, entry__)
 #define STATS_NAME_END(name__)
 #define STATS_NAME_INIT_PARMS(name__) NULL, 0
 
@@ -8,6 +8,8 @@
 #define ZEPHYR_INCLUDE_TRACING_TRACING_FORMAT_H
 
 #include <toolchain/common.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -72,6 +74,57 @@ void tracing_format_raw_data(u8_t *data, u32_t length);
  */
 void tracing_format_data(tracing_data_t *tracing_data_array, u32_t count);
 
+/**
+ * @brief Tracing event classes, used to filter events at run-time.
+ */
+#define TRACING_CLASS_THREAD	BIT(0)
+#define TRACING_CLASS_ISR	BIT(1)
+#define TRACING_CLASS_IDLE	BIT(2)
+#define TRACING_CLASS_MUTEX	BIT(3)
+#define TRACING_CLASS_SEMA	BIT(4)
+#define TRACING_CLASS_CALL	BIT(5)
+#define TRACING_CLASS_ALL	(TRACING_CLASS_THREAD | TRACING_CLASS_ISR | \
+				 TRACING_CLASS_IDLE | TRACING_CLASS_MUTEX | \
+				 TRACING_CLASS_SEMA | TRACING_CLASS_CALL)
+
+extern atomic_t z_tracing_class_mask;
+
+/**
+ * @brief Select the event classes to be traced.
+ *
+ * Classes disabled at build time cannot be enabled at run-time.
+ *
+ * @param classes Bitmask of TRACING_CLASS_* values.
+ */
+void tracing_filter_set(u32_t classes);
+
+/**
+ * @brief Get the event classes currently traced.
+ *
+ * @return Bitmask of TRACING_CLASS_* values.
+ */
+u32_t tracing_filter_get(void);
+
+/**
+ * @brief Check if an event class is traced.
+ *
+ * @param classes TRACING_CLASS_* value.
+ *
+ * @return true if events of the class should be emitted.
+ */
+static inline bool tracing_class_is_enabled(u32_t classes)
+{
+	return (atomic_get(&z_tracing_class_mask) & classes) != 0;
+}
+
+/**
+ * @brief Send the content of the flight recorder to the tracing backend.
+ *
+ * Only available with CONFIG_TRACING_BUFFER_OVERWRITE. Tracing is
+ * suspended while the buffers are sent and the buffers are emptied.
+ */
+void tracing_flight_recorder_dump(void);
+
 #ifdef __cplusplus
 }
 #endif
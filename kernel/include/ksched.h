@@ -58,6 +58,25 @@ struct k_thread *z_find_first_thread_to_unpend(_wait_q_t *wait_q,
 					      struct k_thread *from);
 void idle(void *a, void *b, void *c);
 void z_time_slice(int ticks);
+
+#ifdef CONFIG_WAITQ_PROFILING
+void z_waitq_profile_record(_wait_q_t *wait_q, u32_t start, int ret);
+
+static inline u32_t z_waitq_profile_start(void)
+{
+	return k_cycle_get_32();
+}
+#else
+static inline void z_waitq_profile_record(_wait_q_t *wait_q, u32_t start,
+					  int ret)
+{
+}
+
+static inline u32_t z_waitq_profile_start(void)
+{
+	return 0;
+}
+#endif
 void z_reset_time_slice(void);
 void z_sched_abort(struct k_thread *thread);
 void z_sched_ipi(void);
@@ -650,31 +650,42 @@ void z_thread_timeout(struct _timeout *timeout)
 
 int z_pend_curr_irqlock(u32_t key, _wait_q_t *wait_q, k_timeout_t timeout)
 {
+	u32_t start = z_waitq_profile_start();
+	int ret;
+
 	pend(_current, wait_q, timeout);
 
 #if defined(CONFIG_TIMESLICING) && defined(CONFIG_SWAP_NONATOMIC)
 	pending_current = _current;
 
-	int ret = z_swap_irqlock(key);
+	ret = z_swap_irqlock(key);
 	LOCKED(&sched_spinlock) {
 		if (pending_current == _current) {
 			pending_current = NULL;
 		}
 	}
-	return ret;
 #else
-	return z_swap_irqlock(key);
+	ret = z_swap_irqlock(key);
 #endif
+	z_waitq_profile_record(wait_q, start, ret);
+
+	return ret;
 }
 
 int z_pend_curr(struct k_spinlock *lock, k_spinlock_key_t key,
 	       _wait_q_t *wait_q, k_timeout_t timeout)
 {
+	u32_t start = z_waitq_profile_start();
+	int ret;
+
 #if defined(CONFIG_TIMESLICING) && defined(CONFIG_SWAP_NONATOMIC)
 	pending_current = _current;
 #endif
 	pend(_current, wait_q, timeout);
-	return z_swap(lock, key);
+	ret = z_swap(lock, key);
+	z_waitq_profile_record(wait_q, start, ret);
+
+	return ret;
 }
 
 struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
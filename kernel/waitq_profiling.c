@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <kernel_structs.h>
+#include <ksched.h>
+#include <init.h>
+#include <string.h>
+#include <spinlock.h>
+#include <stats/stats.h>
+#include <debug/waitq_profiling.h>
+
+#define SLOTS CONFIG_WAITQ_PROFILING_SLOTS
+#define TOP_THREADS CONFIG_WAITQ_PROFILING_TOP_THREADS
+
+/* Profiles live in an open addressed hash table keyed by wait queue
+ * address, so recording a wait never allocates and lookups stay cheap on
+ * the wake up path. Slots are only ever emptied all at once, so once the
+ * table is full it stays full, and a profile can be replaced in place
+ * without breaking the probe sequence of the others.
+ */
+static struct waitq_profile profiles[SLOTS];
+static struct k_spinlock lock;
+
+/* Profiles replaced since the last reset */
+static u32_t evictions;
+
+STATS_SECT_START(waitq_stats)
+STATS_SECT_ENTRY32(blocks)
+STATS_SECT_ENTRY32(timeouts)
+STATS_SECT_ENTRY32(evicted)
+STATS_SECT_ENTRY32(max_wait_us)
+STATS_SECT_END;
+
+STATS_NAME_START(waitq_stats)
+STATS_NAME(waitq_stats, blocks)
+STATS_NAME(waitq_stats, timeouts)
+STATS_NAME(waitq_stats, evicted)
+STATS_NAME(waitq_stats, max_wait_us)
+STATS_NAME_END(waitq_stats);
+
+static STATS_SECT_DECL(waitq_stats) waitq_stats;
+
+static unsigned int slot_hash(const _wait_q_t *wait_q)
+{
+	/* Fibonacci hashing of the object address */
+	return (unsigned int)((((uintptr_t)wait_q >> 2) * 2654435761U) %
+			      SLOTS);
+}
+
+static struct waitq_profile *slot_find(const _wait_q_t *wait_q, bool create)
+{
+	unsigned int idx = slot_hash(wait_q);
+
+	for (int i = 0; i < SLOTS; i++) {
+		struct waitq_profile *profile = &profiles[idx];
+
+		if (profile->wait_q == wait_q) {
+			return profile;
+		}
+
+		if (profile->wait_q == NULL) {
+			if (!create) {
+				return NULL;
+			}
+
+			profile->wait_q = wait_q;
+			return profile;
+		}
+
+		idx = (idx + 1) % SLOTS;
+	}
+
+	return NULL;
+}
+
+/* Make room for a new object in a full table. The profile with the least
+ * accumulated wait is the least interesting one, and likely belongs to an
+ * object that is gone, such as a semaphore on a stack.
+ */
+static struct waitq_profile *slot_evict(const _wait_q_t *wait_q)
+{
+	struct waitq_profile *victim = &profiles[0];
+
+	for (int i = 1; i < SLOTS; i++) {
+		if (profiles[i].total_wait_cycles <
+		    victim->total_wait_cycles) {
+			victim = &profiles[i];
+		}
+	}
+
+	(void)memset(victim, 0, sizeof(*victim));
+	victim->wait_q = wait_q;
+
+	evictions++;
+	STATS_INC(waitq_stats, evicted);
+
+	return victim;
+}
+
+static void top_threads_update(struct waitq_profile *profile,
+			       const struct k_thread *thread, u32_t cycles)
+{
+	struct waitq_profile_thread *top = profile->top;
+	struct waitq_profile_thread tmp;
+	int i;
+
+	for (i = 0; i < TOP_THREADS; i++) {
+		if (top[i].thread == thread || top[i].thread == NULL) {
+			break;
+		}
+	}
+
+	if (i == TOP_THREADS) {
+		/* Not tracked yet: evict the last entry if this wait alone
+		 * is longer than its accumulated wait time.
+		 */
+		i = TOP_THREADS - 1;
+		if (top[i].wait_cycles >= cycles) {
+			return;
+		}
+
+		top[i].wait_cycles = 0U;
+		top[i].count = 0U;
+	}
+
+	top[i].thread = thread;
+	top[i].wait_cycles += cycles;
+	top[i].count++;
+
+	/* Keep the array sorted, longest wait first */
+	while (i > 0 && top[i - 1].wait_cycles < top[i].wait_cycles) {
+		tmp = top[i - 1];
+		top[i - 1] = top[i];
+		top[i] = tmp;
+		i--;
+	}
+}
+
+void z_waitq_profile_record(_wait_q_t *wait_q, u32_t start, int ret)
+{
+	u32_t cycles = k_cycle_get_32() - start;
+	struct waitq_profile *profile;
+	k_spinlock_key_t key;
+#ifdef CONFIG_STATS
+	u32_t wait_us;
+#endif
+
+	if (wait_q == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	STATS_INC(waitq_stats, blocks);
+	if (ret == -EAGAIN) {
+		STATS_INC(waitq_stats, timeouts);
+	}
+
+#ifdef CONFIG_STATS
+	wait_us = (u32_t)k_cyc_to_us_floor64(cycles);
+	if (wait_us > waitq_stats.max_wait_us) {
+		waitq_stats.max_wait_us = wait_us;
+	}
+#endif
+
+	profile = slot_find(wait_q, true);
+	if (profile == NULL) {
+		profile = slot_evict(wait_q);
+	}
+
+	profile->contentions++;
+	if (ret == -EAGAIN) {
+		profile->timeouts++;
+	}
+	profile->total_wait_cycles += cycles;
+	profile->max_wait_cycles = MAX(profile->max_wait_cycles, cycles);
+	top_threads_update(profile, _current, cycles);
+
+	k_spin_unlock(&lock, key);
+}
+
+int waitq_profile_get(const _wait_q_t *wait_q, struct waitq_profile *profile)
+{
+	struct waitq_profile *found;
+	k_spinlock_key_t key;
+	int ret = -ENOENT;
+
+	key = k_spin_lock(&lock);
+	found = slot_find(wait_q, false);
+	if (found != NULL) {
+		*profile = *found;
+		ret = 0;
+	}
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+void waitq_profile_foreach(waitq_profile_cb_t cb, void *user_data)
+{
+	struct waitq_profile profile;
+	k_spinlock_key_t key;
+
+	for (int i = 0; i < SLOTS; i++) {
+		key = k_spin_lock(&lock);
+		profile = profiles[i];
+		k_spin_unlock(&lock, key);
+
+		if (profile.wait_q != NULL) {
+			cb(&profile, user_data);
+		}
+	}
+}
+
+void waitq_profile_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	(void)memset(profiles, 0, sizeof(profiles));
+	evictions = 0U;
+	k_spin_unlock(&lock, key);
+}
+
+u32_t waitq_profile_evictions(void)
+{
+	return evictions;
+}
+
+static int waitq_profiling_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	(void)STATS_INIT_AND_REG(waitq_stats, STATS_SIZE_32, "waitq");
+
+	return 0;
+}
+
+SYS_INIT(waitq_profiling_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -20,6 +20,11 @@ LOG_MODULE_REGISTER(net_mqtt_publisher_sample, LOG_LEVEL_DBG);
 static u8_t rx_buffer[APP_MQTT_BUFFER_SIZE];
 static u8_t tx_buffer[APP_MQTT_BUFFER_SIZE];
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+/* QoS 1 and QoS 2 messages kept by the library until acknowledged */
+static u8_t inflight_buffer[CONFIG_MQTT_INFLIGHT_MAX * APP_MQTT_BUFFER_SIZE];
+#endif
+
 #if defined(CONFIG_MQTT_LIB_WEBSOCKET)
 /* Making RX buffer large enough that the full IPv6 packet can fit into it */
 #define MQTT_LIB_WEBSOCKET_RECV_BUF_LEN 1280
@@ -170,6 +175,9 @@ void mqtt_evt_handler(struct mqtt_client *const client,
 
 		LOG_INF("PUBREC packet id: %u", evt->param.pubrec.message_id);
 
+		/* With CONFIG_MQTT_INFLIGHT the library sends the PUBREL
+		 * itself and this event is not notified.
+		 */
 		const struct mqtt_pubrel_param rel_param = {
 			.message_id = evt->param.pubrec.message_id
 		};
@@ -238,7 +246,9 @@ static int publish(struct mqtt_client *client, enum mqtt_qos qos)
 	param.message.payload.data = get_mqtt_payload(qos);
 	param.message.payload.len =
 			strlen(param.message.payload.data);
-	param.message_id = sys_rand32_get();
+	/* The library allocates the message ID of the messages it keeps */
+	param.message_id = IS_ENABLED(CONFIG_MQTT_INFLIGHT) ?
+			   0U : sys_rand32_get();
 	param.dup_flag = 0U;
 	param.retain_flag = 0U;
 
@@ -302,6 +312,10 @@ static void client_init(struct mqtt_client *client)
 	client->rx_buf_size = sizeof(rx_buffer);
 	client->tx_buf = tx_buffer;
 	client->tx_buf_size = sizeof(tx_buffer);
+#if defined(CONFIG_MQTT_INFLIGHT)
+	client->inflight_buf = inflight_buffer;
+	client->inflight_buf_size = sizeof(inflight_buffer);
+#endif
 
 	/* MQTT transport configuration */
 #if defined(CONFIG_MQTT_LIB_TLS)
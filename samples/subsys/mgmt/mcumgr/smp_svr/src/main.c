@@ -26,6 +26,9 @@
 #ifdef CONFIG_MCUMGR_CMD_STAT_MGMT
 #include "stat_mgmt/stat_mgmt.h"
 #endif
+#ifdef CONFIG_MCUMGR_CMD_STAT_SNAPSHOT
+#include <mgmt/stat_snapshot.h>
+#endif
 
 #ifdef CONFIG_MCUMGR_SMP_BT
 #include <bluetooth/bluetooth.h>
@@ -140,6 +143,9 @@ void main(void)
 #ifdef CONFIG_MCUMGR_CMD_STAT_MGMT
 	stat_mgmt_register_group();
 #endif
+#ifdef CONFIG_MCUMGR_CMD_STAT_SNAPSHOT
+	stat_snapshot_register_group();
+#endif
 
 #ifdef CONFIG_MCUMGR_SMP_BT
 	k_work_init(&advertise_work, advertise);
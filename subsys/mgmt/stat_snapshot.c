@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/byteorder.h>
+#include <stats/stats.h>
+#include "cborattr/cborattr.h"
+#include "mgmt/mgmt.h"
+#include <mgmt/stat_snapshot.h>
+
+static u64_t snapshot_values[CONFIG_STAT_SNAPSHOT_MAX_ENTRIES];
+static K_MUTEX_DEFINE(snapshot_lock);
+
+static int stat_snapshot_read(struct mgmt_ctxt *ctxt)
+{
+	char name[CONFIG_STAT_MGMT_MAX_NAME_LEN];
+	bool reset = false;
+	struct stats_hdr *hdr;
+	CborError err = 0;
+	int cnt;
+
+	const struct cbor_attr_t attrs[] = {
+		{
+			.attribute = "name",
+			.type = CborAttrTextStringType,
+			.addr.string = name,
+			.len = sizeof(name),
+		},
+		{
+			.attribute = "reset",
+			.type = CborAttrBooleanType,
+			.addr.boolean = &reset,
+			.nodefault = true,
+		},
+		{ .attribute = NULL },
+	};
+
+	name[0] = '\0';
+	if (cbor_read_object(&ctxt->it, attrs) != 0) {
+		return MGMT_ERR_EINVAL;
+	}
+
+	hdr = stats_group_find(name);
+	if (hdr == NULL) {
+		return MGMT_ERR_ENOENT;
+	}
+
+	k_mutex_lock(&snapshot_lock, K_FOREVER);
+
+	cnt = stats_snapshot(hdr, snapshot_values,
+			     ARRAY_SIZE(snapshot_values), reset);
+	for (int i = 0; i < cnt; i++) {
+		snapshot_values[i] = sys_cpu_to_le64(snapshot_values[i]);
+	}
+
+	err |= cbor_encode_text_stringz(&ctxt->encoder, "rc");
+	err |= cbor_encode_int(&ctxt->encoder, MGMT_ERR_EOK);
+	err |= cbor_encode_text_stringz(&ctxt->encoder, "name");
+	err |= cbor_encode_text_stringz(&ctxt->encoder, name);
+	err |= cbor_encode_text_stringz(&ctxt->encoder, "n");
+	err |= cbor_encode_uint(&ctxt->encoder, cnt);
+	err |= cbor_encode_text_stringz(&ctxt->encoder, "v");
+	err |= cbor_encode_byte_string(&ctxt->encoder,
+				       (const u8_t *)snapshot_values,
+				       cnt * sizeof(snapshot_values[0]));
+
+	k_mutex_unlock(&snapshot_lock);
+
+	if (err != 0) {
+		return MGMT_ERR_ENOMEM;
+	}
+
+	return MGMT_ERR_EOK;
+}
+
+static const struct mgmt_handler stat_snapshot_handlers[] = {
+	[STAT_SNAPSHOT_ID_READ] = {
+		.mh_read = stat_snapshot_read,
+		.mh_write = NULL,
+	},
+};
+
+static struct mgmt_group stat_snapshot_group = {
+	.mg_handlers = stat_snapshot_handlers,
+	.mg_handlers_count = ARRAY_SIZE(stat_snapshot_handlers),
+	.mg_group_id = CONFIG_STAT_SNAPSHOT_MGMT_GROUP_ID,
+};
+
+void stat_snapshot_register_group(void)
+{
+	mgmt_register_group(&stat_snapshot_group);
+}
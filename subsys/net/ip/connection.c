@@ -54,11 +54,28 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Handler for a single peer, hashed on the remote address and port */
+#define NET_CONN_CONNECTED		(NET_CONN_LOCAL_PORT_SPEC | \
+					 NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_REMOTE_ADDR_SPEC)
+
+/** Knuth's multiplicative hash constant, 2^32 / golden ratio */
+#define NET_CONN_HASH_MULT		2654435761U
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Unicast UDP and TCP packets are matched against two hash buckets: the
+ * one of the handlers bound to this peer, and the one of the handlers
+ * bound to the local port only. Handlers without a local port, and those
+ * of the other protocols, are on the wildcard list which is always
+ * checked.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +130,63 @@ void conn_register_debug(struct net_conn *conn,
 #define conn_register_debug(...)
 #endif /* (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG) */
 
+static inline bool conn_is_hashed(u16_t proto)
+{
+	return (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+		(IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP);
+}
+
+static u32_t conn_hash_addr(sa_family_t family, const void *addr)
+{
+	const u32_t *word = addr;
+	u32_t hash = UNALIGNED_GET(&word[0]);
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		hash ^= UNALIGNED_GET(&word[1]) ^ UNALIGNED_GET(&word[2]) ^
+			UNALIGNED_GET(&word[3]);
+	}
+
+	return hash;
+}
+
+/* Ports are in network byte order, addr_hash is 0 for a listener */
+static sys_slist_t *conn_hash_bucket(u16_t proto, u16_t local_port,
+				     u16_t remote_port, u32_t addr_hash)
+{
+	u32_t hash = proto ^ ((u32_t)local_port << 16 | remote_port) ^
+		addr_hash;
+
+	return &conn_hash[((hash * NET_CONN_HASH_MULT) >> 16) %
+			  CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	u16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	u16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	const void *addr;
+
+	if (!conn_is_hashed(conn->proto) ||
+	    !(conn->flags & NET_CONN_LOCAL_PORT_SPEC)) {
+		return &conn_wildcard;
+	}
+
+	if ((conn->flags & NET_CONN_CONNECTED) != NET_CONN_CONNECTED) {
+		return conn_hash_bucket(conn->proto, local_port, 0U, 0U);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    conn->remote_addr.sa_family == AF_INET6) {
+		addr = &net_sin6(&conn->remote_addr)->sin6_addr;
+	} else {
+		addr = &net_sin(&conn->remote_addr)->sin_addr;
+	}
+
+	return conn_hash_bucket(conn->proto, local_port, remote_port,
+				conn_hash_addr(conn->remote_addr.sa_family,
+					       addr));
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -132,6 +206,7 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_hash_list(conn), &conn->hash_node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -377,6 +452,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_hash_list(conn), &conn->hash_node);
 
 	conn_set_unused(conn);
 
@@ -504,6 +580,119 @@ static bool conn_are_end_points_valid(struct net_pkt *pkt,
 	return !(my_src_addr && (src_port == dst_port));
 }
 
+static bool conn_match(struct net_conn *conn, struct net_pkt *pkt,
+		       union net_ip_header *ip_hdr, u8_t proto,
+		       u16_t src_port, u16_t dst_port)
+{
+	if (conn->proto != proto) {
+		return false;
+	}
+
+	if (conn->family != AF_UNSPEC &&
+	    conn->family != net_pkt_family(pkt)) {
+		return false;
+	}
+
+	if (!IS_ENABLED(CONFIG_NET_UDP) && !IS_ENABLED(CONFIG_NET_TCP)) {
+		return true;
+	}
+
+	if (net_sin(&conn->remote_addr)->sin_port) {
+		if (net_sin(&conn->remote_addr)->sin_port != src_port) {
+			return false;
+		}
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port) {
+		if (net_sin(&conn->local_addr)->sin_port != dst_port) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			return false;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Rank the handlers of one list, with the same rules as the full scan
+ * in net_conn_input() uses.
+ */
+static struct net_conn *conn_rank_list(sys_slist_t *list,
+				       struct net_conn *best_match,
+				       struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       u8_t proto,
+				       u16_t src_port, u16_t dst_port)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, hash_node) {
+		if (best_match != NULL &&
+		    best_match->flags & NET_CONN_REMOTE_PORT_SPEC) {
+			break;
+		}
+
+		if (!conn_match(conn, pkt, ip_hdr, proto, src_port,
+				dst_port)) {
+			continue;
+		}
+
+		if (best_match == NULL ||
+		    NET_CONN_RANK(best_match->flags) <
+		    NET_CONN_RANK(conn->flags)) {
+			best_match = conn;
+		}
+	}
+
+	return best_match;
+}
+
+/* Find the handler for a unicast UDP or TCP packet. The handler bound to
+ * the sending peer is looked up first, so a connected socket wins over
+ * the listening one on the same port.
+ */
+static struct net_conn *conn_lookup(struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr,
+				    u8_t proto,
+				    u16_t src_port, u16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *best_match;
+	sys_slist_t *connected;
+	sys_slist_t *listener;
+	const void *addr;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		addr = &ip_hdr->ipv6->src;
+	} else {
+		addr = &ip_hdr->ipv4->src;
+	}
+
+	connected = conn_hash_bucket(proto, dst_port, src_port,
+				     conn_hash_addr(family, addr));
+	listener = conn_hash_bucket(proto, dst_port, 0U, 0U);
+
+	best_match = conn_rank_list(connected, NULL, pkt, ip_hdr, proto,
+				    src_port, dst_port);
+	if (listener != connected) {
+		best_match = conn_rank_list(listener, best_match, pkt, ip_hdr,
+					    proto, src_port, dst_port);
+	}
+
+	return conn_rank_list(&conn_wildcard, best_match, pkt, ip_hdr, proto,
+			      src_port, dst_port);
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				u8_t proto,
@@ -568,48 +757,20 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		if (conn->proto != proto) {
-			continue;
-		}
+	if (!is_mcast_pkt && conn_is_hashed(proto)) {
+		best_match = conn_lookup(pkt, ip_hdr, proto, src_port,
+					 dst_port);
+		goto deliver;
+	}
 
-		if (conn->family != AF_UNSPEC &&
-		    conn->family != net_pkt_family(pkt)) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+		if (!conn_match(conn, pkt, ip_hdr, proto, src_port,
+				dst_port)) {
 			continue;
 		}
 
 		if (IS_ENABLED(CONFIG_NET_UDP) ||
 		    IS_ENABLED(CONFIG_NET_TCP)) {
-			if (net_sin(&conn->remote_addr)->sin_port) {
-				if (net_sin(&conn->remote_addr)->sin_port !=
-				    src_port) {
-					continue;
-				}
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port) {
-				if (net_sin(&conn->local_addr)->sin_port !=
-				    dst_port) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->remote_addr,
-						   true)) {
-					continue;
-				}
-			}
-
-			if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-				if (!conn_addr_cmp(pkt, ip_hdr,
-						   &conn->local_addr,
-						   false)) {
-					continue;
-				}
-			}
-
 			/* If we have an existing best_match, and that one
 			 * specifies a remote port, then we've matched to a
 			 * LISTENING connection that should not override.
@@ -674,6 +835,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+deliver:
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -732,6 +894,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -12,6 +12,7 @@
 LOG_MODULE_REGISTER(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 
 #include <errno.h>
+#include <sys/byteorder.h>
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
@@ -291,6 +292,15 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 
 	net_pkt_set_family(pkt, PF_INET);
 
+	if (sys_get_be16(hdr->offset) & (NET_IPV4_MF | NET_IPV4_OFFSET_MASK)) {
+		verdict = net_ipv4_handle_fragment_hdr(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		}
+
+		return verdict;
+	}
+
 	NET_DBG("IPv4 packet received from %s to %s",
 		log_strdup(net_sprint_ipv4_addr(&hdr->src)),
 		log_strdup(net_sprint_ipv4_addr(&hdr->dst)));
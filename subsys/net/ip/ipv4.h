@@ -35,6 +35,11 @@
 
 #define NET_IPV4_HDR_OPTNS_MAX_LEN 40
 
+/* Flags and fragment offset field, as a 16 bit value */
+#define NET_IPV4_DF          0x4000 /* Don't fragment */
+#define NET_IPV4_MF          0x2000 /* More fragments */
+#define NET_IPV4_OFFSET_MASK 0x1fff /* Fragment offset in 8 byte units */
+
 /**
  * @brief Create IPv4 packet in provided net_pkt.
  *
@@ -132,4 +137,60 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Handles a received IPv4 fragment.
+ *
+ * @param pkt Network packet, the cursor is after the IPv4 header and its
+ * options.
+ * @param hdr The IPv4 header of the packet
+ *
+ * @return Return verdict about the packet
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr);
+#else
+static inline
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+/**
+ * @brief Fragment an IPv4 packet that does not fit the MTU of its
+ * interface, unless its don't fragment bit is set.
+ *
+ * @param pkt Network packet
+ *
+ * @return NET_OK if the packet is to be sent as is, NET_CONTINUE if its
+ * fragments were sent instead and NET_DROP if it cannot be sent.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+/**
+ * @brief Fragment an IPv4 packet and send the fragments.
+ *
+ * @param pkt Network packet
+ * @param mtu Largest fragment to send, headers included
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+int net_ipv4_send_fragmented_pkt(struct net_pkt *pkt, u16_t mtu);
+#endif
+
 #endif /* __IPV4_H */
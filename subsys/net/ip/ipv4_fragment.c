@@ -0,0 +1,272 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <random/rand32.h>
+#include <sys/byteorder.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include "net_private.h"
+#include "ipv4.h"
+#include "reassembly.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+/* Called by the reassembly engine with the fragments joined together */
+static void reassemble_packet(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		goto error;
+	}
+
+	hdr->len = htons(net_pkt_get_len(pkt));
+	sys_put_be16(0, hdr->offset);
+
+	hdr->chksum = 0U;
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_data(pkt, &ipv4_access);
+	net_pkt_set_ipv4_fragment_offset(pkt, 0U);
+
+	NET_DBG("New pkt %p IPv4 len is %zd bytes", pkt, net_pkt_get_len(pkt));
+
+	/* Fed back through the RX queue so that the stack is not nested. The
+	 * packet is marked as already processed by L2 as it has no link layer
+	 * header.
+	 */
+	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+		return;
+	}
+error:
+	net_pkt_unref(pkt);
+}
+
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	u16_t flags = sys_get_be16(hdr->offset);
+	struct net_reass_key key = {
+		.id = sys_get_be16(hdr->id),
+		.proto = hdr->proto,
+		.family = AF_INET,
+	};
+	bool more = !!(flags & NET_IPV4_MF);
+
+	/* The options are not known to the packet unless they are parsed */
+	if ((hdr->vhl & NET_IPV4_IHL_MASK) * 4U !=
+	    net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt)) {
+		NET_DBG("DROP: fragment with options");
+		return NET_DROP;
+	}
+
+	net_pkt_set_ipv4_fragment_offset(pkt,
+					 (flags & NET_IPV4_OFFSET_MASK) * 8U);
+
+	if (more && (net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		     net_pkt_ipv4_opts_len(pkt)) % 8) {
+		NET_DBG("DROP: fragment length not multiple of 8");
+		return NET_DROP;
+	}
+
+	memcpy(&key.src, &hdr->src, sizeof(struct in_addr));
+	memcpy(&key.dst, &hdr->dst, sizeof(struct in_addr));
+
+	NET_DBG("Fragment id 0x%x offset %u%s", key.id,
+		net_pkt_ipv4_fragment_offset(pkt), more ? " more" : "");
+
+	return net_reass_add(&key, pkt, more, IPV4_REASSEMBLY_TIMEOUT,
+			     reassemble_packet);
+}
+
+static int send_ipv4_fragment(struct net_pkt *pkt, u16_t id, u16_t hdr_len,
+			      u16_t frag_offset, u16_t fit_len, bool final)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	u8_t opts_len = net_pkt_ipv4_opts_len(pkt);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *frag_pkt;
+	int ret = -ENOBUFS;
+
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     hdr_len + fit_len, AF_INET, 0,
+					     BUF_ALLOC_TIMEOUT);
+	if (!frag_pkt) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* The options are only copied to the first fragment */
+	if (net_pkt_copy(frag_pkt, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + opts_len - hdr_len) ||
+	    net_pkt_skip(pkt, frag_offset) ||
+	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(frag_pkt, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv4_opts_len(frag_pkt, hdr_len - net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(frag_pkt, net_pkt_priority(pkt));
+
+	net_pkt_cursor_init(frag_pkt);
+	net_pkt_set_overwrite(frag_pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt, &ipv4_access);
+	if (!hdr) {
+		goto fail;
+	}
+
+	hdr->vhl = 0x40 | (hdr_len / 4U);
+	hdr->len = htons(hdr_len + fit_len);
+	sys_put_be16(id, hdr->id);
+	sys_put_be16((frag_offset / 8U) | (final ? 0 : NET_IPV4_MF),
+		     hdr->offset);
+
+	hdr->chksum = 0U;
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(frag_pkt))) {
+		hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+	}
+
+	net_pkt_set_data(frag_pkt, &ipv4_access);
+
+	ret = net_send_data(frag_pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return 0;
+
+fail:
+	NET_DBG("Cannot send fragment (%d)", ret);
+	net_pkt_unref(frag_pkt);
+
+	return ret;
+}
+
+int net_ipv4_send_fragmented_pkt(struct net_pkt *pkt, u16_t mtu)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	u16_t opts_len = net_pkt_ipv4_opts_len(pkt);
+	u16_t hdr_len = net_pkt_ip_hdr_len(pkt);
+	struct net_ipv4_hdr *hdr;
+	u16_t frag_offset = 0U;
+	size_t length;
+	int fit_len;
+	u16_t id;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		return -ENOBUFS;
+	}
+
+	id = sys_get_be16(hdr->id);
+	if (!id) {
+		id = sys_rand32_get();
+	}
+
+	length = net_pkt_get_len(pkt) - hdr_len - opts_len;
+
+	while (length) {
+		bool final = false;
+		u16_t frag_hdr_len;
+
+		/* Every fragment but the last carries a multiple of 8 bytes */
+		frag_hdr_len = hdr_len + (frag_offset ? 0 : opts_len);
+		fit_len = (mtu - frag_hdr_len) & ~7;
+		if (fit_len <= 0) {
+			NET_DBG("No room for IPv4 payload MTU %u hdrs_len %u",
+				mtu, frag_hdr_len);
+			return -EINVAL;
+		}
+
+		if (fit_len >= length) {
+			final = true;
+			fit_len = length;
+		}
+
+		ret = send_ipv4_fragment(pkt, id, frag_hdr_len, frag_offset,
+					 fit_len, final);
+		if (ret < 0) {
+			return ret;
+		}
+
+		length -= fit_len;
+		frag_offset += fit_len;
+	}
+
+	return 0;
+}
+
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	u16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	struct net_ipv4_hdr *hdr;
+	int ret;
+
+	/* A TCP packet with a segment size is cut into segments when it is
+	 * sent.
+	 */
+	if (!mtu || net_pkt_get_len(pkt) <= mtu || net_pkt_gso_size(pkt)) {
+		return NET_OK;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		return NET_DROP;
+	}
+
+	if (sys_get_be16(hdr->offset) & (NET_IPV4_DF | NET_IPV4_MF |
+					 NET_IPV4_OFFSET_MASK)) {
+		/* Not to be fragmented, or a fragment already */
+		return NET_OK;
+	}
+
+	ret = net_ipv4_send_fragmented_pkt(pkt, mtu);
+	if (ret < 0) {
+		NET_DBG("Cannot fragment IPv4 pkt (%d)", ret);
+
+		if (ret == -ENOMEM) {
+			/* Try to send the packet as is if we could not
+			 * allocate the fragments.
+			 */
+			return NET_OK;
+		}
+
+		return NET_DROP;
+	}
+
+	/* We "fake" the sending of the packet here so that TCP increases
+	 * the ref count when re-sending it, as for IPv6 fragments.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP)) {
+		net_pkt_set_sent(pkt, true);
+	}
+
+	net_pkt_unref(pkt);
+
+	return NET_CONTINUE;
+}
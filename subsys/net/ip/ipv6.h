@@ -22,6 +22,7 @@
 
 #include "icmpv6.h"
 #include "nbr.h"
+#include "nbr_hash.h"
 
 #define NET_IPV6_ND_HOP_LIMIT 255
 #define NET_IPV6_ND_INFINITE_LIFETIME 0xFFFFFFFF
@@ -86,6 +87,11 @@ struct net_ipv6_nbr_data {
 	/** IPv6 address. */
 	struct in6_addr addr;
 
+#if defined(CONFIG_NET_IPV6_NBR_CACHE)
+	/** Neighbor cache index by the IPv6 address */
+	struct net_nbr_hash_node hash_node;
+#endif
+
 	/** Reachable timer. */
 	s64_t reachable;
 
@@ -382,34 +388,7 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
 }
 #endif
 
-/* We do not have to accept larger than 1500 byte IPv6 packet (RFC 2460 ch 5).
- * This means that we should receive everything within first two fragments.
- * The first one being 1280 bytes and the second one 220 bytes.
- */
-#if !defined(NET_IPV6_FRAGMENTS_MAX_PKT)
-#define NET_IPV6_FRAGMENTS_MAX_PKT 2
-#endif
-
-/** Store pending IPv6 fragment information that is needed for reassembly. */
-struct net_ipv6_reassembly {
-	/** IPv6 source address of the fragment */
-	struct in6_addr src;
-
-	/** IPv6 destination address of the fragment */
-	struct in6_addr dst;
-
-	/**
-	 * Timeout for cancelling the reassembly. The timer is used
-	 * also to detect if this reassembly slot is used or not.
-	 */
-	struct k_delayed_work timer;
-
-	/** Pointers to pending fragments */
-	struct net_pkt *pkt[NET_IPV6_FRAGMENTS_MAX_PKT];
-
-	/** IPv6 fragment identification */
-	u32_t id;
-};
+struct net_reass;
 
 /**
  * @typedef net_ipv6_frag_cb_t
@@ -418,7 +397,7 @@ struct net_ipv6_reassembly {
  * @param reass IPv6 fragment reassembly struct
  * @param user_data A valid pointer on some user data or NULL
  */
-typedef void (*net_ipv6_frag_cb_t)(struct net_ipv6_reassembly *reass,
+typedef void (*net_ipv6_frag_cb_t)(struct net_reass *reass,
 				   void *user_data);
 
 /**
@@ -97,6 +97,9 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 		   net_neighbor_pool,
 		   net_neighbor_table_clear);
 
+/* The neighbors in use, indexed by their IPv6 address */
+NET_NBR_HASH_DEFINE(nbr_hash, sizeof(struct in6_addr));
+
 const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state)
 {
 	switch (state) {
@@ -255,29 +258,71 @@ void nbr_print(void)
 #define nbr_print(...)
 #endif
 
+static inline struct net_nbr *get_nbr_from_node(struct net_nbr_hash_node *node)
+{
+	struct net_ipv6_nbr_data *data;
+
+	data = CONTAINER_OF(node, struct net_ipv6_nbr_data, hash_node);
+
+	return CONTAINER_OF((u8_t *)data, struct net_nbr, __nbr);
+}
+
+struct nbr_match_data {
+	struct net_if *iface;
+	enum net_ipv6_nbr_state state;
+	u8_t idx;
+};
+
+/* Called inside the read section of the lookup */
+static bool nbr_match(struct net_nbr_hash_node *node, void *user_data)
+{
+	struct net_nbr *nbr = get_nbr_from_node(node);
+	struct nbr_match_data *data = user_data;
+
+	if (!nbr->ref || (data->iface && nbr->iface != data->iface)) {
+		return false;
+	}
+
+	data->state = net_ipv6_nbr_data(nbr)->state;
+	data->idx = nbr->idx;
+
+	return true;
+}
+
 static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	struct nbr_match_data data = { .iface = iface };
+	struct net_nbr_hash_node *node;
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	ARG_UNUSED(table);
 
-		if (!nbr->ref) {
-			continue;
-		}
+	node = net_nbr_hash_lookup(&nbr_hash, addr, nbr_match, &data);
+	if (!node) {
+		return NULL;
+	}
 
-		if (iface && nbr->iface != iface) {
-			continue;
-		}
+	return get_nbr_from_node(node);
+}
 
-		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
-			return nbr;
-		}
+/* Lookup for sending, which uses a copy of the link address index and
+ * of the state, taken while the neighbor could not be replaced.
+ */
+static bool nbr_lookup_lladdr(struct net_if *iface,
+			      const struct in6_addr *addr,
+			      u8_t *idx, enum net_ipv6_nbr_state *state)
+{
+	struct nbr_match_data data = { .iface = iface };
+
+	if (!net_nbr_hash_lookup(&nbr_hash, addr, nbr_match, &data)) {
+		return false;
 	}
 
-	return NULL;
+	*idx = data.idx;
+	*state = data.state;
+
+	return true;
 }
 
 static inline void nbr_clear_ns_pending(struct net_ipv6_nbr_data *data)
@@ -431,6 +476,9 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 
 	nbr_init(nbr, iface, addr, is_router, state);
 
+	net_nbr_hash_add(&nbr_hash, &net_ipv6_nbr_data(nbr)->hash_node,
+			 &net_ipv6_nbr_data(nbr)->addr);
+
 	NET_DBG("nbr %p iface %p/%d state %d IPv6 %s",
 		nbr, iface, net_if_get_by_iface(iface), state,
 		log_strdup(net_sprint_ipv6_addr(addr)));
@@ -653,7 +701,7 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
-	return;
+	net_nbr_hash_del(&nbr_hash, &net_ipv6_nbr_data(nbr)->hash_node);
 }
 
 void net_neighbor_table_clear(struct net_nbr_table *table)
@@ -775,7 +823,9 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 	struct in6_addr *nexthop = NULL;
 	struct net_if *iface = NULL;
 	struct net_ipv6_hdr *ip_hdr;
-	struct net_nbr *nbr;
+	enum net_ipv6_nbr_state state;
+	bool found;
+	u8_t idx;
 	int ret;
 
 	NET_ASSERT(pkt && pkt->buffer);
@@ -787,9 +837,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. A TCP packet
+	 * with a segment size is cut into segments when it is sent.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && !net_pkt_gso_size(pkt)) {
 		u16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
@@ -889,24 +940,23 @@ ignore_frag_error:
 	}
 
 try_send:
-	nbr = nbr_lookup(&net_neighbor.table, iface, nexthop);
+	found = nbr_lookup_lladdr(iface, nexthop, &idx, &state);
 
-	NET_DBG("Neighbor lookup %p (%d) iface %p/%d addr %s state %s", nbr,
-		nbr ? nbr->idx : NET_NBR_LLADDR_UNKNOWN,
+	NET_DBG("Neighbor lookup (%d) iface %p/%d addr %s state %s",
+		found ? idx : NET_NBR_LLADDR_UNKNOWN,
 		iface, net_if_get_by_iface(iface),
 		log_strdup(net_sprint_ipv6_addr(nexthop)),
-		nbr ? net_ipv6_nbr_state2str(net_ipv6_nbr_data(nbr)->state) :
-		"-");
+		found ? net_ipv6_nbr_state2str(state) : "-");
 
-	if (nbr && nbr->idx != NET_NBR_LLADDR_UNKNOWN) {
+	if (found && idx != NET_NBR_LLADDR_UNKNOWN) {
 		struct net_linkaddr_storage *lladdr;
 
-		lladdr = net_nbr_get_lladdr(nbr->idx);
+		lladdr = net_nbr_get_lladdr(idx);
 
 		net_pkt_lladdr_dst(pkt)->addr = lladdr->addr;
 		net_pkt_lladdr_dst(pkt)->len = lladdr->len;
 
-		NET_DBG("Neighbor %p addr %s", nbr,
+		NET_DBG("Neighbor addr %s",
 			log_strdup(net_sprint_ll_addr(lladdr->addr,
 						      lladdr->len)));
 
@@ -914,11 +964,21 @@ try_send:
 		 * See RFC 4861 ch 7.3.3 for details.
 		 */
 #if defined(CONFIG_NET_IPV6_ND)
-		if (net_ipv6_nbr_data(nbr)->state == NET_IPV6_NBR_STATE_STALE) {
-			ipv6_nbr_set_state(nbr, NET_IPV6_NBR_STATE_DELAY);
+		if (state == NET_IPV6_NBR_STATE_STALE) {
+			struct net_nbr *nbr;
 
-			ipv6_nd_restart_reachable_timer(nbr,
+			/* The state is changed on the neighbor itself, as
+			 * the other neighbor updates do.
+			 */
+			nbr = nbr_lookup(&net_neighbor.table, iface, nexthop);
+			if (nbr && net_ipv6_nbr_data(nbr)->state ==
+			    NET_IPV6_NBR_STATE_STALE) {
+				ipv6_nbr_set_state(nbr,
+						   NET_IPV6_NBR_STATE_DELAY);
+
+				ipv6_nd_restart_reachable_timer(nbr,
 							DELAY_FIRST_PROBE_TIME);
+			}
 		}
 #endif
 		return NET_OK;
@@ -0,0 +1,265 @@
+/** @file
+ * @brief Longest prefix match
+ *
+ * Path compressed binary trie over bit strings of up to 128 bits. A node
+ * only exists for a prefix that has entries or where two subtries meet,
+ * so a lookup visits at most one node per distinct prefix length on the
+ * path to the key.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/util.h>
+
+#include "lpm.h"
+
+static inline int lpm_bit(const u8_t *key, u8_t i)
+{
+	return (key[i / 8U] >> (7U - i % 8U)) & 1U;
+}
+
+/* Number of leading bits, up to max, that a and b have in common */
+static u8_t lpm_common(const u8_t *a, const u8_t *b, u8_t max)
+{
+	u8_t i = 0U;
+	u8_t len;
+
+	while (i * 8U < max && a[i] == b[i]) {
+		i++;
+	}
+
+	if (i * 8U >= max) {
+		return max;
+	}
+
+	len = i * 8U + __builtin_clz((u32_t)(a[i] ^ b[i])) - 24U;
+
+	return MIN(len, max);
+}
+
+static bool lpm_match(const u8_t *prefix, const u8_t *key, u8_t len)
+{
+	return lpm_common(prefix, key, len) == len;
+}
+
+static struct net_lpm_node *lpm_node_alloc(struct net_lpm *lpm,
+					   const u8_t *prefix, u8_t len)
+{
+	struct net_lpm_node *node = lpm->free;
+	u8_t bytes = (len + 7U) / 8U;
+
+	if (!node) {
+		return NULL;
+	}
+
+	lpm->free = node->child[0];
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	node->parent = NULL;
+	node->len = len;
+	sys_slist_init(&node->entries);
+
+	/* Bits past the length are kept clear */
+	memset(node->prefix, 0, sizeof(node->prefix));
+	memcpy(node->prefix, prefix, bytes);
+	if (len % 8U) {
+		node->prefix[bytes - 1] &= 0xff << (8U - len % 8U);
+	}
+
+	return node;
+}
+
+static void lpm_node_free(struct net_lpm *lpm, struct net_lpm_node *node)
+{
+	node->child[0] = lpm->free;
+	lpm->free = node;
+}
+
+/* Put node where old was below parent */
+static void lpm_replace(struct net_lpm *lpm, struct net_lpm_node *parent,
+			struct net_lpm_node *old, struct net_lpm_node *node)
+{
+	if (!parent) {
+		lpm->root = node;
+	} else if (parent->child[0] == old) {
+		parent->child[0] = node;
+	} else {
+		parent->child[1] = node;
+	}
+
+	if (node) {
+		node->parent = parent;
+	}
+}
+
+static void lpm_link(struct net_lpm_node *parent, struct net_lpm_node *node)
+{
+	parent->child[lpm_bit(node->prefix, parent->len)] = node;
+	node->parent = parent;
+}
+
+static void lpm_entry_add(struct net_lpm_node *node,
+			  struct net_lpm_entry *entry)
+{
+	entry->owner = node;
+	sys_slist_append(&node->entries, &entry->node);
+}
+
+void net_lpm_init(struct net_lpm *lpm, struct net_lpm_node *nodes,
+		  size_t count)
+{
+	lpm->root = NULL;
+	lpm->free = NULL;
+
+	while (count--) {
+		lpm_node_free(lpm, &nodes[count]);
+	}
+}
+
+int net_lpm_add(struct net_lpm *lpm, struct net_lpm_entry *entry,
+		const u8_t *prefix, u8_t len)
+{
+	struct net_lpm_node *parent = NULL;
+	struct net_lpm_node *cur = lpm->root;
+	struct net_lpm_node *node, *branch;
+	u8_t common;
+
+	while (cur) {
+		common = lpm_common(cur->prefix, prefix, MIN(cur->len, len));
+
+		if (common < cur->len) {
+			break;
+		}
+
+		if (cur->len == len) {
+			lpm_entry_add(cur, entry);
+			return 0;
+		}
+
+		parent = cur;
+		cur = cur->child[lpm_bit(prefix, cur->len)];
+	}
+
+	node = lpm_node_alloc(lpm, prefix, len);
+	if (!node) {
+		return -ENOMEM;
+	}
+
+	if (!cur) {
+		/* New leaf */
+		if (parent) {
+			lpm_link(parent, node);
+		} else {
+			lpm->root = node;
+		}
+	} else if (common == len) {
+		/* The prefix is above the node found */
+		lpm_replace(lpm, parent, cur, node);
+		lpm_link(node, cur);
+	} else {
+		/* The prefix and the node found part at the common bits */
+		branch = lpm_node_alloc(lpm, prefix, common);
+		if (!branch) {
+			lpm_node_free(lpm, node);
+			return -ENOMEM;
+		}
+
+		lpm_replace(lpm, parent, cur, branch);
+		lpm_link(branch, cur);
+		lpm_link(branch, node);
+	}
+
+	lpm_entry_add(node, entry);
+
+	return 0;
+}
+
+void net_lpm_del(struct net_lpm *lpm, struct net_lpm_entry *entry)
+{
+	struct net_lpm_node *node = entry->owner;
+	struct net_lpm_node *parent, *child;
+
+	if (!node) {
+		return;
+	}
+
+	sys_slist_find_and_remove(&node->entries, &entry->node);
+	entry->owner = NULL;
+
+	/* Drop the nodes that neither hold entries nor join two subtries */
+	while (node && sys_slist_is_empty(&node->entries) &&
+	       !(node->child[0] && node->child[1])) {
+		child = node->child[0] ? node->child[0] : node->child[1];
+		parent = node->parent;
+
+		lpm_replace(lpm, parent, node, child);
+		lpm_node_free(lpm, node);
+
+		node = parent;
+	}
+}
+
+static struct net_lpm_entry *lpm_entry_get(struct net_lpm_node *node,
+					   net_lpm_match_t match,
+					   void *user_data)
+{
+	struct net_lpm_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->entries, entry, node) {
+		if (!match || match(entry, user_data)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+struct net_lpm_entry *net_lpm_lookup(struct net_lpm *lpm, const u8_t *key,
+				     u8_t len, net_lpm_match_t match,
+				     void *user_data)
+{
+	struct net_lpm_node *cur = lpm->root;
+	struct net_lpm_entry *best = NULL;
+	struct net_lpm_entry *entry;
+
+	while (cur && cur->len <= len &&
+	       lpm_match(cur->prefix, key, cur->len)) {
+		entry = lpm_entry_get(cur, match, user_data);
+		if (entry) {
+			best = entry;
+		}
+
+		if (cur->len == len) {
+			break;
+		}
+
+		cur = cur->child[lpm_bit(key, cur->len)];
+	}
+
+	return best;
+}
+
+struct net_lpm_entry *net_lpm_find(struct net_lpm *lpm, const u8_t *prefix,
+				   u8_t len, net_lpm_match_t match,
+				   void *user_data)
+{
+	struct net_lpm_node *cur = lpm->root;
+
+	while (cur && cur->len <= len &&
+	       lpm_match(cur->prefix, prefix, cur->len)) {
+		if (cur->len == len) {
+			return lpm_entry_get(cur, match, user_data);
+		}
+
+		cur = cur->child[lpm_bit(prefix, cur->len)];
+	}
+
+	return NULL;
+}
@@ -0,0 +1,131 @@
+/** @file
+ @brief Longest prefix match
+
+ This is not to be included by the application and is only used by
+ core IP stack.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __LPM_H
+#define __LPM_H
+
+#include <zephyr/types.h>
+#include <sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest key, an IPv6 address */
+#define NET_LPM_KEY_LEN 16
+
+/**
+ * @brief Node of a path compressed binary trie. A node holds the entries
+ * added with exactly its prefix, or none if it only joins two subtries.
+ */
+struct net_lpm_node {
+	struct net_lpm_node *child[2];
+	struct net_lpm_node *parent;
+
+	/** Entries with this prefix */
+	sys_slist_t entries;
+
+	u8_t prefix[NET_LPM_KEY_LEN];
+
+	/** Prefix length in bits */
+	u8_t len;
+};
+
+/**
+ * @brief Entry of a prefix trie, to be embedded in the structure that is
+ * looked up.
+ */
+struct net_lpm_entry {
+	sys_snode_t node;
+	struct net_lpm_node *owner;
+};
+
+/**
+ * @brief Prefix trie. The nodes come from a fixed array, a trie of n
+ * prefixes needs at most 2 * n - 1 nodes.
+ */
+struct net_lpm {
+	struct net_lpm_node *root;
+	struct net_lpm_node *free;
+};
+
+typedef bool (*net_lpm_match_t)(struct net_lpm_entry *entry,
+				void *user_data);
+
+/**
+ * @brief Set up an empty trie
+ *
+ * @param lpm Trie
+ * @param nodes Nodes for the trie to use
+ * @param count Number of nodes
+ */
+void net_lpm_init(struct net_lpm *lpm, struct net_lpm_node *nodes,
+		  size_t count);
+
+/**
+ * @brief Add an entry for a prefix
+ *
+ * @param lpm Trie
+ * @param entry Entry, not in any trie
+ * @param prefix Prefix, bits past its length are ignored
+ * @param len Prefix length in bits
+ *
+ * @return 0 if ok, -ENOMEM if there are no nodes left.
+ */
+int net_lpm_add(struct net_lpm *lpm, struct net_lpm_entry *entry,
+		const u8_t *prefix, u8_t len);
+
+/**
+ * @brief Remove an entry added with net_lpm_add()
+ *
+ * @param lpm Trie
+ * @param entry Entry
+ */
+void net_lpm_del(struct net_lpm *lpm, struct net_lpm_entry *entry);
+
+/**
+ * @brief Find the entry with the longest prefix of a key
+ *
+ * @param lpm Trie
+ * @param key Key
+ * @param len Key length in bits
+ * @param match Called for the entries with a matching prefix, an entry is
+ * only taken if it returns true. NULL takes any entry.
+ * @param user_data Passed to match
+ *
+ * @return Entry, NULL if no prefix matches.
+ */
+struct net_lpm_entry *net_lpm_lookup(struct net_lpm *lpm, const u8_t *key,
+				     u8_t len, net_lpm_match_t match,
+				     void *user_data);
+
+/**
+ * @brief Find the entry added for exactly this prefix
+ *
+ * @param lpm Trie
+ * @param prefix Prefix
+ * @param len Prefix length in bits
+ * @param match As for net_lpm_lookup()
+ * @param user_data Passed to match
+ *
+ * @return Entry, NULL if there is none.
+ */
+struct net_lpm_entry *net_lpm_find(struct net_lpm *lpm, const u8_t *prefix,
+				   u8_t len, net_lpm_match_t match,
+				   void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LPM_H */
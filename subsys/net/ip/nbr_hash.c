@@ -0,0 +1,204 @@
+/** @file
+ * @brief Hashed neighbor cache index
+ *
+ * The ARP table and the IPv6 neighbor cache are consulted for every
+ * packet sent. They are indexed here by the address of the neighbor, so
+ * the lookup takes the same time whatever the number of neighbors and
+ * does not need to lock the cache against its updates.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+
+#include "nbr_hash.h"
+
+BUILD_ASSERT((CONFIG_NET_NBR_HASH_SIZE & (CONFIG_NET_NBR_HASH_SIZE - 1)) == 0,
+	     "CONFIG_NET_NBR_HASH_SIZE must be a power of two");
+
+static u32_t key_hash(struct net_nbr_hash *hash, const void *key)
+{
+	const u8_t *addr = key;
+	u32_t word, val = 0U;
+	int i;
+
+	for (i = 0; i < hash->key_len; i += sizeof(word)) {
+		memcpy(&word, addr + i, sizeof(word));
+		val ^= word;
+	}
+
+	val *= 0x9e3779b1U;
+	val ^= val >> 16;
+
+	return val & hash->mask;
+}
+
+/* Called with the lock held, the readers walk the chains again if they
+ * have seen any of the changes done in between.
+ */
+static inline void write_begin(struct net_nbr_hash *hash)
+{
+	atomic_inc(&hash->seq);
+}
+
+static inline void write_end(struct net_nbr_hash *hash)
+{
+	atomic_inc(&hash->seq);
+}
+
+k_spinlock_key_t net_nbr_hash_update_begin(struct net_nbr_hash *hash)
+{
+	k_spinlock_key_t key = k_spin_lock(&hash->lock);
+
+	write_begin(hash);
+
+	return key;
+}
+
+void net_nbr_hash_update_end(struct net_nbr_hash *hash, k_spinlock_key_t key)
+{
+	write_end(hash);
+
+	k_spin_unlock(&hash->lock, key);
+}
+
+void net_nbr_hash_add(struct net_nbr_hash *hash,
+		      struct net_nbr_hash_node *node, const void *key)
+{
+	struct net_nbr_hash_node **bucket = &hash->buckets[key_hash(hash, key)];
+	k_spinlock_key_t lock = k_spin_lock(&hash->lock);
+
+	write_begin(hash);
+
+	node->key = key;
+	node->last_used = k_uptime_get_32();
+	node->next = *bucket;
+
+	/* The node is complete before a reader can reach it */
+	compiler_barrier();
+
+	*bucket = node;
+	hash->count++;
+
+	write_end(hash);
+
+	k_spin_unlock(&hash->lock, lock);
+}
+
+void net_nbr_hash_del(struct net_nbr_hash *hash,
+		      struct net_nbr_hash_node *node)
+{
+	struct net_nbr_hash_node **prev;
+	k_spinlock_key_t lock;
+
+	if (!node->key) {
+		return;
+	}
+
+	lock = k_spin_lock(&hash->lock);
+
+	for (prev = &hash->buckets[key_hash(hash, node->key)]; *prev;
+	     prev = &(*prev)->next) {
+		if (*prev != node) {
+			continue;
+		}
+
+		write_begin(hash);
+
+		/* The next pointer of the node is left as it is, a reader
+		 * standing on it goes on with the rest of the chain.
+		 */
+		*prev = node->next;
+		node->key = NULL;
+		hash->count--;
+
+		write_end(hash);
+		break;
+	}
+
+	k_spin_unlock(&hash->lock, lock);
+}
+
+struct net_nbr_hash_node *net_nbr_hash_lookup(struct net_nbr_hash *hash,
+					      const void *key,
+					      net_nbr_hash_match_t match,
+					      void *user_data)
+{
+	u32_t idx = key_hash(hash, key);
+	struct net_nbr_hash_node *node;
+	atomic_val_t seq;
+	int steps;
+
+	for (;;) {
+		seq = atomic_get(&hash->seq);
+		if (seq & 1) {
+			/* A writer is changing the chains */
+			continue;
+		}
+
+		/* A reader delayed while nodes move around could find
+		 * itself going in circles, the walk is bounded and done
+		 * again in that case.
+		 */
+		steps = hash->count;
+
+		for (node = hash->buckets[idx]; node; node = node->next) {
+			const void *node_key = node->key;
+
+			if (steps-- <= 0) {
+				node = NULL;
+				break;
+			}
+
+			if (node_key &&
+			    !memcmp(node_key, key, hash->key_len) &&
+			    (!match || match(node, user_data))) {
+				break;
+			}
+		}
+
+		/* What match copied belongs to the node found only if
+		 * nothing changed meanwhile.
+		 */
+		if (atomic_get(&hash->seq) == seq) {
+			break;
+		}
+	}
+
+	if (node) {
+		/* Only a hint for the replacement policy, a node reused
+		 * meanwhile just looks recently used.
+		 */
+		node->last_used = k_uptime_get_32();
+	}
+
+	return node;
+}
+
+struct net_nbr_hash_node *net_nbr_hash_lru(struct net_nbr_hash *hash)
+{
+	struct net_nbr_hash_node *node, *oldest = NULL;
+	u32_t now = k_uptime_get_32();
+	k_spinlock_key_t lock;
+	int i;
+
+	lock = k_spin_lock(&hash->lock);
+
+	for (i = 0; i <= hash->mask; i++) {
+		for (node = hash->buckets[i]; node; node = node->next) {
+			if (!oldest ||
+			    now - node->last_used > now - oldest->last_used) {
+				oldest = node;
+			}
+		}
+	}
+
+	k_spin_unlock(&hash->lock, lock);
+
+	return oldest;
+}
@@ -0,0 +1,168 @@
+/** @file
+ @brief Hashed neighbor cache index
+
+ This is not to be included by the application and is only used by
+ core IP stack.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NBR_HASH_H
+#define __NBR_HASH_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <spinlock.h>
+#include <sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Entry of a neighbor hash, to be embedded in the neighbor
+ * structure that is looked up.
+ */
+struct net_nbr_hash_node {
+	struct net_nbr_hash_node *next;
+
+	/** Address of the neighbor, kept in the neighbor structure */
+	const void *key;
+
+	/** Uptime of the last lookup that found the neighbor */
+	u32_t last_used;
+};
+
+/**
+ * @brief Hash of neighbors by their IP address.
+ *
+ * The lookups take no lock. The writers serialize on the spin lock and
+ * bump the sequence count before and after changing the chains, a reader
+ * walks the chain again if the count was odd or has changed meanwhile.
+ * The nodes come from static neighbor tables and are never freed, so a
+ * reader racing with a writer always follows valid pointers. They are
+ * reused for other neighbors though, so what a lockless reader needs
+ * from the neighbor is copied while the count is checked, see
+ * net_nbr_hash_lookup().
+ */
+struct net_nbr_hash {
+	struct net_nbr_hash_node **buckets;
+	struct k_spinlock lock;
+	atomic_t seq;
+
+	/** Number of nodes in the hash, bounds the chain walks */
+	u16_t count;
+
+	/** Number of buckets minus one */
+	u16_t mask;
+
+	/** Length of the keys in bytes, a multiple of 4 */
+	u8_t key_len;
+};
+
+/**
+ * @brief Define a neighbor hash with CONFIG_NET_NBR_HASH_SIZE buckets
+ *
+ * @param _name Name of the hash
+ * @param _key_len Length of the keys, the size of an IP address
+ */
+#define NET_NBR_HASH_DEFINE(_name, _key_len)				\
+	static struct net_nbr_hash_node *				\
+			_name##_buckets[CONFIG_NET_NBR_HASH_SIZE];	\
+	static struct net_nbr_hash _name = {				\
+		.buckets = _name##_buckets,				\
+		.mask = CONFIG_NET_NBR_HASH_SIZE - 1,			\
+		.key_len = _key_len,					\
+	}
+
+/**
+ * @brief Check a node with the address looked up
+ *
+ * Called inside the read section of net_nbr_hash_lookup(), maybe several
+ * times for the same node if the lookup is done again. The fields of the
+ * neighbor the caller needs are copied to user_data here when the node
+ * is taken.
+ *
+ * @return true to take the node.
+ */
+typedef bool (*net_nbr_hash_match_t)(struct net_nbr_hash_node *node,
+				     void *user_data);
+
+/**
+ * @brief Add a neighbor
+ *
+ * @param hash Hash
+ * @param node Node of the neighbor, not in any hash
+ * @param key Address of the neighbor, must not change while it is added
+ */
+void net_nbr_hash_add(struct net_nbr_hash *hash,
+		      struct net_nbr_hash_node *node, const void *key);
+
+/**
+ * @brief Remove a neighbor, does nothing if it was not added
+ *
+ * @param hash Hash
+ * @param node Node of the neighbor
+ */
+void net_nbr_hash_del(struct net_nbr_hash *hash,
+		      struct net_nbr_hash_node *node);
+
+/**
+ * @brief Begin changing fields of added neighbors that lockless lookups
+ * copy, so that they see either the old or the new values.
+ *
+ * @param hash Hash
+ *
+ * @return Key to pass to net_nbr_hash_update_end()
+ */
+k_spinlock_key_t net_nbr_hash_update_begin(struct net_nbr_hash *hash);
+
+/**
+ * @brief End the changes begun with net_nbr_hash_update_begin()
+ *
+ * @param hash Hash
+ * @param key Key returned by net_nbr_hash_update_begin()
+ */
+void net_nbr_hash_update_end(struct net_nbr_hash *hash, k_spinlock_key_t key);
+
+/**
+ * @brief Find a neighbor by its address and mark it as used
+ *
+ * Safe to call without any lock, also while neighbors are added and
+ * removed. Without the lock the neighbor table is changed under, the
+ * node returned may be removed and reused for another neighbor at any
+ * time. Such callers only use what match copied, which is consistent
+ * with the node returned.
+ *
+ * @param hash Hash
+ * @param key Address
+ * @param match Called for the nodes with the address, a node is only
+ * taken if it returns true. NULL takes any node.
+ * @param user_data Passed to match
+ *
+ * @return Node, NULL if there is none.
+ */
+struct net_nbr_hash_node *net_nbr_hash_lookup(struct net_nbr_hash *hash,
+					      const void *key,
+					      net_nbr_hash_match_t match,
+					      void *user_data);
+
+/**
+ * @brief Get the least recently used neighbor, to be replaced when the
+ * cache is full.
+ *
+ * @param hash Hash
+ *
+ * @return Node, NULL if the hash is empty.
+ */
+struct net_nbr_hash_node *net_nbr_hash_lru(struct net_nbr_hash *hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NBR_HASH_H */
@@ -1187,26 +1187,62 @@ static int get_context_txtime(struct net_context *context,
 #endif
 }
 
+static int get_context_tcp_nodelay(struct net_context *context,
+				   void *value, size_t *len)
+{
+#if defined(CONFIG_NET_TCP2)
+	*((bool *)value) = context->options.tcp_nodelay;
+
+	if (len) {
+		*len = sizeof(bool);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int get_context_tcp_cork(struct net_context *context,
+				void *value, size_t *len)
+{
+#if defined(CONFIG_NET_TCP2)
+	*((bool *)value) = context->options.tcp_cork;
+
+	if (len) {
+		*len = sizeof(bool);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. With chksum set the data is summed up while it
+ * is copied, for the transport checksum.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      bool chksum)
 {
+	int (*write)(struct net_pkt *pkt, const void *data, size_t length) =
+		chksum ? net_pkt_write_chksum : net_pkt_write;
 	int ret = 0;
 
 	if (msghdr) {
 		int i;
 
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    msghdr->msg_iov[i].iov_len);
+			ret = write(pkt, msghdr->msg_iov[i].iov_base,
+				    msghdr->msg_iov[i].iov_len);
 			if (ret < 0) {
 				break;
 			}
 		}
 	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+		ret = write(pkt, buf, buf_len);
 	}
 
 	return ret;
@@ -1258,7 +1294,9 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	ret = context_write_data(pkt, buf, len, msg,
+				 net_if_need_calc_tx_checksum(
+					 net_context_get_iface(context)));
 	if (ret) {
 		return ret;
 	}
@@ -1547,7 +1585,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1576,7 +1614,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1590,7 +1628,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1601,7 +1639,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, false);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1709,6 +1747,143 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Largest IP packet sent on the interface of pkt, never less than the
+ * minimum MTU of its family.
+ */
+static size_t context_mtu(struct net_pkt *pkt)
+{
+	size_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		return MAX(mtu, NET_IPV6_MTU);
+	}
+
+	return MAX(mtu, NET_IPV4_MTU);
+}
+
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *buf,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 net_context_send_cb_t cb,
+			 k_timeout_t timeout,
+			 void *user_data)
+{
+	sa_family_t family = net_context_get_family(context);
+	size_t len = net_buf_frags_len(buf);
+	struct net_pkt *pkt = NULL;
+	int ret;
+
+	NET_ASSERT(PART_OF_ARRAY(contexts, context));
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!net_context_is_used(context)) {
+		ret = -EBADF;
+		goto fail;
+	}
+
+	if (!dst_addr) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET)) {
+			ret = -EDESTADDRREQ;
+			goto fail;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = family == AF_INET6 ? sizeof(struct sockaddr_in6) :
+			sizeof(struct sockaddr_in);
+	}
+
+	if ((family == AF_INET6 && addrlen < sizeof(struct sockaddr_in6)) ||
+	    (family == AF_INET && addrlen < sizeof(struct sockaddr_in))) {
+		ret = -EINVAL;
+		goto fail;
+	}
+
+	context->send_cb = cb;
+	context->user_data = user_data;
+
+	if (IS_ENABLED(CONFIG_NET_UDP) &&
+	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
+		/* Only the headers are written, the data follows them */
+		pkt = context_alloc_pkt(context, 0, PKT_WAIT_TIME);
+		if (!pkt) {
+			ret = -ENOMEM;
+			goto fail;
+		}
+
+		ret = context_setup_udp_packet(context, pkt, NULL, 0, NULL,
+					       dst_addr, addrlen);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		/* The datagram is sent as it is, so unlike with a copy
+		 * it cannot be cut to the MTU.
+		 */
+		if (net_pkt_get_len(pkt) + len > context_mtu(pkt)) {
+			ret = -EMSGSIZE;
+			goto fail;
+		}
+
+		net_pkt_append_buffer(pkt, buf);
+		buf = NULL;
+
+		context_finalize_packet(context, pkt);
+
+		ret = net_send_data(pkt);
+	} else if (IS_ENABLED(CONFIG_NET_TCP2) &&
+		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
+		/* TCP queues data only packets and adds the headers to
+		 * each segment.
+		 */
+		pkt = net_pkt_alloc_on_iface(net_context_get_iface(context),
+					     PKT_WAIT_TIME);
+		if (!pkt) {
+			ret = -ENOMEM;
+			goto fail;
+		}
+
+		net_pkt_set_family(pkt, family);
+		net_pkt_set_context(pkt, context);
+		net_pkt_append_buffer(pkt, buf);
+		buf = NULL;
+
+		ret = net_tcp_queue_data(context, pkt);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		pkt = NULL;
+
+		ret = net_tcp_send_data(context, cb, user_data);
+	} else {
+		ret = -EOPNOTSUPP;
+	}
+
+	if (ret < 0) {
+		goto fail;
+	}
+
+	k_mutex_unlock(&context->lock);
+
+	return len;
+fail:
+	if (pkt) {
+		net_pkt_unref(pkt);
+	}
+
+	if (buf) {
+		net_buf_unref(buf);
+	}
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -2049,6 +2224,38 @@ static int set_context_txtime(struct net_context *context,
 #endif
 }
 
+static int set_context_tcp_nodelay(struct net_context *context,
+				   const void *value, size_t len)
+{
+#if defined(CONFIG_NET_TCP2)
+	if (len > sizeof(bool)) {
+		return -EINVAL;
+	}
+
+	context->options.tcp_nodelay = *((bool *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int set_context_tcp_cork(struct net_context *context,
+				const void *value, size_t len)
+{
+#if defined(CONFIG_NET_TCP2)
+	if (len > sizeof(bool)) {
+		return -EINVAL;
+	}
+
+	context->options.tcp_cork = *((bool *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_proxy(struct net_context *context,
 			     const void *value, size_t len)
 {
@@ -2099,10 +2306,24 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = set_context_proxy(context, value, len);
 		break;
+	case NET_OPT_TCP_NODELAY:
+		ret = set_context_tcp_nodelay(context, value, len);
+		break;
+	case NET_OPT_TCP_CORK:
+		ret = set_context_tcp_cork(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
 
+	/* Data held back by the previous setting may go now. TCP takes
+	 * the context lock while holding its own, so push it unlocked.
+	 */
+	if (ret == 0 && net_context_get_ip_proto(context) == IPPROTO_TCP &&
+	    (option == NET_OPT_TCP_NODELAY || option == NET_OPT_TCP_CORK)) {
+		(void)net_tcp_send_data(context, NULL, NULL);
+	}
+
 	return ret;
 }
 
@@ -2133,6 +2354,12 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = get_context_proxy(context, value, len);
 		break;
+	case NET_OPT_TCP_NODELAY:
+		ret = get_context_tcp_nodelay(context, value, len);
+		break;
+	case NET_OPT_TCP_CORK:
+		ret = get_context_tcp_cork(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -54,9 +54,33 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #include "ipv4_autoconf_internal.h"
 
 #include "net_stats.h"
+#include "net_gro.h"
+
+static enum net_verdict process_ip(struct net_pkt *pkt, bool is_loopback)
+{
+	/* IP version and header length. */
+	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
+#if defined(CONFIG_NET_IPV6)
+	case 0x60:
+		return net_ipv6_input(pkt, is_loopback);
+#endif
+#if defined(CONFIG_NET_IPV4)
+	case 0x40:
+		return net_ipv4_input(pkt);
+#endif
+	}
+
+	NET_DBG("Unknown IP family packet (0x%x)",
+		NET_IPV6_HDR(pkt)->vtc & 0xf0);
+	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
+	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
+
+	return NET_DROP;
+}
 
 static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+					    bool is_loopback,
+					    struct net_gro *gro)
 {
 	int ret;
 	bool locally_routed = false;
@@ -66,15 +90,13 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		return ret;
 	}
 
-#if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If the packet is routed back to us when we have reassembled
-	 * an IPv6 packet, then do not pass it to L2 as the packet does
+	 * an IP packet, then do not pass it to L2 as the packet does
 	 * not have link layer headers in it.
 	 */
-	if (net_pkt_ipv6_fragment_start(pkt)) {
+	if (net_pkt_is_l2_processed(pkt)) {
 		locally_routed = true;
 	}
-#endif
 
 	/* If there is no data, then drop the packet. */
 	if (!pkt->frags) {
@@ -107,29 +129,17 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	 */
 	net_pkt_cursor_init(pkt);
 
-	/* IP version and header length. */
-	switch (NET_IPV6_HDR(pkt)->vtc & 0xf0) {
-#if defined(CONFIG_NET_IPV6)
-	case 0x60:
-		return net_ipv6_input(pkt, is_loopback);
-#endif
-#if defined(CONFIG_NET_IPV4)
-	case 0x40:
-		return net_ipv4_input(pkt);
-#endif
+	if (gro && net_gro_receive(gro, pkt, is_loopback) == NET_OK) {
+		return NET_OK;
 	}
 
-	NET_DBG("Unknown IP family packet (0x%x)",
-		NET_IPV6_HDR(pkt)->vtc & 0xf0);
-	net_stats_update_ip_errors_protoerr(net_pkt_iface(pkt));
-	net_stats_update_ip_errors_vhlerr(net_pkt_iface(pkt));
-
-	return NET_DROP;
+	return process_ip(pkt, is_loopback);
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static void processing_data(struct net_pkt *pkt, bool is_loopback,
+			    struct net_gro *gro)
 {
-	switch (process_data(pkt, is_loopback)) {
+	switch (process_data(pkt, is_loopback, gro)) {
 	case NET_OK:
 		NET_DBG("Consumed pkt %p", pkt);
 		break;
@@ -308,7 +318,7 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
-		processing_data(pkt, true);
+		processing_data(pkt, true, NULL);
 		return 0;
 	}
 
@@ -319,7 +329,8 @@ int net_send_data(struct net_pkt *pkt)
 	return 0;
 }
 
-static void net_rx(struct net_if *iface, struct net_pkt *pkt)
+static void net_rx(struct net_if *iface, struct net_pkt *pkt,
+		   struct net_gro *gro)
 {
 	bool is_loopback = false;
 	size_t pkt_len;
@@ -338,7 +349,7 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 #endif
 	}
 
-	processing_data(pkt, is_loopback);
+	processing_data(pkt, is_loopback, gro);
 
 	net_print_statistics();
 	net_pkt_print();
@@ -350,9 +361,37 @@ static void process_rx_packet(struct k_work *work)
 
 	pkt = CONTAINER_OF(work, struct net_pkt, work);
 
-	net_rx(net_pkt_iface(pkt), pkt);
+	net_rx(net_pkt_iface(pkt), pkt, NULL);
 }
 
+#if defined(CONFIG_NET_RX_BATCH)
+/* Packets held back by GRO come here when they are released */
+static void process_ip_held(struct net_pkt *pkt, bool is_loopback)
+{
+	if (process_ip(pkt, is_loopback) != NET_OK) {
+		NET_DBG("Dropping pkt %p", pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+void net_rx_batch(sys_slist_t *pkts)
+{
+	struct net_gro gro;
+	struct net_pkt *pkt;
+	sys_snode_t *node;
+
+	net_gro_init(&gro, process_ip_held);
+
+	while ((node = sys_slist_get(pkts)) != NULL) {
+		pkt = CONTAINER_OF(node, struct net_pkt, next);
+
+		net_rx(net_pkt_iface(pkt), pkt, &gro);
+	}
+
+	net_gro_flush(&gro);
+}
+#endif
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	u8_t prio = net_pkt_priority(pkt);
@@ -405,6 +444,31 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 	return 0;
 }
 
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	int ret = 0;
+	size_t i;
+
+	if (k_is_in_isr()) {
+		return -EINVAL;
+	}
+
+	/* The RX thread gets to run once all of them are queued */
+	k_sched_lock();
+
+	for (i = 0; i < count; i++) {
+		ret = net_recv_data(iface, pkts[i]);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	k_sched_unlock();
+
+	return i > 0 ? i : ret;
+}
+
 static inline void l3_init(void)
 {
 	net_icmpv4_init();
@@ -423,6 +487,7 @@ static inline void l3_init(void)
 	net_tcp_init();
 
 	net_route_init();
+	net_route_ipv4_init();
 
 	NET_DBG("Network L3 init done");
 }
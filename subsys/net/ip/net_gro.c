@@ -0,0 +1,326 @@
+/** @file
+ * @brief Generic receive offload
+ *
+ * In order TCP segments of a connection received in one RX batch are
+ * merged into one packet before they are passed to IP.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_gro, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <sys/byteorder.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+#include "net_gro.h"
+
+/* Offsets of the fields compared between the segments of a connection */
+#define IPV4_ADDR_OFFSET offsetof(struct net_ipv4_hdr, src)
+#define IPV6_ADDR_OFFSET offsetof(struct net_ipv6_hdr, src)
+
+static bool gro_is_ipv4(struct net_pkt *pkt)
+{
+	return IS_ENABLED(CONFIG_NET_IPV4) &&
+		(pkt->buffer->data[0] & 0xf0) == 0x40;
+}
+
+static bool gro_is_ipv6(struct net_pkt *pkt)
+{
+	return IS_ENABLED(CONFIG_NET_IPV6) &&
+		(pkt->buffer->data[0] & 0xf0) == 0x60;
+}
+
+/* Find the IP and TCP headers of a packet, which must both be in the
+ * first buffer. Returns 1 if the packet is a TCP data segment that can be
+ * merged, 0 for any other TCP segment and -EINVAL for anything else.
+ */
+static int gro_parse(struct net_pkt *pkt, struct net_gro_flow *seg)
+{
+	size_t pkt_len = net_pkt_get_len(pkt);
+	struct net_buf *buf = pkt->buffer;
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_ipv6_hdr *ipv6_hdr;
+	u8_t l3_len, flags;
+
+	if (!buf || buf->len < sizeof(struct net_ipv4_hdr)) {
+		return -EINVAL;
+	}
+
+	if (gro_is_ipv4(pkt)) {
+		ipv4_hdr = (struct net_ipv4_hdr *)buf->data;
+
+		/* No options, no fragments and no link layer padding */
+		if (ipv4_hdr->vhl != 0x45 || ipv4_hdr->proto != IPPROTO_TCP ||
+		    (ipv4_hdr->offset[0] & 0x3f) || ipv4_hdr->offset[1] ||
+		    ntohs(ipv4_hdr->len) != pkt_len) {
+			return -EINVAL;
+		}
+
+		l3_len = sizeof(struct net_ipv4_hdr);
+		net_pkt_set_family(pkt, AF_INET);
+	} else if (gro_is_ipv6(pkt) &&
+		   buf->len >= sizeof(struct net_ipv6_hdr)) {
+		ipv6_hdr = (struct net_ipv6_hdr *)buf->data;
+
+		/* No extension headers */
+		if (ipv6_hdr->nexthdr != IPPROTO_TCP ||
+		    ntohs(ipv6_hdr->len) + sizeof(*ipv6_hdr) != pkt_len) {
+			return -EINVAL;
+		}
+
+		l3_len = sizeof(struct net_ipv6_hdr);
+		net_pkt_set_family(pkt, AF_INET6);
+	} else {
+		return -EINVAL;
+	}
+
+	if (buf->len < l3_len + sizeof(struct net_tcp_hdr)) {
+		return -EINVAL;
+	}
+
+	net_pkt_set_ip_hdr_len(pkt, l3_len);
+
+	seg->pkt = pkt;
+	seg->tcp_hdr = (struct net_tcp_hdr *)(buf->data + l3_len);
+	seg->hdr_len = l3_len + (seg->tcp_hdr->offset >> 4) * 4U;
+	seg->len = pkt_len;
+
+	if (seg->hdr_len < l3_len + sizeof(struct net_tcp_hdr) ||
+	    seg->hdr_len > buf->len || seg->hdr_len >= pkt_len) {
+		return 0;
+	}
+
+	seg->seg_len = pkt_len - seg->hdr_len;
+	seg->next_seq = sys_get_be32(seg->tcp_hdr->seq) + seg->seg_len;
+
+	/* Only plain data segments, anything else goes to TCP as is */
+	flags = NET_TCP_FLAGS(seg->tcp_hdr) & ~NET_TCP_PSH;
+
+	return flags == NET_TCP_ACK;
+}
+
+/* Both checksums are verified here, the merged packet only gets its IPv4
+ * header checksum updated for the new length.
+ */
+static bool gro_chksum_ok(struct net_pkt *pkt)
+{
+	if (!net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		return true;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET &&
+	    net_calc_chksum_ipv4(pkt) != 0U) {
+		return false;
+	}
+
+	return !IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) ||
+		net_calc_chksum_tcp(pkt) == 0U;
+}
+
+static bool gro_same_flow(struct net_gro_flow *flow, struct net_gro_flow *seg)
+{
+	u8_t *a = flow->pkt->buffer->data;
+	u8_t *b = seg->pkt->buffer->data;
+
+	if (net_pkt_family(flow->pkt) != net_pkt_family(seg->pkt)) {
+		return false;
+	}
+
+	if (net_pkt_family(seg->pkt) == AF_INET) {
+		if (memcmp(a + IPV4_ADDR_OFFSET, b + IPV4_ADDR_OFFSET,
+			   2 * sizeof(struct in_addr))) {
+			return false;
+		}
+	} else if (memcmp(a + IPV6_ADDR_OFFSET, b + IPV6_ADDR_OFFSET,
+			  2 * sizeof(struct in6_addr))) {
+		return false;
+	}
+
+	/* Source and destination port */
+	return !memcmp(flow->tcp_hdr, seg->tcp_hdr, 2 * sizeof(u16_t));
+}
+
+static int gro_find(struct net_gro *gro, struct net_gro_flow *seg)
+{
+	for (int i = 0; i < gro->count; i++) {
+		if (gro_same_flow(&gro->flows[i], seg)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* The segment continues the pending packet and only differs from it in
+ * the sequence number, PSH and the fields recomputed on merging.
+ */
+static bool gro_can_merge(struct net_gro_flow *flow, struct net_gro_flow *seg)
+{
+	u8_t *a = flow->pkt->buffer->data;
+	u8_t *b = seg->pkt->buffer->data;
+	struct net_tcp_hdr *th_a = flow->tcp_hdr;
+	struct net_tcp_hdr *th_b = seg->tcp_hdr;
+
+	if (seg->next_seq - seg->seg_len != flow->next_seq ||
+	    seg->seg_len > flow->seg_len || seg->hdr_len != flow->hdr_len ||
+	    flow->len + seg->seg_len > UINT16_MAX) {
+		return false;
+	}
+
+	if (net_pkt_family(seg->pkt) == AF_INET) {
+		/* Version, TOS, DF, TTL and protocol */
+		if (a[1] != b[1] || a[6] != b[6] || a[8] != b[8]) {
+			return false;
+		}
+	} else if (memcmp(a, b, 4) || a[7] != b[7]) {
+		/* Traffic class, flow label and hop limit */
+		return false;
+	}
+
+	return !memcmp(th_a->ack, th_b->ack, sizeof(th_a->ack)) &&
+		!memcmp(th_a->wnd, th_b->wnd, sizeof(th_a->wnd)) &&
+		!memcmp(th_a->optdata, th_b->optdata,
+			flow->hdr_len - net_pkt_ip_hdr_len(flow->pkt) -
+			sizeof(struct net_tcp_hdr));
+}
+
+/* Move the data of the segment to the end of the pending packet */
+static void gro_merge(struct net_gro_flow *flow, struct net_gro_flow *seg)
+{
+	struct net_pkt *pkt = seg->pkt;
+	struct net_buf *data = pkt->buffer;
+
+	flow->tcp_hdr->flags |= seg->tcp_hdr->flags & NET_TCP_PSH;
+
+	net_buf_pull(data, seg->hdr_len);
+	if (!data->len) {
+		data = net_buf_frag_del(NULL, data);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_append_buffer(flow->pkt, data);
+
+	flow->len += seg->seg_len;
+	flow->next_seq = seg->next_seq;
+	flow->segs++;
+
+	net_pkt_unref(pkt);
+}
+
+static void gro_flush_flow(struct net_gro *gro, int i)
+{
+	struct net_gro_flow *flow = &gro->flows[i];
+	struct net_pkt *pkt = flow->pkt;
+	bool is_loopback = flow->is_loopback;
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_ipv6_hdr *ipv6_hdr;
+
+	if (flow->segs > 1 && net_pkt_family(pkt) == AF_INET) {
+		ipv4_hdr = (struct net_ipv4_hdr *)pkt->buffer->data;
+		ipv4_hdr->chksum = net_calc_chksum_update(ipv4_hdr->chksum,
+							  ipv4_hdr->len,
+							  htons(flow->len));
+		ipv4_hdr->len = htons(flow->len);
+	} else if (flow->segs > 1) {
+		ipv6_hdr = (struct net_ipv6_hdr *)pkt->buffer->data;
+		ipv6_hdr->len = htons(flow->len - sizeof(*ipv6_hdr));
+	}
+
+	NET_DBG("pkt %p with %u segments, %u bytes", pkt, flow->segs,
+		flow->len);
+
+	gro->count--;
+	memmove(flow, flow + 1, (gro->count - i) * sizeof(*flow));
+
+	net_pkt_cursor_init(pkt);
+	gro->deliver(pkt, is_loopback);
+}
+
+void net_gro_init(struct net_gro *gro, net_gro_deliver_t deliver)
+{
+	gro->deliver = deliver;
+	gro->count = 0U;
+}
+
+enum net_verdict net_gro_receive(struct net_gro *gro, struct net_pkt *pkt,
+				 bool is_loopback)
+{
+	struct net_gro_flow seg, *flow;
+	bool push;
+	int ret, i;
+
+	ret = gro_parse(pkt, &seg);
+	if (ret < 0) {
+		return NET_CONTINUE;
+	}
+
+	i = gro_find(gro, &seg);
+
+	if (ret == 0 || !gro_chksum_ok(pkt)) {
+		/* Keep the order of the connection, TCP sees the pending
+		 * data first
+		 */
+		goto flush;
+	}
+
+	net_pkt_set_chksum_ok(pkt, true);
+	push = !!(seg.tcp_hdr->flags & NET_TCP_PSH);
+
+	if (i >= 0) {
+		flow = &gro->flows[i];
+
+		if (gro_can_merge(flow, &seg)) {
+			gro_merge(flow, &seg);
+
+			/* A short or pushed segment ends the packet */
+			if (seg.seg_len < flow->seg_len || push ||
+			    flow->segs == CONFIG_NET_GRO_MAX_SEGS) {
+				gro_flush_flow(gro, i);
+			}
+
+			return NET_OK;
+		}
+
+		gro_flush_flow(gro, i);
+		i = -ENOENT;
+	}
+
+	if (push) {
+		return NET_CONTINUE;
+	}
+
+	if (gro->count == CONFIG_NET_GRO_FLOWS) {
+		gro_flush_flow(gro, 0);
+	}
+
+	flow = &gro->flows[gro->count++];
+	*flow = seg;
+	flow->segs = 1U;
+	flow->is_loopback = is_loopback;
+
+	return NET_OK;
+flush:
+	if (i >= 0) {
+		gro_flush_flow(gro, i);
+	}
+
+	return NET_CONTINUE;
+}
+
+void net_gro_flush(struct net_gro *gro)
+{
+	while (gro->count > 0) {
+		gro_flush_flow(gro, 0);
+	}
+}
@@ -0,0 +1,114 @@
+/** @file
+ @brief Generic receive offload
+
+ This is not to be included by the application and is only used by
+ core IP stack.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GRO_H
+#define __NET_GRO_H
+
+#include <zephyr/types.h>
+
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Pass a packet on to IP, the function takes ownership of it */
+typedef void (*net_gro_deliver_t)(struct net_pkt *pkt, bool is_loopback);
+
+#if defined(CONFIG_NET_GRO)
+/** TCP connection with a packet pending in the current RX batch */
+struct net_gro_flow {
+	struct net_pkt *pkt;
+	struct net_tcp_hdr *tcp_hdr;
+	u32_t next_seq;
+	u16_t hdr_len;
+	u16_t seg_len;
+	u16_t len;
+	u8_t segs;
+	bool is_loopback;
+};
+
+/** Packets held back during one RX batch */
+struct net_gro {
+	struct net_gro_flow flows[CONFIG_NET_GRO_FLOWS];
+	net_gro_deliver_t deliver;
+	u8_t count;
+};
+#else
+struct net_gro {
+	net_gro_deliver_t deliver;
+};
+#endif /* CONFIG_NET_GRO */
+
+#if defined(CONFIG_NET_GRO)
+/**
+ * @brief Start merging the packets of an RX batch
+ *
+ * @param gro GRO context
+ * @param deliver Function passing the packets on to IP
+ */
+void net_gro_init(struct net_gro *gro, net_gro_deliver_t deliver);
+
+/**
+ * @brief Merge a received packet into a pending one of the same connection
+ *
+ * The packet, which must start with its IP header, is held back if it is
+ * an in order TCP data segment. Packets held back earlier are passed on
+ * whenever needed to keep the order of the connection.
+ *
+ * @param gro GRO context
+ * @param pkt Received packet
+ * @param is_loopback Was the packet received on a loopback interface
+ *
+ * @return NET_OK if the packet was held back, NET_CONTINUE if it is to be
+ * processed now.
+ */
+enum net_verdict net_gro_receive(struct net_gro *gro, struct net_pkt *pkt,
+				 bool is_loopback);
+
+/**
+ * @brief Pass on all the packets held back, at the end of an RX batch
+ *
+ * @param gro GRO context
+ */
+void net_gro_flush(struct net_gro *gro);
+#else
+static inline void net_gro_init(struct net_gro *gro,
+				net_gro_deliver_t deliver)
+{
+	gro->deliver = deliver;
+}
+
+static inline enum net_verdict net_gro_receive(struct net_gro *gro,
+					       struct net_pkt *pkt,
+					       bool is_loopback)
+{
+	ARG_UNUSED(gro);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(is_loopback);
+
+	return NET_CONTINUE;
+}
+
+static inline void net_gro_flush(struct net_gro *gro)
+{
+	ARG_UNUSED(gro);
+}
+#endif /* CONFIG_NET_GRO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GRO_H */
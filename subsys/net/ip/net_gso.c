@@ -0,0 +1,325 @@
+/** @file
+ * @brief Generic segmentation offload
+ *
+ * TCP hands a burst of full sized segments down the stack as one packet,
+ * which is cut into the segments only when it is sent by the L2.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_gso, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <sys/byteorder.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include <net/ethernet.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+#include "net_gso.h"
+
+/* Buffers pointing into the data of a packet, each holding a reference to
+ * the buffer it points into.
+ */
+static void gso_slice_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(gso_slices, CONFIG_NET_GSO_SLICE_COUNT, 0, 0,
+		    gso_slice_destroy);
+
+static struct net_buf *gso_slice_parent[CONFIG_NET_GSO_SLICE_COUNT];
+
+static void gso_slice_destroy(struct net_buf *buf)
+{
+	struct net_buf *parent = gso_slice_parent[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+	net_buf_unref(parent);
+}
+
+struct net_buf *net_gso_slice(struct net_buf *frags, size_t offset,
+			      size_t len)
+{
+	struct net_buf *head = NULL, *last = NULL, *slice;
+	size_t chunk;
+
+	for (; frags && len > 0; frags = frags->frags) {
+		if (offset >= frags->len) {
+			offset -= frags->len;
+			continue;
+		}
+
+		chunk = MIN(len, frags->len - offset);
+
+		slice = net_buf_alloc_with_data(&gso_slices,
+						frags->data + offset, chunk,
+						K_NO_WAIT);
+		if (!slice) {
+			goto fail;
+		}
+
+		gso_slice_parent[net_buf_id(slice)] = net_buf_ref(frags);
+
+		if (last) {
+			net_buf_frag_insert(last, slice);
+		} else {
+			head = slice;
+		}
+
+		last = slice;
+		offset = 0;
+		len -= chunk;
+	}
+
+	if (len > 0) {
+		goto fail;
+	}
+
+	return head;
+fail:
+	if (head) {
+		net_buf_unref(head);
+	}
+
+	return NULL;
+}
+
+static bool gso_offloaded(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return !!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO);
+	}
+#endif
+
+	return false;
+}
+
+/* Length of the IP and TCP headers in front of the data */
+static size_t gso_hdr_len(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t l3_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, l3_len)) {
+		return 0;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return 0;
+	}
+
+	return l3_len + (tcp_hdr->offset >> 4) * 4U;
+}
+
+static void gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+
+	/* The link addresses were set up for the whole burst by
+	 * net_if_send_data() and the neighbor lookup, the L2 header of
+	 * every segment is filled from them.
+	 */
+	memcpy(&seg->lladdr_src, &pkt->lladdr_src, sizeof(seg->lladdr_src));
+	memcpy(&seg->lladdr_dst, &pkt->lladdr_dst, sizeof(seg->lladdr_dst));
+
+	if (!net_pkt_lladdr_src(seg)->addr) {
+		net_pkt_lladdr_src(seg)->addr = net_pkt_lladdr_if(seg)->addr;
+		net_pkt_lladdr_src(seg)->len = net_pkt_lladdr_if(seg)->len;
+	}
+
+#if defined(CONFIG_NET_ARP)
+	if (pkt->lladdr_dst.addr == pkt->arp_lladdr) {
+		memcpy(seg->arp_lladdr, pkt->arp_lladdr,
+		       sizeof(seg->arp_lladdr));
+		seg->lladdr_dst.addr = seg->arp_lladdr;
+	}
+#endif
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Adjust the copied headers to the segment at offset and recompute the
+ * lengths and checksums. Only the last segment keeps PSH and FIN.
+ */
+static int gso_finalize(struct net_pkt *seg, size_t offset, bool last)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+					      struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							seg, &ipv4_access);
+		if (!ipv4_hdr) {
+			return -ENOBUFS;
+		}
+
+		/* net_ipv4_finalize() sums up the header as it is */
+		ipv4_hdr->chksum = 0U;
+	}
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) +
+			 net_pkt_ip_opts_len(seg))) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	if (!last) {
+		tcp_hdr->flags &= ~(NET_TCP_PSH | NET_TCP_FIN);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		return net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
+
+/* Build the segment carrying len bytes of data at offset. The data is
+ * referred to where it is, or copied if there are no slices left.
+ */
+static struct net_pkt *gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				   size_t offset, size_t len, bool last)
+{
+	struct net_buf *data;
+	struct net_pkt *seg;
+
+	data = net_gso_slice(pkt->buffer, hdr_len + offset, len);
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					data ? hdr_len : hdr_len + len,
+					AF_UNSPEC, 0, K_NO_WAIT);
+	if (!seg) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len)) {
+		goto fail;
+	}
+
+	if (data) {
+		net_pkt_append_buffer(seg, data);
+		data = NULL;
+	} else if (net_pkt_skip(pkt, offset) || net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	gso_copy_attributes(seg, pkt);
+
+	if (gso_finalize(seg, offset, last) < 0) {
+		goto fail;
+	}
+
+	return seg;
+fail:
+	if (data) {
+		net_buf_unref(data);
+	}
+
+	if (seg) {
+		net_pkt_unref(seg);
+	}
+
+	return NULL;
+}
+
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	const struct net_l2 *l2 = net_if_l2(iface);
+	size_t hdr_len, data_len, offset, len;
+	int ret = -EINVAL, sent = 0, count = 0;
+	struct net_pkt *seg;
+
+	if (gso_offloaded(iface)) {
+		return l2->send(iface, pkt);
+	}
+
+	hdr_len = gso_hdr_len(pkt);
+	if (!hdr_len || net_pkt_get_len(pkt) < hdr_len) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	/* The segments go to the L2 back to back, a segment lost here is
+	 * left to the TCP retransmission.
+	 */
+	for (offset = 0; offset < data_len; offset += len) {
+		len = MIN(data_len - offset, net_pkt_gso_size(pkt));
+
+		seg = gso_segment(pkt, hdr_len, offset, len,
+				  offset + len == data_len);
+		if (!seg) {
+			ret = -ENOBUFS;
+			break;
+		}
+
+		ret = l2->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		sent += ret;
+		count++;
+	}
+
+	NET_DBG("pkt %p sent in %d segments", pkt, count);
+
+	if (count == 0) {
+		return ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
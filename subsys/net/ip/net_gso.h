@@ -0,0 +1,74 @@
+/** @file
+ @brief Generic segmentation offload
+
+ This is not to be included by the application and is only used by
+ core IP stack.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GSO_H
+#define __NET_GSO_H
+
+#include <zephyr/types.h>
+
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/buf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_GSO)
+/**
+ * @brief Refer to part of the data of a buffer chain
+ *
+ * The returned buffers point into the data of the chain and keep a
+ * reference to the buffers they point into, so the chain can be sent
+ * in pieces without copying it.
+ *
+ * @param frags Buffer chain
+ * @param offset Offset of the data in the chain
+ * @param len Length of the data
+ *
+ * @return Buffer chain holding the data, NULL if out of buffers.
+ */
+struct net_buf *net_gso_slice(struct net_buf *frags, size_t offset,
+			      size_t len);
+
+/**
+ * @brief Send a TCP packet larger than the MTU
+ *
+ * The packet is cut into segments of net_pkt_gso_size() bytes, which are
+ * handed to the L2 one after the other, unless the device segments it
+ * itself. Like the L2 send function, the packet is consumed on success.
+ *
+ * @param iface Network interface
+ * @param pkt TCP packet, with headers for its first segment
+ *
+ * @return Number of bytes sent, negative errno if nothing was sent.
+ */
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline struct net_buf *net_gso_slice(struct net_buf *frags,
+					    size_t offset, size_t len)
+{
+	return NULL;
+}
+
+static inline int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_GSO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GSO_H */
@@ -21,9 +21,11 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 
 #include "net_private.h"
 #include "ipv6.h"
+#include "ipv4.h"
 #include "ipv4_autoconf_internal.h"
 
 #include "net_stats.h"
+#include "net_gso.h"
 
 #define REACHABLE_TIME (MSEC_PER_SEC * 30) /* in ms */
 /*
@@ -204,7 +206,11 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			pkt_priority = net_pkt_priority(pkt);
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (IS_ENABLED(CONFIG_NET_GSO) && net_pkt_gso_size(pkt)) {
+			status = net_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_CONTEXT_TIMESTAMP) && status >= 0 &&
 		    context) {
@@ -383,6 +389,10 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 		verdict = net_ipv6_prepare_for_send(pkt);
 	}
 
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		verdict = net_ipv4_prepare_for_send(pkt);
+	}
+
 done:
 	/*   NET_OK in which case packet has checked successfully. In this case
 	 *   the net_context callback is called after successful delivery in
@@ -1663,6 +1663,65 @@ int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
 }
 
+#if defined(CONFIG_NET_UDP)
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length)
+{
+	struct net_pkt_cursor *c_op = &pkt->cursor;
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	const u8_t *src = data;
+	u16_t sum;
+
+	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
+
+	while (c_op->buf && length) {
+		size_t d_len, len;
+
+		pkt_cursor_advance(pkt, !overwrite);
+		if (c_op->buf == NULL) {
+			break;
+		}
+
+		if (overwrite) {
+			d_len = c_op->buf->len - (c_op->pos - c_op->buf->data);
+		} else {
+			d_len = c_op->buf->size - (c_op->pos - c_op->buf->data);
+		}
+
+		if (!d_len) {
+			break;
+		}
+
+		len = MIN(length, d_len);
+
+		/* The sum of a piece at an odd offset has its bytes swapped */
+		sum = net_calc_chksum_copy(0U, c_op->pos, src, len);
+		if (pkt->data_chksum_len & 1U) {
+			sum = (sum << 8) | (sum >> 8);
+		}
+
+		sum += pkt->data_chksum;
+		pkt->data_chksum = sum < pkt->data_chksum ? sum + 1U : sum;
+		pkt->data_chksum_len += len;
+
+		if (!overwrite) {
+			net_buf_add(c_op->buf, len);
+		}
+
+		pkt_cursor_update(pkt, len, true);
+
+		src += len;
+		length -= len;
+	}
+
+	if (length) {
+		NET_DBG("Still some length to go %zu", length);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_UDP */
+
 int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
 		 size_t length)
@@ -1775,6 +1834,14 @@ struct net_pkt *net_pkt_clone(struct net_pkt *pkt, k_timeout_t timeout)
 		       sizeof(clone_pkt->lladdr_src));
 		memcpy(&clone_pkt->lladdr_dst, &pkt->lladdr_dst,
 		       sizeof(clone_pkt->lladdr_dst));
+
+#if defined(CONFIG_NET_ARP)
+		if (pkt->lladdr_dst.addr == pkt->arp_lladdr) {
+			memcpy(clone_pkt->arp_lladdr, pkt->arp_lladdr,
+			       sizeof(clone_pkt->arp_lladdr));
+			clone_pkt->lladdr_dst.addr = clone_pkt->arp_lladdr;
+		}
+#endif
 	}
 
 	clone_pkt_attributes(pkt, clone_pkt);
@@ -1821,6 +1888,14 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 		       sizeof(clone_pkt->lladdr_src));
 		memcpy(&clone_pkt->lladdr_dst, &pkt->lladdr_dst,
 		       sizeof(clone_pkt->lladdr_dst));
+
+#if defined(CONFIG_NET_ARP)
+		if (pkt->lladdr_dst.addr == pkt->arp_lladdr) {
+			memcpy(clone_pkt->arp_lladdr, pkt->arp_lladdr,
+			       sizeof(clone_pkt->arp_lladdr));
+			clone_pkt->lladdr_dst.addr = clone_pkt->arp_lladdr;
+		}
+#endif
 	}
 
 	clone_pkt_attributes(pkt, clone_pkt);
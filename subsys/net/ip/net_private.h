@@ -78,6 +78,9 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt);
+#if defined(CONFIG_NET_RX_BATCH)
+extern void net_rx_batch(sys_slist_t *pkts);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -149,6 +152,37 @@ extern char *net_sprint_ll_addr_buf(const u8_t *ll, u8_t ll_len,
 				    char *buf, int buflen);
 extern u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto);
 
+/**
+ * @brief Copy data and add it to a one's complement sum on the way
+ *
+ * @param sum Sum so far, in host byte order
+ * @param dst Where to copy the data
+ * @param src Data, which starts a 16 bit word
+ * @param len Length of the data
+ *
+ * @return The new sum
+ */
+extern u16_t net_calc_chksum_copy(u16_t sum, void *dst, const void *src,
+				  size_t len);
+
+/**
+ * @brief Update a checksum for a 16 bit word of the data it covers
+ * changing from old_val to new_val (RFC 1624), without summing up the
+ * data again. The values are taken as they are in the packet.
+ *
+ * @return The new checksum. A UDP checksum of zero must be sent as 0xffff.
+ */
+static inline u16_t net_calc_chksum_update(u16_t chksum, u16_t old_val,
+					   u16_t new_val)
+{
+	u32_t sum = (u16_t)~chksum + (u32_t)(u16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (u16_t)~sum;
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
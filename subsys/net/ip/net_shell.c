@@ -37,6 +37,10 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 
 #include "ipv6.h"
 
+#if defined(CONFIG_NET_IP_REASSEMBLY)
+#include "reassembly.h"
+#endif
+
 #if defined(CONFIG_NET_ARP)
 #include "ethernet/arp.h"
 #endif
@@ -237,6 +241,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_RX_CHKSUM_OFFLOAD, "RX checksum offload"),
 	EC(ETHERNET_HW_VLAN,              "Virtual LAN"),
 	EC(ETHERNET_HW_VLAN_TAG_STRIP,    "VLAN Tag stripping"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
 	EC(ETHERNET_AUTO_NEGOTIATION_SET, "Auto negotiation"),
 	EC(ETHERNET_LINK_10BASE_T,        "10 Mbits"),
 	EC(ETHERNET_LINK_100BASE_T,       "100 Mbits"),
@@ -654,6 +659,38 @@ static void iface_per_mcast_route_cb(struct net_if *iface, void *user_data)
 }
 #endif /* CONFIG_NET_ROUTE_MCAST */
 
+#if defined(CONFIG_NET_ROUTE_IPV4)
+static void route_ipv4_cb(struct net_route_entry_ipv4 *entry, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	struct net_if *iface = data->user_data;
+
+	if (entry->iface != iface) {
+		return;
+	}
+
+	PR("IPv4 prefix : %s/%d\n", net_sprint_ipv4_addr(&entry->addr),
+	   entry->prefix_len);
+	PR("\tgateway : %s\n", net_sprint_ipv4_addr(&entry->gw));
+}
+
+static void iface_per_ipv4_route_cb(struct net_if *iface, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	const char *extra;
+
+	PR("\nIPv4 routes for interface %p (%s)\n", iface,
+	   iface2str(iface, &extra));
+	PR("=======================================%s\n", extra);
+
+	data->user_data = iface;
+
+	net_route_ipv4_foreach(route_ipv4_cb, data);
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
 #if defined(CONFIG_NET_STATISTICS)
 
 #if NET_TC_COUNT > 1
@@ -1220,50 +1257,50 @@ static void tcp_sent_list_cb(struct net_tcp *tcp, void *user_data)
 #endif /* CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG */
 #endif
 
-#if defined(CONFIG_NET_IPV6_FRAGMENT)
-static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
-			 void *user_data)
+#if defined(CONFIG_NET_IP_REASSEMBLY)
+static void reass_cb(struct net_reass *reass, void *user_data)
 {
 	struct net_shell_user_data *data = user_data;
 	const struct shell *shell = data->shell;
 	int *count = data->user_data;
+	u8_t family = reass->key.family;
 	char src[ADDR_LEN];
-	int i;
+	struct net_pkt *pkt;
+	int i = 0;
 
 	if (!*count) {
-		PR("\nIPv6 reassembly Id         Remain "
-		   "Src             \tDst\n");
+		PR("\n%s reassembly Id         Remain "
+		   "Src             \tDst\n",
+		   family == AF_INET6 ? "IPv6" : "IPv4");
 	}
 
-	snprintk(src, ADDR_LEN, "%s", net_sprint_ipv6_addr(&reass->src));
+	snprintk(src, ADDR_LEN, "%s", net_sprint_addr(family, &reass->key.src));
 
 	PR("%p      0x%08x  %5d %16s\t%16s\n",
-	   reass, reass->id,
+	   reass, reass->key.id,
 	   k_delayed_work_remaining_get(&reass->timer),
-	   src, net_sprint_ipv6_addr(&reass->dst));
+	   src, net_sprint_addr(family, &reass->key.dst));
 
-	for (i = 0; i < NET_IPV6_FRAGMENTS_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			struct net_buf *frag = reass->pkt[i]->frags;
+	NET_REASS_FOR_EACH_FRAG(reass, pkt) {
+		struct net_buf *frag = pkt->frags;
 
-			PR("[%d] pkt %p->", i, reass->pkt[i]);
+		PR("[%d] pkt %p->", i++, pkt);
 
-			while (frag) {
-				PR("%p", frag);
+		while (frag) {
+			PR("%p", frag);
 
-				frag = frag->frags;
-				if (frag) {
-					PR("->");
-				}
+			frag = frag->frags;
+			if (frag) {
+				PR("->");
 			}
-
-			PR("\n");
 		}
+
+		PR("\n");
 	}
 
 	(*count)++;
 }
-#endif /* CONFIG_NET_IPV6_FRAGMENT */
+#endif /* CONFIG_NET_IP_REASSEMBLY */
 
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 static void allocs_cb(struct net_pkt *pkt,
@@ -1481,10 +1518,14 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 
 #endif
 
-#if defined(CONFIG_NET_IPV6_FRAGMENT)
+#if defined(CONFIG_NET_IP_REASSEMBLY)
 	count = 0;
 
-	net_ipv6_frag_foreach(ipv6_frag_cb, &user_data);
+	net_reass_foreach(AF_INET, reass_cb, &user_data);
+
+	count = 0;
+
+	net_reass_foreach(AF_INET6, reass_cb, &user_data);
 
 	/* Do not print anything if no fragments are pending atm */
 #endif
@@ -1640,6 +1681,68 @@ static int cmd_net_dns_cancel(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void dns_cache_cb(const char *query, enum dns_query_type type,
+			 const struct dns_addrinfo *info, int count,
+			 u32_t ttl, void *user_data)
+{
+	const struct shell *shell = user_data;
+	int i;
+
+	PR("%s %s ttl %u s\n", query,
+	   type == DNS_QUERY_TYPE_AAAA ? "AAAA" : "A", ttl);
+
+	if (count == 0) {
+		PR("\t<no such name>\n");
+		return;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (info[i].ai_family == AF_INET) {
+			PR("\t%s\n", net_sprint_ipv4_addr(
+				   &net_sin(&info[i].ai_addr)->sin_addr));
+		} else if (info[i].ai_family == AF_INET6) {
+			PR("\t%s\n", net_sprint_ipv6_addr(
+				   &net_sin6(&info[i].ai_addr)->sin6_addr));
+		}
+	}
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+static int cmd_net_dns_cache(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	PR("Cached names:\n");
+	dns_resolve_cache_foreach(dns_cache_cb, (void *)shell);
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_dns_flush(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	dns_resolve_cache_flush();
+	PR("DNS cache flushed.\n");
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_query(const struct shell *shell, size_t argc,
 			     char *argv[])
 {
@@ -3308,11 +3411,13 @@ static int cmd_net_route(const struct shell *shell, size_t argc, char *argv[])
 	ARG_UNUSED(argv);
 
 #if defined(CONFIG_NET_NATIVE)
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_ROUTE_IPV4)
 	struct net_shell_user_data user_data;
 #endif
 
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_ROUTE_IPV4)
 	user_data.shell = shell;
 #endif
 
@@ -3326,6 +3431,10 @@ static int cmd_net_route(const struct shell *shell, size_t argc, char *argv[])
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	net_if_foreach(iface_per_mcast_route_cb, &user_data);
 #endif
+
+#if defined(CONFIG_NET_ROUTE_IPV4)
+	net_if_foreach(iface_per_ipv4_route_cb, &user_data);
+#endif
 #endif
 	return 0;
 }
@@ -4111,8 +4220,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_arp,
 );
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, NULL, "Show the names kept in the DNS cache.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
+	SHELL_CMD(flush, NULL, "Remove all names from the DNS cache.",
+		  cmd_net_dns_flush),
 	SHELL_CMD(query, NULL,
 		  "'net dns <hostname> [A or AAAA]' queries IPv4 address "
 		  "(default) or IPv6 address for a host name.",
@@ -29,6 +29,31 @@ K_THREAD_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
 
+#if defined(CONFIG_NET_RX_BATCH)
+/* Packets queued to a traffic class since its RX thread last ran */
+struct rx_batch {
+	struct k_work work;
+	struct k_spinlock lock;
+	sys_slist_t pkts;
+};
+
+static struct rx_batch rx_batches[NET_TC_RX_COUNT];
+
+static void rx_batch_process(struct k_work *work)
+{
+	struct rx_batch *batch = CONTAINER_OF(work, struct rx_batch, work);
+	k_spinlock_key_t key;
+	sys_slist_t pkts;
+
+	key = k_spin_lock(&batch->lock);
+	pkts = batch->pkts;
+	sys_slist_init(&batch->pkts);
+	k_spin_unlock(&batch->lock, key);
+
+	net_rx_batch(&pkts);
+}
+#endif
+
 bool net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt)
 {
 	if (k_work_pending(net_pkt_work(pkt))) {
@@ -42,7 +67,19 @@ bool net_tc_submit_to_tx_queue(u8_t tc, struct net_pkt *pkt)
 
 void net_tc_submit_to_rx_queue(u8_t tc, struct net_pkt *pkt)
 {
+#if defined(CONFIG_NET_RX_BATCH)
+	struct rx_batch *batch = &rx_batches[tc];
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&batch->lock);
+	sys_slist_append(&batch->pkts, &pkt->next);
+	k_spin_unlock(&batch->lock, key);
+
+	/* Does nothing if the batch is already waiting for the thread */
+	k_work_submit_to_queue(&rx_classes[tc].work_q, &batch->work);
+#else
 	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+#endif
 }
 
 int net_tx_priority2tc(enum net_priority prio)
@@ -262,6 +299,11 @@ void net_tc_rx_init(void)
 		thread_priority = rx_tc2thread(i);
 		rx_classes[i].tc = thread_priority;
 
+#if defined(CONFIG_NET_RX_BATCH)
+		k_work_init(&rx_batches[i].work, rx_batch_process);
+		sys_slist_init(&rx_batches[i].pkts);
+#endif
+
 		NET_DBG("[%d] Starting RX queue %p stack size %zd "
 			"prio %d (%d)", i,
 			&rx_classes[i].work_q.queue,
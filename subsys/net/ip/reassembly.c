@@ -0,0 +1,409 @@
+/** @file
+ * @brief IP fragment reassembly
+ *
+ * Common reassembly of IPv4 and IPv6 fragments. The packets being
+ * reassembled are found by hashing their key, and each keeps its
+ * fragments in a list ordered by offset, so a fragment is inserted
+ * without moving the others. The memory a source can tie up is bounded
+ * by the number of its packets at a time, their size and the number of
+ * fragments in each.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_reass, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <errno.h>
+#include <string.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+
+#include "net_private.h"
+#include "reassembly.h"
+
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+#define REASS_IPV4_COUNT CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT
+#else
+#define REASS_IPV4_COUNT 0
+#endif
+
+#if defined(CONFIG_NET_IPV6_FRAGMENT)
+#define REASS_IPV6_COUNT CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT
+#else
+#define REASS_IPV6_COUNT 0
+#endif
+
+#define REASS_COUNT (REASS_IPV4_COUNT + REASS_IPV6_COUNT)
+
+/* Power of two */
+#define REASS_BUCKETS 8
+
+static struct net_reass reass_slots[REASS_COUNT];
+static sys_slist_t reass_buckets[REASS_BUCKETS];
+static sys_slist_t reass_free;
+static int reass_used[2];
+static bool reass_init_done;
+
+K_MUTEX_DEFINE(reass_lock);
+
+static void reass_timeout(struct k_work *work);
+
+static void reass_init(void)
+{
+	int i;
+
+	for (i = 0; i < REASS_COUNT; i++) {
+		k_delayed_work_init(&reass_slots[i].timer, reass_timeout);
+		sys_slist_append(&reass_free, &reass_slots[i].node);
+	}
+
+	reass_init_done = true;
+}
+
+static inline int family_idx(u8_t family)
+{
+	return family == AF_INET6;
+}
+
+static inline int family_max(u8_t family)
+{
+	return family == AF_INET6 ? REASS_IPV6_COUNT : REASS_IPV4_COUNT;
+}
+
+static u32_t key_hash(const struct net_reass_key *key)
+{
+	u32_t hash = key->id ^ key->proto ^ key->family;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(key->src.s6_addr32); i++) {
+		hash ^= key->src.s6_addr32[i] ^ key->dst.s6_addr32[i];
+	}
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash & (REASS_BUCKETS - 1);
+}
+
+static bool key_cmp(const struct net_reass_key *a,
+		    const struct net_reass_key *b)
+{
+	return a->id == b->id && a->proto == b->proto &&
+		a->family == b->family &&
+		net_ipv6_addr_cmp(&a->src, &b->src) &&
+		net_ipv6_addr_cmp(&a->dst, &b->dst);
+}
+
+/* Where the fragment data starts in the packet */
+static u16_t frag_start(struct net_pkt *pkt)
+{
+	if (net_pkt_family(pkt) == AF_INET6) {
+		return net_pkt_ipv6_fragment_start(pkt) +
+			sizeof(struct net_ipv6_frag_hdr);
+	}
+
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+}
+
+static u16_t frag_offset(struct net_pkt *pkt)
+{
+	if (net_pkt_family(pkt) == AF_INET6) {
+		return net_pkt_ipv6_fragment_offset(pkt);
+	}
+
+	return net_pkt_ipv4_fragment_offset(pkt);
+}
+
+static u16_t frag_end(struct net_pkt *pkt)
+{
+	return frag_offset(pkt) + net_pkt_get_len(pkt) - frag_start(pkt);
+}
+
+static struct net_reass *reass_find(const struct net_reass_key *key,
+				    sys_slist_t *bucket)
+{
+	struct net_reass *reass;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, reass, node) {
+		if (key_cmp(&reass->key, key)) {
+			return reass;
+		}
+	}
+
+	return NULL;
+}
+
+static int src_count(const struct net_reass_key *key)
+{
+	int i, count = 0;
+
+	for (i = 0; i < REASS_COUNT; i++) {
+		if (reass_slots[i].key.family == key->family &&
+		    net_ipv6_addr_cmp(&reass_slots[i].key.src, &key->src)) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static struct net_reass *reass_new(const struct net_reass_key *key,
+				   sys_slist_t *bucket, k_timeout_t timeout)
+{
+	struct net_reass *reass;
+	sys_snode_t *node;
+
+	if (reass_used[family_idx(key->family)] >= family_max(key->family)) {
+		NET_DBG("No free reassembly slot");
+		return NULL;
+	}
+
+	if (src_count(key) >= CONFIG_NET_IP_REASSEMBLY_MAX_PER_SRC) {
+		NET_DBG("Too many packets from one source");
+		return NULL;
+	}
+
+	node = sys_slist_get(&reass_free);
+	if (!node) {
+		return NULL;
+	}
+
+	reass = CONTAINER_OF(node, struct net_reass, node);
+	reass->key = *key;
+	reass->last = NULL;
+	reass->received = 0U;
+	reass->len = 0U;
+	reass->count = 0U;
+	sys_slist_init(&reass->frags);
+
+	sys_slist_prepend(bucket, &reass->node);
+	reass_used[family_idx(key->family)]++;
+
+	k_delayed_work_submit(&reass->timer, timeout);
+
+	return reass;
+}
+
+/* Give the slot back, the fragments are released by the caller */
+static void reass_release(struct net_reass *reass)
+{
+	k_delayed_work_cancel(&reass->timer);
+
+	sys_slist_find_and_remove(&reass_buckets[key_hash(&reass->key)],
+				  &reass->node);
+	sys_slist_append(&reass_free, &reass->node);
+
+	reass_used[family_idx(reass->key.family)]--;
+	reass->key.family = AF_UNSPEC;
+}
+
+static void reass_cancel(struct net_reass *reass)
+{
+	sys_snode_t *node;
+
+	NET_DBG("Cancel id 0x%x", reass->key.id);
+
+	while ((node = sys_slist_get(&reass->frags)) != NULL) {
+		net_pkt_unref(CONTAINER_OF(node, struct net_pkt, next));
+	}
+
+	reass_release(reass);
+}
+
+static void reass_timeout(struct k_work *work)
+{
+	struct net_reass *reass = CONTAINER_OF(work, struct net_reass, timer);
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	/* The slot might have been released, or taken again, meanwhile */
+	if (reass->key.family != AF_UNSPEC &&
+	    !k_delayed_work_remaining_get(&reass->timer)) {
+		NET_DBG("Reassembly id 0x%x timed out", reass->key.id);
+		reass_cancel(reass);
+	}
+
+	k_mutex_unlock(&reass_lock);
+}
+
+/* Append the data of the other fragments to the first one */
+static struct net_pkt *reass_join(struct net_reass *reass)
+{
+	struct net_pkt *head, *pkt;
+	sys_snode_t *node;
+
+	node = sys_slist_get(&reass->frags);
+	head = CONTAINER_OF(node, struct net_pkt, next);
+
+	while ((node = sys_slist_get(&reass->frags)) != NULL) {
+		pkt = CONTAINER_OF(node, struct net_pkt, next);
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_pull(pkt, frag_start(pkt))) {
+			NET_ERR("Failed to pull headers");
+			net_pkt_unref(pkt);
+			net_pkt_unref(head);
+			head = NULL;
+			continue;
+		}
+
+		if (head) {
+			net_pkt_append_buffer(head, pkt->buffer);
+			pkt->buffer = NULL;
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	reass_release(reass);
+
+	if (head) {
+		net_pkt_set_l2_processed(head, true);
+		net_pkt_cursor_init(head);
+	}
+
+	return head;
+}
+
+/* Put the fragment in offset order, returns 1 if it is a copy of one that
+ * is there already, and -EINVAL if it overlaps another one.
+ */
+static int reass_insert(struct net_reass *reass, struct net_pkt *pkt)
+{
+	u16_t offset = frag_offset(pkt);
+	u16_t end = frag_end(pkt);
+	struct net_pkt *prev = NULL, *frag;
+
+	/* Fragments come mostly in order */
+	if (!reass->last || offset >= frag_end(reass->last)) {
+		sys_slist_append(&reass->frags, &pkt->next);
+		reass->last = pkt;
+		return 0;
+	}
+
+	NET_REASS_FOR_EACH_FRAG(reass, frag) {
+		if (offset == frag_offset(frag) && end == frag_end(frag)) {
+			return 1;
+		}
+
+		if (end <= frag_offset(frag)) {
+			break;
+		}
+
+		if (offset < frag_end(frag)) {
+			return -EINVAL;
+		}
+
+		prev = frag;
+	}
+
+	sys_slist_insert(&reass->frags, prev ? &prev->next : NULL,
+			 &pkt->next);
+
+	return 0;
+}
+
+enum net_verdict net_reass_add(const struct net_reass_key *key,
+			       struct net_pkt *pkt, bool more,
+			       k_timeout_t timeout, net_reass_done_t done)
+{
+	sys_slist_t *bucket = &reass_buckets[key_hash(key)];
+	u16_t end = frag_end(pkt);
+	struct net_reass *reass;
+	int ret;
+
+	if (frag_start(pkt) >= net_pkt_get_len(pkt) && more) {
+		return NET_DROP;
+	}
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	if (!reass_init_done) {
+		reass_init();
+	}
+
+	reass = reass_find(key, bucket);
+	if (!reass) {
+		reass = reass_new(key, bucket, timeout);
+		if (!reass) {
+			k_mutex_unlock(&reass_lock);
+			return NET_DROP;
+		}
+	}
+
+	if (end > CONFIG_NET_IP_REASSEMBLY_MAX_SIZE ||
+	    reass->count == CONFIG_NET_IP_REASSEMBLY_MAX_FRAGS ||
+	    (reass->len && end > reass->len) ||
+	    (!more && reass->len && end != reass->len) ||
+	    (!more && reass->last && frag_end(reass->last) > end)) {
+		NET_DBG("Fragment %u..%u does not fit id 0x%x",
+			frag_offset(pkt), end, key->id);
+		goto cancel;
+	}
+
+	ret = reass_insert(reass, pkt);
+	if (ret < 0) {
+		NET_DBG("Overlapping fragment %u..%u id 0x%x",
+			frag_offset(pkt), end, key->id);
+		goto cancel;
+	}
+
+	if (ret > 0) {
+		/* Copy of a fragment we have already */
+		k_mutex_unlock(&reass_lock);
+		net_pkt_unref(pkt);
+		return NET_OK;
+	}
+
+	reass->count++;
+	reass->received += end - frag_offset(pkt);
+
+	if (!more) {
+		reass->len = end;
+	}
+
+	NET_DBG("Fragment %u..%u id 0x%x, %u of %u bytes",
+		frag_offset(pkt), end, key->id, reass->received, reass->len);
+
+	if (reass->len && reass->received == reass->len) {
+		pkt = reass_join(reass);
+		k_mutex_unlock(&reass_lock);
+
+		if (pkt) {
+			done(pkt);
+		}
+
+		return NET_OK;
+	}
+
+	k_mutex_unlock(&reass_lock);
+
+	return NET_OK;
+
+cancel:
+	reass_cancel(reass);
+	k_mutex_unlock(&reass_lock);
+
+	return NET_DROP;
+}
+
+void net_reass_foreach(u8_t family, net_reass_cb_t cb, void *user_data)
+{
+	int i;
+
+	k_mutex_lock(&reass_lock, K_FOREVER);
+
+	for (i = 0; i < REASS_COUNT; i++) {
+		if (reass_slots[i].key.family == family) {
+			cb(&reass_slots[i], user_data);
+		}
+	}
+
+	k_mutex_unlock(&reass_lock);
+}
@@ -0,0 +1,118 @@
+/** @file
+ @brief IP fragment reassembly
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __REASSEMBLY_H
+#define __REASSEMBLY_H
+
+#include <kernel.h>
+#include <sys/slist.h>
+
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Identifies the fragments of one packet */
+struct net_reass_key {
+	/** Source address, an IPv4 address is in the first 4 bytes */
+	struct in6_addr src;
+
+	/** Destination address, an IPv4 address is in the first 4 bytes */
+	struct in6_addr dst;
+
+	/** Fragment identification */
+	u32_t id;
+
+	/** IPv4 protocol, 0 for IPv6 */
+	u8_t proto;
+
+	/** AF_INET or AF_INET6 */
+	u8_t family;
+};
+
+/** Packet being reassembled from its fragments */
+struct net_reass {
+	/** Hash bucket of the key while in use, free list otherwise */
+	sys_snode_t node;
+
+	/** Fragments received so far, ordered by their offset */
+	sys_slist_t frags;
+
+	/** Fragment with the highest offset */
+	struct net_pkt *last;
+
+	/** Timeout for cancelling the reassembly */
+	struct k_delayed_work timer;
+
+	struct net_reass_key key;
+
+	/** Data bytes received */
+	u16_t received;
+
+	/** Data length of the packet, 0 until the last fragment is in */
+	u16_t len;
+
+	/** Number of fragments held */
+	u8_t count;
+};
+
+/**
+ * @brief Called with the reassembled packet. It holds the headers of the
+ * first fragment followed by the data of all the fragments.
+ */
+typedef void (*net_reass_done_t)(struct net_pkt *pkt);
+
+typedef void (*net_reass_cb_t)(struct net_reass *reass, void *user_data);
+
+/**
+ * @brief Add a received fragment to the packet it belongs to
+ *
+ * The offset of the fragment data is read with
+ * net_pkt_ipv4_fragment_offset() or net_pkt_ipv6_fragment_offset(). The
+ * data starts after the IPv4 header and its options, or after the IPv6
+ * fragment header.
+ *
+ * @param key Packet the fragment belongs to
+ * @param pkt Fragment
+ * @param more Are there fragments after this one
+ * @param timeout How long to wait for the rest of the fragments
+ * @param done Called once the packet is complete
+ *
+ * @return NET_OK if the fragment was taken, NET_DROP if the caller is to
+ * drop it.
+ */
+enum net_verdict net_reass_add(const struct net_reass_key *key,
+			       struct net_pkt *pkt, bool more,
+			       k_timeout_t timeout, net_reass_done_t done);
+
+/**
+ * @brief Go through the packets being reassembled
+ *
+ * @param family AF_INET or AF_INET6
+ * @param cb Callback to call for each of them
+ * @param user_data User specified data or NULL
+ */
+void net_reass_foreach(u8_t family, net_reass_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the fragments of a packet being reassembled in order
+ */
+#define NET_REASS_FOR_EACH_FRAG(reass, pkt)				\
+	SYS_SLIST_FOR_EACH_CONTAINER(&(reass)->frags, pkt, next)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __REASSEMBLY_H */
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "ipv6.h"
 #include "icmpv6.h"
 #include "nbr.h"
+#include "lpm.h"
 #include "route.h"
 
 #if !defined(NET_ROUTE_EXTRA_DATA_SIZE)
@@ -36,7 +37,73 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
+
+/* The routes are looked up by prefix in a trie, a route takes at most two
+ * nodes of it.
+ */
+static struct net_lpm route_lpm;
+static struct net_lpm_node route_lpm_nodes[2 * CONFIG_NET_MAX_ROUTES];
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Recently looked up destinations and the route found for them. The cache
+ * is flushed whenever the routing table changes.
+ */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+
+static struct route_cache_entry *route_cache_slot(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	u32_t hash = POINTER_TO_UINT(iface);
+
+	hash ^= UNALIGNED_GET(&dst->s6_addr32[0]) ^
+		UNALIGNED_GET(&dst->s6_addr32[1]) ^
+		UNALIGNED_GET(&dst->s6_addr32[2]) ^
+		UNALIGNED_GET(&dst->s6_addr32[3]);
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct in6_addr *dst)
+{
+	struct route_cache_entry *slot = route_cache_slot(iface, dst);
+
+	if (slot->route && slot->iface == iface &&
+	    net_ipv6_addr_cmp(&slot->dst, dst)) {
+		return slot->route;
+	}
+
+	return NULL;
+}
+
+static void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *slot = route_cache_slot(iface, dst);
+
+	net_ipaddr_copy(&slot->dst, dst);
+	slot->iface = iface;
+	slot->route = route;
+}
+
+static void route_cache_flush(void)
+{
+	(void)memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_get(...) NULL
+#define route_cache_put(...)
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
 
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
@@ -253,36 +320,51 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static bool route_iface_match(struct net_lpm_entry *entry, void *user_data)
 {
-	struct net_route_entry *route, *found = NULL;
-	u8_t longest_match = 0U;
-	int i;
+	struct net_route_entry *route = CONTAINER_OF(entry,
+						     struct net_route_entry,
+						     lpm);
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	return !user_data || route->iface == user_data;
+}
 
-		if (!nbr->ref) {
-			continue;
-		}
+/* The route to exactly this prefix, routes to longer or shorter prefixes
+ * of the same address are kept apart.
+ */
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  u8_t prefix_len)
+{
+	struct net_lpm_entry *entry;
 
-		if (iface && nbr->iface != iface) {
-			continue;
-		}
+	entry = net_lpm_find(&route_lpm, addr->s6_addr, prefix_len,
+			     route_iface_match, iface);
+	if (!entry) {
+		return NULL;
+	}
 
-		route = net_route_data(nbr);
+	return CONTAINER_OF(entry, struct net_route_entry, lpm);
+}
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix((u8_t *)dst,
-				       (u8_t *)&route->addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+	struct net_lpm_entry *entry;
+
+	found = route_cache_get(iface, dst);
+	if (!found) {
+		entry = net_lpm_lookup(&route_lpm, dst->s6_addr, 128,
+				       route_iface_match, iface);
+		if (entry) {
+			found = CONTAINER_OF(entry, struct net_route_entry,
+					     lpm);
+			route_cache_put(iface, dst, found);
 		}
 	}
 
@@ -333,7 +415,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		log_strdup(net_sprint_ll_addr(nexthop_lladdr->addr,
 					      nexthop_lladdr->len)));
 
-	route = net_route_lookup(iface, addr);
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -353,9 +435,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
-
-		sys_slist_find_and_remove(&routes, last);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -401,7 +481,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route = net_route_data(nbr);
 	route->iface = iface;
 
-	sys_slist_prepend(&routes, &route->node);
+	if (net_lpm_add(&route_lpm, &route->lpm, route->addr.s6_addr,
+			route->prefix_len) < 0) {
+		NET_ERR("No prefix node available!");
+		nbr_free(nbr);
+		nbr_free(tmp);
+		return NULL;
+	}
+
+	route_cache_flush();
+
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -454,7 +544,12 @@ int net_route_del(struct net_route_entry *route)
 	net_mgmt_event_notify(NET_EVENT_IPV6_ROUTE_DEL, route->iface);
 #endif
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	net_lpm_del(&route_lpm, &route->lpm);
+	route_cache_flush();
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -712,7 +807,7 @@ net_route_mcast_lookup(struct in6_addr *group)
 	for (i = 0; i < CONFIG_NET_MAX_MCAST_ROUTES; i++) {
 		struct net_route_entry_mcast *route = &route_mcast_entries[i];
 
-		if (!route->is_used) {
+		if (route->is_used) {
 			if (net_ipv6_addr_cmp(group, &route->group)) {
 				return route;
 			}
@@ -845,6 +940,9 @@ int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface)
 
 void net_route_init(void)
 {
+	net_lpm_init(&route_lpm, route_lpm_nodes,
+		     ARRAY_SIZE(route_lpm_nodes));
+
 	NET_DBG("Allocated %d routing entries (%zu bytes)",
 		CONFIG_NET_MAX_ROUTES, sizeof(net_route_entries_pool));
 
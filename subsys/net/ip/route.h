@@ -15,10 +15,12 @@
 
 #include <kernel.h>
 #include <sys/slist.h>
+#include <sys/dlist.h>
 
 #include <net/net_ip.h>
 
 #include "nbr.h"
+#include "lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,7 +48,10 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
+
+	/** Entry of the prefix trie that the routes are looked up in. */
+	struct net_lpm_entry lpm;
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
@@ -278,6 +283,93 @@ void net_route_init(void);
 #define net_route_init(...)
 #endif /* CONFIG_NET_ROUTE */
 
+/**
+ * @brief IPv4 route entry.
+ */
+struct net_route_entry_ipv4 {
+	/** Entry of the prefix trie that the routes are looked up in. */
+	struct net_lpm_entry lpm;
+
+	/** Network interface for the route. */
+	struct net_if *iface;
+
+	/** IPv4 address/prefix of the route. */
+	struct in_addr addr;
+
+	/** Gateway that the route goes through. */
+	struct in_addr gw;
+
+	/** IPv4 address/prefix length. */
+	u8_t prefix_len;
+
+	/** Is this entry in use or not */
+	bool is_used;
+};
+
+typedef void (*net_route_ipv4_cb_t)(struct net_route_entry_ipv4 *entry,
+				    void *user_data);
+
+#if defined(CONFIG_NET_ROUTE_IPV4) && defined(CONFIG_NET_NATIVE)
+/**
+ * @brief Add an IPv4 route, or change the gateway of an existing route to
+ * the same prefix.
+ *
+ * @param iface Network interface that this route is tied to.
+ * @param addr IPv4 address/prefix.
+ * @param prefix_len Length of the IPv4 address/prefix.
+ * @param gw IPv4 address of the gateway, on the link of iface.
+ *
+ * @return Return the route entry, NULL if could not be created.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						struct in_addr *addr,
+						u8_t prefix_len,
+						struct in_addr *gw);
+
+/**
+ * @brief Delete an IPv4 route.
+ *
+ * @param route Existing route entry.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route);
+
+/**
+ * @brief Lookup the IPv4 route with the longest prefix of a destination.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ *
+ * @return Return route entry for the destination, NULL if not found.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   struct in_addr *dst);
+
+/**
+ * @brief Go through all the IPv4 routes and call callback for each of them.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ *
+ * @return Total number of IPv4 routes found.
+ */
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data);
+
+void net_route_ipv4_init(void);
+#else
+static inline struct net_route_entry_ipv4 *
+net_route_ipv4_lookup(struct net_if *iface, struct in_addr *dst)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+
+	return NULL;
+}
+
+#define net_route_ipv4_init(...)
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
 #ifdef __cplusplus
 }
 #endif
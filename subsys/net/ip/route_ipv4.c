@@ -0,0 +1,154 @@
+/** @file
+ * @brief IPv4 route handling.
+ *
+ * Routes towards IPv4 prefixes via a gateway on the link. They are looked
+ * up by the longest prefix in the same kind of trie as the IPv6 routes.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_route_ipv4, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/types.h>
+
+#include <net/net_core.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#include "net_private.h"
+#include "lpm.h"
+#include "route.h"
+
+static struct net_route_entry_ipv4 routes[CONFIG_NET_MAX_ROUTES_IPV4];
+
+static struct net_lpm route_lpm;
+static struct net_lpm_node route_lpm_nodes[2 * CONFIG_NET_MAX_ROUTES_IPV4];
+
+static bool route_iface_match(struct net_lpm_entry *entry, void *user_data)
+{
+	struct net_route_entry_ipv4 *route =
+		CONTAINER_OF(entry, struct net_route_entry_ipv4, lpm);
+
+	return !user_data || route->iface == user_data;
+}
+
+static struct net_route_entry_ipv4 *route_get(struct net_lpm_entry *entry)
+{
+	if (!entry) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry_ipv4, lpm);
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						struct in_addr *addr,
+						u8_t prefix_len,
+						struct in_addr *gw)
+{
+	struct net_route_entry_ipv4 *route;
+	int i;
+
+	NET_ASSERT(iface);
+	NET_ASSERT(addr);
+	NET_ASSERT(gw);
+
+	if (prefix_len > 32) {
+		return NULL;
+	}
+
+	route = route_get(net_lpm_find(&route_lpm, addr->s4_addr, prefix_len,
+				       route_iface_match, iface));
+	if (route) {
+		NET_DBG("Route %s/%d gateway changed to %s",
+			log_strdup(net_sprint_ipv4_addr(addr)), prefix_len,
+			log_strdup(net_sprint_ipv4_addr(gw)));
+
+		net_ipaddr_copy(&route->gw, gw);
+		return route;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(routes); i++) {
+		if (!routes[i].is_used) {
+			route = &routes[i];
+			break;
+		}
+	}
+
+	if (!route) {
+		NET_DBG("No free IPv4 route entries");
+		return NULL;
+	}
+
+	if (net_lpm_add(&route_lpm, &route->lpm, addr->s4_addr,
+			prefix_len) < 0) {
+		return NULL;
+	}
+
+	route->iface = iface;
+	route->prefix_len = prefix_len;
+	route->is_used = true;
+	net_ipaddr_copy(&route->addr, addr);
+	net_ipaddr_copy(&route->gw, gw);
+
+	NET_DBG("Added route %s/%d via %s (iface %p)",
+		log_strdup(net_sprint_ipv4_addr(addr)), prefix_len,
+		log_strdup(net_sprint_ipv4_addr(gw)), iface);
+
+	return route;
+}
+
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route)
+{
+	if (!route || !route->is_used) {
+		return -EINVAL;
+	}
+
+	NET_DBG("Deleted route %s/%d (iface %p)",
+		log_strdup(net_sprint_ipv4_addr(&route->addr)),
+		route->prefix_len, route->iface);
+
+	net_lpm_del(&route_lpm, &route->lpm);
+	route->is_used = false;
+
+	return 0;
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   struct in_addr *dst)
+{
+	return route_get(net_lpm_lookup(&route_lpm, dst->s4_addr, 32,
+					route_iface_match, iface));
+}
+
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data)
+{
+	int i, ret = 0;
+
+	for (i = 0; i < ARRAY_SIZE(routes); i++) {
+		if (!routes[i].is_used) {
+			continue;
+		}
+
+		cb(&routes[i], user_data);
+
+		ret++;
+	}
+
+	return ret;
+}
+
+void net_route_ipv4_init(void)
+{
+	net_lpm_init(&route_lpm, route_lpm_nodes,
+		     ARRAY_SIZE(route_lpm_nodes));
+
+	NET_DBG("Allocated %d IPv4 routing entries (%zu bytes)",
+		CONFIG_NET_MAX_ROUTES_IPV4, sizeof(routes));
+}
@@ -7,29 +7,42 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <zephyr.h>
 #include <net/net_pkt.h>
 #include <net/net_context.h>
 #include <net/udp.h>
+#include <sys/byteorder.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
+#include "net_gso.h"
 #include "tcp2_priv.h"
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = 3;
-static int tcp_window = NET_IPV6_MTU;
+static int tcp_window = CONFIG_NET_TCP_RECV_WINDOW_SIZE;
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MEM_SLAB_DEFINE(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+/* Segments cut out of application buffers, each holding a reference to
+ * the buffer it points into.
+ */
+static void tcp_slice_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(tcp_slices, CONFIG_NET_BUF_TX_COUNT, 0, 0,
+		    tcp_slice_destroy);
+
+static struct net_buf *tcp_slice_parent[CONFIG_NET_BUF_TX_COUNT];
+#endif
+
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static size_t tcp_data_len(struct net_pkt *pkt);
 int net_tcp_finalize(struct net_pkt *pkt);
@@ -222,6 +235,38 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
+static void tcp_seg_free(struct tcp_seg *seg)
+{
+	tcp_pkt_unref(seg->pkt);
+	tcp_free(seg);
+}
+
+static void tcp_data_queue_flush(struct tcp *conn)
+{
+	struct net_pkt *pkt;
+	struct tcp_seg *seg;
+
+	k_delayed_work_cancel(&conn->rto_timer);
+	k_delayed_work_cancel(&conn->ack_timer);
+
+	while ((pkt = tcp_slist(&conn->send_data, get,
+				struct net_pkt, next))) {
+		tcp_pkt_unref(pkt);
+	}
+
+	conn->send_data_len = 0U;
+
+	while ((seg = tcp_slist(&conn->unacked, get, struct tcp_seg, next))) {
+		tcp_seg_free(seg);
+	}
+
+	while ((seg = tcp_slist(&conn->ooo, get, struct tcp_seg, next))) {
+		tcp_seg_free(seg);
+	}
+
+	conn->ooo_cnt = 0U;
+}
+
 static int tcp_conn_unref(struct tcp *conn)
 {
 	int ref_count = atomic_dec(&conn->ref_count) - 1;
@@ -253,6 +298,8 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	tcp_send_queue_flush(conn);
 
+	tcp_data_queue_flush(conn);
+
 	tcp_free(conn->src);
 	tcp_free(conn->dst);
 
@@ -418,6 +465,12 @@ static bool tcp_options_check(void *buf, ssize_t len)
 				goto end;
 			}
 			break;
+		case TCPOPT_TIMESTAMP:
+			if (opt_len != 10) {
+				result = false;
+				goto end;
+			}
+			break;
 		default:
 			continue;
 		}
@@ -430,6 +483,235 @@ end:
 	return result;
 }
 
+static u16_t tcp_mss(struct tcp *conn)
+{
+	size_t hdr_len = sizeof(struct tcphdr) +
+		(net_context_get_family(conn->context) == AF_INET ?
+		 sizeof(struct net_ipv4_hdr) : sizeof(struct net_ipv6_hdr));
+	u16_t mtu = conn->iface ? net_if_get_mtu(conn->iface) : 0U;
+
+	return mtu > hdr_len ? mtu - hdr_len : TCP_MSS_DEFAULT;
+}
+
+/* Payload of a full sized segment, options take their share of the MSS */
+static u16_t tcp_smss(struct tcp *conn)
+{
+	return conn->mss - (conn->ts_enabled ? TCP_TS_OPT_LEN : 0);
+}
+
+static void tcp_sack_mark(struct tcp *conn, const u8_t *blocks, int n)
+{
+	struct tcp_seg *seg;
+	u32_t left, right;
+
+	for ( ; n > 0; n--, blocks += 8) {
+		left = sys_get_be32(blocks);
+		right = sys_get_be32(blocks + 4);
+
+		/* Ignore D-SACK and blocks covering data never sent */
+		if (seq_leq(right, conn->snd_una) || seq_gt(right, conn->seq)) {
+			continue;
+		}
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn->unacked, seg, next) {
+			if (seq_geq(seg->seq, left) &&
+			    seq_leq(seg->seq + seg->len, right)) {
+				seg->sacked = 1U;
+			}
+		}
+
+		if (seq_gt(right, conn->sack_high)) {
+			conn->sack_high = right;
+		}
+	}
+}
+
+/* Options have been validated by tcp_options_check(). Returns false if the
+ * segment is an old duplicate and must be dropped.
+ */
+static bool tcp_options_parse(struct tcp *conn, struct tcphdr *th, size_t len)
+{
+	u8_t *options = (u8_t *)(th + 1), opt, opt_len;
+	bool syn = th->th_flags & SYN, ts = false;
+	u32_t ts_val = 0U;
+
+	for ( ; len >= 1; options += opt_len, len -= opt_len) {
+		opt = options[0];
+
+		if (opt == TCPOPT_END) {
+			break;
+		} else if (opt == TCPOPT_NOP) {
+			opt_len = 1;
+			continue;
+		}
+
+		opt_len = options[1];
+
+		switch (opt) {
+		case TCPOPT_MAXSEG:
+			if (syn) {
+				conn->mss = MIN(tcp_mss(conn),
+						sys_get_be16(&options[2]));
+			}
+			break;
+		case TCPOPT_SACK_PERM:
+			if (syn) {
+				conn->sack_enabled =
+					IS_ENABLED(CONFIG_NET_TCP_SACK);
+			}
+			break;
+		case TCPOPT_SACK:
+			if (!syn && conn->sack_enabled &&
+			    (th->th_flags & ACK)) {
+				tcp_sack_mark(conn, &options[2],
+					      (opt_len - 2) / 8);
+			}
+			break;
+		case TCPOPT_WINDOW:
+			if (syn && IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALING)) {
+				conn->snd_wscale = MIN(options[2],
+						       TCP_WSCALE_MAX);
+				conn->wscale_enabled = true;
+			}
+			break;
+		case TCPOPT_TIMESTAMP:
+			if (syn) {
+				conn->ts_enabled =
+					IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS);
+			}
+			if (conn->ts_enabled) {
+				ts_val = sys_get_be32(&options[2]);
+				conn->ts_ecr = sys_get_be32(&options[6]);
+				ts = true;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!ts) {
+		return true;
+	}
+
+	/* PAWS, a timestamp older than the last one seen marks a duplicate
+	 * from an earlier wrap of the sequence space (RFC 7323 section 5)
+	 */
+	if (!syn && !(th->th_flags & RST) && seq_lt(ts_val, conn->ts_recent)) {
+		return false;
+	}
+
+	if (syn || seq_leq(th_seq(th), conn->ack)) {
+		conn->ts_recent = ts_val;
+	}
+
+	return true;
+}
+
+/* SACK blocks describing the out of order queue, the block holding the
+ * most recently received segment first (RFC 2018)
+ */
+static int tcp_sack_blocks(struct tcp *conn, struct tcp_sack_block *blocks)
+{
+	struct tcp_sack_block tmp;
+	struct tcp_seg *seg;
+	u32_t right;
+	int n = 0, i;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->ooo, seg, next) {
+		right = seg->seq + seg->len;
+
+		if (n > 0 && seq_leq(seg->seq, blocks[n - 1].right)) {
+			if (seq_gt(right, blocks[n - 1].right)) {
+				blocks[n - 1].right = right;
+			}
+			continue;
+		}
+
+		blocks[n].left = seg->seq;
+		blocks[n].right = right;
+		n++;
+	}
+
+	for (i = 1; i < n; i++) {
+		if (seq_geq(conn->ooo_last, blocks[i].left) &&
+		    seq_lt(conn->ooo_last, blocks[i].right)) {
+			tmp = blocks[0];
+			blocks[0] = blocks[i];
+			blocks[i] = tmp;
+			break;
+		}
+	}
+
+	return n;
+}
+
+static size_t tcp_options_build(struct tcp *conn, u8_t flags, u8_t *options)
+{
+	struct tcp_sack_block blocks[CONFIG_NET_TCP_OOO_SEGMENTS];
+	size_t len = 0;
+	int n, i;
+
+	if (flags & SYN) {
+		options[len++] = TCPOPT_MAXSEG;
+		options[len++] = 4U;
+		sys_put_be16(tcp_mss(conn), &options[len]);
+		len += 2;
+
+		/* Offer SACK, or accept it on SYN-ACK if the peer did */
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    (!(flags & ACK) || conn->sack_enabled)) {
+			options[len++] = TCPOPT_NOP;
+			options[len++] = TCPOPT_NOP;
+			options[len++] = TCPOPT_SACK_PERM;
+			options[len++] = 2U;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALING) &&
+		    (!(flags & ACK) || conn->wscale_enabled)) {
+			options[len++] = TCPOPT_NOP;
+			options[len++] = TCPOPT_WINDOW;
+			options[len++] = 3U;
+			options[len++] = conn->rcv_wscale;
+		}
+	}
+
+	/* Timestamps are offered on SYN and, once agreed on, carried by
+	 * every segment
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) &&
+	    (flags == SYN || conn->ts_enabled)) {
+		options[len++] = TCPOPT_NOP;
+		options[len++] = TCPOPT_NOP;
+		options[len++] = TCPOPT_TIMESTAMP;
+		options[len++] = 10U;
+		sys_put_be32(k_uptime_get_32(), &options[len]);
+		sys_put_be32((flags & ACK) ? conn->ts_recent : 0U,
+			     &options[len + 4]);
+		len += 8;
+	}
+
+	if (flags == ACK && conn->sack_enabled && conn->ooo_cnt) {
+		/* Only on pure ACKs, data segments are already MSS sized */
+		n = MIN(tcp_sack_blocks(conn, blocks),
+			MIN((TCP_OPTIONS_MAX - len - 4) / 8,
+			    TCP_SACK_BLOCKS_MAX));
+
+		options[len++] = TCPOPT_NOP;
+		options[len++] = TCPOPT_NOP;
+		options[len++] = TCPOPT_SACK;
+		options[len++] = 2 + n * 8;
+
+		for (i = 0; i < n; i++) {
+			sys_put_be32(blocks[i].left, &options[len]);
+			sys_put_be32(blocks[i].right, &options[len + 4]);
+			len += 8;
+		}
+	}
+
+	return len;
+}
+
 static size_t tcp_data_len(struct net_pkt *pkt)
 {
 	struct tcphdr *th = th_get(pkt);
@@ -445,6 +727,36 @@ static size_t tcp_data_len(struct net_pkt *pkt)
 	return len > 0 ? len : 0;
 }
 
+/* Pass the last len bytes of the segment to the application. Returns
+ * false if the data could not be taken and must not be acknowledged.
+ */
+static bool tcp_data_deliver(struct tcp *conn, struct net_pkt *pkt,
+			     size_t len)
+{
+	struct net_pkt *up;
+
+	if (!conn->context->recv_cb) {
+		return true;
+	}
+
+	up = net_pkt_clone(pkt, K_NO_WAIT);
+	if (!up) {
+		NET_ERR("Cannot clone received data");
+		return false;
+	}
+
+	net_pkt_cursor_init(up);
+	net_pkt_set_overwrite(up, true);
+
+	net_pkt_skip(up, net_pkt_get_len(up) - len);
+
+	net_context_packet_received(
+		(struct net_conn *)conn->context->conn_handler,
+		up, NULL, NULL, conn->recv_user_data);
+
+	return true;
+}
+
 static size_t tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 {
 	ssize_t len = tcp_data_len(pkt);
@@ -454,19 +766,8 @@ static size_t tcp_data_get(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
-	if (len > 0) {
-		if (conn->context->recv_cb) {
-			struct net_pkt *up = net_pkt_clone(pkt, K_NO_WAIT);
-
-			net_pkt_cursor_init(up);
-			net_pkt_set_overwrite(up, true);
-
-			net_pkt_skip(up, net_pkt_get_len(up) - len);
-
-			net_context_packet_received(
-				(struct net_conn *)conn->context->conn_handler,
-				up, NULL, NULL, conn->recv_user_data);
-		}
+	if (len > 0 && !tcp_data_deliver(conn, pkt, len)) {
+		len = 0;
 	}
  out:
 	return len;
@@ -487,10 +788,29 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
-static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, u8_t flags)
+/* The window of a SYN segment is never scaled (RFC 7323) */
+static u16_t tcp_rcv_wnd(struct tcp *conn, u8_t flags)
+{
+	u32_t win = (flags & SYN) ? conn->win : conn->win >> conn->rcv_wscale;
+
+	return MIN(win, UINT16_MAX);
+}
+
+static u32_t tcp_snd_wnd(struct tcp *conn, struct tcphdr *th)
+{
+	u32_t win = ntohs(th->th_win);
+
+	return (th->th_flags & SYN) ? win : win << conn->snd_wscale;
+}
+
+static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, u8_t flags,
+			  u32_t seq)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	u8_t options[TCP_OPTIONS_MAX];
+	size_t options_len;
 	struct tcphdr *th;
+	int r;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -502,16 +822,30 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, u8_t flags)
 	th->th_sport = conn->src->sin.sin_port;
 	th->th_dport = conn->dst->sin.sin_port;
 
-	th->th_off = 5;
+	options_len = tcp_options_build(conn, flags, options);
+
+	th->th_off = 5 + options_len / 4;
 	th->th_flags = flags;
-	th->th_win = htons(conn->win);
-	th->th_seq = htonl(conn->seq);
+	th->th_win = htons(tcp_rcv_wnd(conn, flags));
+	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
 		th->th_ack = htonl(conn->ack);
+
+		/* This segment carries any acknowledgment held back */
+		if (conn->ack_pending) {
+			conn->ack_pending = 0U;
+			conn->ack_pending_len = 0U;
+			k_delayed_work_cancel(&conn->ack_timer);
+		}
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	r = net_pkt_set_data(pkt, &tcp_access);
+	if (r < 0 || options_len == 0) {
+		return r;
+	}
+
+	return net_pkt_write(pkt, options, options_len);
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -545,52 +879,65 @@ static struct net_pkt *tcp_pkt_alloc(struct net_if *iface,
 	return pkt;
 }
 
-static void tcp_out(struct tcp *conn, u8_t flags, ...)
+/* Data only packet, the headers go in front of it when it is sent */
+static struct net_pkt *tcp_data_alloc(struct tcp *conn, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(conn->iface, len, AF_UNSPEC, 0,
+					K_NO_WAIT);
+
+#if IS_ENABLED(CONFIG_NET_TEST_PROTOCOL)
+	tp_pkt_alloc(pkt);
+#endif
+	return pkt;
+}
+
+/* Build a segment, the reference to the data buffer is passed to it */
+static struct net_pkt *tcp_pkt_build(struct tcp *conn, u8_t flags,
+				     struct net_buf *data, u32_t seq)
 {
 	struct net_pkt *pkt;
-	size_t len = 0;
-	int r;
 
 	pkt = tcp_pkt_alloc(conn->iface, net_context_get_family(conn->context),
-			    sizeof(struct tcphdr));
+			    sizeof(struct tcphdr) + TCP_OPTIONS_MAX);
 	if (!pkt) {
 		goto fail;
 	}
 
-	if (PSH & flags) {
-		struct net_pkt *data_pkt;
-		va_list ap;
-		va_start(ap, flags);
-		data_pkt = va_arg(ap, struct net_pkt *);
-		va_end(ap);
-
-		len = net_pkt_get_len(data_pkt);
+	if (data) {
 		/* Append the data buffer to pkt */
-		net_pkt_append_buffer(pkt, data_pkt->buffer);
-
-		data_pkt->buffer = NULL;
-		tcp_pkt_unref(data_pkt);
+		net_pkt_append_buffer(pkt, data);
+		data = NULL;
 	}
 
 	pkt->iface = conn->iface;
 
-	r = ip_header_add(conn, pkt);
-	if (r < 0) {
+	if (ip_header_add(conn, pkt) < 0 ||
+	    tcp_header_add(conn, pkt, flags, seq) < 0 ||
+	    tcp_finalize_pkt(pkt) < 0) {
 		goto fail;
 	}
 
-	r = tcp_header_add(conn, pkt, flags);
-	if (r < 0) {
-		goto fail;
+	return pkt;
+fail:
+	if (data) {
+		net_buf_unref(data);
 	}
 
-	r = tcp_finalize_pkt(pkt);
-	if (r < 0) {
-		goto fail;
+	if (pkt) {
+		tcp_pkt_unref(pkt);
 	}
 
-	if (len) {
-		conn_seq(conn, + len);
+	return NULL;
+}
+
+static void tcp_out(struct tcp *conn, u8_t flags)
+{
+	struct net_pkt *pkt = tcp_pkt_build(conn, flags, NULL, conn->seq);
+
+	if (!pkt) {
+		goto out;
 	}
 
 	NET_DBG("%s", log_strdup(tcp_th(pkt)));
@@ -605,78 +952,840 @@ static void tcp_out(struct tcp *conn, u8_t flags, ...)
 	tcp_send_process((struct k_work *)&conn->send_timer);
 out:
 	return;
+}
 
-fail:
-	if (pkt) {
-		tcp_pkt_unref(pkt);
+static void tcp_rto_timer_restart(struct tcp *conn)
+{
+	k_delayed_work_submit(&conn->rto_timer, K_MSEC(conn->rto));
+}
+
+static void tcp_rto_timer_start(struct tcp *conn)
+{
+	if (!k_delayed_work_remaining_get(&conn->rto_timer)) {
+		tcp_rto_timer_restart(conn);
 	}
 }
 
-static void tcp_conn_ref(struct tcp *conn)
+/* RFC 6298 retransmission timeout, srtt and rttvar are kept scaled by 8
+ * and 4 as in BSD
+ */
+static void tcp_rtt_update(struct tcp *conn, u32_t rtt)
 {
-	int ref_count = atomic_inc(&conn->ref_count) + 1;
+	s32_t delta;
 
-	NET_DBG("conn: %p, ref_count: %d", conn, ref_count);
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = rtt - (conn->srtt >> 3);
+		conn->srtt += delta;
+		if (delta < 0) {
+			delta = -delta;
+		}
+		conn->rttvar += delta - (s32_t)(conn->rttvar >> 2);
+	}
+
+	conn->rto = (conn->srtt >> 3) + MAX(conn->rttvar, 1U);
+	conn->rto = MIN(MAX(conn->rto, TCP_RTO_MIN), TCP_RTO_MAX);
 }
 
-static struct tcp *tcp_conn_alloc(void)
+/* Bluetooth, IEEE 802.15.4 and CAN use 6lo, which compresses and
+ * fragments the sent packet in place, so they get a copy of the data.
+ */
+static bool tcp_data_by_ref(struct tcp *conn)
 {
-	struct tcp *conn = NULL;
-	int ret;
+	enum net_link_type type = net_if_get_link_addr(conn->iface)->type;
 
-	ret = k_mem_slab_alloc(&tcp_conns_slab, (void **)&conn, K_NO_WAIT);
-	if (ret) {
-		goto out;
-	}
+	return !(type == NET_LINK_BLUETOOTH || type == NET_LINK_IEEE802154 ||
+		 type == NET_LINK_CANBUS);
+}
 
-	memset(conn, 0, sizeof(*conn));
+static int tcp_seg_xmit(struct tcp *conn, struct tcp_seg *seg, bool rexmit)
+{
+	struct net_pkt *copy, *pkt;
+	struct net_buf *data;
 
-	k_mutex_init(&conn->lock);
+	if (tcp_data_by_ref(conn)) {
+		/* The segment keeps the data until it is acknowledged,
+		 * referencing the head of the chain keeps the whole chain
+		 */
+		data = net_buf_ref(seg->pkt->buffer);
+	} else {
+		copy = tcp_pkt_clone(seg->pkt);
+		if (!copy) {
+			return -ENOBUFS;
+		}
 
-	conn->state = TCP_LISTEN;
+		data = copy->buffer;
+		copy->buffer = NULL;
+		tcp_pkt_unref(copy);
+	}
 
-	conn->win = tcp_window;
+	pkt = tcp_pkt_build(conn, PSH | ACK, data, seg->seq);
+	if (!pkt) {
+		return -ENOBUFS;
+	}
 
-	sys_slist_init(&conn->send_queue);
+	seg->sent = k_uptime_get_32();
 
-	k_delayed_work_init(&conn->send_timer, tcp_send_process);
+	if (rexmit) {
+		seg->retransmitted = 1U;
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+		net_stats_update_tcp_resent(conn->iface, seg->len);
+	}
 
-	tcp_conn_ref(conn);
+	tcp_send(pkt);
 
-	sys_slist_append(&tcp_conns, (sys_snode_t *)conn);
-out:
-	NET_DBG("conn: %p", conn);
+	return 0;
+}
 
-	return conn;
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+static void tcp_slice_destroy(struct net_buf *buf)
+{
+	struct net_buf *parent = tcp_slice_parent[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+	net_buf_unref(parent);
 }
 
-int net_tcp_get(struct net_context *context)
+/* Point a segment into the application buffer at the head of the send
+ * queue, if the segment fits in it.
+ */
+static struct net_pkt *tcp_data_slice(struct tcp *conn, struct net_pkt *head,
+				      size_t len)
 {
-	int ret = 0, key = irq_lock();
-	struct tcp *conn;
+	struct net_buf *parent = head->cursor.buf;
+	struct net_buf *slice;
+	struct net_pkt *pkt;
 
-	conn = tcp_conn_alloc();
-	if (conn == NULL) {
-		ret = -ENOMEM;
-		goto out;
+	if (!parent || !(parent->flags & NET_BUF_EXTERNAL_DATA) ||
+	    (size_t)(parent->data + parent->len - head->cursor.pos) < len) {
+		return NULL;
 	}
 
-	/* Mutually link the net_context and tcp connection */
-	conn->context = context;
-	context->tcp = conn;
-out:
-	irq_unlock(key);
+	pkt = tcp_data_alloc(conn, 0);
+	if (!pkt) {
+		return NULL;
+	}
 
-	NET_DBG("context: %p (local: %s, remote: %s), conn: %p", context,
-		log_strdup(tcp_endpoint_to_string((void *)&context->local)),
-		log_strdup(tcp_endpoint_to_string((void *)&context->remote)),
-		conn);
+	slice = net_buf_alloc_with_data(&tcp_slices, head->cursor.pos, len,
+					K_NO_WAIT);
+	if (!slice) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
 
-	return ret;
-}
+	tcp_slice_parent[net_buf_id(slice)] = net_buf_ref(parent);
+	net_pkt_append_buffer(pkt, slice);
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-				int which)
+	net_pkt_set_overwrite(head, true);
+	net_pkt_skip(head, len);
+
+	if (net_pkt_remaining_data(head) == 0) {
+		sys_slist_get(&conn->send_data);
+		tcp_pkt_unref(head);
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NET_CONTEXT_ZEROCOPY */
+
+/* Take the next len bytes off the send queue. A queued packet holding
+ * exactly the segment is used as is, and a segment within an application
+ * buffer sent with net_context_send_buf() refers to it. Otherwise the data
+ * is copied into a new packet, which coalesces small writes into one
+ * segment.
+ */
+static struct net_pkt *tcp_data_take(struct tcp *conn, size_t len)
+{
+	struct net_pkt *head = tcp_slist(&conn->send_data, peek_head,
+					 struct net_pkt, next);
+	struct net_pkt *pkt;
+	size_t left, chunk;
+
+	if (net_pkt_get_len(head) == len &&
+	    net_pkt_remaining_data(head) == len) {
+		sys_slist_get(&conn->send_data);
+		pkt = head;
+		goto out;
+	}
+
+#if defined(CONFIG_NET_CONTEXT_ZEROCOPY)
+	pkt = tcp_data_slice(conn, head, len);
+	if (pkt) {
+		goto out;
+	}
+#endif
+
+	pkt = tcp_data_alloc(conn, len);
+	if (!pkt) {
+		return NULL;
+	}
+
+	for (left = len; left > 0; left -= chunk) {
+		head = tcp_slist(&conn->send_data, peek_head,
+				 struct net_pkt, next);
+		chunk = MIN(left, net_pkt_remaining_data(head));
+
+		net_pkt_copy(pkt, head, chunk);
+
+		if (net_pkt_remaining_data(head) == 0) {
+			sys_slist_get(&conn->send_data);
+			tcp_pkt_unref(head);
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+out:
+	conn->send_data_len -= len;
+
+	return pkt;
+}
+
+/* Take the next len bytes of queued data as a new segment. The data is
+ * committed to the sequence space now, if it cannot go out the
+ * retransmission timer resends it.
+ */
+static struct tcp_seg *tcp_seg_new(struct tcp *conn, size_t len)
+{
+	struct tcp_seg *seg;
+
+	seg = tcp_calloc(1, sizeof(*seg));
+	if (!seg) {
+		goto out;
+	}
+
+	seg->pkt = tcp_data_take(conn, len);
+	if (!seg->pkt) {
+		tcp_free(seg);
+		seg = NULL;
+		goto out;
+	}
+
+	seg->seq = conn->seq;
+	seg->len = len;
+
+	sys_slist_append(&conn->unacked, &seg->next);
+	conn_seq(conn, + len);
+out:
+	/* Without a segment, try again from the timer once buffers have
+	 * been released
+	 */
+	tcp_rto_timer_start(conn);
+
+	return seg;
+}
+
+/* Send the next len bytes of queued data as a new segment */
+static bool tcp_data_send_one(struct tcp *conn, size_t len)
+{
+	struct tcp_seg *seg = tcp_seg_new(conn, len);
+
+	if (!seg) {
+		return false;
+	}
+
+	(void)tcp_seg_xmit(conn, seg, false);
+
+	return true;
+}
+
+#if defined(CONFIG_NET_GSO)
+/* Send n consecutive new segments of the same size as one packet, which
+ * is cut back into the segments when it reaches the network device. The
+ * segments are still acknowledged and retransmitted one by one.
+ */
+static void tcp_gso_xmit(struct tcp *conn, struct tcp_seg *first, int n)
+{
+	struct net_buf *data = NULL, *slice;
+	struct tcp_seg *seg = first;
+	struct net_pkt *pkt;
+	u32_t now;
+	int i;
+
+	for (i = 0; n > 1 && i < n; i++) {
+		slice = net_gso_slice(seg->pkt->buffer, 0, seg->len);
+		if (!slice) {
+			break;
+		}
+
+		if (data) {
+			net_buf_frag_add(data, slice);
+		} else {
+			data = slice;
+		}
+
+		seg = SYS_SLIST_PEEK_NEXT_CONTAINER(seg, next);
+	}
+
+	if (n > 1 && i == n) {
+		pkt = tcp_pkt_build(conn, PSH | ACK, data, first->seq);
+		data = NULL;
+
+		if (pkt) {
+			net_pkt_set_gso_size(pkt, first->len);
+			now = k_uptime_get_32();
+
+			for (i = 0, seg = first; i < n; i++) {
+				seg->sent = now;
+				seg = SYS_SLIST_PEEK_NEXT_CONTAINER(seg, next);
+			}
+
+			tcp_send(pkt);
+			return;
+		}
+	}
+
+	if (data) {
+		net_buf_unref(data);
+	}
+
+	/* Out of buffers, send the segments one by one */
+	for (i = 0, seg = first; i < n; i++) {
+		(void)tcp_seg_xmit(conn, seg, false);
+		seg = SYS_SLIST_PEEK_NEXT_CONTAINER(seg, next);
+	}
+}
+#endif /* CONFIG_NET_GSO */
+
+/* The FIN goes out once all the queued data has been sent. It takes a
+ * sequence number and is retransmitted from the send queue.
+ */
+static void tcp_fin_send(struct tcp *conn)
+{
+	if (!conn->fin_queued || conn->fin_sent || conn->send_data_len > 0) {
+		return;
+	}
+
+	conn->fin_seq = conn->seq;
+	conn->fin_sent = true;
+
+	tcp_out(conn, FIN | ACK);
+	conn_seq(conn, + 1);
+}
+
+/* Send queued data as allowed by the congestion and the peer's window.
+ * Unless the socket has TCP_NODELAY set, a segment smaller than the MSS
+ * waits until the data in flight has been acknowledged (Nagle, RFC 896),
+ * and with TCP_CORK set it waits for a full segment.
+ */
+static void tcp_data_send(struct tcp *conn)
+{
+	u32_t wnd = MIN(conn->cwnd, conn->snd_wnd), flight;
+	u16_t smss = tcp_smss(conn);
+	size_t len;
+#if defined(CONFIG_NET_GSO)
+	bool gso = tcp_data_by_ref(conn);
+	struct tcp_seg *burst = NULL, *seg;
+	int n = 0;
+#endif
+
+	while (conn->send_data_len > 0) {
+		flight = conn_flight(conn);
+		len = MIN(conn->send_data_len, smss);
+
+		if (flight + len > wnd) {
+			/* Only fill the peer's window if nothing is in
+			 * flight, the congestion window is at least an MSS
+			 */
+			if (flight > 0 || conn->snd_wnd == 0U) {
+				break;
+			}
+
+			len = MIN(len, conn->snd_wnd);
+		}
+
+		if (len < smss && !conn->fin_queued &&
+		    (conn->context->options.tcp_cork ||
+		     (flight > 0 && !conn->context->options.tcp_nodelay))) {
+			break;
+		}
+
+#if defined(CONFIG_NET_GSO)
+		/* Full sized segments are collected into a burst sent as
+		 * one packet, any other segment goes out after it
+		 */
+		seg = tcp_seg_new(conn, len);
+		if (!seg) {
+			break;
+		}
+
+		if (gso && len == smss) {
+			burst = n ? burst : seg;
+			if (++n < CONFIG_NET_GSO_MAX_SEGS) {
+				continue;
+			}
+		}
+
+		if (n) {
+			tcp_gso_xmit(conn, burst, n);
+			n = 0;
+		}
+
+		if (!gso || len < smss) {
+			(void)tcp_seg_xmit(conn, seg, false);
+		}
+#else
+		if (!tcp_data_send_one(conn, len)) {
+			break;
+		}
+#endif
+	}
+
+#if defined(CONFIG_NET_GSO)
+	if (n) {
+		tcp_gso_xmit(conn, burst, n);
+	}
+#endif
+
+	if (conn->send_data_len > 0 && conn->snd_wnd == 0U) {
+		/* Zero window, probe it from the retransmission timer */
+		tcp_rto_timer_start(conn);
+	}
+
+	tcp_fin_send(conn);
+}
+
+/* Retransmit the first segment which is neither SACKed nor already resent
+ * in this recovery. Without SACK only the oldest segment is known lost.
+ */
+static void tcp_retransmit_next(struct tcp *conn)
+{
+	struct tcp_seg *head = tcp_slist(&conn->unacked, peek_head,
+					 struct tcp_seg, next);
+	struct tcp_seg *seg;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->unacked, seg, next) {
+		if (seg->sacked || seg->recovery_rexmit) {
+			continue;
+		}
+
+		if (seg != head && (!conn->sack_enabled ||
+				    seq_geq(seg->seq, conn->sack_high))) {
+			break;
+		}
+
+		if (tcp_seg_xmit(conn, seg, true) == 0) {
+			seg->recovery_rexmit = 1U;
+		}
+		break;
+	}
+}
+
+/* Fast retransmit and enter NewReno fast recovery (RFC 5681, RFC 6582) */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	struct tcp_seg *seg;
+
+	NET_DBG("conn: %p una: %u", conn, conn->snd_una);
+
+	tcp_cc_loss(conn);
+
+	conn->recover = conn->seq - 1;
+	conn->in_recovery = true;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->unacked, seg, next) {
+		seg->recovery_rexmit = 0U;
+	}
+
+	tcp_retransmit_next(conn);
+
+	conn->cwnd = conn->ssthresh + TCP_DUPACK_THRESHOLD * conn->mss;
+}
+
+static void tcp_unacked_release(struct tcp *conn, u32_t ack)
+{
+	struct tcp_seg *seg;
+	bool released = false, sample = true;
+	u32_t sent = 0U;
+
+	while ((seg = tcp_slist(&conn->unacked, peek_head,
+				struct tcp_seg, next)) &&
+	       seq_leq(seg->seq + seg->len, ack)) {
+		/* Karn's algorithm: retransmitted data gives no RTT sample */
+		if (seg->retransmitted) {
+			sample = false;
+		}
+
+		sent = seg->sent;
+		released = true;
+
+		sys_slist_get(&conn->unacked);
+		tcp_seg_free(seg);
+	}
+
+	if (!released) {
+		return;
+	}
+
+	if (conn->ts_ecr) {
+		/* The echoed timestamp gives a sample even for resent data */
+		tcp_rtt_update(conn, k_uptime_get_32() - conn->ts_ecr);
+	} else if (sample) {
+		tcp_rtt_update(conn, k_uptime_get_32() - sent);
+	}
+}
+
+static void tcp_ack_process(struct tcp *conn, struct tcphdr *th, size_t len)
+{
+	u32_t ack = th_ack(th), wnd = tcp_snd_wnd(conn, th), acked;
+	bool wnd_update = wnd != conn->snd_wnd;
+
+	if (seq_lt(ack, conn->snd_una)) {
+		return; /* old duplicate */
+	}
+
+	/* Nothing beyond what was sent can be acknowledged */
+	if (seq_gt(ack, conn->seq)) {
+		ack = conn->seq;
+	}
+
+	conn->snd_wnd = wnd;
+
+	if (seq_gt(ack, conn->snd_una)) {
+		acked = ack - conn->snd_una;
+		conn->snd_una = ack;
+		conn->dup_acks = 0U;
+		conn->rto_retries = 0U;
+
+		tcp_unacked_release(conn, ack);
+
+		if (!conn->in_recovery) {
+			tcp_cc_ack(conn, acked);
+
+			if (seq_leq(ack, conn->recover)) {
+				/* Still repairing after a timeout */
+				tcp_retransmit_next(conn);
+			}
+		} else if (seq_gt(ack, conn->recover)) {
+			/* Full acknowledgment, deflate the window */
+			conn->in_recovery = false;
+			conn->cwnd = MIN(conn->ssthresh,
+					 MAX(conn_flight(conn), conn->mss) +
+					 conn->mss);
+		} else {
+			/* Partial acknowledgment, the next hole is lost too */
+			tcp_retransmit_next(conn);
+
+			conn->cwnd -= MIN(conn->cwnd, acked);
+			if (acked >= conn->mss) {
+				conn->cwnd += conn->mss;
+			}
+			conn->cwnd = MAX(conn->cwnd, conn->mss);
+		}
+
+		if (sys_slist_is_empty(&conn->unacked)) {
+			k_delayed_work_cancel(&conn->rto_timer);
+		} else {
+			tcp_rto_timer_restart(conn);
+		}
+	} else if (len == 0 && !wnd_update &&
+		   !(th->th_flags & (SYN | FIN)) &&
+		   !sys_slist_is_empty(&conn->unacked)) {
+		conn->dup_acks++;
+
+		if (conn->in_recovery) {
+			conn->cwnd += conn->mss;
+			if (conn->sack_enabled) {
+				tcp_retransmit_next(conn);
+			}
+		} else if (conn->dup_acks == TCP_DUPACK_THRESHOLD &&
+			   seq_gt(conn->snd_una, conn->recover)) {
+			tcp_fast_retransmit(conn);
+		}
+	}
+
+	tcp_data_send(conn);
+}
+
+static void tcp_rto_expired(struct k_work *work)
+{
+	struct tcp *conn = CONTAINER_OF(work, struct tcp, rto_timer);
+	struct tcp_seg *head, *seg;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	head = tcp_slist(&conn->unacked, peek_head, struct tcp_seg, next);
+	if (!head) {
+		/* Zero window probe, or a send postponed for lack of
+		 * buffers
+		 */
+		if (conn->snd_wnd == 0U) {
+			if (conn->send_data_len > 0) {
+				tcp_data_send_one(conn, 1);
+			}
+		} else {
+			tcp_data_send(conn);
+		}
+		goto out;
+	}
+
+	/* Probing a zero window does not give up on the connection */
+	if (conn->snd_wnd > 0 && conn->rto_retries++ >= tcp_retries) {
+		k_mutex_unlock(&conn->lock);
+		tcp_conn_unref(conn);
+		return;
+	}
+
+	NET_DBG("conn: %p seq: %u rto: %u", conn, head->seq, conn->rto);
+
+	tcp_cc_timeout(conn);
+
+	conn->in_recovery = false;
+	conn->dup_acks = 0U;
+	conn->recover = conn->seq - 1;
+	conn->sack_high = conn->snd_una;
+
+	/* The receiver may have dropped the data it SACKed (RFC 2018) */
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->unacked, seg, next) {
+		seg->sacked = 0U;
+		seg->recovery_rexmit = 0U;
+	}
+
+	conn->rto = MIN(conn->rto * 2, TCP_RTO_MAX);
+
+	if (tcp_seg_xmit(conn, head, true) == 0) {
+		head->recovery_rexmit = 1U;
+	}
+
+	tcp_rto_timer_restart(conn);
+out:
+	k_mutex_unlock(&conn->lock);
+}
+
+static void tcp_ooo_add(struct tcp *conn, struct net_pkt *pkt, u32_t seq,
+			size_t len)
+{
+	struct tcp_seg *seg, *prev = NULL, *new;
+
+	conn->ooo_last = seq;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->ooo, seg, next) {
+		if (seg->seq == seq) {
+			return; /* already queued */
+		}
+
+		if (seq_gt(seg->seq, seq)) {
+			break;
+		}
+
+		prev = seg;
+	}
+
+	if (conn->ooo_cnt >= CONFIG_NET_TCP_OOO_SEGMENTS) {
+		return;
+	}
+
+	new = tcp_calloc(1, sizeof(*new));
+	if (!new) {
+		return;
+	}
+
+	new->pkt = tcp_pkt_clone(pkt);
+	if (!new->pkt) {
+		tcp_free(new);
+		return;
+	}
+
+	new->seq = seq;
+	new->len = len;
+
+	sys_slist_insert(&conn->ooo, prev ? &prev->next : NULL, &new->next);
+	conn->ooo_cnt++;
+}
+
+/* Deliver the queued segments the last in order data made contiguous */
+static void tcp_ooo_drain(struct tcp *conn)
+{
+	struct tcp_seg *seg;
+	u32_t end;
+
+	while ((seg = tcp_slist(&conn->ooo, peek_head, struct tcp_seg, next)) &&
+	       seq_leq(seg->seq, conn->ack)) {
+		end = seg->seq + seg->len;
+
+		if (seq_gt(end, conn->ack)) {
+			if (!tcp_data_deliver(conn, seg->pkt,
+					      end - conn->ack)) {
+				break;
+			}
+
+			conn_ack(conn, + (end - conn->ack));
+		}
+
+		sys_slist_get(&conn->ooo);
+		conn->ooo_cnt--;
+		tcp_seg_free(seg);
+	}
+}
+
+/* Acknowledge in order data with the second segment, once two full
+ * segments are pending, or when the delayed ACK timer expires (RFC 1122
+ * 4.2.3.2). A packet merged by GRO holds several segments, so the
+ * pending length counts too. A window too small for two segments would
+ * stall the sender, so it is acknowledged at once.
+ */
+static void tcp_ack_delay(struct tcp *conn, size_t len)
+{
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	u32_t mss = tcp_mss(conn);
+
+	conn->ack_pending_len += len;
+
+	if (++conn->ack_pending < 2U && conn->ack_pending_len < 2U * mss &&
+	    conn->win >= 2U * mss) {
+		k_delayed_work_submit(&conn->ack_timer,
+				      K_MSEC(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT));
+		return;
+	}
+#endif
+	tcp_out(conn, ACK);
+}
+
+static void tcp_ack_timeout(struct k_work *work)
+{
+	struct tcp *conn = CONTAINER_OF(work, struct tcp, ack_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->ack_pending) {
+		tcp_out(conn, ACK);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+
+static void tcp_data_recv(struct tcp *conn, struct net_pkt *pkt,
+			  struct tcphdr *th, size_t len)
+{
+	u32_t seq = th_seq(th), end = seq + len;
+	bool in_order = false;
+
+	if (seq == conn->ack) {
+		if (tcp_data_get(conn, pkt) > 0) {
+			conn_ack(conn, + len);
+			in_order = sys_slist_is_empty(&conn->ooo);
+			tcp_ooo_drain(conn);
+		}
+	} else if (seq_lt(seq, conn->ack) && seq_gt(end, conn->ack)) {
+		/* Retransmission overlapping new data */
+		if (tcp_data_deliver(conn, pkt, end - conn->ack)) {
+			conn_ack(conn, + (end - conn->ack));
+			tcp_ooo_drain(conn);
+		}
+	} else if (seq_gt(seq, conn->ack)) {
+		tcp_ooo_add(conn, pkt, seq, len);
+	}
+
+	if (in_order) {
+		tcp_ack_delay(conn, len);
+		return;
+	}
+
+	/* Out of order data, data filling a hole and old data the peer
+	 * has resent are acknowledged at once, which also reports holes
+	 * with a duplicate acknowledgment (RFC 5681)
+	 */
+	tcp_out(conn, ACK);
+}
+
+static void tcp_conn_established(struct tcp *conn, struct tcphdr *th)
+{
+	conn->snd_una = conn->seq;
+	conn->sack_high = conn->seq;
+	conn->recover = conn->seq - 1;
+	conn->snd_wnd = tcp_snd_wnd(conn, th);
+
+	if (!conn->wscale_enabled) {
+		conn->rcv_wscale = 0U;
+	}
+
+	tcp_cc_init(conn);
+}
+
+static void tcp_conn_ref(struct tcp *conn)
+{
+	int ref_count = atomic_inc(&conn->ref_count) + 1;
+
+	NET_DBG("conn: %p, ref_count: %d", conn, ref_count);
+}
+
+static struct tcp *tcp_conn_alloc(void)
+{
+	struct tcp *conn = NULL;
+	int ret;
+
+	ret = k_mem_slab_alloc(&tcp_conns_slab, (void **)&conn, K_NO_WAIT);
+	if (ret) {
+		goto out;
+	}
+
+	memset(conn, 0, sizeof(*conn));
+
+	k_mutex_init(&conn->lock);
+
+	conn->state = TCP_LISTEN;
+
+	conn->win = tcp_window;
+
+	sys_slist_init(&conn->send_queue);
+
+	k_delayed_work_init(&conn->send_timer, tcp_send_process);
+
+	sys_slist_init(&conn->send_data);
+	sys_slist_init(&conn->unacked);
+	sys_slist_init(&conn->ooo);
+
+	k_delayed_work_init(&conn->rto_timer, tcp_rto_expired);
+	k_delayed_work_init(&conn->ack_timer, tcp_ack_timeout);
+
+	conn->mss = TCP_MSS_DEFAULT;
+	conn->rto = tcp_rto;
+
+	/* Smallest scale that fits the window in the 16 bit header field */
+	while (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALING) &&
+	       (conn->win >> conn->rcv_wscale) > UINT16_MAX &&
+	       conn->rcv_wscale < TCP_WSCALE_MAX) {
+		conn->rcv_wscale++;
+	}
+
+	tcp_conn_ref(conn);
+
+	sys_slist_append(&tcp_conns, (sys_snode_t *)conn);
+out:
+	NET_DBG("conn: %p", conn);
+
+	return conn;
+}
+
+int net_tcp_get(struct net_context *context)
+{
+	int ret = 0, key = irq_lock();
+	struct tcp *conn;
+
+	conn = tcp_conn_alloc();
+	if (conn == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	/* Mutually link the net_context and tcp connection */
+	conn->context = context;
+	context->tcp = conn;
+out:
+	irq_unlock(key);
+
+	NET_DBG("context: %p (local: %s, remote: %s), conn: %p", context,
+		log_strdup(tcp_endpoint_to_string((void *)&context->local)),
+		log_strdup(tcp_endpoint_to_string((void *)&context->remote)),
+		conn);
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_TEST_PROTOCOL)
+static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
+				int which)
 {
 	union tcp_endpoint *ep_new = tcp_endpoint_new(pkt, which);
 	bool is_equal = memcmp(ep, ep_new, tcp_endpoint_len(ep->sa.sa_family)) ?
@@ -713,6 +1822,7 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	return found ? conn : NULL;
 }
+#endif /* CONFIG_NET_TEST_PROTOCOL */
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
@@ -722,23 +1832,32 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 union net_proto_header *proto,
 				 void *user_data)
 {
-	struct tcp *conn;
+	struct tcp *conn = ((struct net_context *)user_data)->tcp;
 	struct tcphdr *th;
 
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
-	conn = tcp_conn_search(pkt);
-	if (conn) {
-		goto in;
+	if (conn == NULL) {
+		return NET_DROP;
 	}
 
-	th = th_get(pkt);
+	/* The connection handler lookup prefers the handler registered
+	 * for this peer, so only a new peer reaches a listening connection.
+	 */
+	if (conn->state == TCP_LISTEN) {
+		struct tcp *conn_old = conn;
+
+		th = th_get(pkt);
 
-	if (th->th_flags & SYN && !(th->th_flags & ACK)) {
-		struct tcp *conn_old = ((struct net_context *)user_data)->tcp;
+		if (!(th->th_flags & SYN) || (th->th_flags & ACK)) {
+			return NET_DROP;
+		}
 
 		conn = tcp_conn_new(pkt);
+		if (conn == NULL) {
+			return NET_DROP;
+		}
 
 		conn_old->context->remote = conn->dst->sa;
 
@@ -747,10 +1866,8 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				    sizeof(struct sockaddr), 0,
 				    conn_old->context);
 	}
- in:
-	if (conn) {
-		tcp_in(conn, pkt);
-	}
+
+	tcp_in(conn, pkt);
 
 	return NET_DROP;
 }
@@ -833,6 +1950,14 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	conn->ts_ecr = 0U;
+
+	if (tcp_options_len && !tcp_options_parse(conn, th, tcp_options_len)) {
+		NET_DBG("DROP: PAWS");
+		tcp_out(conn, ACK);
+		goto out;
+	}
+
 	if (FL(&fl, &, RST)) {
 		conn_state(conn, TCP_CLOSED);
 	}
@@ -856,6 +1981,7 @@ next_state:
 		if (FL(&fl, &, ACK, th_ack(th) == conn->seq &&
 				th_seq(th) == conn->ack)) {
 			tcp_send_timer_cancel(conn);
+			tcp_conn_established(conn, th);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -873,6 +1999,7 @@ next_state:
 		 */
 		if (FL(&fl, &, ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_conn_established(conn, th);
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -886,6 +2013,9 @@ next_state:
 		}
 		break;
 	case TCP_ESTABLISHED:
+		if (th && (th->th_flags & ACK)) {
+			tcp_ack_process(conn, th, len);
+		}
 		/* full-close */
 		if (th && FL(&fl, ==, (FIN | ACK), th_seq(th) == conn->ack)) {
 			conn_ack(conn, + 1);
@@ -894,21 +2024,22 @@ next_state:
 			break;
 		}
 		if (len) {
-			if (th_seq(th) == conn->ack) {
-				tcp_data_get(conn, pkt);
-				conn_ack(conn, + len);
-				tcp_out(conn, ACK);
-			} else if (th_seq(th) < conn->ack) {
-				tcp_out(conn, ACK); /* peer has resent */
-			}
+			tcp_data_recv(conn, pkt, th, len);
 		}
 		break; /* TODO: Catch all the rest here */
 	case TCP_CLOSE_WAIT:
-		tcp_out(conn, FIN | ACK);
+		/* The data queued so far is still sent as the windows allow,
+		 * and retransmitted from the RTO timer, the FIN after it.
+		 */
+		conn->fin_queued = true;
+		tcp_data_send(conn);
 		next = TCP_LAST_ACK;
 		break;
 	case TCP_LAST_ACK:
-		if (FL(&fl, ==, ACK, th_seq(th) == conn->ack)) {
+		if (th && (th->th_flags & ACK)) {
+			tcp_ack_process(conn, th, len);
+		}
+		if (conn->fin_sent && seq_gt(conn->snd_una, conn->fin_seq)) {
 			tcp_send_timer_cancel(conn);
 			next = TCP_CLOSED;
 		}
@@ -933,7 +2064,7 @@ next_state:
 		next = 0;
 		goto next_state;
 	}
-
+out:
 	k_mutex_unlock(&conn->lock);
 }
 
@@ -945,12 +2076,15 @@ int net_tcp_put(struct net_context *context)
 	NET_DBG("%s", conn ? log_strdup(tcp_conn_state(conn, NULL)) : "");
 
 	if (conn) {
+		/* The connection keeps the stack's reference to the context
+		 * until the FIN has been acknowledged, or it gives up
+		 */
 		conn->state = TCP_CLOSE_WAIT;
 		tcp_in(conn, NULL);
+	} else {
+		net_context_unref(context);
 	}
 
-	net_context_unref(context);
-
 	return 0;
 }
 
@@ -983,15 +2117,39 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 		goto out;
 	}
 
-	tcp_out(conn, PSH | ACK, pkt);
+	if (net_pkt_get_len(pkt) == 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	net_pkt_cursor_init(pkt);
+
+	sys_slist_append(&conn->send_data, &pkt->next);
+	conn->send_data_len += net_pkt_get_len(pkt);
+
+	k_mutex_unlock(&conn->lock);
 out:
 	return ret;
 }
 
-/* net context is about to send out queued data - inform caller only */
+/* net context is about to send out queued data */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
 {
+	struct tcp *conn = context->tcp;
+
+	if (conn) {
+		k_mutex_lock(&conn->lock, K_FOREVER);
+
+		if (conn->state == TCP_ESTABLISHED) {
+			tcp_data_send(conn);
+		}
+
+		k_mutex_unlock(&conn->lock);
+	}
+
 	if (cb) {
 		cb(context, 0, user_data);
 	}
@@ -1205,6 +2363,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 			net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+			!net_pkt_chksum_ok(pkt) &&
 			net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -1268,6 +2427,7 @@ static size_t tp_tcp_recv_cb(struct tcp *conn, struct net_pkt *pkt)
 	net_pkt_pull(up, net_pkt_get_len(up) - len);
 
 	net_tcp_queue_data(conn->context, up);
+	net_tcp_send_data(conn->context, NULL, NULL);
 
 	return len;
 }
@@ -1415,6 +2575,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				net_pkt_write(data_pkt, buf, len);
 				net_pkt_cursor_init(data_pkt);
 				net_tcp_queue_data(conn->context, data_pkt);
+				net_tcp_send_data(conn->context, NULL, NULL);
 			}
 		}
 		break;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control. All windows are in bytes. Fast recovery window
+ * inflation and deflation is done by the caller, the functions here only
+ * decide how the window grows and how much it is reduced on loss.
+ */
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+
+/* RFC 8312 constants, C = 0.4 and beta = 0.7 */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+#define CUBIC_D_MAX_MS 100000
+
+/* Integer cube root, Hacker's Delight 9-3 */
+static u32_t cubic_root(u64_t x)
+{
+	u64_t y = 0U, b;
+	int s;
+
+	for (s = 63; s >= 0; s -= 3) {
+		y += y;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (u32_t)y;
+}
+
+static void cubic_epoch_start(struct tcp *conn)
+{
+	conn->cubic_epoch = k_uptime_get_32() | 1;
+
+	if (conn->cwnd < conn->cubic_w_max) {
+		/* K = cbrt((W_max - cwnd) / C) in ms, windows in segments */
+		conn->cubic_k = cubic_root((u64_t)(conn->cubic_w_max -
+						    conn->cwnd) *
+					   2500000000ULL / conn->mss);
+		conn->cubic_origin = conn->cubic_w_max;
+	} else {
+		conn->cubic_k = 0U;
+		conn->cubic_origin = conn->cwnd;
+	}
+
+	conn->cubic_w_est = conn->cwnd;
+}
+
+static void cubic_ack(struct tcp *conn, u32_t acked)
+{
+	s64_t d, target;
+	u32_t t;
+
+	if (conn->cubic_epoch == 0U) {
+		cubic_epoch_start(conn);
+	}
+
+	/* W_cubic(t + RTT) */
+	t = k_uptime_get_32() - conn->cubic_epoch + (conn->srtt >> 3);
+	d = (s64_t)t - conn->cubic_k;
+	d = MAX(MIN(d, CUBIC_D_MAX_MS), -CUBIC_D_MAX_MS);
+	target = conn->cubic_origin +
+		(d * d / 1000 * d / 1000) * 4 * conn->mss / 10000;
+
+	/* TCP friendly region: track the window standard TCP would have */
+	conn->cubic_w_est += (u64_t)acked * conn->mss * 9 /
+		(17 * (u64_t)conn->cwnd);
+	if (target < conn->cubic_w_est) {
+		target = conn->cubic_w_est;
+	}
+
+	target = MIN(target, (s64_t)conn->cwnd * 3 / 2);
+
+	if (target > conn->cwnd) {
+		conn->cwnd += MAX((target - conn->cwnd) * acked / conn->cwnd,
+				  1);
+	} else {
+		conn->cwnd += MAX((u64_t)acked * conn->mss /
+				  (100 * (u64_t)conn->cwnd), 1);
+	}
+}
+
+static void cubic_loss(struct tcp *conn)
+{
+	/* Fast convergence: release bandwidth if the window keeps
+	 * shrinking
+	 */
+	if (conn->cwnd < conn->cubic_w_max) {
+		conn->cubic_w_max = conn->cwnd *
+			(CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			(2 * CUBIC_BETA_DEN);
+	} else {
+		conn->cubic_w_max = conn->cwnd;
+	}
+
+	conn->cubic_epoch = 0U;
+	conn->ssthresh = MAX(conn->cwnd / CUBIC_BETA_DEN * CUBIC_BETA_NUM,
+			     2U * conn->mss);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+void tcp_cc_init(struct tcp *conn)
+{
+	/* RFC 5681 initial window */
+	conn->cwnd = MIN(4U * conn->mss, MAX(2U * conn->mss, 4380U));
+	conn->ssthresh = TCP_CWND_MAX;
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	conn->cubic_epoch = 0U;
+	conn->cubic_w_max = 0U;
+#endif
+}
+
+void tcp_cc_ack(struct tcp *conn, u32_t acked)
+{
+	if (conn->cwnd < conn->ssthresh) {
+		/* Slow start, with appropriate byte counting (L = 1) */
+		conn->cwnd += MIN(acked, conn->mss);
+	} else {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		cubic_ack(conn, acked);
+#else
+		conn->cwnd += MAX(conn->mss * conn->mss / conn->cwnd, 1U);
+#endif
+	}
+
+	conn->cwnd = MIN(conn->cwnd, TCP_CWND_MAX);
+}
+
+void tcp_cc_loss(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	cubic_loss(conn);
+#else
+	conn->ssthresh = MAX(conn_flight(conn) / 2, 2U * conn->mss);
+#endif
+}
+
+void tcp_cc_timeout(struct tcp *conn)
+{
+	if (conn_flight(conn) > 0) {
+		tcp_cc_loss(conn);
+	}
+
+	conn->cwnd = conn->mss;
+}
@@ -54,6 +54,8 @@
 #define conn_ack(_conn, _req) (_conn)->ack += (_req)
 #endif
 
+#define conn_flight(_conn) ((_conn)->seq - (_conn)->snd_una)
+
 #define conn_state(_conn, _s)						\
 ({									\
 	NET_DBG("%s->%s",						\
@@ -66,6 +68,26 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+#define TCPOPT_TIMESTAMP	8
+
+#define TCP_OPTIONS_MAX	40
+#define TCP_SACK_BLOCKS_MAX	3
+#define TCP_TS_OPT_LEN	12	/* NOP, NOP, kind, length, TSval, TSecr */
+#define TCP_WSCALE_MAX	14
+
+#define TCP_MSS_DEFAULT	536
+#define TCP_DUPACK_THRESHOLD	3
+#define TCP_RTO_MIN	200
+#define TCP_RTO_MAX	60000
+#define TCP_CWND_MAX	(1U << 30)
+
+/* Sequence number comparisons modulo 2^32 */
+#define seq_lt(_a, _b) ((s32_t)((_a) - (_b)) < 0)
+#define seq_leq(_a, _b) ((s32_t)((_a) - (_b)) <= 0)
+#define seq_gt(_a, _b) seq_lt(_b, _a)
+#define seq_geq(_a, _b) seq_leq(_b, _a)
 
 enum pkt_addr {
 	SRC = 1,
@@ -120,6 +142,22 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	u32_t left;
+	u32_t right;
+};
+
+struct tcp_seg { /* Segment in the retransmission or out of order queue */
+	sys_snode_t next;
+	struct net_pkt *pkt;
+	u32_t seq;
+	u32_t sent;	/* k_uptime_get_32() of the last transmission */
+	u16_t len;
+	u8_t retransmitted : 1;
+	u8_t sacked : 1;
+	u8_t recovery_rexmit : 1; /* resent during the current recovery */
+};
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -130,7 +168,7 @@ struct tcp { /* TCP connection */
 	u32_t ack;
 	union tcp_endpoint *src;
 	union tcp_endpoint *dst;
-	u16_t win;
+	u32_t win;
 	struct k_delayed_work send_timer;
 	sys_slist_t send_queue;
 	bool in_retransmission;
@@ -138,8 +176,56 @@ struct tcp { /* TCP connection */
 	struct net_if *iface;
 	net_tcp_accept_cb_t accept_cb;
 	atomic_t ref_count;
+	/* Sender */
+	sys_slist_t send_data;	/* data not sent yet */
+	u32_t send_data_len;
+	sys_slist_t unacked;	/* struct tcp_seg, sent and not acked */
+	struct k_delayed_work rto_timer;
+	u32_t snd_una;
+	u32_t snd_wnd;
+	u32_t sack_high;	/* highest sequence SACKed by the peer */
+	u32_t recover;
+	u32_t cwnd;
+	u32_t ssthresh;
+	u32_t srtt;		/* ms, scaled by 8 */
+	u32_t rttvar;		/* ms, scaled by 4 */
+	u32_t rto;		/* ms */
+	u16_t mss;
+	u8_t dup_acks;
+	u8_t rto_retries;
+	bool in_recovery;
+	bool fin_queued;	/* close() called, FIN follows the data */
+	bool fin_sent;
+	u32_t fin_seq;
+	bool sack_enabled;
+	bool wscale_enabled;
+	bool ts_enabled;
+	u8_t snd_wscale;	/* peer's window scale */
+	u8_t rcv_wscale;	/* our window scale */
+	u32_t ts_recent;	/* latest TSval to echo */
+	u32_t ts_ecr;		/* TSecr of the segment being processed */
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	u32_t cubic_epoch;
+	u32_t cubic_k;		/* ms */
+	u32_t cubic_w_max;
+	u32_t cubic_origin;
+	u32_t cubic_w_est;
+#endif
+	/* Receiver */
+	sys_slist_t ooo;	/* struct tcp_seg, sorted by sequence */
+	u32_t ooo_last;		/* last out of order sequence received */
+	u8_t ooo_cnt;
+	u8_t ack_pending;	/* in order segments not acknowledged yet */
+	u32_t ack_pending_len;	/* and their length */
+	struct k_delayed_work ack_timer;
 };
 
+/* Congestion control, see tcp2_cc.c */
+void tcp_cc_init(struct tcp *conn);
+void tcp_cc_ack(struct tcp *conn, u32_t acked);
+void tcp_cc_loss(struct tcp *conn);
+void tcp_cc_timeout(struct tcp *conn);
+
 #define _flags(_fl, _op, _mask, _cond)					\
 ({									\
 	bool result = false;						\
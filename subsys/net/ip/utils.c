@@ -489,37 +489,104 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
+static inline u16_t chksum_add(u16_t sum, u16_t value)
+{
+	u32_t tmp = (u32_t)sum + value;
+
+	return (tmp & 0xffff) + (tmp >> 16);
+}
+
+/* The sum of data starting at an odd offset has the bytes swapped */
+static inline u16_t chksum_swap(u16_t sum)
 {
-	const u8_t *end;
-	u16_t tmp;
+	return (sum << 8) | (sum >> 8);
+}
+
+/* Sum up the data in 16 bit words, the first byte being the most
+ * significant one of the first word, and copy it to dst if it is not
+ * NULL. The words are added 32 bits at a time in host byte order to a 64
+ * bit accumulator, which is folded only at the end.
+ */
+static ALWAYS_INLINE u16_t chksum_words(u16_t sum, u8_t *dst,
+					const u8_t *data, size_t len)
+{
+	u64_t acc = 0U;
+	u32_t w[8];
+	u16_t half;
+
+	while (len >= sizeof(w)) {
+		memcpy(w, data, sizeof(w));
+		if (dst) {
+			memcpy(dst, w, sizeof(w));
+			dst += sizeof(w);
+		}
 
-	end = data + len - 1;
+		acc += (u64_t)w[0] + w[1] + w[2] + w[3] +
+			w[4] + w[5] + w[6] + w[7];
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
+		data += sizeof(w);
+		len -= sizeof(w);
+	}
+
+	while (len >= sizeof(w[0])) {
+		memcpy(w, data, sizeof(w[0]));
+		if (dst) {
+			memcpy(dst, w, sizeof(w[0]));
+			dst += sizeof(w[0]);
+		}
+
+		acc += w[0];
+
+		data += sizeof(w[0]);
+		len -= sizeof(w[0]);
+	}
+
+	if (len >= sizeof(half)) {
+		memcpy(&half, data, sizeof(half));
+		if (dst) {
+			memcpy(dst, &half, sizeof(half));
+			dst += sizeof(half);
 		}
 
-		data += 2;
+		acc += half;
+
+		data += sizeof(half);
+		len -= sizeof(half);
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
+	if (len) {
+		if (dst) {
+			*dst = *data;
 		}
+
+		/* Padded with a zero byte */
+		acc += ntohs(*data << 8);
 	}
 
-	return sum;
+	while (acc >> 16) {
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return chksum_add(sum, ntohs((u16_t)acc));
+}
+
+static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
+{
+	return chksum_words(sum, NULL, data, len);
 }
 
-static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
+u16_t net_calc_chksum_copy(u16_t sum, void *dst, const void *src, size_t len)
+{
+	return chksum_words(sum, dst, src, len);
+}
+
+/* Sum up len bytes from the cursor on, or up to the end of the packet */
+static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum,
+				    size_t left)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
+	bool odd = false;
+	u16_t frag_sum;
 	size_t len;
 
 	if (!cur->buf || !cur->pos) {
@@ -528,8 +595,14 @@ static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
 
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
-	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+	while (cur->buf && left) {
+		len = MIN(len, left);
+
+		frag_sum = calc_chksum(0U, cur->pos, len);
+		sum = chksum_add(sum, odd ? chksum_swap(frag_sum) : frag_sum);
+
+		odd ^= len & 1U;
+		left -= len;
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -537,18 +610,7 @@ static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
 		}
 
 		cur->pos = cur->buf->data;
-
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
-		}
+		len = cur->buf->len;
 	}
 
 	return sum;
@@ -556,25 +618,27 @@ static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
 
 u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 {
-	size_t len = 0U;
+	size_t len = 0U, data_len;
 	u16_t sum = 0U;
 	struct net_pkt_cursor backup;
 	bool ow;
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
+		data_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+			net_pkt_ipv4_opts_len(pkt);
+
 		if (proto != IPPROTO_ICMP) {
 			len = 2 * sizeof(struct in_addr);
-			sum = net_pkt_get_len(pkt) -
-				net_pkt_ip_hdr_len(pkt) -
-				net_pkt_ipv4_opts_len(pkt) + proto;
+			sum = data_len + proto;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		   net_pkt_family(pkt) == AF_INET6) {
+		data_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+			net_pkt_ipv6_ext_len(pkt);
+
 		len = 2 * sizeof(struct in6_addr);
-		sum =  net_pkt_get_len(pkt) -
-			net_pkt_ip_hdr_len(pkt) -
-			net_pkt_ipv6_ext_len(pkt) + proto;
+		sum = data_len + proto;
 	} else {
 		NET_DBG("Unknown protocol family %d", net_pkt_family(pkt));
 		return 0;
@@ -591,7 +655,15 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	/* The data summed up when it was written is not read again */
+	if (net_pkt_data_chksum_len(pkt) <= data_len) {
+		data_len -= net_pkt_data_chksum_len(pkt);
+		sum = chksum_add(sum, (data_len & 1U) ?
+				 chksum_swap(net_pkt_data_chksum(pkt)) :
+				 net_pkt_data_chksum(pkt));
+	}
+
+	sum = pkt_calc_chksum(pkt, sum, data_len);
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
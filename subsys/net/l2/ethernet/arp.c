@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #include "arp.h"
 #include "net_private.h"
+#include "route.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT (2 * MSEC_PER_SEC)
@@ -30,6 +31,15 @@ static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
 static sys_slist_t arp_table;
 
+/* The entries of arp_table indexed by their IP address */
+NET_NBR_HASH_DEFINE(arp_hash, sizeof(struct in_addr));
+
+/* Serializes the changes to the ARP table. The lookups of resolved
+ * addresses go through arp_hash and do not take it, they copy the
+ * hardware address instead, see arp_entry_lookup().
+ */
+static K_MUTEX_DEFINE(arp_mutex);
+
 struct k_delayed_work arp_request_timer;
 
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
@@ -74,28 +84,80 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
-static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
-							  struct in_addr *dst)
+struct arp_entry_match_data {
+	struct net_if *iface;
+	struct net_eth_addr eth;
+};
+
+/* Called inside the read section of the lookup */
+static bool arp_entry_match(struct net_nbr_hash_node *node, void *user_data)
 {
-	sys_snode_t *prev = NULL;
-	struct arp_entry *entry;
+	struct arp_entry *entry = CONTAINER_OF(node, struct arp_entry,
+					       hash_node);
+	struct arp_entry_match_data *data = user_data;
+
+	if (entry->iface != data->iface) {
+		return false;
+	}
+
+	memcpy(&data->eth, &entry->eth, sizeof(data->eth));
+
+	return true;
+}
+
+/* The entry can only be used with arp_mutex held */
+static struct arp_entry *arp_entry_find_table(struct net_if *iface,
+					      struct in_addr *dst)
+{
+	struct arp_entry_match_data data = { .iface = iface };
+	struct net_nbr_hash_node *node;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
-	if (entry) {
-		/* Let's assume the target is going to be accessed
-		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
-		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
-		}
+	node = net_nbr_hash_lookup(&arp_hash, dst, arp_entry_match, &data);
+	if (!node) {
+		return NULL;
 	}
 
-	return entry;
+	return CONTAINER_OF(node, struct arp_entry, hash_node);
+}
+
+/* Lockless lookup of the hardware address of dst. The entry may be
+ * replaced as soon as the lookup is done, so only a copy is returned.
+ */
+static bool arp_entry_lookup(struct net_if *iface, struct in_addr *dst,
+			     struct net_eth_addr *eth)
+{
+	struct arp_entry_match_data data = { .iface = iface };
+
+	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
+
+	if (!net_nbr_hash_lookup(&arp_hash, dst, arp_entry_match, &data)) {
+		return false;
+	}
+
+	memcpy(eth, &data.eth, sizeof(*eth));
+
+	return true;
+}
+
+/* Change the hardware address of an entry of the table, with arp_mutex
+ * held.
+ */
+static void arp_entry_set_eth(struct arp_entry *entry,
+			      struct net_eth_addr *hwaddr)
+{
+	k_spinlock_key_t key = net_nbr_hash_update_begin(&arp_hash);
+
+	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+
+	net_nbr_hash_update_end(&arp_hash, key);
+}
+
+static void arp_entry_add_to_table(struct arp_entry *entry)
+{
+	sys_slist_prepend(&arp_table, &entry->node);
+	net_nbr_hash_add(&arp_hash, &entry->hash_node, &entry->ip);
 }
 
 static inline
@@ -145,20 +207,23 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct net_nbr_hash_node *node;
+	struct arp_entry *entry;
 
-	/* We assume last entry is the oldest one,
-	 * so is the preferred one to be taken out.
+	/* The entry that was not looked up for the longest time
+	 * is the preferred one to be taken out.
 	 */
-
-	node = sys_slist_peek_tail(&arp_table);
+	node = net_nbr_hash_lru(&arp_hash);
 	if (!node) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	entry = CONTAINER_OF(node, struct arp_entry, hash_node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	net_nbr_hash_del(&arp_hash, node);
+	sys_slist_find_and_remove(&arp_table, &entry->node);
+
+	return entry;
 }
 
 
@@ -184,6 +249,8 @@ static void arp_request_timeout(struct k_work *work)
 
 	ARG_UNUSED(work);
 
+	k_mutex_lock(&arp_mutex, K_FOREVER);
+
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
 		if ((s32_t)(entry->req_start +
@@ -204,6 +271,8 @@ static void arp_request_timeout(struct k_work *work)
 				      K_MSEC(entry->req_start +
 					     ARP_REQUEST_TIMEOUT - current));
 	}
+
+	k_mutex_unlock(&arp_mutex);
 }
 
 static inline struct in_addr *if_get_addr(struct net_if *iface,
@@ -313,25 +382,65 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	return pkt;
 }
 
+static struct net_pkt *arp_request(struct net_pkt *pkt,
+				   struct in_addr *addr,
+				   struct in_addr *current_ip)
+{
+	struct arp_entry *entry;
+	struct net_pkt *req;
+
+	entry = arp_entry_find_pending(net_pkt_iface(pkt), addr);
+	if (!entry) {
+		/* No pending, let's try to get a new entry */
+		entry = arp_entry_get_free();
+		if (!entry) {
+			/* Then let's take one from table? */
+			entry = arp_entry_get_last_from_table();
+		}
+	} else {
+		/* There is a pending already */
+		entry = NULL;
+	}
+
+	req = arp_prepare(net_pkt_iface(pkt), addr, entry, pkt, current_ip);
+
+	if (!entry) {
+		/* We cannot send the packet, the ARP cache is full
+		 * or there is already a pending query to this IP
+		 * address, so this packet must be discarded.
+		 */
+		NET_DBG("Resending ARP %p", req);
+	}
+
+	return req;
+}
+
 struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				struct in_addr *request_ip,
 				struct in_addr *current_ip)
 {
 	struct arp_entry *entry;
+	struct net_eth_addr *eth;
 	struct in_addr *addr;
 
 	if (!pkt || !pkt->buffer) {
 		return NULL;
 	}
 
+	eth = (struct net_eth_addr *)pkt->arp_lladdr;
+
 	/* Is the destination in the local network, if not route via
-	 * the gateway address.
+	 * the gateway of the route to it or the default gateway.
 	 */
 	if (!current_ip &&
 	    !net_if_ipv4_addr_mask_cmp(net_pkt_iface(pkt), request_ip)) {
 		struct net_if_ipv4 *ipv4 = net_pkt_iface(pkt)->config.ip.ipv4;
+		struct net_route_entry_ipv4 *route;
 
-		if (ipv4) {
+		route = net_route_ipv4_lookup(net_pkt_iface(pkt), request_ip);
+		if (route) {
+			addr = &route->gw;
+		} else if (ipv4) {
 			addr = &ipv4->gw;
 			if (net_ipv4_is_addr_unspecified(addr)) {
 				NET_ERR("Gateway not set for iface %p",
@@ -347,44 +456,34 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	}
 
 	/* If the destination address is already known, we do not need
-	 * to send any ARP packet.
+	 * to send any ARP packet. The packet gets its own copy of the
+	 * address, the entry can be replaced before the packet is sent.
 	 */
-	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
-	if (!entry) {
+	if (!arp_entry_lookup(net_pkt_iface(pkt), addr, eth)) {
 		struct net_pkt *req;
 
-		entry = arp_entry_find_pending(net_pkt_iface(pkt), addr);
-		if (!entry) {
-			/* No pending, let's try to get a new entry */
-			entry = arp_entry_get_free();
-			if (!entry) {
-				/* Then let's take one from table? */
-				entry = arp_entry_get_last_from_table();
-			}
-		} else {
-			/* There is a pending already */
-			entry = NULL;
-		}
-
-		req = arp_prepare(net_pkt_iface(pkt), addr, entry, pkt,
-				  current_ip);
+		k_mutex_lock(&arp_mutex, K_FOREVER);
 
+		/* The reply might have been received meanwhile */
+		entry = arp_entry_find_table(net_pkt_iface(pkt), addr);
 		if (!entry) {
-			/* We cannot send the packet, the ARP cache is full
-			 * or there is already a pending query to this IP
-			 * address, so this packet must be discarded.
-			 */
-			NET_DBG("Resending ARP %p", req);
+			req = arp_request(pkt, addr, current_ip);
+			k_mutex_unlock(&arp_mutex);
+
+			return req;
 		}
 
-		return req;
+		memcpy(eth, &entry->eth, sizeof(*eth));
+
+		k_mutex_unlock(&arp_mutex);
 	}
 
+	/* The entry found is on the interface of the packet */
 	net_pkt_lladdr_src(pkt)->addr =
-		(u8_t *)net_if_get_link_addr(entry->iface)->addr;
+		(u8_t *)net_if_get_link_addr(net_pkt_iface(pkt))->addr;
 	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
 
-	net_pkt_lladdr_dst(pkt)->addr = (u8_t *)&entry->eth;
+	net_pkt_lladdr_dst(pkt)->addr = (u8_t *)eth;
 	net_pkt_lladdr_dst(pkt)->len = sizeof(struct net_eth_addr);
 
 	NET_DBG("ARP using ll %s for IP %s",
@@ -399,10 +498,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find_table(iface, src);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -412,7 +510,7 @@ static void arp_gratuitous(struct net_if *iface,
 					   (const u8_t *)hwaddr,
 					   sizeof(struct net_eth_addr))));
 
-		memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+		arp_entry_set_eth(entry, hwaddr);
 	}
 }
 
@@ -427,6 +525,8 @@ static void arp_update(struct net_if *iface,
 
 	NET_DBG("src %s", log_strdup(net_sprint_ipv4_addr(src)));
 
+	k_mutex_lock(&arp_mutex, K_FOREVER);
+
 	entry = arp_entry_get_pending(iface, src);
 	if (!entry) {
 		if (IS_ENABLED(CONFIG_NET_ARP_GRATUITOUS) && gratuitous) {
@@ -434,13 +534,11 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_entry_find_table(iface, src);
 			if (entry) {
-				memcpy(&entry->eth, hwaddr,
-				       sizeof(struct net_eth_addr));
+				arp_entry_set_eth(entry, hwaddr);
 			} else {
 				/* Add new entry as it was not found and force
 				 * was set.
@@ -456,11 +554,13 @@ static void arp_update(struct net_if *iface,
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					arp_entry_add_to_table(entry);
 				}
 			}
 		}
 
+		k_mutex_unlock(&arp_mutex);
+
 		return;
 	}
 
@@ -479,7 +579,9 @@ static void arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_entry_add_to_table(entry);
+
+	k_mutex_unlock(&arp_mutex);
 
 	net_if_queue_tx(iface, pkt);
 }
@@ -674,12 +776,15 @@ void net_arp_clear_cache(struct net_if *iface)
 
 	NET_DBG("Flushing ARP table");
 
+	k_mutex_lock(&arp_mutex, K_FOREVER);
+
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
 		if (iface && iface != entry->iface) {
 			prev = &entry->node;
 			continue;
 		}
 
+		net_nbr_hash_del(&arp_hash, &entry->hash_node);
 		arp_entry_cleanup(entry, false);
 
 		sys_slist_remove(&arp_table, prev, &entry->node);
@@ -706,6 +811,8 @@ void net_arp_clear_cache(struct net_if *iface)
 	if (sys_slist_is_empty(&arp_pending_entries)) {
 		k_delayed_work_cancel(&arp_request_timer);
 	}
+
+	k_mutex_unlock(&arp_mutex);
 }
 
 int net_arp_foreach(net_arp_cb_t cb, void *user_data)
@@ -713,11 +820,15 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 	int ret = 0;
 	struct arp_entry *entry;
 
+	k_mutex_lock(&arp_mutex, K_FOREVER);
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
 		ret++;
 		cb(entry, user_data);
 	}
 
+	k_mutex_unlock(&arp_mutex);
+
 	return ret;
 }
 
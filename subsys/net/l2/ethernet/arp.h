@@ -12,6 +12,8 @@
 #include <sys/slist.h>
 #include <net/ethernet.h>
 
+#include "nbr_hash.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -51,6 +53,7 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 struct arp_entry {
 	sys_snode_t node;
+	struct net_nbr_hash_node hash_node;
 	u32_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
@@ -20,6 +20,7 @@ LOG_MODULE_REGISTER(net_coap, CONFIG_COAP_LOG_LEVEL);
 
 #include <net/net_ip.h>
 #include <net/net_core.h>
+#include <net/buf.h>
 #include <net/coap.h>
 
 /* Values as per RFC 7252, section-3.1.
@@ -50,6 +51,117 @@ LOG_MODULE_REGISTER(net_coap, CONFIG_COAP_LOG_LEVEL);
 /* The CoAP message ID that is incremented each time coap_next_id() is called. */
 static u16_t message_id;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static void option_index_reset(struct coap_packet *cpkt)
+{
+	cpkt->opt_count = 0U;
+	cpkt->opt_indexed = true;
+}
+
+static void option_index_drop(struct coap_packet *cpkt)
+{
+	cpkt->opt_indexed = false;
+}
+
+static void option_index_add(struct coap_packet *cpkt, u16_t code,
+			     u16_t offset, u16_t len)
+{
+	struct coap_option_ref *ref;
+
+	if (!cpkt->opt_indexed) {
+		return;
+	}
+
+	/* The options of the packet are then found by decoding it */
+	if (cpkt->opt_count == ARRAY_SIZE(cpkt->opt_index)) {
+		cpkt->opt_indexed = false;
+		return;
+	}
+
+	ref = &cpkt->opt_index[cpkt->opt_count++];
+	ref->code = code;
+	ref->offset = offset;
+	ref->len = len;
+}
+
+static void option_index_move(struct coap_packet *cpkt, int diff)
+{
+	u8_t i;
+
+	for (i = 0U; i < cpkt->opt_count; i++) {
+		cpkt->opt_index[i].offset += diff;
+	}
+}
+
+static int option_index_find(const struct coap_packet *cpkt, u16_t code,
+			     struct coap_option *options, u16_t veclen)
+{
+	const struct coap_option_ref *ref;
+	u16_t num = 0U;
+	u8_t i;
+
+	for (i = 0U; i < cpkt->opt_count && num < veclen; i++) {
+		ref = &cpkt->opt_index[i];
+
+		/* Options are in the ascending order of their numbers */
+		if (ref->code > code) {
+			break;
+		}
+
+		if (ref->code != code) {
+			continue;
+		}
+
+		if (ref->len > sizeof(options[num].value)) {
+			NET_ERR("%u is > sizeof(coap_option->value)(%zu)!",
+				ref->len, sizeof(options[num].value));
+			return -EINVAL;
+		}
+
+		options[num].delta = code;
+		options[num].len = ref->len;
+		memcpy(options[num].value, cpkt->data + ref->offset, ref->len);
+		num++;
+	}
+
+	return num;
+}
+
+static inline bool option_index_valid(const struct coap_packet *cpkt)
+{
+	return cpkt->opt_indexed;
+}
+#else
+static inline void option_index_reset(struct coap_packet *cpkt)
+{
+}
+
+static inline void option_index_drop(struct coap_packet *cpkt)
+{
+}
+
+static inline void option_index_add(struct coap_packet *cpkt, u16_t code,
+				    u16_t offset, u16_t len)
+{
+}
+
+static inline void option_index_move(struct coap_packet *cpkt, int diff)
+{
+}
+
+static inline int option_index_find(const struct coap_packet *cpkt,
+				    u16_t code, struct coap_option *options,
+				    u16_t veclen)
+{
+	return -ENOTSUP;
+}
+
+static inline bool option_index_valid(const struct coap_packet *cpkt)
+{
+	return false;
+}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 static inline bool append_u8(struct coap_packet *cpkt, u8_t data)
 {
 	if (!cpkt) {
@@ -115,6 +227,8 @@ int coap_packet_init(struct coap_packet *cpkt, u8_t *data,
 	cpkt->max_len = max_len;
 	cpkt->delta = 0U;
 
+	option_index_reset(cpkt);
+
 	hdr = (ver & 0x3) << 6;
 	hdr |= (type & 0x3) << 4;
 	hdr |= tokenlen & 0xF;
@@ -268,6 +382,8 @@ int coap_packet_append_option(struct coap_packet *cpkt, u16_t code,
 	cpkt->opt_len += r;
 	cpkt->delta += code;
 
+	option_index_add(cpkt, cpkt->delta, cpkt->offset - len, len);
+
 	return 0;
 }
 
@@ -330,6 +446,30 @@ int coap_packet_append_payload(struct coap_packet *cpkt, u8_t *payload,
 	return append(cpkt, payload, payload_len) ? 0 : -EINVAL;
 }
 
+int coap_packet_buf_commit(struct coap_packet *cpkt, struct net_buf *buf,
+			   struct net_buf *payload)
+{
+	if (!cpkt || !buf || cpkt->data != net_buf_tail(buf)) {
+		return -EINVAL;
+	}
+
+	/* Nothing was added to the packet after its options */
+	if (payload && net_buf_frags_len(payload) &&
+	    cpkt->offset == cpkt->hdr_len + cpkt->opt_len) {
+		if (!append_u8(cpkt, COAP_MARKER)) {
+			return -EINVAL;
+		}
+	}
+
+	net_buf_add(buf, cpkt->offset);
+
+	if (payload) {
+		net_buf_frag_add(buf, payload);
+	}
+
+	return 0;
+}
+
 u8_t *coap_next_token(void)
 {
 	static u32_t rand[2];
@@ -429,7 +569,7 @@ static int decode_delta(u8_t *data, u16_t offset, u16_t *pos, u16_t max_len,
 
 static int parse_option(u8_t *data, u16_t offset, u16_t *pos,
 			u16_t max_len, u16_t *opt_delta, u16_t *opt_len,
-			struct coap_option *option)
+			struct coap_option *option, u16_t *value_len)
 {
 	u16_t hdr_len;
 	u16_t delta;
@@ -486,6 +626,10 @@ static int parse_option(u8_t *data, u16_t offset, u16_t *pos,
 	*opt_delta += delta;
 	*opt_len += len;
 
+	if (value_len) {
+		*value_len = len;
+	}
+
 	if (r == 0) {
 		if (len == 0U) {
 			return r;
@@ -555,6 +699,8 @@ int coap_packet_parse(struct coap_packet *cpkt, u8_t *data, u16_t len,
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
 
+	option_index_reset(cpkt);
+
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
 	if (tkl > 8) {
@@ -578,13 +724,23 @@ int coap_packet_parse(struct coap_packet *cpkt, u8_t *data, u16_t len,
 
 	while (1) {
 		struct coap_option *option;
+		u16_t start = offset;
+		u16_t value_len = 0U;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
-				   &delta, &opt_len, option);
+				   &delta, &opt_len, option, &value_len);
 		if (ret < 0) {
+			option_index_drop(cpkt);
 			return ret;
-		} else if (ret == 0) {
+		}
+
+		if (cpkt->data[start] != COAP_MARKER) {
+			option_index_add(cpkt, delta, offset - value_len,
+					 value_len);
+		}
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -605,6 +761,10 @@ int coap_find_options(const struct coap_packet *cpkt, u16_t code,
 	u8_t num;
 	int r;
 
+	if (option_index_valid(cpkt)) {
+		return option_index_find(cpkt, code, options, veclen);
+	}
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
@@ -613,7 +773,7 @@ int coap_find_options(const struct coap_packet *cpkt, u16_t code,
 	while (delta <= code && num < veclen) {
 		r = parse_option(cpkt->data, offset, &offset,
 				 cpkt->max_len, &delta, &opt_len,
-				 &options[num]);
+				 &options[num], NULL);
 		if (r < 0) {
 			return -EINVAL;
 		}
@@ -1315,6 +1475,73 @@ int coap_resource_notify(struct coap_resource *resource)
 	return 0;
 }
 
+/* Give its token to a notification already built, moving the options and
+ * the payload when the length of the token changes.
+ */
+static int packet_set_token(struct coap_packet *cpkt, const u8_t *token,
+			    u8_t tkl)
+{
+	u8_t old_tkl = cpkt->data[0] & 0x0f;
+	int diff = (int)tkl - (int)old_tkl;
+
+	if (tkl > 8 || old_tkl > 8) {
+		return -EINVAL;
+	}
+
+	if (diff) {
+		if (cpkt->offset + diff > cpkt->max_len) {
+			return -ENOMEM;
+		}
+
+		memmove(cpkt->data + BASIC_HEADER_SIZE + tkl,
+			cpkt->data + BASIC_HEADER_SIZE + old_tkl,
+			cpkt->offset - BASIC_HEADER_SIZE - old_tkl);
+
+		cpkt->offset += diff;
+		cpkt->hdr_len += diff;
+		option_index_move(cpkt, diff);
+	}
+
+	cpkt->data[0] = (cpkt->data[0] & 0xf0) | tkl;
+	memcpy(cpkt->data + BASIC_HEADER_SIZE, token, tkl);
+
+	return 0;
+}
+
+int coap_resource_notify_packet(struct coap_resource *resource,
+				struct coap_packet *cpkt,
+				coap_observer_send_t send, void *user_data)
+{
+	struct coap_observer *o, *next;
+	int r;
+
+	if (!resource || !cpkt || !cpkt->data || !send) {
+		return -EINVAL;
+	}
+
+	if (cpkt->offset < BASIC_HEADER_SIZE) {
+		return -EINVAL;
+	}
+
+	/* The observer can be removed by the callback */
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&resource->observers, o, next,
+					  list) {
+		r = packet_set_token(cpkt, o->token, o->tkl);
+		if (r < 0) {
+			return r;
+		}
+
+		sys_put_be16(coap_next_id(), &cpkt->data[2]);
+
+		r = send(resource, o, cpkt, user_data);
+		if (r < 0) {
+			NET_DBG("Cannot notify observer %p (%d)", o, r);
+		}
+	}
+
+	return 0;
+}
+
 bool coap_request_is_observe(const struct coap_packet *request)
 {
 	return get_observe_option(request) == 0;
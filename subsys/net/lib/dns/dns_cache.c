@@ -0,0 +1,214 @@
+/** @file
+ * @brief DNS resolver cache
+ *
+ * Names resolved by the DNS servers are kept for the time to live of the
+ * answers, and names that did not resolve for a configured time, so that
+ * connecting again to the same host does not wait for the DNS server.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "dns_cache.h"
+
+/* Longer names are resolved by the DNS servers every time */
+#define DNS_CACHE_NAME_LEN 64
+
+struct dns_cache_entry {
+	/** Name that was queried */
+	char query[DNS_CACHE_NAME_LEN];
+
+	/** Addresses the name resolved to */
+	struct dns_addrinfo info[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+
+	/** Uptime when the entry expires */
+	s64_t expiry;
+
+	/** Uptime of the last query answered by the entry */
+	u32_t last_used;
+
+	/** Number of addresses, 0 if the name did not resolve */
+	u8_t count;
+
+	/** Type of the query, enum dns_query_type */
+	u8_t type;
+
+	bool is_used;
+};
+
+static struct dns_cache_entry dns_cache[CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES];
+
+/* The answers are added from the network receive thread */
+static K_MUTEX_DEFINE(dns_cache_lock);
+
+/* Must be called with dns_cache_lock held */
+static struct dns_cache_entry *cache_find(const char *query,
+					  enum dns_query_type type,
+					  s64_t now)
+{
+	struct dns_cache_entry *entry;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		entry = &dns_cache[i];
+
+		if (!entry->is_used) {
+			continue;
+		}
+
+		if (entry->expiry <= now) {
+			entry->is_used = false;
+			continue;
+		}
+
+		if (entry->type == type && !strcmp(entry->query, query)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be called with dns_cache_lock held */
+static struct dns_cache_entry *cache_get_free(u32_t now)
+{
+	struct dns_cache_entry *entry, *oldest = NULL;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		entry = &dns_cache[i];
+
+		if (!entry->is_used) {
+			return entry;
+		}
+
+		if (!oldest ||
+		    now - entry->last_used > now - oldest->last_used) {
+			oldest = entry;
+		}
+	}
+
+	NET_DBG("Evicting %s", log_strdup(oldest->query));
+
+	return oldest;
+}
+
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, int count, u32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	s64_t now;
+
+	if (count == 0) {
+		ttl = CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL;
+	}
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+
+	if (ttl == 0U || strlen(query) >= DNS_CACHE_NAME_LEN) {
+		return;
+	}
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	entry = cache_find(query, type, now);
+	if (!entry) {
+		entry = cache_get_free((u32_t)now);
+	}
+
+	strcpy(entry->query, query);
+	entry->type = type;
+	entry->count = MIN(count, ARRAY_SIZE(entry->info));
+	memcpy(entry->info, info, entry->count * sizeof(*info));
+	entry->expiry = now + (s64_t)ttl * MSEC_PER_SEC;
+	entry->last_used = (u32_t)now;
+	entry->is_used = true;
+
+	k_mutex_unlock(&dns_cache_lock);
+
+	NET_DBG("Cached %s with %d addresses for %u s", log_strdup(query),
+		count, ttl);
+}
+
+int dns_cache_resolve(const char *query, enum dns_query_type type,
+		      dns_resolve_cb_t cb, void *user_data)
+{
+	struct dns_addrinfo info[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+	struct dns_cache_entry *entry;
+	int i, count;
+	s64_t now;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	entry = cache_find(query, type, now);
+	if (!entry) {
+		k_mutex_unlock(&dns_cache_lock);
+		return -ENOENT;
+	}
+
+	count = entry->count;
+	memcpy(info, entry->info, count * sizeof(*info));
+	entry->last_used = (u32_t)now;
+
+	k_mutex_unlock(&dns_cache_lock);
+
+	/* The callback is free to start another query */
+	for (i = 0; i < count; i++) {
+		cb(DNS_EAI_INPROGRESS, &info[i], user_data);
+	}
+
+	cb(count ? DNS_EAI_ALLDONE : DNS_EAI_NODATA, NULL, user_data);
+
+	return 0;
+}
+
+void dns_resolve_cache_foreach(dns_resolve_cache_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry *entry;
+	s64_t now;
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		entry = &dns_cache[i];
+
+		if (!entry->is_used || entry->expiry <= now) {
+			continue;
+		}
+
+		cb(entry->query, entry->type, entry->info, entry->count,
+		   (entry->expiry - now + MSEC_PER_SEC - 1) / MSEC_PER_SEC,
+		   user_data);
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
+
+void dns_resolve_cache_flush(void)
+{
+	int i;
+
+	k_mutex_lock(&dns_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(dns_cache); i++) {
+		dns_cache[i].is_used = false;
+	}
+
+	k_mutex_unlock(&dns_cache_lock);
+}
@@ -0,0 +1,65 @@
+/** @file
+ @brief DNS resolver cache
+
+ This is not to be included by the application and is only used by
+ the DNS resolver.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _DNS_CACHE_H_
+#define _DNS_CACHE_H_
+
+#include <zephyr/types.h>
+#include <errno.h>
+#include <net/dns_resolve.h>
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Keep the answer to a query
+ *
+ * @param query Name that was queried
+ * @param type Type of the query
+ * @param info Addresses the name resolved to
+ * @param count Number of addresses, 0 if the name did not resolve
+ * @param ttl Smallest time to live of the answers in seconds, ignored
+ * if the name did not resolve.
+ */
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, int count, u32_t ttl);
+
+/**
+ * @brief Answer a query from the cache
+ *
+ * The callback is called as it would be for an answer received from a
+ * DNS server, before returning.
+ *
+ * @param query Name to resolve
+ * @param type Type of the query
+ * @param cb Callback of the query
+ * @param user_data User data of the query
+ *
+ * @return 0 if the query was answered, -ENOENT if the name is not cached.
+ */
+int dns_cache_resolve(const char *query, enum dns_query_type type,
+		      dns_resolve_cb_t cb, void *user_data);
+#else
+static inline void dns_cache_add(const char *query, enum dns_query_type type,
+				 const struct dns_addrinfo *info, int count,
+				 u32_t ttl)
+{
+}
+
+static inline int dns_cache_resolve(const char *query,
+				    enum dns_query_type type,
+				    dns_resolve_cb_t cb, void *user_data)
+{
+	return -ENOENT;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+#endif /* _DNS_CACHE_H_ */
@@ -217,9 +217,11 @@ int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 	ancount = dns_unpack_header_ancount(dns_header);
 
 	/* For mDNS (when src_id == 0) the query count is 0 so accept
-	 * the packet in that case.
+	 * the packet in that case. A DNS response without answers tells
+	 * that the name has no record of the queried type (NODATA), an
+	 * mDNS one cannot be matched to a query without them.
 	 */
-	if ((qdcount < 1 && src_id > 0) || ancount < 1) {
+	if ((qdcount < 1 && src_id > 0) || (ancount < 1 && src_id == 0)) {
 		return -EINVAL;
 	}
 
@@ -293,7 +293,8 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, u32_t *ttl);
  * @retval -EINVAL if the src_id does not match the header's id, or if the
  *         header's QR value is not DNS_RESPONSE or if the header's OPCODE
  *         value is not DNS_QUERY, or if the header's Z value is not 0 or if
- *         the question counter is not 1 or the answer counter is less than 1.
+ *         the question counter is not 1, or if the answer counter of an mDNS
+ *         response (src_id 0) is less than 1.
  * @retval RFC 1035 RCODEs (> 0) 1 Format error, 2 Server failure, 3 Name Error,
  *         4 Not Implemented and 5 Refused.
  */
@@ -367,7 +368,8 @@ int dns_copy_qname(u8_t *buf, u16_t *len, u16_t size,
  * @retval -EINVAL if the src_id does not match the header's id, or if the
  *         header's QR value is not DNS_RESPONSE or if the header's OPCODE
  *         value is not DNS_QUERY, or if the header's Z value is not 0 or if
- *         the question counter is not 1 or the answer counter is less than 1.
+ *         the question counter is not 1, or if the answer counter of an mDNS
+ *         response (src_id 0) is less than 1.
  * @retval RFC 1035 RCODEs (> 0) 1 Format error, 2 Server failure, 3 Name Error,
  *         4 Not Implemented and 5 Refused.
  */
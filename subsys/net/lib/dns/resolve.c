@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <net/net_mgmt.h>
 #include <net/dns_resolve.h>
 #include "dns_pack.h"
+#include "dns_cache.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -368,8 +369,16 @@ static int dns_read(struct dns_resolve_context *ctx,
 {
 	struct dns_addrinfo info = { 0 };
 	/* Helper struct to track the dns msg received from the server */
-	struct dns_msg_t dns_msg;
-	u32_t ttl; /* RR ttl, so far it is not passed to caller */
+	struct dns_msg_t dns_msg = {
+		.response_type = DNS_RESPONSE_INVALID,
+	};
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_addrinfo cached[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRS];
+#else
+	struct dns_addrinfo *cached = NULL;
+#endif
+	u32_t min_ttl = UINT32_MAX;
+	u32_t ttl;
 	u8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -377,6 +386,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 	int answer_ptr;
 	int data_len;
 	int items;
+	int rcode;
 	int ret;
 	int server_idx, query_idx = -1;
 
@@ -400,8 +410,9 @@ static int dns_read(struct dns_resolve_context *ctx,
 	 * we do not know what the DNS id is yet.
 	 */
 	*dns_id = dns_unpack_header_id(dns_msg.msg);
+	rcode = dns_header_rcode(dns_msg.msg);
 
-	if (dns_header_rcode(dns_msg.msg) == DNS_HEADER_REFUSED) {
+	if (rcode == DNS_HEADER_REFUSED) {
 		ret = DNS_EAI_FAIL;
 		goto quit;
 	}
@@ -450,6 +461,8 @@ static int dns_read(struct dns_resolve_context *ctx,
 			goto quit;
 		}
 
+		min_ttl = MIN(min_ttl, ttl);
+
 		switch (dns_msg.response_type) {
 		case DNS_RESPONSE_IP:
 			if (query_idx >= 0) {
@@ -524,6 +537,13 @@ static int dns_read(struct dns_resolve_context *ctx,
 		query_known:
 			ctx->queries[query_idx].cb(DNS_EAI_INPROGRESS, &info,
 					ctx->queries[query_idx].user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+			if (items < ARRAY_SIZE(cached)) {
+				cached[items] = info;
+			}
+#endif
+
 			items++;
 			break;
 
@@ -586,6 +606,17 @@ static int dns_read(struct dns_resolve_context *ctx,
 		ret = DNS_EAI_ALLDONE;
 	}
 
+	/* As in RFC 2308, only a name that does not exist or that has no
+	 * address of the queried type is cached negatively. A server
+	 * failure, or any other error, may not last.
+	 */
+	if (items > 0 || rcode == DNS_HEADER_NOERROR ||
+	    rcode == DNS_HEADER_NAMEERROR) {
+		dns_cache_add(ctx->queries[query_idx].query,
+			      ctx->queries[query_idx].query_type, cached,
+			      items, min_ttl);
+	}
+
 	if (k_delayed_work_remaining_get(&ctx->queries[query_idx].timer) > 0) {
 		k_delayed_work_cancel(&ctx->queries[query_idx].timer);
 	}
@@ -960,6 +991,14 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	if (dns_cache_resolve(query, type, cb, user_data) == 0) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
@@ -25,104 +25,279 @@ LOG_MODULE_REGISTER(net_http, CONFIG_NET_HTTP_LOG_LEVEL);
 #include <net/http_client.h>
 
 #include "net_private.h"
+#include "http_client_internal.h"
 
-#define HTTP_CONTENT_LEN_SIZE 6
-#define MAX_SEND_BUF_LEN 192
+#define HTTP_CONTENT_LEN_SIZE 11
+#define HTTP_CHUNK_LEN_SIZE 11
+#define HTTP_SEND_IOV_MAX 16
 
-static ssize_t sendall(int sock, const void *buf, size_t len)
+/* The pieces of a request are collected here and written with a single
+ * sendmsg() once the vector is full, or before a callback writes to the
+ * socket itself. Nothing is copied, the pieces must stay valid until the
+ * vector is flushed.
+ */
+struct http_send_ctx {
+	struct iovec iov[HTTP_SEND_IOV_MAX];
+	int iovcnt;
+	int sock;
+	int total_sent;
+};
+
+static int sendmsg_all(int sock, struct iovec *iov, int iovcnt)
 {
-	while (len) {
-		ssize_t out_len = send(sock, buf, len, 0);
+	struct msghdr msg;
+	ssize_t out_len;
+
+	while (iovcnt > 0) {
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = iov;
+		msg.msg_iovlen = iovcnt;
 
+		out_len = sendmsg(sock, &msg, 0);
 		if (out_len < 0) {
 			return -errno;
 		}
 
-		buf = (const char *)buf + out_len;
-		len -= out_len;
+		/* Skip what went out, a partial write continues from the
+		 * middle of the vector.
+		 */
+		while (iovcnt > 0 && out_len >= iov->iov_len) {
+			out_len -= iov->iov_len;
+			iov++;
+			iovcnt--;
+		}
+
+		if (iovcnt > 0) {
+			iov->iov_base = (u8_t *)iov->iov_base + out_len;
+			iov->iov_len -= out_len;
+		}
 	}
 
 	return 0;
 }
 
-static int http_send_data(int sock, char *send_buf,
-			  size_t send_buf_max_len, size_t *send_buf_pos,
-			  ...)
+static int http_flush_data(struct http_send_ctx *ctx)
+{
+	int ret;
+
+	if (ctx->iovcnt == 0) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_HTTP_LOG_LEVEL_DBG)) {
+		for (int i = 0; i < ctx->iovcnt; i++) {
+			LOG_HEXDUMP_DBG(ctx->iov[i].iov_base,
+					ctx->iov[i].iov_len, "Data to send");
+		}
+	}
+
+	ret = sendmsg_all(ctx->sock, ctx->iov, ctx->iovcnt);
+	if (ret < 0) {
+		NET_DBG("Cannot send %d pieces (%d)", ctx->iovcnt, ret);
+		return ret;
+	}
+
+	ctx->iovcnt = 0;
+
+	return 0;
+}
+
+static int http_add_data(struct http_send_ctx *ctx, const void *data,
+			 size_t len)
+{
+	int ret;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if (ctx->iovcnt == ARRAY_SIZE(ctx->iov)) {
+		ret = http_flush_data(ctx);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ctx->iov[ctx->iovcnt].iov_base = (void *)data;
+	ctx->iov[ctx->iovcnt].iov_len = len;
+	ctx->iovcnt++;
+	ctx->total_sent += len;
+
+	return 0;
+}
+
+/* Adds a NULL terminated list of strings */
+static int http_send_data(struct http_send_ctx *ctx, ...)
 {
 	const char *data;
 	va_list va;
-	int ret, end_of_send = *send_buf_pos;
-	int end_of_data, remaining_len;
+	int ret = 0;
 
-	va_start(va, send_buf_pos);
+	va_start(va, ctx);
 
 	data = va_arg(va, const char *);
 
 	while (data) {
-		end_of_data = 0;
-
-		do {
-			int to_be_copied;
-
-			remaining_len = strlen(data + end_of_data);
-			to_be_copied = send_buf_max_len - end_of_send;
-
-			if (remaining_len > to_be_copied) {
-				strncpy(send_buf + end_of_send,
-					data + end_of_data,
-					to_be_copied);
-
-				end_of_send += to_be_copied;
-				end_of_data += to_be_copied;
-				remaining_len -= to_be_copied;
-
-				LOG_HEXDUMP_DBG(send_buf, end_of_send,
-						"Data to send");
-
-				ret = sendall(sock, send_buf, end_of_send);
-				if (ret < 0) {
-					NET_DBG("Cannot send %d bytes (%d)",
-						end_of_send, ret);
-					goto err;
-				}
-
-				end_of_send = 0;
-				continue;
-			} else {
-				strncpy(send_buf + end_of_send,
-					data + end_of_data,
-					remaining_len);
-				end_of_send += remaining_len;
-				remaining_len = 0;
-			}
-		} while (remaining_len > 0);
+		ret = http_add_data(ctx, data, strlen(data));
+		if (ret < 0) {
+			break;
+		}
 
 		data = va_arg(va, const char *);
-	};
+	}
 
 	va_end(va);
 
-	if (end_of_send > (int)send_buf_max_len) {
-		NET_ERR("Sending overflow (%d > %zd)", end_of_send,
-			send_buf_max_len);
-		return -EMSGSIZE;
-	}
+	return ret;
+}
 
-	*send_buf_pos = end_of_send;
+/* Sends the body that the chunk callback produces, with chunked transfer
+ * encoding, a chunk at a time as it is handed over.
+ */
+static int http_send_chunked(struct http_send_ctx *ctx,
+			     struct http_request *req, void *user_data)
+{
+	char chunk_len_str[HTTP_CHUNK_LEN_SIZE];
+	const u8_t *data;
+	int len, ret;
 
-	return end_of_send;
+	do {
+		len = req->chunk_cb(req, &data, user_data);
+		if (len < 0) {
+			return len;
+		}
 
-err:
-	va_end(va);
+		snprintk(chunk_len_str, sizeof(chunk_len_str), "%x" HTTP_CRLF,
+			 len);
 
-	return ret;
+		ret = http_send_data(ctx, chunk_len_str, NULL);
+		if (ret == 0) {
+			ret = http_add_data(ctx, data, len);
+		}
+
+		if (ret == 0) {
+			/* The last chunk is empty and ends the body */
+			ret = http_send_data(ctx, HTTP_CRLF, NULL);
+		}
+
+		if (ret == 0) {
+			ret = http_flush_data(ctx);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+	} while (len > 0);
+
+	return 0;
 }
 
-static int http_flush_data(int sock, const char *send_buf, size_t send_buf_len)
+int http_client_send(int sock, struct http_request *req, void *user_data)
 {
-	LOG_HEXDUMP_DBG(send_buf, send_buf_len, "Data to send");
+	struct http_send_ctx ctx = {
+		.sock = sock,
+	};
+	char content_len_str[HTTP_CONTENT_LEN_SIZE];
+	int ret, i;
+
+	ret = http_send_data(&ctx, http_method_str(req->method), " ",
+			     req->url, " ", req->protocol, HTTP_CRLF,
+			     "Host", ": ", req->host, HTTP_CRLF, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (req->optional_headers_cb) {
+		ret = http_flush_data(&ctx);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = req->optional_headers_cb(sock, req, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ctx.total_sent += ret;
+	} else {
+		for (i = 0; req->optional_headers && req->optional_headers[i];
+		     i++) {
+			ret = http_send_data(&ctx, req->optional_headers[i],
+					     NULL);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	for (i = 0; req->header_fields && req->header_fields[i]; i++) {
+		ret = http_send_data(&ctx, req->header_fields[i], NULL);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (req->content_type_value) {
+		ret = http_send_data(&ctx, "Content-Type", ": ",
+				     req->content_type_value, HTTP_CRLF, NULL);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (req->chunk_cb) {
+		ret = http_send_data(&ctx, "Transfer-Encoding: chunked",
+				     HTTP_CRLF, HTTP_CRLF, NULL);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = http_send_chunked(&ctx, req, user_data);
+	} else if (req->payload_cb) {
+		ret = http_send_data(&ctx, HTTP_CRLF, NULL);
+		if (ret == 0) {
+			ret = http_flush_data(&ctx);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
 
-	return sendall(sock, send_buf, send_buf_len);
+		ret = req->payload_cb(sock, req, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ctx.total_sent += ret;
+	} else if (req->payload) {
+		ret = snprintk(content_len_str, HTTP_CONTENT_LEN_SIZE, "%zd",
+			       req->payload_len);
+		if (ret <= 0 || ret >= HTTP_CONTENT_LEN_SIZE) {
+			return -ENOMEM;
+		}
+
+		ret = http_send_data(&ctx, "Content-Length", ": ",
+				     content_len_str, HTTP_CRLF, HTTP_CRLF,
+				     NULL);
+		if (ret == 0) {
+			ret = http_add_data(&ctx, req->payload,
+					    req->payload_len);
+		}
+	} else {
+		ret = http_send_data(&ctx, HTTP_CRLF, NULL);
+	}
+
+	if (ret == 0) {
+		ret = http_flush_data(&ctx);
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	NET_DBG("Sent %d bytes", ctx.total_sent);
+
+	return ctx.total_sent;
 }
 
 static void print_header_field(size_t len, const char *str)
@@ -395,8 +570,8 @@ static int on_chunk_complete(struct http_parser *parser)
 	return 0;
 }
 
-static void http_client_init_parser(struct http_parser *parser,
-				    struct http_parser_settings *settings)
+void http_client_init_parser(struct http_parser *parser,
+			     struct http_parser_settings *settings)
 {
 	http_parser_init(parser, HTTP_RESPONSE);
 
@@ -470,13 +645,7 @@ static void http_timeout(struct k_work *work)
 int http_client_req(int sock, struct http_request *req,
 		    s32_t timeout, void *user_data)
 {
-	/* Utilize the network usage by sending data in bigger blocks */
-	char send_buf[MAX_SEND_BUF_LEN];
-	const size_t send_buf_max_len = sizeof(send_buf);
-	size_t send_buf_pos = 0;
-	int total_sent = 0;
-	int ret, total_recv, i;
-	const char *method;
+	int total_sent, total_recv;
 
 	if (sock < 0 || req == NULL || req->response == NULL ||
 	    req->recv_buf == NULL || req->recv_buf_len == 0) {
@@ -498,145 +667,11 @@ int http_client_req(int sock, struct http_request *req,
 		req->internal.timeout = K_MSEC(timeout);
 	}
 
-	method = http_method_str(req->method);
-
-	ret = http_send_data(sock, send_buf, send_buf_max_len, &send_buf_pos,
-			     method, " ", req->url, " ", req->protocol,
-			     HTTP_CRLF, NULL);
-	if (ret < 0) {
-		goto out;
+	total_sent = http_client_send(sock, req, user_data);
+	if (total_sent < 0) {
+		return total_sent;
 	}
 
-	total_sent += ret;
-
-	ret = http_send_data(sock, send_buf, send_buf_max_len, &send_buf_pos,
-			     "Host", ": ", req->host, HTTP_CRLF, NULL);
-	if (ret < 0) {
-		goto out;
-	}
-
-	total_sent += ret;
-
-	if (req->optional_headers_cb) {
-		ret = http_flush_data(sock, send_buf, send_buf_pos);
-		if (ret < 0) {
-			goto out;
-		}
-
-		send_buf_pos = 0;
-		total_sent += ret;
-
-		ret = req->optional_headers_cb(sock, req, user_data);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-	} else {
-		for (i = 0; req->optional_headers && req->optional_headers[i];
-		     i++) {
-			ret = http_send_data(sock, send_buf, send_buf_max_len,
-					     &send_buf_pos,
-					     req->optional_headers[i], NULL);
-			if (ret < 0) {
-				goto out;
-			}
-
-			total_sent += ret;
-		}
-	}
-
-	for (i = 0; req->header_fields && req->header_fields[i]; i++) {
-		ret = http_send_data(sock, send_buf, send_buf_max_len,
-				     &send_buf_pos, req->header_fields[i],
-				     NULL);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-	}
-
-	if (req->content_type_value) {
-		ret = http_send_data(sock, send_buf, send_buf_max_len,
-				     &send_buf_pos, "Content-Type", ": ",
-				     req->content_type_value, HTTP_CRLF, NULL);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-	}
-
-	if (req->payload_cb) {
-		ret = http_send_data(sock, send_buf, send_buf_max_len,
-				     &send_buf_pos, HTTP_CRLF, NULL);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-
-		ret = http_flush_data(sock, send_buf, send_buf_pos);
-		if (ret < 0) {
-			goto out;
-		}
-
-		send_buf_pos = 0;
-		total_sent += ret;
-
-		ret = req->payload_cb(sock, req, user_data);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-	} else if (req->payload) {
-		char content_len_str[HTTP_CONTENT_LEN_SIZE];
-
-		ret = snprintk(content_len_str, HTTP_CONTENT_LEN_SIZE,
-			       "%zd", req->payload_len);
-		if (ret <= 0 || ret >= HTTP_CONTENT_LEN_SIZE) {
-			ret = -ENOMEM;
-			goto out;
-		}
-
-		ret = http_send_data(sock, send_buf, send_buf_max_len,
-				     &send_buf_pos, "Content-Length", ": ",
-				     content_len_str, HTTP_CRLF,
-				     HTTP_CRLF, NULL);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-
-		ret = http_send_data(sock, send_buf, send_buf_max_len,
-				     &send_buf_pos, req->payload, NULL);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-	} else {
-		ret = http_send_data(sock, send_buf, send_buf_max_len,
-				     &send_buf_pos, HTTP_CRLF, NULL);
-		if (ret < 0) {
-			goto out;
-		}
-	}
-
-	if (send_buf_pos > 0) {
-		ret = http_flush_data(sock, send_buf, send_buf_pos);
-		if (ret < 0) {
-			goto out;
-		}
-
-		total_sent += ret;
-	}
-
-	NET_DBG("Sent %d bytes", total_sent);
-
 	http_client_init_parser(&req->internal.parser,
 				&req->internal.parser_settings);
 
@@ -661,7 +696,4 @@ int http_client_req(int sock, struct http_request *req,
 	}
 
 	return total_sent;
-
-out:
-	return ret;
 }
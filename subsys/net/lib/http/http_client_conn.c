@@ -0,0 +1,584 @@
+/** @file
+ * @brief HTTP client connection pool
+ *
+ * Connections to HTTP servers kept open between requests, with the
+ * requests pipelined on them.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_http_conn, CONFIG_NET_HTTP_LOG_LEVEL);
+
+#include <kernel.h>
+#include <string.h>
+#include <errno.h>
+
+#include <net/net_ip.h>
+#include <net/socket.h>
+#include <net/http_client.h>
+
+#include "net_private.h"
+#include "http_client_internal.h"
+
+struct http_client_conn {
+	/** Requests sent and waiting for their response, oldest first */
+	struct http_request *pending[CONFIG_HTTP_CLIENT_CONN_PIPELINE];
+
+	/** Uptime by which the response to each request must be complete,
+	 * 0 for none.
+	 */
+	s64_t deadline[CONFIG_HTTP_CLIENT_CONN_PIPELINE];
+
+	/** Address of the server */
+	struct sockaddr addr;
+
+	/** When the last request was sent or completed */
+	s64_t last_used;
+
+	/** Socket of the connection */
+	int sock;
+
+	/** Index of the oldest pending request */
+	u8_t head;
+
+	/** Number of pending requests */
+	u8_t count;
+
+	/** Is the connection open */
+	u8_t open : 1;
+
+	/** Is the connection being made, without conns_lock held */
+	u8_t connecting : 1;
+
+	/** Responses are read here */
+	u8_t buf[CONFIG_HTTP_CLIENT_CONN_BUF_SIZE];
+};
+
+static struct http_client_conn conns[CONFIG_HTTP_CLIENT_CONN_MAX];
+
+static K_MUTEX_DEFINE(conns_lock);
+
+static bool addr_equal(const struct sockaddr *a, const struct sockaddr *b)
+{
+	if (a->sa_family != b->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && a->sa_family == AF_INET) {
+		return net_sin(a)->sin_port == net_sin(b)->sin_port &&
+		       net_ipv4_addr_cmp(&net_sin(a)->sin_addr,
+					 &net_sin(b)->sin_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && a->sa_family == AF_INET6) {
+		return net_sin6(a)->sin6_port == net_sin6(b)->sin6_port &&
+		       net_ipv6_addr_cmp(&net_sin6(a)->sin6_addr,
+					 &net_sin6(b)->sin6_addr);
+	}
+
+	return false;
+}
+
+static struct http_request *conn_head(struct http_client_conn *conn)
+{
+	return conn->pending[conn->head];
+}
+
+static void conn_pop(struct http_client_conn *conn)
+{
+	conn->head = (conn->head + 1) % CONFIG_HTTP_CLIENT_CONN_PIPELINE;
+	conn->count--;
+	conn->last_used = k_uptime_get();
+}
+
+/* Completes a request that will get no more of its response. What the
+ * parser found so far, such as the status, is left for the callback.
+ */
+static void request_abort(struct http_request *req)
+{
+	struct http_response *rsp = &req->internal.response;
+
+	rsp->body_start = NULL;
+	rsp->data_len = 0;
+
+	rsp->cb(rsp, HTTP_DATA_FINAL, req->internal.user_data);
+}
+
+static void conn_close(struct http_client_conn *conn)
+{
+	NET_DBG("[%p] Closing, %d requests in flight", conn, conn->count);
+
+	(void)close(conn->sock);
+	conn->open = 0U;
+
+	while (conn->count > 0) {
+		struct http_request *req = conn_head(conn);
+
+		conn_pop(conn);
+		request_abort(req);
+	}
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_request *req = CONTAINER_OF(parser,
+						struct http_request,
+						internal.parser);
+	struct http_response *rsp = &req->internal.response;
+
+	rsp->processed += length;
+
+	if (rsp->http_cb && rsp->http_cb->on_body) {
+		rsp->http_cb->on_body(parser, at, length);
+	}
+
+	/* The body is handed out from where the parser found it */
+	rsp->body_found = 1U;
+	rsp->body_start = (u8_t *)at;
+	rsp->data_len = length;
+
+	rsp->cb(rsp, HTTP_DATA_MORE, req->internal.user_data);
+
+	return 0;
+}
+
+/* The response is parsed for what it is. The body of an error or of a
+ * reply without a Content-Length is still on the connection, in front
+ * of the next response, so only a response to HEAD has none.
+ */
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_request *req = CONTAINER_OF(parser,
+						struct http_request,
+						internal.parser);
+	struct http_response *rsp = &req->internal.response;
+
+	if (rsp->http_cb && rsp->http_cb->on_headers_complete) {
+		rsp->http_cb->on_headers_complete(parser);
+	}
+
+	if (req->method == HTTP_HEAD) {
+		NET_DBG("No body expected");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_request *req = CONTAINER_OF(parser,
+						struct http_request,
+						internal.parser);
+	struct http_response *rsp = &req->internal.response;
+
+	if (rsp->http_cb && rsp->http_cb->on_message_complete) {
+		rsp->http_cb->on_message_complete(parser);
+	}
+
+	rsp->message_complete = 1U;
+	rsp->body_start = NULL;
+	rsp->data_len = 0;
+
+	rsp->cb(rsp, HTTP_DATA_FINAL, req->internal.user_data);
+
+	/* What follows belongs to the response to the next request */
+	http_parser_pause(parser, 1);
+
+	return 0;
+}
+
+/* Feeds the data read from the connection to the parsers of the pending
+ * requests, returns the number of requests completed.
+ */
+static int conn_parse(struct http_client_conn *conn, size_t len)
+{
+	struct http_request *req;
+	size_t offset = 0, parsed;
+	int completed = 0;
+
+	while (conn->open && conn->count > 0 && offset < len) {
+		req = conn_head(conn);
+
+		parsed = http_parser_execute(&req->internal.parser,
+					     &req->internal.parser_settings,
+					     conn->buf + offset, len - offset);
+		offset += parsed;
+
+		if (req->internal.response.message_complete) {
+			conn_pop(conn);
+			completed++;
+
+			if (!http_should_keep_alive(&req->internal.parser)) {
+				/* Whatever was sent after this request is
+				 * not going to be answered.
+				 */
+				conn_close(conn);
+			}
+		} else if (HTTP_PARSER_ERRNO(&req->internal.parser) !=
+			   HPE_OK) {
+			NET_DBG("[%p] Invalid response (%s)", conn,
+				http_errno_name(HTTP_PARSER_ERRNO(
+						&req->internal.parser)));
+			conn_close(conn);
+		}
+	}
+
+	if (conn->open && offset < len) {
+		NET_DBG("[%p] %zd bytes without a request", conn,
+			len - offset);
+	}
+
+	return completed;
+}
+
+static int conn_input(struct http_client_conn *conn)
+{
+	struct http_request *req;
+	ssize_t len;
+	int completed = 0;
+
+	len = recv(conn->sock, conn->buf, sizeof(conn->buf), MSG_DONTWAIT);
+	if (len < 0) {
+		int err = -errno;
+
+		if (err == -EAGAIN) {
+			return 0;
+		}
+
+		NET_DBG("[%p] Receive error (%d)", conn, err);
+		conn_close(conn);
+		return err;
+	}
+
+	if (len > 0) {
+		return conn_parse(conn, len);
+	}
+
+	/* A response without a length ends when the server closes */
+	if (conn->count > 0) {
+		req = conn_head(conn);
+
+		(void)http_parser_execute(&req->internal.parser,
+					  &req->internal.parser_settings,
+					  NULL, 0);
+		if (req->internal.response.message_complete) {
+			conn_pop(conn);
+			completed++;
+		}
+	}
+
+	conn_close(conn);
+
+	return completed;
+}
+
+/* Uptime of the earliest response deadline of the connection, 0 if
+ * there is none.
+ */
+static s64_t conn_deadline(struct http_client_conn *conn)
+{
+	s64_t deadline = 0;
+
+	for (int i = 0; i < conn->count; i++) {
+		s64_t d = conn->deadline[(conn->head + i) %
+					 CONFIG_HTTP_CLIENT_CONN_PIPELINE];
+
+		if (d && (!deadline || d < deadline)) {
+			deadline = d;
+		}
+	}
+
+	return deadline;
+}
+
+static void conns_expire(void)
+{
+	s64_t now = k_uptime_get();
+	s64_t deadline;
+
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (!conns[i].open) {
+			continue;
+		}
+
+		/* The responses come in order, so none of the requests
+		 * can complete once the server stalls on one.
+		 */
+		deadline = conn_deadline(&conns[i]);
+		if (deadline && now >= deadline) {
+			NET_DBG("[%p] Response timed out", &conns[i]);
+			conn_close(&conns[i]);
+			continue;
+		}
+
+		if (CONFIG_HTTP_CLIENT_CONN_IDLE_TIMEOUT > 0 &&
+		    conns[i].count == 0 &&
+		    now - conns[i].last_used >=
+		    CONFIG_HTTP_CLIENT_CONN_IDLE_TIMEOUT) {
+			conn_close(&conns[i]);
+		}
+	}
+}
+
+/* How long to wait for data before a response deadline passes */
+static s32_t conns_wait(s32_t timeout)
+{
+	s64_t now = k_uptime_get();
+	s64_t deadline;
+
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (!conns[i].open) {
+			continue;
+		}
+
+		deadline = conn_deadline(&conns[i]);
+		if (deadline &&
+		    (timeout == NET_WAIT_FOREVER || deadline - now < timeout)) {
+			timeout = MAX(deadline - now, 0);
+		}
+	}
+
+	return timeout;
+}
+
+/* Called without conns_lock held, connecting may take a while */
+static int conn_connect(const struct sockaddr *addr, socklen_t addrlen)
+{
+	int sock;
+
+	sock = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (connect(sock, addr, addrlen) < 0) {
+		int err = -errno;
+
+		(void)close(sock);
+		return err;
+	}
+
+	return sock;
+}
+
+static void conn_open(struct http_client_conn *conn,
+		      const struct sockaddr *addr, socklen_t addrlen, int sock)
+{
+	memcpy(&conn->addr, addr, MIN(addrlen, sizeof(conn->addr)));
+	conn->sock = sock;
+	conn->head = 0U;
+	conn->count = 0U;
+	conn->open = 1U;
+	conn->last_used = k_uptime_get();
+
+	NET_DBG("[%p] Connected (sock %d)", conn, sock);
+}
+
+/* The least busy connection to the server that can take another request.
+ * Another connection is only made when there is none, so requests are
+ * pipelined rather than spread over connections. Returns 1 if a slot was
+ * set aside for a new connection, which the caller makes.
+ */
+static int conn_get(const struct sockaddr *addr,
+		    struct http_client_conn **conn)
+{
+	struct http_client_conn *best = NULL, *unused = NULL, *idle = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct http_client_conn *c = &conns[i];
+
+		if (!c->open) {
+			if (!c->connecting) {
+				unused = c;
+			}
+		} else if (addr_equal(&c->addr, addr)) {
+			if (c->count < CONFIG_HTTP_CLIENT_CONN_PIPELINE &&
+			    (!best || c->count < best->count)) {
+				best = c;
+			}
+		} else if (c->count == 0 &&
+			   (!idle || c->last_used < idle->last_used)) {
+			idle = c;
+		}
+	}
+
+	if (best) {
+		*conn = best;
+		return 0;
+	}
+
+	if (!unused) {
+		if (!idle) {
+			return -EAGAIN;
+		}
+
+		/* Make room by closing the connection idle the longest */
+		conn_close(idle);
+		unused = idle;
+	}
+
+	unused->connecting = 1U;
+	*conn = unused;
+
+	return 1;
+}
+
+int http_client_conn_req(const struct sockaddr *addr, socklen_t addrlen,
+			 struct http_request *req, s32_t timeout,
+			 void *user_data)
+{
+	struct http_client_conn *conn;
+	int ret;
+
+	if (addr == NULL || req == NULL || req->response == NULL ||
+	    (timeout <= 0 && timeout != NET_WAIT_FOREVER)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	conns_expire();
+
+	ret = conn_get(addr, &conn);
+	if (ret < 0) {
+		goto out;
+	}
+
+	if (ret > 0) {
+		/* The slot is kept aside meanwhile, by its connecting flag */
+		k_mutex_unlock(&conns_lock);
+		ret = conn_connect(addr, addrlen);
+		k_mutex_lock(&conns_lock, K_FOREVER);
+
+		conn->connecting = 0U;
+
+		if (ret < 0) {
+			goto out;
+		}
+
+		conn_open(conn, addr, addrlen, ret);
+	}
+
+	memset(&req->internal.response, 0, sizeof(req->internal.response));
+
+	req->internal.response.http_cb = req->http_cb;
+	req->internal.response.cb = req->response;
+	req->internal.response.recv_buf = conn->buf;
+	req->internal.response.recv_buf_len = sizeof(conn->buf);
+	req->internal.user_data = user_data;
+	req->internal.sock = conn->sock;
+	req->internal.timeout = K_FOREVER;
+
+	http_client_init_parser(&req->internal.parser,
+				&req->internal.parser_settings);
+
+	req->internal.parser_settings.on_headers_complete =
+		on_headers_complete;
+	req->internal.parser_settings.on_body = on_body;
+	req->internal.parser_settings.on_message_complete =
+		on_message_complete;
+
+	ret = http_client_send(conn->sock, req, user_data);
+	if (ret < 0) {
+		NET_DBG("[%p] Cannot send request (%d)", conn, ret);
+		conn_close(conn);
+		goto out;
+	}
+
+	conn->pending[(conn->head + conn->count) %
+		      CONFIG_HTTP_CLIENT_CONN_PIPELINE] = req;
+	conn->deadline[(conn->head + conn->count) %
+		       CONFIG_HTTP_CLIENT_CONN_PIPELINE] =
+		timeout == NET_WAIT_FOREVER ? 0 : k_uptime_get() + timeout;
+	conn->count++;
+	conn->last_used = k_uptime_get();
+
+	ret = 0;
+
+out:
+	k_mutex_unlock(&conns_lock);
+
+	return ret;
+}
+
+int http_client_conn_input(s32_t timeout)
+{
+	struct pollfd fds[CONFIG_HTTP_CLIENT_CONN_MAX];
+	struct http_client_conn *polled[CONFIG_HTTP_CLIENT_CONN_MAX];
+	int nfds = 0, completed = 0;
+	int ret;
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	conns_expire();
+
+	/* Idle connections are polled too, to notice the server closing
+	 * them.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].open) {
+			fds[nfds].fd = conns[i].sock;
+			fds[nfds].events = POLLIN;
+			polled[nfds++] = &conns[i];
+		}
+	}
+
+	/* Do not wait past a response deadline */
+	timeout = conns_wait(timeout);
+
+	k_mutex_unlock(&conns_lock);
+
+	if (nfds == 0) {
+		return 0;
+	}
+
+	ret = poll(fds, nfds, timeout == NET_WAIT_FOREVER ? -1 : timeout);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	if (ret == 0) {
+		conns_expire();
+		k_mutex_unlock(&conns_lock);
+
+		return 0;
+	}
+
+	for (int i = 0; i < nfds; i++) {
+		/* The connection may have been closed and reused meanwhile */
+		if (!fds[i].revents || !polled[i]->open ||
+		    polled[i]->sock != fds[i].fd) {
+			continue;
+		}
+
+		ret = conn_input(polled[i]);
+		if (ret > 0) {
+			completed += ret;
+		}
+	}
+
+	k_mutex_unlock(&conns_lock);
+
+	return completed;
+}
+
+void http_client_conn_close_all(void)
+{
+	k_mutex_lock(&conns_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(conns); i++) {
+		if (conns[i].open) {
+			conn_close(&conns[i]);
+		}
+	}
+
+	k_mutex_unlock(&conns_lock);
+}
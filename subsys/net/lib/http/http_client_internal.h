@@ -0,0 +1,39 @@
+/** @file
+ * @brief HTTP client internal definitions
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef HTTP_CLIENT_INTERNAL_H_
+#define HTTP_CLIENT_INTERNAL_H_
+
+#include <net/http_client.h>
+
+/**
+ * @brief Write a HTTP request to the socket, headers and body.
+ *
+ * @param sock Socket id of the connection.
+ * @param req HTTP request information.
+ * @param user_data User specified data that is passed to the callbacks.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_send(int sock, struct http_request *req, void *user_data);
+
+/**
+ * @brief Set up a parser for a HTTP response and the callbacks that
+ * fill in the response information of the request.
+ *
+ * @param parser Parser of the request.
+ * @param settings Parser callbacks of the request.
+ */
+void http_client_init_parser(struct http_parser *parser,
+			     struct http_parser_settings *settings);
+
+#endif /* HTTP_CLIENT_INTERNAL_H_ */
@@ -127,6 +127,26 @@ static sys_slist_t engine_obj_inst_list;
 static sys_slist_t engine_observer_list;
 static sys_slist_t engine_service_list;
 
+/* engine_obj_list and engine_obj_inst_list hashed by their IDs */
+#define ENGINE_HASH_MASK	(CONFIG_LWM2M_ENGINE_HASH_SIZE - 1)
+
+BUILD_ASSERT((CONFIG_LWM2M_ENGINE_HASH_SIZE & ENGINE_HASH_MASK) == 0,
+	     "CONFIG_LWM2M_ENGINE_HASH_SIZE must be a power of two");
+
+static sys_slist_t engine_obj_hash[CONFIG_LWM2M_ENGINE_HASH_SIZE];
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_HASH_SIZE];
+
+static inline u32_t obj_hash(u16_t obj_id)
+{
+	return obj_id & ENGINE_HASH_MASK;
+}
+
+static inline u32_t obj_inst_hash(u16_t obj_id, u16_t obj_inst_id)
+{
+	/* Instances of the same object spread over consecutive buckets */
+	return ((u32_t)obj_id * 31U + obj_inst_id) & ENGINE_HASH_MASK;
+}
+
 static K_THREAD_STACK_DEFINE(engine_thread_stack,
 			      CONFIG_LWM2M_ENGINE_STACK_SIZE);
 static struct k_thread engine_thread_data;
@@ -606,19 +626,24 @@ static void engine_remove_observer_by_id(u16_t obj_id, s32_t obj_inst_id)
 void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 {
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_append(&engine_obj_hash[obj_hash(obj->obj_id)],
+			 &obj->hash_node);
 }
 
 void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 {
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(&engine_obj_hash[obj_hash(obj->obj_id)],
+				  &obj->hash_node);
 }
 
 static struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_hash[obj_hash(obj_id)], obj,
+				     hash_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -633,6 +658,14 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 	int i;
 
 	if (obj && obj->fields && obj->field_count > 0) {
+		/* Objects mostly define their fields in the order of
+		 * their IDs, starting from 0.
+		 */
+		if (res_id >= 0 && res_id < obj->field_count &&
+		    obj->fields[res_id].res_id == res_id) {
+			return &obj->fields[res_id];
+		}
+
 		for (i = 0; i < obj->field_count; i++) {
 			if (obj->fields[i].res_id == res_id) {
 				return &obj->fields[i];
@@ -643,11 +676,38 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 	return NULL;
 }
 
+struct lwm2m_engine_res *
+lwm2m_engine_get_res(struct lwm2m_engine_obj_inst *obj_inst, int res_id)
+{
+	int i;
+
+	if (!obj_inst->resources) {
+		return NULL;
+	}
+
+	/* Same as the fields, most resources are at the index of their ID */
+	if (res_id >= 0 && res_id < obj_inst->resource_count &&
+	    obj_inst->resources[res_id].res_id == res_id) {
+		return &obj_inst->resources[res_id];
+	}
+
+	for (i = 0; i < obj_inst->resource_count; i++) {
+		if (obj_inst->resources[i].res_id == res_id) {
+			return &obj_inst->resources[i];
+		}
+	}
+
+	return NULL;
+}
+
 /* engine object instance */
 
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(&engine_obj_inst_hash[obj_inst_hash(
+				obj_inst->obj->obj_id, obj_inst->obj_inst_id)],
+			 &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -655,6 +715,9 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 	engine_remove_observer_by_id(
 			obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(&engine_obj_inst_hash[obj_inst_hash(
+				obj_inst->obj->obj_id, obj_inst->obj_inst_id)],
+				  &obj_inst->hash_node);
 }
 
 static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
@@ -662,8 +725,9 @@ static struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id,
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst,
-				     node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(
+			&engine_obj_inst_hash[obj_inst_hash(obj_id, obj_inst_id)],
+			obj_inst, hash_node) {
 		if (obj_inst->obj->obj_id == obj_id &&
 		    obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
@@ -1282,13 +1346,7 @@ static int path_to_objs(const struct lwm2m_obj_path *path,
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
-		}
-	}
-
+	r = lwm2m_engine_get_res(oi, path->res_id);
 	if (!r) {
 		LOG_ERR("resource %d not found", path->res_id);
 		return -ENOENT;
@@ -1688,7 +1746,16 @@ static int lwm2m_engine_get(char *pathstr, void *buf, u16_t buflen)
 
 	/* TODO: handle data_len > buflen case */
 
-	if (data_ptr && data_len > 0) {
+	if (!data_ptr && res->post_write_cb &&
+	    obj_field->data_type == LWM2M_RES_TYPE_OPAQUE) {
+		/* Streamed to the callback straight from the request */
+		ret = lwm2m_write_handler_opaque(obj_inst, res, res_inst,
+						 &msg->in, NULL, 0,
+						 last_block, total_size);
+		if (ret < 0) {
+			return ret;
+		}
+	} else if (data_ptr && data_len > 0) {
 		switch (obj_field->data_type) {
 
 		case LWM2M_RES_TYPE_OPAQUE:
@@ -2220,8 +2287,16 @@ static int lwm2m_write_handler_opaque(struct lwm2m_engine_obj_inst *obj_inst,
 {
 	size_t len = 1;
 	bool last_pkt_block = false, first_read = true;
+	u8_t *value = data_ptr;
 	int ret = 0;
 
+	/* Without a buffer to copy into, the value is read in one go and
+	 * handed over where it is in the request.
+	 */
+	if (!data_ptr) {
+		data_len = in->in_cpkt->max_len;
+	}
+
 	while (!last_pkt_block && len > 0) {
 		if (first_read) {
 			len = engine_get_opaque(in, (u8_t *)data_ptr,
@@ -2242,11 +2317,15 @@ static int lwm2m_write_handler_opaque(struct lwm2m_engine_obj_inst *obj_inst,
 			return -EINVAL;
 		}
 
+		if (!data_ptr) {
+			value = in->in_cpkt->data + in->offset - len;
+		}
+
 		if (res->post_write_cb) {
 			ret = res->post_write_cb(obj_inst->obj_inst_id,
 						 res->res_id,
 						 res_inst->res_inst_id,
-						 data_ptr, len,
+						 value, len,
 						 last_pkt_block && last_block,
 						 total_size);
 			if (ret < 0) {
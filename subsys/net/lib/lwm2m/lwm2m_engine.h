@@ -58,6 +58,8 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj);
 void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj);
 struct lwm2m_engine_obj_field *
 lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id);
+struct lwm2m_engine_res *
+lwm2m_engine_get_res(struct lwm2m_engine_obj_inst *obj_inst, int res_id);
 int  lwm2m_create_obj_inst(u16_t obj_id, u16_t obj_inst_id,
 			   struct lwm2m_engine_obj_inst **obj_inst);
 int  lwm2m_delete_obj_inst(u16_t obj_id, u16_t obj_inst_id);
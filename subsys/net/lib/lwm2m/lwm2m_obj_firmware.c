@@ -14,6 +14,11 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <string.h>
 #include <init.h>
 
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_FLASH_IMG)
+#include <dfu/flash_img.h>
+#include <storage/flash_map.h>
+#endif
+
 #include "lwm2m_object.h"
 #include "lwm2m_engine.h"
 
@@ -74,6 +79,75 @@ static lwm2m_engine_user_cb_t update_cb;
 extern int lwm2m_firmware_start_transfer(char *package_uri);
 #endif
 
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_FLASH_IMG)
+static struct flash_img_context flash_img;
+static bool flash_img_open;
+
+/* Default write_cb: each block goes to the secondary image slot straight
+ * from the CoAP message it came in, through the flash_img write buffer.
+ */
+static int flash_img_write_cb(u16_t obj_inst_id, u16_t res_id,
+			      u16_t res_inst_id, u8_t *data, u16_t data_len,
+			      bool last_block, size_t total_size)
+{
+	int ret;
+
+	if (!flash_img_open) {
+		ret = flash_img_init(&flash_img);
+		if (ret < 0) {
+			LOG_ERR("Cannot open the image slot (%d)", ret);
+			return -EIO;
+		}
+
+		if (total_size > flash_img.flash_area->fa_size) {
+			LOG_ERR("Package of %zu bytes does not fit in the "
+				"image slot", total_size);
+			flash_area_close(flash_img.flash_area);
+			return -ENOSPC;
+		}
+
+#if !defined(CONFIG_IMG_ERASE_PROGRESSIVELY)
+		ret = flash_area_erase(flash_img.flash_area, 0,
+				       flash_img.flash_area->fa_size);
+		if (ret < 0) {
+			LOG_ERR("Cannot erase the image slot (%d)", ret);
+			flash_area_close(flash_img.flash_area);
+			return -EIO;
+		}
+#endif
+
+		flash_img_open = true;
+	}
+
+	if (flash_img_bytes_written(&flash_img) + flash_img.buf_bytes +
+	    data_len > flash_img.flash_area->fa_size) {
+		ret = -ENOSPC;
+		goto close;
+	}
+
+	/* The area is closed when the last block is flushed */
+	ret = flash_img_buffered_write(&flash_img, data, data_len, last_block);
+	if (ret < 0) {
+		LOG_ERR("Cannot write the image slot (%d)", ret);
+		ret = -EIO;
+		goto close;
+	}
+
+	if (last_block) {
+		flash_img_open = false;
+		LOG_INF("Firmware package of %zu bytes written",
+			flash_img_bytes_written(&flash_img));
+	}
+
+	return 0;
+
+close:
+	flash_area_close(flash_img.flash_area);
+	flash_img_open = false;
+	return ret;
+}
+#endif
+
 u8_t lwm2m_firmware_get_update_state(void)
 {
 	return update_state;
@@ -113,6 +187,14 @@ void lwm2m_firmware_set_update_state(u8_t state)
 			update_state, state);
 	}
 
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_FLASH_IMG)
+	/* A transfer given up on starts over at the beginning of the slot */
+	if (state == STATE_IDLE && flash_img_open) {
+		flash_area_close(flash_img.flash_area);
+		flash_img_open = false;
+	}
+#endif
+
 	update_state = state;
 	NOTIFY_OBSERVER(LWM2M_OBJECT_FIRMWARE_ID, 0, FIRMWARE_STATE_ID);
 	LOG_DBG("Update state = %d", update_state);
@@ -351,6 +433,9 @@ static int lwm2m_firmware_init(struct device *dev)
 #else
 	delivery_method = DELIVERY_METHOD_PUSH_ONLY;
 #endif
+#if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_FLASH_IMG)
+	write_cb = flash_img_write_cb;
+#endif
 
 	firmware.obj_id = LWM2M_OBJECT_FIRMWARE_ID;
 	firmware.fields = fields;
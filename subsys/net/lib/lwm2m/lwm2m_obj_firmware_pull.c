@@ -320,7 +320,18 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 		}
 
 		write_cb = lwm2m_firmware_get_write_cb();
-		if (write_cb) {
+		if (write_cb && !write_buf) {
+			/* no buffer to copy into: hand the payload over
+			 * where it is in the response
+			 */
+			ret = write_cb(0, 0, 0,
+				       response->data + payload_offset,
+				       payload_len, last_block,
+				       firmware_block_ctx.total_size);
+			if (ret < 0) {
+				goto error;
+			}
+		} else if (write_cb) {
 			/* flush incoming data to write_cb */
 			while (payload_len > 0) {
 				len = (payload_len > write_buflen) ?
@@ -176,6 +176,9 @@ struct lwm2m_engine_obj {
 	/* object list */
 	sys_snode_t node;
 
+	/* object registry bucket */
+	sys_snode_t hash_node;
+
 	/* object field definitions */
 	struct lwm2m_engine_obj_field *fields;
 
@@ -342,6 +345,9 @@ struct lwm2m_engine_obj_inst {
 	/* instance list */
 	sys_snode_t node;
 
+	/* object instance registry bucket */
+	sys_snode_t hash_node;
+
 	struct lwm2m_engine_obj *obj;
 	struct lwm2m_engine_res *resources;
 
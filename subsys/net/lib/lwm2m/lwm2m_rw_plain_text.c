@@ -388,13 +388,7 @@ int do_write_op_plain_text(struct lwm2m_message *msg)
 		return -EINVAL;
 	}
 
-	for (i = 0; i < obj_inst->resource_count; i++) {
-		if (obj_inst->resources[i].res_id == msg->path.res_id) {
-			res = &obj_inst->resources[i];
-			break;
-		}
-	}
-
+	res = lwm2m_engine_get_res(obj_inst, msg->path.res_id);
 	if (!res) {
 		return -ENOENT;
 	}
@@ -25,16 +25,116 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+#if defined(CONFIG_MQTT_WRITE_COALESCE)
+	client->internal.tx_pending = 0U;
+#endif
+}
+
+/** @brief Length of the packets coalesced in tx buffer, not written yet. */
+static inline u32_t tx_pending(const struct mqtt_client *client)
+{
+#if defined(CONFIG_MQTT_WRITE_COALESCE)
+	return client->internal.tx_pending;
+#else
+	return 0U;
+#endif
+}
+
+static int client_write(struct mqtt_client *client, const u8_t *data,
+			u32_t datalen);
+static int client_write_msg(struct mqtt_client *client,
+			    const struct msghdr *message);
+
+/** @brief Write the packets coalesced in tx buffer. */
+static int tx_flush(struct mqtt_client *client)
+{
+#if defined(CONFIG_MQTT_WRITE_COALESCE)
+	u32_t pending = client->internal.tx_pending;
+
+	if (pending > 0U) {
+		client->internal.tx_pending = 0U;
+
+		return client_write(client, client->tx_buf, pending);
+	}
+#endif
+
+	return 0;
 }
 
-/** @brief Initialize tx buffer. */
+/** @brief Initialize tx buffer. Packets coalesced in it are written first,
+ *         on failure the client is disconnected, which verify_tx_state()
+ *         reports.
+ */
 static void tx_buf_init(struct mqtt_client *client, struct buf_ctx *buf)
 {
+	(void)tx_flush(client);
+
 	memset(client->tx_buf, 0, client->tx_buf_size);
 	buf->cur = client->tx_buf;
 	buf->end = client->tx_buf + client->tx_buf_size;
 }
 
+/** @brief Initialize tx buffer behind the packets coalesced in it. */
+static void tx_buf_append_init(struct mqtt_client *client, struct buf_ctx *buf)
+{
+	buf->cur = client->tx_buf + tx_pending(client);
+	buf->end = client->tx_buf + client->tx_buf_size;
+}
+
+/** @brief Write a packet given in two parts. With CONFIG_MQTT_WRITE_COALESCE,
+ *         it is coalesced behind the packets not written yet if it fits in
+ *         tx buffer, otherwise all of them are written at once.
+ */
+static int tx_write(struct mqtt_client *client, const u8_t *head,
+		    u32_t head_len, const u8_t *tail, u32_t tail_len)
+{
+	struct iovec io_vector[3];
+	struct msghdr msg;
+	int iovlen = 0;
+
+#if defined(CONFIG_MQTT_WRITE_COALESCE)
+	u32_t pending = client->internal.tx_pending;
+
+	if (pending + head_len + tail_len <= client->tx_buf_size) {
+		/* Head may be already encoded in tx buffer, behind the
+		 * pending packets.
+		 */
+		memmove(client->tx_buf + pending, head, head_len);
+		if (tail_len > 0) {
+			memcpy(client->tx_buf + pending + head_len, tail,
+			       tail_len);
+		}
+
+		client->internal.tx_pending += head_len + tail_len;
+
+		return 0;
+	}
+
+	if (pending > 0U) {
+		io_vector[iovlen].iov_base = client->tx_buf;
+		io_vector[iovlen].iov_len = pending;
+		iovlen++;
+
+		client->internal.tx_pending = 0U;
+	}
+#endif
+
+	io_vector[iovlen].iov_base = (void *)head;
+	io_vector[iovlen].iov_len = head_len;
+	iovlen++;
+
+	io_vector[iovlen].iov_base = (void *)tail;
+	io_vector[iovlen].iov_len = tail_len;
+	iovlen++;
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = iovlen;
+
+	return client_write_msg(client, &msg);
+}
+
 /**@brief Notifies disconnection event to the application.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -180,6 +280,30 @@ static int client_write_msg(struct mqtt_client *client,
 	return 0;
 }
 
+/** @brief Send the publications in flight that are due and write the packets
+ *         coalesced in tx buffer.
+ */
+static int client_flush(struct mqtt_client *client)
+{
+#if defined(CONFIG_MQTT_INFLIGHT)
+	struct mqtt_inflight *entry;
+	int err_code;
+
+	entry = mqtt_inflight_due(client);
+	while (entry != NULL && MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		err_code = tx_write(client, entry->data, entry->len, NULL, 0);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		mqtt_inflight_sent(client, entry);
+		entry = mqtt_inflight_due(client);
+	}
+#endif
+
+	return tx_flush(client);
+}
+
 void mqtt_client_init(struct mqtt_client *client)
 {
 	NULL_PARAM_CHECK_VOID(client);
@@ -254,8 +378,11 @@ int mqtt_publish(struct mqtt_client *client,
 {
 	int err_code;
 	struct buf_ctx packet;
-	struct iovec io_vector[2];
-	struct msghdr msg;
+#if defined(CONFIG_MQTT_INFLIGHT)
+	struct mqtt_publish_param inflight_param;
+	struct mqtt_inflight *entry;
+	bool inflight;
+#endif
 
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
@@ -267,29 +394,63 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
-
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
+#if defined(CONFIG_MQTT_INFLIGHT)
+	inflight = (client->inflight_buf != NULL) &&
+		   (param->message.topic.qos > MQTT_QOS_0_AT_MOST_ONCE);
+	if (inflight && param->message_id == 0U) {
+		inflight_param = *param;
+		inflight_param.message_id = mqtt_inflight_next_id(client);
+		param = &inflight_param;
+	}
+#endif
+
+	tx_buf_append_init(client, &packet);
+
 	err_code = publish_encode(param, &packet);
+	if (err_code == -ENOMEM && tx_pending(client) > 0U) {
+		/* No room behind the coalesced packets, write them first. */
+		err_code = tx_flush(client);
+		if (err_code < 0) {
+			goto error;
+		}
+
+		tx_buf_append_init(client, &packet);
+		err_code = publish_encode(param, &packet);
+	}
+
 	if (err_code < 0) {
 		goto error;
 	}
 
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
+#if defined(CONFIG_MQTT_INFLIGHT)
+	if (inflight) {
+		err_code = mqtt_inflight_store(client, param->message_id,
+					       packet.cur,
+					       packet.end - packet.cur,
+					       param->message.payload.data,
+					       param->message.payload.len,
+					       &entry);
+		if (err_code < 0) {
+			goto error;
+		}
 
-	memset(&msg, 0, sizeof(msg));
+		err_code = tx_write(client, entry->data, entry->len, NULL, 0);
+		if (err_code == 0) {
+			mqtt_inflight_sent(client, entry);
+		}
 
-	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+		goto error;
+	}
+#endif
 
-	err_code = client_write_msg(client, &msg);
+	err_code = tx_write(client, packet.cur, packet.end - packet.cur,
+			    param->message.payload.data,
+			    param->message.payload.len);
 
 error:
 	MQTT_TRC("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -614,6 +775,14 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+	if (MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		err_code = client_flush(client);
+		if (err_code < 0) {
+			mqtt_mutex_unlock(client);
+			return err_code;
+		}
+	}
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
@@ -631,7 +800,7 @@ int mqtt_live(struct mqtt_client *client)
 	}
 }
 
-u32_t mqtt_keepalive_time_left(const struct mqtt_client *client)
+static u32_t keepalive_time_left(const struct mqtt_client *client)
 {
 	u32_t elapsed_time = mqtt_elapsed_time_in_ms_get(
 					client->internal.last_activity);
@@ -649,6 +818,25 @@ u32_t mqtt_keepalive_time_left(const struct mqtt_client *client)
 	return keepalive_ms - elapsed_time;
 }
 
+u32_t mqtt_keepalive_time_left(const struct mqtt_client *client)
+{
+	u32_t time_left;
+
+	if (tx_pending(client) > 0U) {
+		return 0;
+	}
+
+	time_left = keepalive_time_left(client);
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+	if (MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		time_left = MIN(time_left, mqtt_inflight_time_left(client));
+	}
+#endif
+
+	return time_left;
+}
+
 int mqtt_input(struct mqtt_client *client)
 {
 	int err_code = 0;
@@ -660,7 +848,17 @@ int mqtt_input(struct mqtt_client *client)
 	MQTT_TRC("state:0x%08x", client->internal.state);
 
 	if (MQTT_HAS_STATE(client, MQTT_STATE_TCP_CONNECTED)) {
-		err_code = client_read(client);
+		err_code = client_flush(client);
+		if (err_code == 0) {
+			err_code = client_read(client);
+		}
+
+		/* Answer the acknowledgments read, resend on a resumed
+		 * session.
+		 */
+		if (err_code == 0) {
+			err_code = client_flush(client);
+		}
 	} else {
 		err_code = -EACCES;
 	}
@@ -670,6 +868,24 @@ int mqtt_input(struct mqtt_client *client)
 	return err_code;
 }
 
+int mqtt_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code == 0) {
+		err_code = client_flush(client);
+	}
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
 static int read_publish_payload(struct mqtt_client *client, void *buffer,
 				size_t length, bool shall_block)
 {
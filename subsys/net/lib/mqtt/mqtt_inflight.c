@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file mqtt_inflight.c
+ *
+ * @brief Window of the QoS 1 and QoS 2 publications not acknowledged yet.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_mqtt_inflight, CONFIG_MQTT_LOG_LEVEL);
+
+#include <stdlib.h>
+#include <sys/printk.h>
+#include <settings/settings.h>
+
+#include "mqtt_internal.h"
+#include "mqtt_os.h"
+
+#define INFLIGHT_SETTINGS_KEY "mqtt/inflight"
+
+static u32_t slot_size(const struct mqtt_client *client)
+{
+	return client->inflight_buf_size / CONFIG_MQTT_INFLIGHT_MAX;
+}
+
+static u8_t *slot_data(const struct mqtt_client *client,
+		       const struct mqtt_inflight *entry)
+{
+	return client->inflight_buf +
+	       (entry - client->internal.inflight) * slot_size(client);
+}
+
+#if defined(CONFIG_MQTT_INFLIGHT_SETTINGS)
+/* Each entry is kept under the index of its slot, so it is overwritten
+ * in place once PUBREC turns it into a PUBREL.
+ */
+static void inflight_save(struct mqtt_client *client,
+			  const struct mqtt_inflight *entry)
+{
+	char key[sizeof(INFLIGHT_SETTINGS_KEY "/") + 2];
+	int err_code;
+
+	snprintk(key, sizeof(key), INFLIGHT_SETTINGS_KEY "/%u",
+		 (unsigned int)(entry - client->internal.inflight));
+
+	if (entry->len > 0) {
+		err_code = settings_save_one(key, entry->data, entry->len);
+	} else {
+		err_code = settings_delete(key);
+	}
+
+	if (err_code < 0) {
+		MQTT_ERR("[CID %p]: Cannot save %s, error %d", client, key,
+			 err_code);
+	}
+}
+#else
+static inline void inflight_save(struct mqtt_client *client,
+				 const struct mqtt_inflight *entry)
+{
+}
+#endif
+
+static void inflight_free(struct mqtt_client *client,
+			  struct mqtt_inflight *entry)
+{
+	entry->len = 0U;
+	entry->due = 0U;
+
+	inflight_save(client, entry);
+}
+
+static struct mqtt_inflight *inflight_find(struct mqtt_client *client,
+					   u16_t message_id)
+{
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->len > 0 && entry->message_id == message_id) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static u8_t inflight_type(const struct mqtt_inflight *entry)
+{
+	return entry->data[0] & 0xF0;
+}
+
+u16_t mqtt_inflight_next_id(struct mqtt_client *client)
+{
+	u16_t message_id = client->internal.last_message_id;
+
+	/* Zero is not a valid message ID, and there are always fewer
+	 * entries in the window than IDs.
+	 */
+	do {
+		message_id++;
+		if (message_id == 0U) {
+			message_id = 1U;
+		}
+	} while (inflight_find(client, message_id) != NULL);
+
+	client->internal.last_message_id = message_id;
+
+	return message_id;
+}
+
+int mqtt_inflight_store(struct mqtt_client *client, u16_t message_id,
+			const u8_t *header, u32_t header_len,
+			const u8_t *payload, u32_t payload_len,
+			struct mqtt_inflight **entry)
+{
+	struct mqtt_inflight *free_entry = NULL;
+
+	if (header_len + payload_len > slot_size(client)) {
+		return -EMSGSIZE;
+	}
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		if (client->internal.inflight[i].len == 0U) {
+			free_entry = &client->internal.inflight[i];
+			break;
+		}
+	}
+
+	if (free_entry == NULL) {
+		return -EAGAIN;
+	}
+
+	free_entry->data = slot_data(client, free_entry);
+	memcpy(free_entry->data, header, header_len);
+	if (payload_len > 0) {
+		memcpy(free_entry->data + header_len, payload, payload_len);
+	}
+
+	free_entry->len = header_len + payload_len;
+	free_entry->message_id = message_id;
+	free_entry->sent = 0U;
+	free_entry->due = 0U;
+
+	inflight_save(client, free_entry);
+
+	*entry = free_entry;
+
+	return 0;
+}
+
+bool mqtt_inflight_ack(struct mqtt_client *client, u8_t type,
+		       u16_t message_id)
+{
+	struct mqtt_pubrel_param pubrel = { .message_id = message_id };
+	u8_t pubrel_buf[MQTT_FIXED_HEADER_MAX_SIZE + sizeof(u16_t)];
+	struct buf_ctx packet = {
+		.cur = pubrel_buf,
+		.end = pubrel_buf + sizeof(pubrel_buf),
+	};
+	struct mqtt_inflight *entry;
+
+	entry = inflight_find(client, message_id);
+	if (entry == NULL) {
+		/* Not published through the window. */
+		return false;
+	}
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+		if (inflight_type(entry) == MQTT_PKT_TYPE_PUBLISH) {
+			inflight_free(client, entry);
+		}
+
+		break;
+
+	case MQTT_PKT_TYPE_PUBREC:
+		if (inflight_type(entry) == MQTT_PKT_TYPE_PUBREL) {
+			/* PUBREC sent again, so was the PUBREL lost. */
+			entry->due = 1U;
+			break;
+		}
+
+		if (publish_release_encode(&pubrel, &packet) < 0) {
+			break;
+		}
+
+		/* The broker owns the message now, what remains to be
+		 * acknowledged is the PUBREL.
+		 */
+		entry->len = packet.end - packet.cur;
+		memcpy(entry->data, packet.cur, entry->len);
+		entry->due = 1U;
+
+		inflight_save(client, entry);
+		break;
+
+	case MQTT_PKT_TYPE_PUBCOMP:
+		if (inflight_type(entry) == MQTT_PKT_TYPE_PUBREL) {
+			inflight_free(client, entry);
+		}
+
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+void mqtt_inflight_resume(struct mqtt_client *client,
+			  const struct mqtt_connack_param *param)
+{
+	bool session_present;
+
+	/* MQTT 3.1.0 has no session present flag, the session is resumed
+	 * whenever it is not a clean one.
+	 */
+	if (client->protocol_version == MQTT_VERSION_3_1_1) {
+		session_present = param->session_present_flag;
+	} else {
+		session_present = !client->clean_session;
+	}
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->len == 0U) {
+			continue;
+		}
+
+		if (session_present) {
+			entry->due = 1U;
+		} else {
+			MQTT_TRC("[CID %p]: No session, message id 0x%04x "
+				 "dropped", client, entry->message_id);
+			inflight_free(client, entry);
+		}
+	}
+}
+
+struct mqtt_inflight *mqtt_inflight_due(struct mqtt_client *client)
+{
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		struct mqtt_inflight *entry = &client->internal.inflight[i];
+
+		if (entry->len == 0U) {
+			continue;
+		}
+
+		if (entry->due ||
+		    (CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT > 0 &&
+		     mqtt_elapsed_time_in_ms_get(entry->sent) >=
+		     CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+void mqtt_inflight_sent(struct mqtt_client *client,
+			struct mqtt_inflight *entry)
+{
+	/* Any later transmission of a PUBLISH is a duplicate. */
+	if (inflight_type(entry) == MQTT_PKT_TYPE_PUBLISH) {
+		entry->data[0] |= MQTT_HEADER_DUP_MASK;
+	}
+
+	entry->sent = mqtt_sys_tick_in_ms_get();
+	entry->due = 0U;
+}
+
+u32_t mqtt_inflight_time_left(const struct mqtt_client *client)
+{
+	u32_t time_left = UINT32_MAX;
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		const struct mqtt_inflight *entry =
+			&client->internal.inflight[i];
+		u32_t elapsed_time;
+
+		if (entry->len == 0U) {
+			continue;
+		}
+
+		if (entry->due) {
+			return 0;
+		}
+
+		if (CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT == 0) {
+			continue;
+		}
+
+		elapsed_time = mqtt_elapsed_time_in_ms_get(entry->sent);
+		if (elapsed_time >= CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT) {
+			return 0;
+		}
+
+		time_left = MIN(time_left, CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT -
+					   elapsed_time);
+	}
+
+	return time_left;
+}
+
+#if defined(CONFIG_MQTT_INFLIGHT_SETTINGS)
+static int inflight_load(const char *key, size_t len,
+			 settings_read_cb read_cb, void *cb_arg, void *param)
+{
+	struct mqtt_client *client = param;
+	struct mqtt_publish_param publish;
+	struct mqtt_pubrel_param pubrel;
+	struct mqtt_inflight *entry;
+	struct buf_ctx buf;
+	u8_t type_and_flags;
+	u32_t length;
+	unsigned long index;
+	char *end;
+	int err_code;
+
+	if (key == NULL) {
+		return 0;
+	}
+
+	index = strtoul(key, &end, 10);
+	if (end == key || *end != '\0' || index >= CONFIG_MQTT_INFLIGHT_MAX) {
+		return 0;
+	}
+
+	/* Older values come first, the last one found is current. */
+	entry = &client->internal.inflight[index];
+	entry->len = 0U;
+	entry->due = 0U;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if (len > slot_size(client)) {
+		MQTT_ERR("[CID %p]: Message in slot %lu too large (%zu)",
+			 client, index, len);
+		return 0;
+	}
+
+	entry->data = slot_data(client, entry);
+	if (read_cb(cb_arg, entry->data, len) != len) {
+		return 0;
+	}
+
+	buf.cur = entry->data;
+	buf.end = entry->data + len;
+
+	err_code = fixed_header_decode(&buf, &type_and_flags, &length);
+	if (err_code < 0) {
+		return 0;
+	}
+
+	if ((type_and_flags & 0xF0) == MQTT_PKT_TYPE_PUBLISH) {
+		err_code = publish_decode(type_and_flags, length, &buf,
+					  &publish);
+		entry->message_id = publish.message_id;
+		entry->data[0] |= MQTT_HEADER_DUP_MASK;
+	} else {
+		err_code = publish_release_decode(&buf, &pubrel);
+		entry->message_id = pubrel.message_id;
+	}
+
+	if (err_code < 0) {
+		return 0;
+	}
+
+	entry->len = len;
+	entry->due = 1U;
+
+	return 0;
+}
+
+int mqtt_inflight_restore(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	if (client->inflight_buf == NULL) {
+		return -ENOMEM;
+	}
+
+	mqtt_mutex_lock(client);
+
+	err_code = settings_load_subtree_direct(INFLIGHT_SETTINGS_KEY,
+						inflight_load, client);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+#endif /* CONFIG_MQTT_INFLIGHT_SETTINGS */
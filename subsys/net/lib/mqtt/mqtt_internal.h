@@ -388,6 +388,79 @@ int subscribe_ack_decode(struct buf_ctx *buf,
 int unsubscribe_ack_decode(struct buf_ctx *buf,
 			   struct mqtt_unsuback_param *param);
 
+/**@brief Allocate a message ID not used by the publications in flight.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return Message ID, never 0.
+ */
+u16_t mqtt_inflight_next_id(struct mqtt_client *client);
+
+/**@brief Keep a PUBLISH packet until it is acknowledged.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] message_id Message ID of the publication.
+ * @param[in] header Encoded PUBLISH packet, without the payload.
+ * @param[in] header_len Length of the encoded packet.
+ * @param[in] payload Payload of the publication.
+ * @param[in] payload_len Length of the payload.
+ * @param[out] entry Entry keeping the complete packet.
+ *
+ * @return 0 if the procedure is successful, -EAGAIN if the window is full,
+ *         -EMSGSIZE if the packet does not fit an entry.
+ */
+int mqtt_inflight_store(struct mqtt_client *client, u16_t message_id,
+			const u8_t *header, u32_t header_len,
+			const u8_t *payload, u32_t payload_len,
+			struct mqtt_inflight **entry);
+
+/**@brief Handle the acknowledgment of a publication in flight.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] type MQTT_PKT_TYPE_PUBACK, MQTT_PKT_TYPE_PUBREC or
+ *                 MQTT_PKT_TYPE_PUBCOMP.
+ * @param[in] message_id Message ID acknowledged.
+ *
+ * @return true if the message was published through the window, false if
+ *         the acknowledgment is left to the application.
+ */
+bool mqtt_inflight_ack(struct mqtt_client *client, u8_t type,
+		       u16_t message_id);
+
+/**@brief Send the publications in flight again if the broker resumed the
+ *        session, drop them otherwise.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] param Connect Ack accepting the connection.
+ */
+void mqtt_inflight_resume(struct mqtt_client *client,
+			  const struct mqtt_connack_param *param);
+
+/**@brief Get a publication in flight to be sent, either on request or
+ *        because its retry timeout expired.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return Entry to be sent, NULL if none.
+ */
+struct mqtt_inflight *mqtt_inflight_due(struct mqtt_client *client);
+
+/**@brief Record the transmission of a publication in flight.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] entry Entry that was sent.
+ */
+void mqtt_inflight_sent(struct mqtt_client *client,
+			struct mqtt_inflight *entry);
+
+/**@brief Time until a publication in flight is to be sent again.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return Time in milliseconds, UINT32_MAX if none is to be sent again.
+ */
+u32_t mqtt_inflight_time_left(const struct mqtt_client *client);
+
 #ifdef __cplusplus
 }
 #endif
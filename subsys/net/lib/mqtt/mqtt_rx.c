@@ -42,6 +42,11 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+				mqtt_inflight_resume(client,
+						     &evt.param.connack);
+#endif
 			}
 
 			evt.result = evt.param.connack.return_code;
@@ -75,6 +80,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(buf, &evt.param.puback);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+		if (err_code == 0) {
+			mqtt_inflight_ack(client, MQTT_PKT_TYPE_PUBACK,
+					  evt.param.puback.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -83,6 +95,17 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBREC;
 		err_code = publish_receive_decode(buf, &evt.param.pubrec);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+		/* The library answers with PUBREL for the messages in the
+		 * window, the application only hears of their PUBCOMP.
+		 */
+		if (err_code == 0 &&
+		    mqtt_inflight_ack(client, MQTT_PKT_TYPE_PUBREC,
+				      evt.param.pubrec.message_id)) {
+			notify_event = false;
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -99,6 +122,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBCOMP;
 		err_code = publish_complete_decode(buf, &evt.param.pubcomp);
 		evt.result = err_code;
+
+#if defined(CONFIG_MQTT_INFLIGHT)
+		if (err_code == 0) {
+			mqtt_inflight_ack(client, MQTT_PKT_TYPE_PUBCOMP,
+					  evt.param.pubcomp.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
@@ -123,6 +123,10 @@ int zsock_socket_internal(int family, int type, int proto)
 	/* recv_q and accept_q are in union */
 	k_fifo_init(&ctx->recv_q);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	sys_slist_init(&ctx->epoll_items);
+#endif
+
 #ifdef CONFIG_USERSPACE
 	/* Set net context object as initialized and grant access to the
 	 * calling thread (and only the calling thread)
@@ -200,6 +204,7 @@ int zsock_close_ctx(struct net_context *ctx)
 		(void)net_context_recv(ctx, NULL, K_NO_WAIT, NULL);
 	}
 
+	zsock_epoll_detach(ctx);
 	zsock_flush_queue(ctx);
 
 	SET_ERRNO(net_context_put(ctx));
@@ -267,6 +272,7 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		k_fifo_init(&new_ctx->recv_q);
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		zsock_epoll_notify(parent);
 	}
 }
 
@@ -284,6 +290,11 @@ static void zsock_received_cb(struct net_context *ctx,
 	if (!pkt) {
 		struct net_pkt *last_pkt = k_fifo_peek_tail(&ctx->recv_q);
 
+		if (status < 0) {
+			/* The connection was reset or timed out */
+			sock_set_error(ctx);
+		}
+
 		if (!last_pkt) {
 			/* If there're no packets in the queue, recv() may
 			 * be blocked waiting on it to become non-empty,
@@ -296,6 +307,8 @@ static void zsock_received_cb(struct net_context *ctx,
 			net_pkt_set_eof(last_pkt, true);
 			NET_DBG("Set EOF flag on pkt %p", last_pkt);
 		}
+
+		zsock_epoll_notify(ctx);
 		return;
 	}
 
@@ -307,6 +320,7 @@ static void zsock_received_cb(struct net_context *ctx,
 	}
 
 	k_fifo_put(&ctx->recv_q, pkt);
+	zsock_epoll_notify(ctx);
 }
 
 int zsock_bind_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -622,6 +636,173 @@ static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int count;
+	ssize_t ret;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	for (count = 0U; count < vlen; count++) {
+		ret = vtable->sendmsg(ctx, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	/* As on Linux, an error is only reported if nothing was sent */
+	if (count == 0U && vlen > 0U) {
+		return -1;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static void zsock_mmsg_free(struct zsock_mmsghdr *msgvec, unsigned int vlen)
+{
+	for (unsigned int i = 0U; i < vlen; i++) {
+		k_free(msgvec[i].msg_hdr.msg_iov);
+	}
+
+	k_free(msgvec);
+}
+
+/* Copy a message vector and its iovec arrays from user mode, and check
+ * that the buffers they point to can be accessed. The copy is what the
+ * socket code works on, so the user thread cannot change the pointers
+ * once they have been checked.
+ */
+static int zsock_mmsg_from_user(struct zsock_mmsghdr *msgvec,
+				unsigned int vlen, bool write,
+				struct zsock_mmsghdr **copy)
+{
+	struct zsock_mmsghdr *msgs;
+	struct msghdr *msg;
+	struct iovec *iov;
+	unsigned int i;
+	size_t size;
+
+	if (vlen == 0U) {
+		/* Nothing to copy, the call only checks the socket */
+		*copy = NULL;
+		return 0;
+	}
+
+	if (size_mul_overflow(vlen, sizeof(*msgvec), &size)) {
+		return -EFAULT;
+	}
+
+	msgs = z_user_alloc_from_copy(msgvec, size);
+	if (!msgs) {
+		return -ENOMEM;
+	}
+
+	for (i = 0U; i < vlen; i++) {
+		msg = &msgs[i].msg_hdr;
+		iov = msg->msg_iov;
+		msg->msg_iov = NULL;
+
+		if (msg->msg_iovlen > 0) {
+			if (size_mul_overflow(msg->msg_iovlen, sizeof(*iov),
+					      &size)) {
+				goto fault;
+			}
+
+			msg->msg_iov = z_user_alloc_from_copy(iov, size);
+			if (!msg->msg_iov) {
+				goto fault;
+			}
+		}
+
+		for (size_t j = 0; j < msg->msg_iovlen; j++) {
+			iov = &msg->msg_iov[j];
+			if (Z_SYSCALL_MEMORY(iov->iov_base, iov->iov_len,
+					     write)) {
+				goto fault;
+			}
+		}
+
+		if (msg->msg_name &&
+		    Z_SYSCALL_MEMORY(msg->msg_name, msg->msg_namelen, write)) {
+			goto fault;
+		}
+
+		if (write) {
+			/* Ancillary data is not received */
+			msg->msg_control = NULL;
+			msg->msg_controllen = 0;
+		} else if (msg->msg_control &&
+			   Z_SYSCALL_MEMORY_READ(msg->msg_control,
+						 msg->msg_controllen)) {
+			goto fault;
+		}
+	}
+
+	*copy = msgs;
+
+	return 0;
+
+fault:
+	/* The entries after i still point to user memory */
+	zsock_mmsg_free(msgs, i + 1);
+
+	return -EFAULT;
+}
+
+/* Report the outcome of the first count messages back to user mode */
+static void zsock_mmsg_to_user(struct zsock_mmsghdr *msgvec,
+			       struct zsock_mmsghdr *copy, unsigned int count)
+{
+	for (unsigned int i = 0U; i < count; i++) {
+		(void)z_user_to_copy(&msgvec[i].msg_len, &copy[i].msg_len,
+				     sizeof(msgvec[i].msg_len));
+		(void)z_user_to_copy(&msgvec[i].msg_hdr.msg_namelen,
+				     &copy[i].msg_hdr.msg_namelen,
+				     sizeof(socklen_t));
+	}
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *copy;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	ret = zsock_mmsg_from_user(msgvec, vlen, false, &copy);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, copy, vlen, flags);
+	if (ret > 0) {
+		zsock_mmsg_to_user(msgvec, copy, ret);
+	}
+
+	zsock_mmsg_free(copy, vlen);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -725,6 +906,44 @@ error:
 	return ret;
 }
 
+/* Scatter the data of a datagram over the buffers of msg */
+static ssize_t zsock_recv_dgram_msg(struct net_context *ctx,
+				    struct net_pkt *pkt, struct msghdr *msg)
+{
+	size_t recv_len = 0;
+	size_t len;
+	int ret;
+
+	if (msg->msg_name && msg->msg_namelen) {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					    msg->msg_name, msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (net_pkt_family(pkt) == AF_INET) {
+			msg->msg_namelen = sizeof(struct sockaddr_in);
+		} else if (net_pkt_family(pkt) == AF_INET6) {
+			msg->msg_namelen = sizeof(struct sockaddr_in6);
+		} else {
+			return -ENOTSUP;
+		}
+	}
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		len = MIN(msg->msg_iov[i].iov_len,
+			  net_pkt_remaining_data(pkt));
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			return -ENOBUFS;
+		}
+
+		recv_len += len;
+	}
+
+	return recv_len;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       void *buf,
 				       size_t max_len,
@@ -968,6 +1187,346 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* The datagrams are taken off the queue one after the other, without
+ * going through the socket layer again for each of them.
+ */
+static int zsock_recvmmsg_ctx(struct net_context *ctx,
+			      struct zsock_mmsghdr *msgvec,
+			      unsigned int vlen, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	unsigned int count;
+	ssize_t ret = 0;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	for (count = 0U; count < vlen; count++) {
+		pkt = k_fifo_get(&ctx->recv_q, timeout);
+		if (!pkt) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		ret = zsock_recv_dgram_msg(ctx, pkt, &msgvec[count].msg_hdr);
+
+		net_stats_update_tc_rx_time(net_pkt_iface(pkt),
+					    net_pkt_priority(pkt),
+					    net_pkt_timestamp(pkt)->nanosecond,
+					    k_cycle_get_32());
+
+		net_pkt_unref(pkt);
+
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			timeout = K_NO_WAIT;
+		}
+	}
+
+	if (count == 0U && vlen > 0U) {
+		errno = -ret;
+		return -1;
+	}
+
+	return count;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return zsock_recvmmsg_ctx(ctx, msgvec, vlen, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *copy;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	ret = zsock_mmsg_from_user(msgvec, vlen, true, &copy);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, copy, vlen, flags);
+	if (ret > 0) {
+		zsock_mmsg_to_user(msgvec, copy, ret);
+	}
+
+	zsock_mmsg_free(copy, vlen);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+struct zsock_zc_tx {
+	zsock_zc_done_cb_t cb;
+	void *user_data;
+	const void *data;
+	size_t len;
+};
+
+static void zsock_zc_tx_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(zsock_zc_tx_pool, CONFIG_NET_SOCKETS_ZEROCOPY_TX_BUFS,
+		    0, 0, zsock_zc_tx_destroy);
+
+static struct zsock_zc_tx zc_tx[CONFIG_NET_SOCKETS_ZEROCOPY_TX_BUFS];
+
+/* Called once the stack has dropped its last reference to the data */
+static void zsock_zc_tx_destroy(struct net_buf *buf)
+{
+	struct zsock_zc_tx tx = zc_tx[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+
+	if (tx.cb) {
+		tx.cb(tx.data, tx.len, tx.user_data);
+	}
+}
+
+static struct net_context *zsock_zc_get_ctx(int sock)
+{
+	/* TLS and offloaded sockets do not keep their data in net_pkt */
+	return z_get_fd_obj(sock,
+			    (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			    EOPNOTSUPP);
+}
+
+/* Move the cursor off the end of a fragment, and return the length of
+ * the data that follows it in the same fragment.
+ */
+static size_t zsock_zc_span(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor cursor = pkt->cursor;
+
+	while (cursor.buf &&
+	       cursor.pos == cursor.buf->data + cursor.buf->len) {
+		cursor.buf = cursor.buf->frags;
+		cursor.pos = cursor.buf ? cursor.buf->data : NULL;
+	}
+
+	net_pkt_cursor_restore(pkt, &cursor);
+
+	if (!cursor.buf) {
+		return 0;
+	}
+
+	return MIN((size_t)(cursor.buf->data + cursor.buf->len - cursor.pos),
+		   net_pkt_remaining_data(pkt));
+}
+
+/* Drop the fully consumed head packet */
+static void zsock_zc_dequeue(struct net_context *ctx, struct net_pkt *pkt)
+{
+	k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	net_stats_update_tc_rx_time(net_pkt_iface(pkt),
+				    net_pkt_priority(pkt),
+				    net_pkt_timestamp(pkt)->nanosecond,
+				    k_cycle_get_32());
+
+	net_pkt_unref(pkt);
+}
+
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	int res;
+
+	ctx = zsock_zc_get_ctx(sock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	zc->data = NULL;
+	zc->len = 0;
+	zc->more = false;
+
+	do {
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		res = k_fifo_wait_non_empty(&ctx->recv_q, timeout);
+		/* EAGAIN when timeout expired, EINTR when cancelled */
+		if (res && res != -EAGAIN && res != -EINTR) {
+			errno = -res;
+			return -1;
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		zc->len = zsock_zc_span(pkt);
+		if (zc->len == 0) {
+			/* An empty datagram, or a stream packet that only
+			 * carries the EOF.
+			 */
+			zsock_zc_dequeue(ctx, pkt);
+
+			if (net_context_get_type(ctx) == SOCK_DGRAM) {
+				return 0;
+			}
+		}
+	} while (zc->len == 0);
+
+	zc->data = net_pkt_cursor_get_pos(pkt);
+	zc->more = net_pkt_remaining_data(pkt) > zc->len;
+
+	return zc->len;
+}
+
+int zsock_recv_zc_release(int sock, struct zsock_zc_buf *zc)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+
+	ctx = zsock_zc_get_ctx(sock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (zc->data == NULL) {
+		/* Nothing was received */
+		return 0;
+	}
+
+	pkt = k_fifo_peek_head(&ctx->recv_q);
+	if (!pkt || net_pkt_cursor_get_pos(pkt) != zc->data ||
+	    net_pkt_remaining_data(pkt) < zc->len) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	(void)net_pkt_skip(pkt, zc->len);
+
+	if (net_pkt_remaining_data(pkt) == 0) {
+		zsock_zc_dequeue(ctx, pkt);
+	}
+
+	if (net_context_get_type(ctx) == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, zc->len);
+	}
+
+	zc->data = NULL;
+	zc->len = 0;
+
+	return 0;
+}
+
+ssize_t zsock_sendto_zc(int sock, const void *buf, size_t len, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen,
+			zsock_zc_done_cb_t cb, void *user_data)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	struct zsock_zc_tx *tx;
+	struct net_buf *nbuf;
+	int status;
+
+	ctx = zsock_zc_get_ctx(sock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	nbuf = net_buf_alloc_with_data(&zsock_zc_tx_pool, (void *)buf, len,
+				       timeout);
+	if (!nbuf) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	tx = &zc_tx[net_buf_id(nbuf)];
+	tx->cb = cb;
+	tx->user_data = user_data;
+	tx->data = buf;
+	tx->len = len;
+
+	/* Keep the buffer until the outcome is known, a failed send must
+	 * not complete it.
+	 */
+	status = net_context_send_buf(ctx, net_buf_ref(nbuf), dest_addr,
+				      addrlen, NULL, timeout, ctx->user_data);
+	if (status < 0) {
+		tx->cb = NULL;
+	}
+
+	net_buf_unref(nbuf);
+
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	return status;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1266,6 +1825,44 @@ static inline int z_vrfy_zsock_inet_pton(sa_family_t family,
 #include <syscalls/zsock_inet_pton_mrsh.c>
 #endif
 
+/* Boolean options are ints at the socket API and bools in net_context */
+static int sock_set_bool_option(struct net_context *ctx,
+				enum net_context_option option,
+				const void *optval, socklen_t optlen)
+{
+	bool value;
+
+	if (optval == NULL || optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	value = *(const int *)optval != 0;
+
+	return net_context_set_option(ctx, option, &value, sizeof(value));
+}
+
+static int sock_get_bool_option(struct net_context *ctx,
+				enum net_context_option option,
+				void *optval, socklen_t *optlen)
+{
+	bool value;
+	int ret;
+
+	if (optval == NULL || optlen == NULL || *optlen < sizeof(int)) {
+		return -EINVAL;
+	}
+
+	ret = net_context_get_option(ctx, option, &value, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*(int *)optval = value;
+	*optlen = sizeof(int);
+
+	return 0;
+}
+
 int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 void *optval, socklen_t *optlen)
 {
@@ -1288,6 +1885,41 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 		}
 
+		break;
+
+	case IPPROTO_TCP:
+		switch (optname) {
+		case TCP_NODELAY:
+			if (IS_ENABLED(CONFIG_NET_TCP2)) {
+				ret = sock_get_bool_option(ctx,
+							   NET_OPT_TCP_NODELAY,
+							   optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
+		case TCP_CORK:
+			if (IS_ENABLED(CONFIG_NET_TCP2)) {
+				ret = sock_get_bool_option(ctx,
+							   NET_OPT_TCP_CORK,
+							   optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+		}
+
 		break;
 	}
 
@@ -1415,10 +2047,36 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 	case IPPROTO_TCP:
 		switch (optname) {
 		case TCP_NODELAY:
-			/* Ignore for now. Provided to let port
-			 * existing apps.
-			 */
+			if (!IS_ENABLED(CONFIG_NET_TCP2)) {
+				/* Ignore, this stack sends small
+				 * segments at once anyway.
+				 */
+				return 0;
+			}
+
+			ret = sock_set_bool_option(ctx, NET_OPT_TCP_NODELAY,
+						   optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
 			return 0;
+
+		case TCP_CORK:
+			if (IS_ENABLED(CONFIG_NET_TCP2)) {
+				ret = sock_set_bool_option(ctx,
+							   NET_OPT_TCP_CORK,
+							   optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 		break;
 
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* epoll() style event API. Each instance keeps the sockets added to it on
+ * an interest list, and the sockets that may be ready on a ready list. The
+ * socket receive callbacks move entries to the ready list, so waiting only
+ * looks at the sockets that got something since the last wait.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <sys/dlist.h>
+#include <sys/fdtable.h>
+#include <net/net_context.h>
+#include <net/socket.h>
+
+#include "sockets_internal.h"
+
+/* Events that are reported whether asked for or not */
+#define EPOLL_ALWAYS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+#define EPOLL_FLAGS (ZSOCK_EPOLLET | ZSOCK_EPOLLONESHOT)
+
+struct epoll_item {
+	/** Node in the socket's list of entries */
+	sys_snode_t ctx_node;
+	/** Node in the instance's interest list */
+	sys_dnode_t node;
+	/** Node in the instance's ready list */
+	sys_dnode_t ready_node;
+	struct zsock_epoll *ep;
+	struct net_context *ctx;
+	struct zsock_epoll_event event;
+	int fd;
+};
+
+struct zsock_epoll {
+	sys_dlist_t interest;
+	sys_dlist_t ready;
+	struct k_sem wait;
+	bool in_use;
+};
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static struct zsock_epoll epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+
+K_MEM_SLAB_DEFINE(epoll_items, sizeof(struct epoll_item),
+		  CONFIG_NET_SOCKETS_EPOLL_MAX_ITEMS, 4);
+
+/* Protects the lists of all the instances and sockets. Socket callbacks
+ * are called from the network threads, never from an ISR.
+ */
+static K_MUTEX_DEFINE(epoll_lock);
+
+static u32_t epoll_ready_events(struct net_context *ctx)
+{
+	/* As with poll(), a socket is always writable */
+	u32_t events = ZSOCK_EPOLLOUT;
+
+	/* recv_q and accept_q are shared via a union */
+	if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+		events |= ZSOCK_EPOLLIN;
+	}
+
+	/* The peer closed, and what it sent has been read. recv() then
+	 * returns 0 right away.
+	 */
+	if (sock_is_eof(ctx)) {
+		events |= ZSOCK_EPOLLHUP;
+	}
+
+	/* The connection was lost rather than closed */
+	if (sock_is_error(ctx)) {
+		events |= ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP;
+	}
+
+	return events;
+}
+
+static void epoll_item_ready(struct epoll_item *item)
+{
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		return;
+	}
+
+	if (!(item->event.events & ~EPOLL_FLAGS)) {
+		/* Disabled by ZSOCK_EPOLLONESHOT */
+		return;
+	}
+
+	sys_dlist_append(&item->ep->ready, &item->ready_node);
+	k_sem_give(&item->ep->wait);
+}
+
+static void epoll_item_free(struct epoll_item *item)
+{
+	sys_slist_find_and_remove(&item->ctx->epoll_items, &item->ctx_node);
+	sys_dlist_remove(&item->node);
+
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	k_mem_slab_free(&epoll_items, (void **)&item);
+}
+
+static struct epoll_item *epoll_item_find(struct zsock_epoll *ep, int fd)
+{
+	struct epoll_item *item;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->interest, item, node) {
+		if (item->fd == fd) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct epoll_item *item;
+
+	/* Most sockets are in no instance, they do not take the lock for
+	 * every packet. The packet is queued before this check, and
+	 * epoll_add() looks at the queue after linking its entry, so a
+	 * socket being added meanwhile is still found ready.
+	 */
+	if (sys_slist_is_empty(&ctx->epoll_items)) {
+		return;
+	}
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		epoll_item_ready(item);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+void zsock_epoll_detach(struct net_context *ctx)
+{
+	struct epoll_item *item, *next;
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&ctx->epoll_items, item, next,
+					  ctx_node) {
+		epoll_item_free(item);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+int zsock_epoll_create(int flags)
+{
+	struct zsock_epoll *ep = NULL;
+	int fd, i;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	sys_dlist_init(&ep->interest);
+	sys_dlist_init(&ep->ready);
+	k_sem_init(&ep->wait, 0, 1);
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+static int epoll_add(struct zsock_epoll *ep, int fd, struct net_context *ctx,
+		     struct zsock_epoll_event *event)
+{
+	struct epoll_item *item;
+
+	if (epoll_item_find(ep, fd) != NULL) {
+		return -EEXIST;
+	}
+
+	if (k_mem_slab_alloc(&epoll_items, (void **)&item, K_NO_WAIT) < 0) {
+		return -ENOMEM;
+	}
+
+	(void)memset(item, 0, sizeof(*item));
+	item->ep = ep;
+	item->ctx = ctx;
+	item->fd = fd;
+	item->event = *event;
+
+	sys_dlist_append(&ep->interest, &item->node);
+	sys_slist_append(&ctx->epoll_items, &item->ctx_node);
+
+	if (epoll_ready_events(ctx) & (event->events | EPOLL_ALWAYS)) {
+		epoll_item_ready(item);
+	}
+
+	return 0;
+}
+
+static int epoll_mod(struct zsock_epoll *ep, int fd,
+		     struct zsock_epoll_event *event)
+{
+	struct epoll_item *item = epoll_item_find(ep, fd);
+
+	if (item == NULL) {
+		return -ENOENT;
+	}
+
+	item->event = *event;
+
+	/* Edge triggered sockets get a new edge, as on Linux */
+	if (epoll_ready_events(item->ctx) & (event->events | EPOLL_ALWAYS)) {
+		epoll_item_ready(item);
+	}
+
+	return 0;
+}
+
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+	struct epoll_item *item;
+	struct zsock_epoll *ep;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* TLS, packet and offloaded sockets keep their own queues */
+	if (vtable != &sock_fd_op_vtable.fd_vtable) {
+		errno = EPERM;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_add(ep, fd, ctx, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		ret = epoll_mod(ep, fd, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		item = epoll_item_find(ep, fd);
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_free(item);
+		ret = 0;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Report the entries of the ready list that are still ready. Level
+ * triggered ones stay on the list, behind the others so that a small
+ * maxevents does not starve the sockets after them.
+ */
+static int epoll_collect(struct zsock_epoll *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_item *item, *next;
+	sys_dlist_t again;
+	sys_dnode_t *node;
+	u32_t revents;
+	int count = 0;
+
+	sys_dlist_init(&again);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->ready, item, next,
+					  ready_node) {
+		if (count == maxevents) {
+			break;
+		}
+
+		sys_dlist_remove(&item->ready_node);
+
+		revents = epoll_ready_events(item->ctx) &
+			(item->event.events | EPOLL_ALWAYS);
+		if (revents == 0U) {
+			continue;
+		}
+
+		events[count].events = revents;
+		events[count].data = item->event.data;
+		count++;
+
+		if (item->event.events & ZSOCK_EPOLLONESHOT) {
+			item->event.events &= EPOLL_FLAGS;
+		} else if (!(item->event.events & ZSOCK_EPOLLET)) {
+			sys_dlist_append(&again, &item->ready_node);
+		}
+	}
+
+	while ((node = sys_dlist_get(&again)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	return count;
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	struct zsock_epoll *ep;
+	k_timeout_t wait;
+	s64_t remaining;
+	u64_t end;
+	int count;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	wait = timeout < 0 ? K_FOREVER : K_MSEC(timeout);
+	end = z_timeout_end_calc(wait);
+
+	for (;;) {
+		k_mutex_lock(&epoll_lock, K_FOREVER);
+		count = epoll_collect(ep, events, maxevents);
+
+		/* A level triggered socket still on the ready list must
+		 * wake up the next waiter too.
+		 */
+		if (!sys_dlist_is_empty(&ep->ready)) {
+			k_sem_give(&ep->wait);
+		}
+
+		k_mutex_unlock(&epoll_lock);
+
+		if (count > 0 || K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			return count;
+		}
+
+		if (!K_TIMEOUT_EQ(wait, K_FOREVER)) {
+			remaining = end - z_tick_get();
+			if (remaining <= 0) {
+				return 0;
+			}
+
+			wait = Z_TIMEOUT_TICKS(remaining);
+		}
+
+		/* Woken up by a socket callback */
+		(void)k_sem_take(&ep->wait, wait);
+	}
+}
+
+static int epoll_close(struct zsock_epoll *ep)
+{
+	struct epoll_item *item, *next;
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->interest, item, next, node) {
+		epoll_item_free(item);
+	}
+
+	ep->in_use = false;
+
+	k_mutex_unlock(&epoll_lock);
+
+	return 0;
+}
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	switch (request) {
+	case ZFD_IOCTL_CLOSE:
+		return epoll_close(obj);
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
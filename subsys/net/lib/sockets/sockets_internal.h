@@ -11,6 +11,7 @@
 
 #define SOCK_EOF 1
 #define SOCK_NONBLOCK 2
+#define SOCK_ERROR 4
 
 static inline void sock_set_flag(struct net_context *ctx, uintptr_t mask,
 				 uintptr_t flag)
@@ -29,6 +30,25 @@ static inline uintptr_t sock_get_flag(struct net_context *ctx, uintptr_t mask)
 #define sock_is_eof(ctx) sock_get_flag(ctx, SOCK_EOF)
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
+#define sock_is_error(ctx) sock_get_flag(ctx, SOCK_ERROR)
+#define sock_set_error(ctx) sock_set_flag(ctx, SOCK_ERROR, SOCK_ERROR)
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* Put the epoll entries of a socket on the ready lists */
+void zsock_epoll_notify(struct net_context *ctx);
+/* Remove a closed socket from the epoll instances */
+void zsock_epoll_detach(struct net_context *ctx);
+#else
+static inline void zsock_epoll_notify(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void zsock_epoll_detach(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 
 struct socket_op_vtable {
 	struct fd_op_vtable fd_vtable;
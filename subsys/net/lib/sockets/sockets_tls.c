@@ -32,6 +32,12 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/x509_crt.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/ssl_cookie.h>
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include <mbedtls/ssl_cache.h>
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
 #endif /* CONFIG_MBEDTLS */
@@ -39,6 +45,10 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include "sockets_internal.h"
 #include "tls_internal.h"
 
+#if defined(MBEDTLS_SSL_CACHE_C) || defined(MBEDTLS_SSL_TICKET_C)
+#define TLS_SERVER_SESSIONS
+#endif
+
 extern const struct socket_op_vtable sock_fd_op_vtable;
 
 static const struct socket_op_vtable tls_sock_fd_op_vtable;
@@ -102,8 +112,16 @@ struct tls_context {
 
 		/** DTLS role, client by default. */
 		s8_t role;
+
+		/** Information whether sessions are cached for resumption. */
+		bool cache_enabled;
 	} options;
 
+#if defined(TLS_SERVER_SESSIONS)
+	/** Sessions a server resumes, those of its credentials only. */
+	struct tls_server_sessions *server_sessions;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	/** Context information for DTLS timing. */
 	struct dtls_timing_context dtls_timing;
@@ -147,9 +165,100 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
+/* Length of the hostnames kept with client sessions, the sessions of
+ * longer hostnames are not cached.
+ */
+#define SESSION_HOSTNAME_LEN 64
+
+/** A TLS session kept by a client, to be resumed on a later connection. */
+struct tls_session_cache {
+	/** Information whether the entry is used. */
+	bool is_used;
+
+	/** Uptime of when the session was stored. */
+	u32_t timestamp;
+
+	/** Address of the peer the session was established with. */
+	struct sockaddr peer_addr;
+
+	/** Secure tags of the credentials the session was established with. */
+	struct sec_tag_list sec_tag_list;
+
+	/** Hostname the peer was verified against, empty if none. */
+	char hostname[SESSION_HOSTNAME_LEN];
+
+	/** mbedTLS session, including the session ticket if any. */
+	mbedtls_ssl_session session;
+};
+
+#if defined(MBEDTLS_SSL_CLI_C)
+static struct tls_session_cache
+		client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT];
+#endif
+
+#if defined(TLS_SERVER_SESSIONS)
+/** Sessions resumed by the TLS servers using the same credentials. A
+ * session is only resumed with the credentials and the peer verification
+ * it was established with.
+ */
+struct tls_server_sessions {
+	/** Information whether the entry is used. */
+	bool is_used;
+
+	/** Number of TLS contexts using the sessions. */
+	u8_t refs;
+
+	/** Secure tags of the credentials of the servers. */
+	struct sec_tag_list sec_tag_list;
+
+	/** Peer verification level of the servers. */
+	s8_t verify_level;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	/** Session ID cache. */
+	mbedtls_ssl_cache_context cache;
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/** Session ticket keys. */
+	mbedtls_ssl_ticket_context tickets;
+
+	/** Information whether the ticket keys were set up. */
+	bool tickets_ready;
+#endif
+};
+
+static struct tls_server_sessions
+		server_sessions[CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_CACHES];
+#endif /* TLS_SERVER_SESSIONS */
+
+/* A mutex for protecting the session caches, mbedTLS does not lock them
+ * itself as it is built without threading support.
+ */
+static struct k_mutex session_cache_lock;
+
 #define IS_LISTENING(context) (net_context_get_state(context) == \
 			       NET_CONTEXT_LISTENING)
 
+/* Largest record a TLS client can ask its peer to send, so that the
+ * records always fit in the input buffer, whatever its configured size.
+ */
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+#if MBEDTLS_SSL_IN_CONTENT_LEN >= 16384
+#define TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_NONE
+#elif MBEDTLS_SSL_IN_CONTENT_LEN >= 4096
+#define TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_4096
+#elif MBEDTLS_SSL_IN_CONTENT_LEN >= 2048
+#define TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_2048
+#elif MBEDTLS_SSL_IN_CONTENT_LEN >= 1024
+#define TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_1024
+#elif MBEDTLS_SSL_IN_CONTENT_LEN >= 512
+#define TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_512
+#else
+#define TLS_MAX_FRAG_LEN MBEDTLS_SSL_MAX_FRAG_LEN_NONE
+#endif
+#endif /* MBEDTLS_SSL_MAX_FRAGMENT_LENGTH */
+
 #if defined(MBEDTLS_DEBUG_C) && (CONFIG_NET_SOCKETS_LOG_LEVEL >= LOG_LEVEL_DBG)
 static void tls_debug(void *ctx, int level, const char *file,
 		      int line, const char *str)
@@ -274,6 +383,7 @@ static int tls_init(struct device *unused)
 	(void)memset(tls_contexts, 0, sizeof(tls_contexts));
 
 	k_mutex_init(&context_lock);
+	k_mutex_init(&session_cache_lock);
 
 	mbedtls_ctr_drbg_init(&tls_ctr_drbg);
 
@@ -299,6 +409,139 @@ static inline bool is_handshake_complete(struct net_context *ctx)
 	return k_sem_count_get(&ctx->tls->tls_established) != 0;
 }
 
+#if defined(TLS_SERVER_SESSIONS)
+static bool tls_server_sessions_match(struct tls_server_sessions *entry,
+				      struct tls_context *tls)
+{
+	struct sec_tag_list *tags = &tls->options.sec_tag_list;
+
+	return entry->verify_level == tls->options.verify_level &&
+	       entry->sec_tag_list.sec_tag_count == tags->sec_tag_count &&
+	       !memcmp(entry->sec_tag_list.sec_tags, tags->sec_tags,
+		       tags->sec_tag_count * sizeof(sec_tag_t));
+}
+
+static void tls_server_sessions_free(struct tls_server_sessions *entry)
+{
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_free(&entry->cache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_free(&entry->tickets);
+#endif
+	entry->is_used = false;
+}
+
+static void tls_server_sessions_init(struct tls_server_sessions *entry,
+				     struct tls_context *tls)
+{
+	memcpy(&entry->sec_tag_list, &tls->options.sec_tag_list,
+	       sizeof(entry->sec_tag_list));
+	entry->verify_level = tls->options.verify_level;
+	entry->refs = 0U;
+	entry->is_used = true;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_init(&entry->cache);
+	mbedtls_ssl_cache_set_max_entries(
+			&entry->cache,
+			CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT);
+	mbedtls_ssl_cache_set_timeout(&entry->cache,
+				      CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&entry->tickets);
+
+	entry->tickets_ready =
+		mbedtls_ssl_ticket_setup(&entry->tickets,
+					 mbedtls_ctr_drbg_random,
+					 &tls_ctr_drbg,
+					 MBEDTLS_CIPHER_AES_256_GCM,
+					 CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME)
+		== 0;
+	if (!entry->tickets_ready) {
+		NET_WARN("TLS session tickets initialization failed");
+	}
+#endif
+}
+
+/* The sessions of the servers using the same credentials as tls. Those
+ * of credentials no server uses any more are dropped to make room.
+ */
+static struct tls_server_sessions *tls_server_sessions_get(
+						struct tls_context *tls)
+{
+	struct tls_server_sessions *entry = NULL;
+	int i;
+
+	if (tls->server_sessions) {
+		return tls->server_sessions;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(server_sessions); i++) {
+		if (server_sessions[i].is_used &&
+		    tls_server_sessions_match(&server_sessions[i], tls)) {
+			entry = &server_sessions[i];
+			goto out;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(server_sessions); i++) {
+		if (!server_sessions[i].is_used) {
+			entry = &server_sessions[i];
+			break;
+		}
+
+		if (!entry && server_sessions[i].refs == 0U) {
+			entry = &server_sessions[i];
+		}
+	}
+
+	if (!entry) {
+		NET_DBG("No TLS session cache left, sessions not resumed");
+		goto out;
+	}
+
+	if (entry->is_used) {
+		tls_server_sessions_free(entry);
+	}
+
+	tls_server_sessions_init(entry, tls);
+
+out:
+	if (entry) {
+		entry->refs++;
+		tls->server_sessions = entry;
+	}
+
+	k_mutex_unlock(&session_cache_lock);
+
+	return entry;
+}
+
+static void tls_server_sessions_put(struct tls_context *tls)
+{
+	if (!tls->server_sessions) {
+		return;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	/* The sessions are kept for the next server with the credentials */
+	tls->server_sessions->refs--;
+	tls->server_sessions = NULL;
+
+	k_mutex_unlock(&session_cache_lock);
+}
+#else
+static inline void tls_server_sessions_put(struct tls_context *tls)
+{
+}
+#endif /* TLS_SERVER_SESSIONS */
+
 /* Allocate TLS context. */
 static struct tls_context *tls_alloc(void)
 {
@@ -383,6 +626,8 @@ static int tls_release(struct tls_context *tls)
 		return -EBADF;
 	}
 
+	tls_server_sessions_put(tls);
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	mbedtls_ssl_cookie_free(&tls->cookie);
 #endif
@@ -715,6 +960,26 @@ static int tls_set_credential(struct tls_context *tls,
 	return 0;
 }
 
+/* Certificates and keys are not used past the handshake, unless it can be
+ * renegotiated. Free them once a TLS connection is established, so that an
+ * idle connection only holds on to its session and record buffers.
+ */
+static void tls_mbedtls_free_credentials(struct tls_context *tls)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && !defined(MBEDTLS_SSL_RENEGOTIATION)
+	mbedtls_ssl_conf_ca_chain(&tls->config, NULL, NULL);
+
+	/* The configuration still refers to the own certificate and key,
+	 * they are left empty.
+	 */
+	mbedtls_x509_crt_free(&tls->ca_chain);
+	mbedtls_x509_crt_free(&tls->own_cert);
+	mbedtls_pk_free(&tls->priv_key);
+#else
+	ARG_UNUSED(tls);
+#endif
+}
+
 static int tls_mbedtls_set_credentials(struct tls_context *tls)
 {
 	struct tls_credential *cred;
@@ -758,6 +1023,304 @@ exit:
 	return err;
 }
 
+static const char *tls_session_hostname(struct tls_context *tls)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (tls->options.is_hostname_set && tls->ssl.hostname) {
+		return tls->ssl.hostname;
+	}
+#endif
+
+	return "";
+}
+
+static const struct sockaddr *tls_session_peer_addr(struct net_context *ctx)
+{
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
+	if (net_context_get_type(ctx) == SOCK_DGRAM) {
+		return &ctx->tls->dtls_peer_addr;
+	}
+#endif
+
+	return &ctx->remote;
+}
+
+static bool tls_session_peer_addr_cmp(const struct sockaddr *addr1,
+				      const struct sockaddr *addr2)
+{
+	if (addr1->sa_family != addr2->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr1->sa_family == AF_INET6) {
+		return (net_sin6(addr1)->sin6_port ==
+			net_sin6(addr2)->sin6_port) &&
+			net_ipv6_addr_cmp(&net_sin6(addr1)->sin6_addr,
+					  &net_sin6(addr2)->sin6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   addr1->sa_family == AF_INET) {
+		return (net_sin(addr1)->sin_port == net_sin(addr2)->sin_port) &&
+			net_ipv4_addr_cmp(&net_sin(addr1)->sin_addr,
+					  &net_sin(addr2)->sin_addr);
+	}
+
+	return false;
+}
+
+#if defined(MBEDTLS_SSL_CLI_C)
+static void tls_session_free(struct tls_session_cache *entry)
+{
+	mbedtls_ssl_session_free(&entry->session);
+	entry->is_used = false;
+}
+
+/* Find the session established with the same peer, hostname and
+ * credentials. Must be called with session_cache_lock held.
+ */
+static struct tls_session_cache *tls_session_find(struct net_context *context)
+{
+	const struct sockaddr *peer_addr = tls_session_peer_addr(context);
+	const char *hostname = tls_session_hostname(context->tls);
+	struct sec_tag_list *tags = &context->tls->options.sec_tag_list;
+	struct tls_session_cache *entry;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		entry = &client_cache[i];
+
+		if (!entry->is_used) {
+			continue;
+		}
+
+		if (k_uptime_get_32() - entry->timestamp >=
+		    CONFIG_NET_SOCKETS_TLS_SESSION_LIFETIME * MSEC_PER_SEC) {
+			tls_session_free(entry);
+			continue;
+		}
+
+		if (tls_session_peer_addr_cmp(&entry->peer_addr, peer_addr) &&
+		    entry->sec_tag_list.sec_tag_count == tags->sec_tag_count &&
+		    !memcmp(entry->sec_tag_list.sec_tags, tags->sec_tags,
+			    tags->sec_tag_count * sizeof(sec_tag_t)) &&
+		    !strcmp(entry->hostname, hostname)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Offer the session cached for the peer, if any, in the next handshake. */
+static void tls_session_restore(struct net_context *context)
+{
+	struct tls_session_cache *entry;
+	int ret;
+
+	if (!context->tls->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (entry) {
+		ret = mbedtls_ssl_set_session(&context->tls->ssl,
+					      &entry->session);
+		if (ret != 0) {
+			NET_DBG("Cannot restore TLS session: -%x", -ret);
+		}
+	}
+
+	k_mutex_unlock(&session_cache_lock);
+}
+
+/* Keep the session just established, in place of the one cached for the
+ * same peer or else of the oldest one.
+ */
+static void tls_session_store(struct net_context *context)
+{
+	const char *hostname = tls_session_hostname(context->tls);
+	struct tls_session_cache *entry;
+	int i, ret;
+
+	if (!context->tls->options.cache_enabled) {
+		return;
+	}
+
+	if (strlen(hostname) >= SESSION_HOSTNAME_LEN) {
+		NET_DBG("Hostname too long, TLS session not cached");
+		return;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(context);
+	if (!entry) {
+		for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+			if (!client_cache[i].is_used) {
+				entry = &client_cache[i];
+				break;
+			}
+
+			if (!entry ||
+			    (s32_t)(client_cache[i].timestamp -
+				    entry->timestamp) < 0) {
+				entry = &client_cache[i];
+			}
+		}
+	}
+
+	if (entry->is_used) {
+		tls_session_free(entry);
+	}
+
+	mbedtls_ssl_session_init(&entry->session);
+
+	ret = mbedtls_ssl_get_session(&context->tls->ssl, &entry->session);
+	if (ret != 0) {
+		NET_DBG("Cannot store TLS session: -%x", -ret);
+		mbedtls_ssl_session_free(&entry->session);
+		goto out;
+	}
+
+	memcpy(&entry->peer_addr, tls_session_peer_addr(context),
+	       sizeof(entry->peer_addr));
+	memcpy(&entry->sec_tag_list, &context->tls->options.sec_tag_list,
+	       sizeof(entry->sec_tag_list));
+	strcpy(entry->hostname, hostname);
+	entry->timestamp = k_uptime_get_32();
+	entry->is_used = true;
+
+out:
+	k_mutex_unlock(&session_cache_lock);
+}
+
+static void tls_session_purge(void)
+{
+	int i;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(client_cache); i++) {
+		if (client_cache[i].is_used) {
+			tls_session_free(&client_cache[i]);
+		}
+	}
+
+	k_mutex_unlock(&session_cache_lock);
+}
+#else
+static inline void tls_session_restore(struct net_context *context)
+{
+}
+
+static inline void tls_session_store(struct net_context *context)
+{
+}
+
+static inline void tls_session_purge(void)
+{
+}
+#endif /* MBEDTLS_SSL_CLI_C */
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int server_cache_get(void *data, mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+
+static int server_cache_set(void *data, const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int server_ticket_write(void *p_ticket,
+			       const mbedtls_ssl_session *session,
+			       unsigned char *start, const unsigned char *end,
+			       size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_write(p_ticket, session, start, end, tlen,
+				       lifetime);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+
+static int server_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+			       unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	k_mutex_unlock(&session_cache_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+static void tls_session_conf(struct tls_context *tls, bool is_server)
+{
+#if defined(TLS_SERVER_SESSIONS)
+	struct tls_server_sessions *sessions;
+#endif
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+	/* Tickets are only worth asking for if they are kept */
+	if (!is_server) {
+		mbedtls_ssl_conf_session_tickets(&tls->config,
+				tls->options.cache_enabled ?
+				MBEDTLS_SSL_SESSION_TICKETS_ENABLED :
+				MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+	}
+#endif
+
+	if (!is_server || !tls->options.cache_enabled) {
+		return;
+	}
+
+#if defined(TLS_SERVER_SESSIONS)
+	/* A session of other credentials is neither found in the cache
+	 * nor decrypted from its ticket, a full handshake is done.
+	 */
+	sessions = tls_server_sessions_get(tls);
+	if (!sessions) {
+		return;
+	}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_conf_session_cache(&tls->config, &sessions->cache,
+				       server_cache_get, server_cache_set);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (sessions->tickets_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&tls->config,
+						    server_ticket_write,
+						    server_ticket_parse,
+						    &sessions->tickets);
+	}
+#endif
+#endif /* TLS_SERVER_SESSIONS */
+}
+
 static int tls_mbedtls_reset(struct net_context *context)
 {
 	int ret;
@@ -809,6 +1372,15 @@ static int tls_mbedtls_handshake(struct net_context *context, bool block)
 	}
 
 	if (ret == 0) {
+		if (context->tls->config.endpoint == MBEDTLS_SSL_IS_CLIENT) {
+			tls_session_store(context);
+		}
+
+		/* A DTLS server handshakes again with its next peer */
+		if (net_context_get_type(context) == SOCK_STREAM) {
+			tls_mbedtls_free_credentials(context->tls);
+		}
+
 		k_sem_give(&context->tls->tls_established);
 	}
 
@@ -901,10 +1473,26 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 					  context->tls->options.verify_level);
 	}
 
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+	/* Have the server send records that fit in the input buffer, when
+	 * it is smaller than the records allowed by the standard. Servers
+	 * follow what their clients ask for.
+	 */
+	if (!is_server) {
+		ret = mbedtls_ssl_conf_max_frag_len(&context->tls->config,
+						    TLS_MAX_FRAG_LEN);
+		if (ret != 0) {
+			return -EINVAL;
+		}
+	}
+#endif
+
 	mbedtls_ssl_conf_rng(&context->tls->config,
 			     mbedtls_ctr_drbg_random,
 			     &tls_ctr_drbg);
 
+	tls_session_conf(context->tls, is_server);
+
 	ret = tls_mbedtls_set_credentials(context->tls);
 	if (ret != 0) {
 		return ret;
@@ -919,6 +1507,10 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 		return -ENOMEM;
 	}
 
+	if (!is_server) {
+		tls_session_restore(context);
+	}
+
 	context->tls->is_initialized = true;
 
 	return 0;
@@ -1112,6 +1704,58 @@ static int tls_opt_dtls_role_set(struct net_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_set(struct net_context *context,
+				     const void *optval, socklen_t optlen)
+{
+	int *cache;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	cache = (int *)optval;
+	if (*cache != TLS_SESSION_CACHE_DISABLED &&
+	    *cache != TLS_SESSION_CACHE_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->tls->options.cache_enabled =
+				(*cache == TLS_SESSION_CACHE_ENABLED);
+
+	return 0;
+}
+
+static int tls_opt_session_cache_get(struct net_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->tls->options.cache_enabled ?
+				TLS_SESSION_CACHE_ENABLED :
+				TLS_SESSION_CACHE_DISABLED;
+
+	return 0;
+}
+
+static int tls_opt_session_cache_purge_set(struct net_context *context,
+					   const void *optval,
+					   socklen_t optlen)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(optval);
+	ARG_UNUSED(optlen);
+
+	tls_session_purge();
+
+	return 0;
+}
+
 static int ztls_socket(int family, int type, int proto)
 {
 	enum net_ip_protocol_secure tls_proto = 0;
@@ -1872,6 +2516,10 @@ int ztls_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_ciphersuite_used_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_get(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or write-only option. */
 		err = -ENOPROTOOPT;
@@ -1922,6 +2570,14 @@ int ztls_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_dtls_role_set(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_set(ctx, optval, optlen);
+		break;
+
+	case TLS_SESSION_CACHE_PURGE:
+		err = tls_opt_session_cache_purge_set(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or read-only option. */
 		err = -ENOPROTOOPT;
@@ -445,6 +445,49 @@ static int websocket_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+/* Masks or unmasks len bytes of payload from src to dst, which may be the
+ * same buffer. The offset is the position of src[0] within the frame
+ * payload and selects the byte of the masking key to start with.
+ * The bulk is done a machine word at a time: the key repeats every four
+ * bytes, so once the word is lined up with the key it is the same for every
+ * word of the payload.
+ */
+static void websocket_mask_payload(u8_t *dst, const u8_t *src, size_t len,
+				   u32_t masking_value, u64_t offset)
+{
+	u8_t mask_bytes[sizeof(unsigned long)];
+	unsigned long mask_word;
+	size_t i;
+
+	/* Byte at a time until dst is word aligned */
+	for (i = 0; i < len &&
+		     ((uintptr_t)&dst[i] & (sizeof(unsigned long) - 1)); i++) {
+		dst[i] = src[i] ^
+			 (u8_t)(masking_value >> (8 * (3 - (offset + i) % 4)));
+	}
+
+	if (len - i >= sizeof(unsigned long)) {
+		for (int j = 0; j < sizeof(mask_bytes); j++) {
+			mask_bytes[j] = masking_value >>
+					(8 * (3 - (offset + i + j) % 4));
+		}
+
+		memcpy(&mask_word, mask_bytes, sizeof(mask_word));
+
+		for (; len - i >= sizeof(unsigned long);
+		     i += sizeof(unsigned long)) {
+			*(unsigned long *)&dst[i] =
+				UNALIGNED_GET((const unsigned long *)&src[i]) ^
+				mask_word;
+		}
+	}
+
+	for (; i < len; i++) {
+		dst[i] = src[i] ^
+			 (u8_t)(masking_value >> (8 * (3 - (offset + i) % 4)));
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      u8_t *header, size_t header_len,
 				      u8_t *payload, size_t payload_len,
@@ -553,28 +596,24 @@ int websocket_send_msg(int ws_sock, const u8_t *payload, size_t payload_len,
 		hdr_len += 8;
 	}
 
-	/* Add masking value if needed */
+	/* Add masking value if needed. The key is only used for this frame,
+	 * ctx->masking_value belongs to the frame being received.
+	 */
 	if (mask) {
-		int i;
-
-		ctx->masking_value = sys_rand32_get();
+		u32_t masking_value = sys_rand32_get();
 
-		header[hdr_len++] |= ctx->masking_value >> 24;
-		header[hdr_len++] |= ctx->masking_value >> 16;
-		header[hdr_len++] |= ctx->masking_value >> 8;
-		header[hdr_len++] |= ctx->masking_value;
+		header[hdr_len++] |= masking_value >> 24;
+		header[hdr_len++] |= masking_value >> 16;
+		header[hdr_len++] |= masking_value >> 8;
+		header[hdr_len++] |= masking_value;
 
 		data_to_send = k_malloc(payload_len);
 		if (!data_to_send) {
 			return -ENOMEM;
 		}
 
-		memcpy(data_to_send, payload, payload_len);
-
-		for (i = 0; i < payload_len; i++) {
-			data_to_send[i] ^=
-				ctx->masking_value >> (8 * (3 - i % 4));
-		}
+		websocket_mask_payload(data_to_send, payload, payload_len,
+				       masking_value, 0);
 	}
 
 	ret = websocket_prepare_and_send(ctx, header, hdr_len,
@@ -656,6 +695,60 @@ static bool websocket_parse_header(u8_t *buf, size_t buf_len, bool *masked,
 	return false;
 }
 
+/* Continuation frames carry no type of their own, they are reported with
+ * the type of the first frame of the message so that a fragmented message
+ * can be consumed as it arrives. Control frames may come in between.
+ */
+static void websocket_track_fragments(struct websocket_context *ctx)
+{
+	u32_t data_type;
+
+	if ((ctx->message_type & ~WEBSOCKET_FLAG_FINAL) == 0U) {
+		ctx->message_type |= ctx->fragment_type;
+	}
+
+	data_type = ctx->message_type &
+		    (WEBSOCKET_FLAG_TEXT | WEBSOCKET_FLAG_BINARY);
+	if (data_type == 0U) {
+		return;
+	}
+
+	if (ctx->message_type & WEBSOCKET_FLAG_FINAL) {
+		ctx->fragment_type = 0U;
+	} else {
+		ctx->fragment_type = data_type;
+	}
+}
+
+/* Parses the header at the start of the temp buffer, returns true once all
+ * of it has been received.
+ */
+static bool websocket_header_buffered(struct websocket_context *ctx,
+				      size_t *header_len)
+{
+	bool masked;
+
+	if (ctx->tmp_buf_pos < MIN_HEADER_LEN) {
+		return false;
+	}
+
+	/* Now we will be able to figure out what is the actual size of
+	 * the header.
+	 */
+	ctx->message_type = 0U;
+
+	if (!websocket_parse_header(&ctx->tmp_buf[0], ctx->tmp_buf_pos,
+				    &masked, &ctx->masking_value,
+				    &ctx->message_len, &ctx->message_type,
+				    header_len)) {
+		return false;
+	}
+
+	ctx->masked = masked;
+
+	return ctx->tmp_buf_pos >= *header_len;
+}
+
 int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 		       u32_t *message_type, u64_t *remaining, s32_t timeout)
 {
@@ -694,8 +787,12 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 	}
 #endif /* CONFIG_NET_TEST */
 
-	/* If we have not received the websocket header yet, read it first */
-	if (!ctx->header_received) {
+	/* If we have not received the websocket header yet, read it first.
+	 * The previous read may have left all of it in the temp buffer
+	 * already, in which case there is nothing to wait for.
+	 */
+	if (!ctx->header_received &&
+	    !websocket_header_buffered(ctx, &header_len)) {
 #if defined(CONFIG_NET_TEST)
 		size_t input_len = MIN(ctx->tmp_buf_len - ctx->tmp_buf_pos,
 				       test_data->input_len);
@@ -721,40 +818,23 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 
 		ctx->tmp_buf_pos += ret;
 
-		if (ctx->tmp_buf_pos >= MIN_HEADER_LEN) {
-			bool masked;
-
-			/* Now we will be able to figure out what is the
-			 * actual size of the header.
-			 */
-			if (websocket_parse_header(&ctx->tmp_buf[0],
-						   ctx->tmp_buf_pos,
-						   &masked,
-						   &ctx->masking_value,
-						   &ctx->message_len,
-						   &ctx->message_type,
-						   &header_len)) {
-				ctx->masked = masked;
-
-				if (message_type) {
-					*message_type = ctx->message_type;
-				}
-			} else {
-				return -EAGAIN;
-			}
-		} else {
-			return -EAGAIN;
-		}
-
-		if (ctx->tmp_buf_pos < header_len) {
+		if (!websocket_header_buffered(ctx, &header_len)) {
 			return -EAGAIN;
 		}
+	}
 
+	if (!ctx->header_received) {
 		/* All of the header is now received, we can read the payload
 		 * data next.
 		 */
 		ctx->header_received = true;
 
+		websocket_track_fragments(ctx);
+
+		if (message_type) {
+			*message_type = ctx->message_type;
+		}
+
 		if (HEXDUMP_RECV_PACKETS) {
 			LOG_HEXDUMP_DBG(&ctx->tmp_buf[0], header_len,
 					"Header");
@@ -766,9 +846,9 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 
 		ctx->total_read = 0;
 
-		memmove(ctx->tmp_buf, &ctx->tmp_buf[header_len],
-			ctx->tmp_buf_len - header_len);
 		ctx->tmp_buf_pos -= header_len;
+		memmove(ctx->tmp_buf, &ctx->tmp_buf[header_len],
+			ctx->tmp_buf_pos);
 
 		if (ctx->tmp_buf_pos == 0) {
 			/* No data after the header, let the caller call
@@ -782,17 +862,19 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 
 	/* Now read the whole payload or parts of it */
 
-	if (ctx->tmp_buf_pos == 0) {
-		/* Read more data into temp buffer */
-#if defined(CONFIG_NET_TEST)
-		size_t input_len = MIN(ctx->tmp_buf_len, test_data->input_len);
+	if (ctx->tmp_buf_pos == 0 && ctx->total_read < ctx->message_len) {
+		/* Nothing is left over in the temp buffer, so the payload
+		 * is read straight into the caller's buffer.
+		 */
+		can_copy = MIN(ctx->message_len - ctx->total_read, buf_len);
 
-		memcpy(ctx->tmp_buf, test_data->input_buf, input_len);
-		test_data->input_buf += input_len;
+#if defined(CONFIG_NET_TEST)
+		ret = MIN(can_copy, test_data->input_len);
 
-		ret = input_len;
+		memcpy(buf, test_data->input_buf, ret);
+		test_data->input_buf += ret;
 #else
-		ret = recv(ctx->real_sock, ctx->tmp_buf, ctx->tmp_buf_len,
+		ret = recv(ctx->real_sock, buf, can_copy,
 			   K_TIMEOUT_EQ(tout, K_NO_WAIT) ? MSG_DONTWAIT : 0);
 #endif /* CONFIG_NET_TEST */
 
@@ -804,55 +886,43 @@ int websocket_recv_msg(int ws_sock, u8_t *buf, size_t buf_len,
 			return 0;
 		}
 
-		ctx->tmp_buf_pos = ret;
-	}
-
-	if (ctx->tmp_buf_pos <= buf_len) {
-		/* Is there already any data in the temp buffer? If yes,
-		 * just return it to the caller.
-		 */
-		can_copy = MIN(ctx->message_len - ctx->total_read,
-			       ctx->tmp_buf_pos);
+		recv_len = ret;
 	} else {
-		/* We have more data in tmp buffer that will fit into
-		 * user buffer.
-		 */
-		can_copy = MIN(ctx->message_len - ctx->total_read, buf_len);
-	}
+		/* Hand out what was read together with the header first */
+		can_copy = MIN(ctx->message_len - ctx->total_read,
+			       MIN(ctx->tmp_buf_pos, buf_len));
 
-	left = ctx->tmp_buf_pos - can_copy;
+		left = ctx->tmp_buf_pos - can_copy;
 
-	NET_ASSERT(ctx->tmp_buf_pos >= can_copy);
+		memmove(buf, ctx->tmp_buf, can_copy);
+		recv_len = can_copy;
 
-	memmove(buf, ctx->tmp_buf, can_copy);
-	recv_len = can_copy;
+		if (left > 0) {
+			memmove(ctx->tmp_buf, &ctx->tmp_buf[can_copy], left);
+		}
 
-	if (left > 0) {
-		memmove(ctx->tmp_buf, &ctx->tmp_buf[can_copy], left);
+		ctx->tmp_buf_pos = left;
 	}
 
-	ctx->tmp_buf_pos = left;
 	ctx->total_read += recv_len;
 
-	/* Unmask the data */
+	/* Unmask the data. As we might have received the payload in pieces
+	 * that are not a multiple of 4 bytes, the masking key is applied
+	 * from where the previous piece left off.
+	 */
 	if (ctx->masked) {
-		/* As we might have less than 4 received bytes, we must select
-		 * which byte from masking value to take. The mask_shift will
-		 * tell that.
-		 */
-		int mask_shift = (ctx->total_read - recv_len) % sizeof(u32_t);
-		int i;
-
-		for (i = 0; i < recv_len; i++) {
-			buf[i] ^= ctx->masking_value >>
-				(8 * (3 - (i + mask_shift) % 4));
-		}
+		websocket_mask_payload(buf, buf, recv_len, ctx->masking_value,
+				       ctx->total_read - recv_len);
 	}
 
 #if HEXDUMP_RECV_PACKETS
 	LOG_HEXDUMP_DBG(buf, recv_len, "Payload");
 #endif
 
+	if (message_type) {
+		*message_type = ctx->message_type;
+	}
+
 	if (remaining) {
 		*remaining = ctx->message_len - ctx->total_read;
 	}
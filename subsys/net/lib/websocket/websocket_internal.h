@@ -87,6 +87,9 @@ struct websocket_context {
 	/** Message type */
 	u32_t message_type;
 
+	/** Type of the fragmented message being received, 0 if none */
+	u32_t fragment_type;
+
 	/** Is the message masked */
 	u8_t masked : 1;
 
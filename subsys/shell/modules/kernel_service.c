@@ -14,6 +14,8 @@
 #include <string.h>
 #include <device.h>
 #include <drivers/timer/system_timer.h>
+#include <debug/thread_runtime_stats.h>
+#include <debug/waitq_profiling.h>
 
 static int cmd_kernel_version(const struct shell *shell,
 			      size_t argc, char **argv)
@@ -171,6 +173,149 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_TRACING_CPU_STATS_THREAD)
+static void shell_runtime_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *shell = (const struct shell *)user_data;
+	struct k_thread_runtime_stats stats;
+	const char *tname;
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(shell, "%s%p %-10s %3u %%\ttotal %llu us\tswitches %u",
+		      (thread == k_current_get()) ? "*" : " ",
+		      thread,
+		      tname ? tname : "NA",
+		      stats.window_percent,
+		      k_cyc_to_us_floor64(stats.execution_cycles),
+		      stats.switch_count);
+}
+
+static int cmd_kernel_runtime(const struct shell *shell,
+			      size_t argc, char **argv)
+{
+	struct cpu_runtime_stats cpu;
+	struct isr_runtime_stats isr;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	(void)k_cpu_runtime_stats_get(&cpu);
+
+	shell_print(shell, "CPU usage: %u %% over last %llu us",
+		      cpu.window_percent,
+		      k_cyc_to_us_floor64(cpu.window_length));
+	shell_print(shell,
+		      "\tidle %llu us, threads %llu us, ISRs %llu us, "
+		      "scheduler %llu us",
+		      k_cyc_to_us_floor64(cpu.idle_cycles),
+		      k_cyc_to_us_floor64(cpu.thread_cycles),
+		      k_cyc_to_us_floor64(cpu.isr_cycles),
+		      k_cyc_to_us_floor64(cpu.sched_cycles));
+
+	shell_print(shell, "Threads:");
+	k_thread_foreach(shell_runtime_dump, (void *)shell);
+
+	shell_print(shell, "Interrupts:");
+	for (unsigned int i = 0; i < isr_runtime_stats_lines(); i++) {
+		if (isr_runtime_stats_get(i, &isr) != 0 || isr.count == 0U) {
+			continue;
+		}
+
+		shell_print(shell,
+			      " IRQ %3u\tcount %u\ttotal %llu us\tmax %llu us",
+			      i, isr.count,
+			      k_cyc_to_us_floor64(isr.execution_cycles),
+			      k_cyc_to_us_floor64(isr.max_cycles));
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_WAITQ_PROFILING)
+#if defined(CONFIG_OBJECT_TRACING)
+#define WAITQ_OWNER_FIND(type, name, wait_q)				\
+	do {								\
+		type *obj = SYS_TRACING_HEAD(type, name);		\
+									\
+		while (obj != NULL) {					\
+			if (&obj->wait_q == (wait_q)) {			\
+				return #name;				\
+			}						\
+			obj = SYS_TRACING_NEXT(type, name, obj);	\
+		}							\
+	} while (false)
+
+static const char *waitq_owner_type(const _wait_q_t *wait_q)
+{
+	WAITQ_OWNER_FIND(struct k_mutex, k_mutex, wait_q);
+	WAITQ_OWNER_FIND(struct k_sem, k_sem, wait_q);
+	WAITQ_OWNER_FIND(struct k_queue, k_queue, wait_q);
+	WAITQ_OWNER_FIND(struct k_msgq, k_msgq, wait_q);
+	WAITQ_OWNER_FIND(struct k_stack, k_stack, wait_q);
+
+	return "object";
+}
+#else
+static const char *waitq_owner_type(const _wait_q_t *wait_q)
+{
+	ARG_UNUSED(wait_q);
+
+	return "object";
+}
+#endif
+
+static void shell_waitq_dump(const struct waitq_profile *profile,
+			     void *user_data)
+{
+	const struct shell *shell = (const struct shell *)user_data;
+	const char *tname;
+
+	shell_print(shell, "%s %p: contentions %u, timeouts %u, "
+		      "total %llu us, max %llu us",
+		      waitq_owner_type(profile->wait_q),
+		      profile->wait_q,
+		      profile->contentions,
+		      profile->timeouts,
+		      k_cyc_to_us_floor64(profile->total_wait_cycles),
+		      k_cyc_to_us_floor64(profile->max_wait_cycles));
+
+	for (int i = 0; i < ARRAY_SIZE(profile->top); i++) {
+		if (profile->top[i].thread == NULL) {
+			break;
+		}
+
+		tname = k_thread_name_get((k_tid_t)profile->top[i].thread);
+
+		shell_print(shell, "\t%p %-10s waits %u, total %llu us",
+			      profile->top[i].thread,
+			      tname ? tname : "NA",
+			      profile->top[i].count,
+			      k_cyc_to_us_floor64(
+				      profile->top[i].wait_cycles));
+	}
+}
+
+static int cmd_kernel_contention(const struct shell *shell,
+				 size_t argc, char **argv)
+{
+	if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+		waitq_profile_reset();
+		return 0;
+	}
+
+	waitq_profile_foreach(shell_waitq_dump, (void *)shell);
+	shell_print(shell, "evicted profiles: %u", waitq_profile_evictions());
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -198,10 +343,19 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 #endif
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
+#if defined(CONFIG_WAITQ_PROFILING)
+	SHELL_CMD_ARG(contention, NULL,
+		      "List kernel object contention, \"reset\" to clear.",
+		      cmd_kernel_contention, 1, 1),
+#endif
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
+#if defined(CONFIG_TRACING_CPU_STATS_THREAD)
+	SHELL_CMD(runtime, NULL, "List thread and ISR CPU usage.",
+		  cmd_kernel_runtime),
+#endif
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 		defined(CONFIG_THREAD_MONITOR)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
@@ -16,6 +16,96 @@
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
+#ifdef CONFIG_SMP
+struct z_stats_cpu_seq z_stats_cpu_seqs[CONFIG_MP_NUM_CPUS];
+#endif
+
+static bool
+stats_is_percpu(const struct stats_hdr *hdr)
+{
+	return (hdr->s_flags & STATS_HDR_F_PERCPU) != 0U;
+}
+
+/* Distance between the copies of an entry owned by two consecutive CPUs,
+ * each copy padded to a whole number of cache lines.
+ */
+static size_t
+stats_cpu_stride(const struct stats_hdr *hdr)
+{
+	size_t len = (size_t)hdr->s_size * hdr->s_cnt;
+
+	return stats_is_percpu(hdr) ? ROUND_UP(len, STATS_PERCPU_ALIGN) : len;
+}
+
+/* Offset of the first entry, the copies of a per-CPU group start on a
+ * cache line boundary.
+ */
+static size_t
+stats_first_off(const struct stats_hdr *hdr)
+{
+	return stats_is_percpu(hdr) ?
+	       ROUND_UP(sizeof(*hdr), STATS_PERCPU_ALIGN) : sizeof(*hdr);
+}
+
+static u16_t
+stats_get_off(const struct stats_hdr *hdr, int idx)
+{
+	return stats_first_off(hdr) + idx * hdr->s_size;
+}
+
+static u64_t
+stats_read_entry(const u8_t *ptr, u8_t size)
+{
+	switch (size) {
+	case sizeof(u16_t):
+		return *(const u16_t *)ptr;
+	case sizeof(u32_t):
+		return *(const u32_t *)ptr;
+	case sizeof(u64_t):
+		return *(const u64_t *)ptr;
+	default:
+		return 0;
+	}
+}
+
+static void
+stats_write_entry(u8_t *ptr, u8_t size, u64_t value)
+{
+	switch (size) {
+	case sizeof(u16_t):
+		*(u16_t *)ptr = value;
+		break;
+	case sizeof(u32_t):
+		*(u32_t *)ptr = value;
+		break;
+	case sizeof(u64_t):
+		*(u64_t *)ptr = value;
+		break;
+	}
+}
+
+/* Read an entry of the given CPU's copy without holding off increments */
+static u64_t
+stats_read_cpu_entry(const u8_t *ptr, u8_t size, int cpu)
+{
+#ifdef CONFIG_SMP
+	atomic_t *seq = &z_stats_cpu_seqs[cpu].seq;
+	atomic_val_t start;
+	u64_t value;
+
+	do {
+		start = atomic_get(seq);
+		value = stats_read_entry(ptr, size);
+	} while ((start & 1) || atomic_get(seq) != start);
+
+	return value;
+#else
+	ARG_UNUSED(cpu);
+
+	return stats_read_entry(ptr, size);
+#endif
+}
+
 static const char *
 stats_get_name(const struct stats_hdr *hdr, int idx)
 {
@@ -29,7 +119,7 @@ stats_get_name(const struct stats_hdr *hdr, int idx)
 	 * offset.  This annotation allows for naming only certain statistics,
 	 * and doesn't enforce ordering restrictions on the stats name map.
 	 */
-	off = sizeof(*hdr) + idx * hdr->s_size;
+	off = stats_get_off(hdr, idx);
 	for (i = 0; i < hdr->s_map_cnt; i++) {
 		cur = hdr->s_map + i;
 		if (cur->snm_off == off) {
@@ -41,12 +131,6 @@ stats_get_name(const struct stats_hdr *hdr, int idx)
 	return NULL;
 }
 
-static u16_t
-stats_get_off(const struct stats_hdr *hdr, int idx)
-{
-	return sizeof(*hdr) + idx * hdr->s_size;
-}
-
 /**
  * Creates a generic name for an unnamed stat.  The name has the form:
  *     s<idx>
@@ -90,6 +174,9 @@ stats_gen_name(int idx, char *dst)
  *   ("s%d", n), where n is the number of the statistic in the structure.
  * - A pointer to the current entry.
  *
+ * For a per-CPU section the header and offset given to walk_func are those
+ * of a copy holding the sum of the CPUs' entries.
+ *
  * @return 0 on success, the return code of the walk_func on abort.
  *
  */
@@ -98,9 +185,26 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 {
 	const char *name;
 	char name_buf[STATS_GEN_NAME_MAX_LEN];
+	/* A regular group of one entry holding the sum of the copies of a
+	 * per-CPU entry, handed to walk functions reading hdr + off.
+	 */
+	struct {
+		struct stats_hdr hdr;
+		u64_t value;
+	} total;
 	int rc;
 	int i;
 
+	if (stats_is_percpu(hdr)) {
+		total.hdr = *hdr;
+		total.hdr.s_cnt = 1U;
+		total.hdr.s_flags &= ~STATS_HDR_F_PERCPU;
+#ifdef CONFIG_STATS_NAMES
+		total.hdr.s_map = NULL;
+		total.hdr.s_map_cnt = 0;
+#endif
+	}
+
 	for (i = 0; i < hdr->s_cnt; i++) {
 		name = stats_get_name(hdr, i);
 		if (name == NULL) {
@@ -109,7 +213,15 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 			name = name_buf;
 		}
 
-		rc = walk_func(hdr, arg, name, stats_get_off(hdr, i));
+		if (stats_is_percpu(hdr)) {
+			stats_write_entry((u8_t *)&total.value, hdr->s_size,
+					  stats_get(hdr, stats_get_off(hdr, i)));
+			rc = walk_func(&total.hdr, arg, name,
+				       offsetof(__typeof__(total), value));
+		} else {
+			rc = walk_func(hdr, arg, name, stats_get_off(hdr, i));
+		}
+
 		if (rc != 0) {
 			return rc;
 		}
@@ -273,6 +385,51 @@ stats_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
 	return 0;
 }
 
+/**
+ * Initializes and registers the specified per-CPU statistics section.
+ *
+ * @param shdr The statistics header to register
+ * @param size The entry size of the statistics to register either 2 (16-bit),
+ *             4 (32-bit) or 8 (64-bit).
+ * @param cnt  The number of statistics entries of one CPU.
+ * @param map  The map of statistics entry to statistics name, only used when
+ *             STATS_NAMES is enabled.
+ * @param map_cnt The number of elements in the statistics name map.
+ * @param name The name of the statistics element to register with the system.
+ *
+ * @return 0 on success, non-zero error code on failure.
+ */
+int
+stats_percpu_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
+			  const struct stats_name_map *map, u16_t map_cnt,
+			  const char *name)
+{
+	shdr->s_flags |= STATS_HDR_F_PERCPU;
+
+	return stats_init_and_reg(shdr, size, cnt, map, map_cnt, name);
+}
+
+/* Zero the copy of the given CPU, storing what it held in values if set.
+ * Increments on that CPU wait meanwhile.
+ */
+static void
+stats_clear_cpu(struct stats_hdr *hdr, int cpu, u64_t *values, u16_t cnt)
+{
+	u8_t *ptr = (u8_t *)hdr + stats_first_off(hdr) +
+		    cpu * stats_cpu_stride(hdr);
+	unsigned int key = z_stats_cpu_lock_other(cpu);
+	int i;
+
+	for (i = 0; values && i < cnt; i++) {
+		values[i] += stats_read_entry(ptr + i * hdr->s_size,
+					      hdr->s_size);
+	}
+
+	(void)memset(ptr, 0, (size_t)hdr->s_size * hdr->s_cnt);
+
+	z_stats_cpu_unlock(cpu, key);
+}
+
 /**
  * Resets and zeroes the specified statistics section.
  *
@@ -281,5 +438,98 @@ stats_init_and_reg(struct stats_hdr *shdr, u8_t size, u16_t cnt,
 void
 stats_reset(struct stats_hdr *hdr)
 {
-	(void)memset((u8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+	unsigned int key;
+	int i;
+
+	if (stats_is_percpu(hdr)) {
+		for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			stats_clear_cpu(hdr, i, NULL, 0);
+		}
+		return;
+	}
+
+	key = arch_irq_lock();
+	(void)memset((u8_t *)hdr + sizeof(*hdr), 0, stats_cpu_stride(hdr));
+	arch_irq_unlock(key);
+}
+
+/**
+ * Read a statistic entry, summing the copies of all CPUs for per-CPU
+ * sections.
+ *
+ * @param hdr The statistics header the entry belongs to
+ * @param off The offset of the entry, as passed to the walk function
+ *
+ * @return the value of the entry.
+ */
+u64_t
+stats_get(const struct stats_hdr *hdr, u16_t off)
+{
+	const u8_t *ptr = (const u8_t *)hdr + off;
+	u64_t value = 0;
+	int i;
+
+	if (!stats_is_percpu(hdr)) {
+		return stats_read_entry(ptr, hdr->s_size);
+	}
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		value += stats_read_cpu_entry(ptr, hdr->s_size, i);
+		ptr += stats_cpu_stride(hdr);
+	}
+
+	return value;
+}
+
+/**
+ * Read, and optionally zero, all the entries of a statistics section.
+ * Per-CPU sections are read through the sequence counts of the CPUs.
+ *
+ * @param hdr The statistics header to read
+ * @param values The array receiving the entries
+ * @param cnt The number of elements of values
+ * @param reset Zero the section once read
+ *
+ * @return the number of entries stored in values.
+ */
+int
+stats_snapshot(struct stats_hdr *hdr, u64_t *values, u16_t cnt, bool reset)
+{
+	unsigned int key;
+	int i;
+
+	cnt = MIN(cnt, hdr->s_cnt);
+
+	if (stats_is_percpu(hdr) && reset) {
+		(void)memset(values, 0, cnt * sizeof(values[0]));
+
+		for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+			stats_clear_cpu(hdr, i, values, cnt);
+		}
+
+		return cnt;
+	}
+
+	if (stats_is_percpu(hdr)) {
+		for (i = 0; i < cnt; i++) {
+			values[i] = stats_get(hdr, stats_get_off(hdr, i));
+		}
+
+		return cnt;
+	}
+
+	key = arch_irq_lock();
+
+	for (i = 0; i < cnt; i++) {
+		values[i] = stats_get(hdr, stats_get_off(hdr, i));
+	}
+
+	if (reset) {
+		(void)memset((u8_t *)hdr + sizeof(*hdr), 0,
+			     stats_cpu_stride(hdr));
+	}
+
+	arch_irq_unlock(key);
+
+	return cnt;
 }
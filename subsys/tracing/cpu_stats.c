@@ -8,11 +8,14 @@
 #include <sys/printk.h>
 #include <kernel_internal.h>
 #include <ksched.h>
+#include <debug/thread_runtime_stats.h>
+#include <syscall_handler.h>
 
 enum cpu_state {
 	CPU_STATE_IDLE,
 	CPU_STATE_NON_IDLE,
-	CPU_STATE_SCHEDULER
+	CPU_STATE_SCHEDULER,
+	CPU_STATE_ISR
 };
 
 static enum cpu_state last_cpu_state = CPU_STATE_SCHEDULER;
@@ -23,31 +26,219 @@ static struct cpu_stats stats_hw_tick;
 static int nested_interrupts;
 static struct k_thread *current_thread;
 
-void update_counter(volatile u64_t *cnt)
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+#if defined(CONFIG_CPU_CORTEX_M)
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+
+/* One slot per external interrupt plus one for core exceptions. */
+#define ISR_LINES (CONFIG_NUM_IRQS + 1)
+
+static inline unsigned int isr_active_line(void)
 {
-	u32_t time = k_cycle_get_32();
+	int irq = (int)__get_IPSR() - 16;
 
-	if (time >= last_time) {
-		(*cnt) += (time - last_time);
-	} else {
-		(*cnt) += (UINT32_MAX - last_time + 1 + time);
+	if (irq < 0 || irq >= CONFIG_NUM_IRQS) {
+		return CONFIG_NUM_IRQS;
+	}
+
+	return irq;
+}
+#else
+#define ISR_LINES 1
+
+static inline unsigned int isr_active_line(void)
+{
+	return 0;
+}
+#endif
+
+/* Deepest interrupt nesting tracked separately, deeper levels are
+ * accounted to the innermost tracked level.
+ */
+#define ISR_NEST_MAX 8
+
+struct isr_frame {
+	unsigned int line;
+	u32_t cycles;
+};
+
+static struct isr_runtime_stats isr_stats[ISR_LINES];
+static struct isr_frame isr_frames[ISR_NEST_MAX];
+
+static struct {
+	u64_t idle;
+	u64_t thread;
+	u64_t isr;
+	u64_t sched;
+	u64_t window_busy;
+	u64_t window_total;
+	u64_t last_window_busy;
+	u64_t last_window_total;
+	u32_t window_seq;
+} runtime;
+
+/* Window length in cycles, the window ends when window_total reaches it */
+#define WINDOW_CYCLES k_ms_to_cyc_ceil64(CONFIG_TRACING_CPU_STATS_WINDOW)
+
+static struct isr_frame *isr_frame_top(void)
+{
+	int level = MIN(nested_interrupts, ISR_NEST_MAX);
+
+	return &isr_frames[level - 1];
+}
+
+/* Threads are not visited when a window ends: the window cycles of a
+ * thread are moved to its last window the next time it is accounted or
+ * read, depending on how many windows have ended since.
+ */
+static void runtime_stats_thread_sync(struct k_thread *thread)
+{
+	u32_t age = runtime.window_seq - thread->rt_stats.window_seq;
+
+	if (age == 0U) {
+		return;
+	}
+
+	thread->rt_stats.last_window_cycles =
+		(age == 1U) ? thread->rt_stats.window_cycles : 0U;
+	thread->rt_stats.window_cycles = 0U;
+	thread->rt_stats.window_seq = runtime.window_seq;
+}
+
+static void runtime_stats_window_add(u64_t cycles)
+{
+	runtime.window_total += cycles;
+
+	if (last_cpu_state == CPU_STATE_IDLE) {
+		return;
+	}
+
+	runtime.window_busy += cycles;
+
+	if (last_cpu_state == CPU_STATE_NON_IDLE && current_thread != NULL) {
+		runtime_stats_thread_sync(current_thread);
+		current_thread->rt_stats.window_cycles += cycles;
+	}
+}
+
+static void runtime_stats_window_end(void)
+{
+	runtime.last_window_busy = runtime.window_busy;
+	runtime.last_window_total = runtime.window_total;
+	runtime.window_busy = 0U;
+	runtime.window_total = 0U;
+	runtime.window_seq++;
+}
+
+/* Windows are rolled from the accounting itself, so the cycles spent in
+ * one state are split at the window boundaries they cross.
+ */
+static void runtime_stats_window_account(u32_t delta)
+{
+	u64_t room = WINDOW_CYCLES - runtime.window_total;
+	u64_t rest;
+
+	if (delta < room) {
+		runtime_stats_window_add(delta);
+		return;
+	}
+
+	runtime_stats_window_add(room);
+	runtime_stats_window_end();
+	rest = delta - room;
+
+	if (rest >= WINDOW_CYCLES) {
+		/* Whole windows spent in the same state, only the last one
+		 * of them is kept.
+		 */
+		runtime.window_seq += rest / WINDOW_CYCLES - 1U;
+		runtime_stats_window_add(WINDOW_CYCLES);
+		runtime_stats_window_end();
+		rest %= WINDOW_CYCLES;
+	}
+
+	runtime_stats_window_add(rest);
+}
+
+static void runtime_stats_account(u32_t delta)
+{
+	runtime_stats_window_account(delta);
+
+	switch (last_cpu_state) {
+	case CPU_STATE_IDLE:
+		runtime.idle += delta;
+		return;
+
+	case CPU_STATE_NON_IDLE:
+		runtime.thread += delta;
+		break;
+
+	case CPU_STATE_ISR:
+		runtime.isr += delta;
+		isr_frame_top()->cycles += delta;
+		return;
+
+	case CPU_STATE_SCHEDULER:
+	default:
+		runtime.sched += delta;
+		return;
+	}
+
+	if (current_thread != NULL) {
+		current_thread->rt_stats.execution_cycles += delta;
+	}
+}
+
+static void isr_frame_push(void)
+{
+	if (nested_interrupts < ISR_NEST_MAX) {
+		isr_frames[nested_interrupts].line = isr_active_line();
+		isr_frames[nested_interrupts].cycles = 0U;
+	}
+}
+
+static void isr_frame_pop(void)
+{
+	struct isr_frame *frame;
+	struct isr_runtime_stats *stats;
+
+	if (nested_interrupts > ISR_NEST_MAX) {
+		return;
 	}
+
+	frame = isr_frame_top();
+	stats = &isr_stats[frame->line];
+	stats->execution_cycles += frame->cycles;
+	stats->max_cycles = MAX(stats->max_cycles, frame->cycles);
+	stats->count++;
+}
+#endif /* CONFIG_TRACING_CPU_STATS_THREAD */
+
+static u32_t cycles_elapsed(void)
+{
+	u32_t time = k_cycle_get_32();
+	u32_t delta = time - last_time;
+
 	last_time = time;
+	return delta;
 }
 
 static void cpu_stats_update_counters(void)
 {
+	u32_t delta = cycles_elapsed();
+
 	switch (last_cpu_state) {
 	case CPU_STATE_IDLE:
-		update_counter(&stats_hw_tick.idle);
+		stats_hw_tick.idle += delta;
 		break;
 
 	case CPU_STATE_NON_IDLE:
-		update_counter(&stats_hw_tick.non_idle);
+	case CPU_STATE_ISR:
+		stats_hw_tick.non_idle += delta;
 		break;
 
 	case CPU_STATE_SCHEDULER:
-		update_counter(&stats_hw_tick.sched);
+		stats_hw_tick.sched += delta;
 		break;
 
 	default:
@@ -55,6 +246,10 @@ static void cpu_stats_update_counters(void)
 		__ASSERT_NO_MSG(false);
 		break;
 	}
+
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+	runtime_stats_account(delta);
+#endif
 }
 
 void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns)
@@ -98,6 +293,9 @@ void sys_trace_thread_switched_in(void)
 
 	cpu_stats_update_counters();
 	current_thread = k_current_get();
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+	current_thread->rt_stats.switch_count++;
+#endif
 	if (z_is_idle_thread_object(current_thread)) {
 		last_cpu_state = CPU_STATE_IDLE;
 	} else {
@@ -122,11 +320,14 @@ void sys_trace_isr_enter(void)
 {
 	int key = irq_lock();
 
+	cpu_stats_update_counters();
 	if (nested_interrupts == 0) {
-		cpu_stats_update_counters();
 		cpu_state_before_interrupts = last_cpu_state;
-		last_cpu_state = CPU_STATE_NON_IDLE;
+		last_cpu_state = CPU_STATE_ISR;
 	}
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+	isr_frame_push();
+#endif
 	nested_interrupts++;
 	irq_unlock(key);
 }
@@ -135,9 +336,12 @@ void sys_trace_isr_exit(void)
 {
 	int key = irq_lock();
 
+	cpu_stats_update_counters();
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+	isr_frame_pop();
+#endif
 	nested_interrupts--;
 	if (nested_interrupts == 0) {
-		cpu_stats_update_counters();
 		last_cpu_state = cpu_state_before_interrupts;
 	}
 	irq_unlock(key);
@@ -147,6 +351,122 @@ void sys_trace_idle(void)
 {
 }
 
+#ifdef CONFIG_TRACING_CPU_STATS_THREAD
+static u32_t window_percent(u64_t cycles, u64_t length)
+{
+	if (length == 0U) {
+		return 0U;
+	}
+
+	return (u32_t)((cycles * 100U) / length);
+}
+
+int z_impl_k_thread_runtime_stats_get(k_tid_t thread,
+				      struct k_thread_runtime_stats *stats)
+{
+	int key;
+
+	if (thread == NULL || stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	cpu_stats_update_counters();
+	runtime_stats_thread_sync(thread);
+	stats->execution_cycles = thread->rt_stats.execution_cycles;
+	stats->window_cycles = thread->rt_stats.last_window_cycles;
+	stats->window_length = runtime.last_window_total;
+	stats->switch_count = thread->rt_stats.switch_count;
+	irq_unlock(key);
+
+	stats->window_percent = window_percent(stats->window_cycles,
+					       stats->window_length);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_runtime_stats_get(k_tid_t thread,
+				struct k_thread_runtime_stats *stats)
+{
+	struct k_thread_runtime_stats kstats;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(stats, sizeof(*stats)));
+
+	ret = z_impl_k_thread_runtime_stats_get(thread, &kstats);
+	if (ret == 0) {
+		Z_OOPS(z_user_to_copy(stats, &kstats, sizeof(kstats)));
+	}
+
+	return ret;
+}
+#include <syscalls/k_thread_runtime_stats_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_cpu_runtime_stats_get(struct cpu_runtime_stats *stats)
+{
+	int key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	cpu_stats_update_counters();
+	stats->idle_cycles = runtime.idle;
+	stats->thread_cycles = runtime.thread;
+	stats->isr_cycles = runtime.isr;
+	stats->sched_cycles = runtime.sched;
+	stats->window_length = runtime.last_window_total;
+	stats->window_percent = window_percent(runtime.last_window_busy,
+					       runtime.last_window_total);
+	irq_unlock(key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_cpu_runtime_stats_get(
+					struct cpu_runtime_stats *stats)
+{
+	struct cpu_runtime_stats kstats;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(stats, sizeof(*stats)));
+
+	ret = z_impl_k_cpu_runtime_stats_get(&kstats);
+	if (ret == 0) {
+		Z_OOPS(z_user_to_copy(stats, &kstats, sizeof(kstats)));
+	}
+
+	return ret;
+}
+#include <syscalls/k_cpu_runtime_stats_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int isr_runtime_stats_get(unsigned int irq, struct isr_runtime_stats *stats)
+{
+	int key;
+
+	if (irq >= ISR_LINES || stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = isr_stats[irq];
+	irq_unlock(key);
+
+	return 0;
+}
+
+unsigned int isr_runtime_stats_lines(void)
+{
+	return ISR_LINES;
+}
+#endif /* CONFIG_TRACING_CPU_STATS_THREAD */
+
 #ifdef CONFIG_TRACING_CPU_STATS_LOG
 static struct k_delayed_work cpu_stats_log;
 
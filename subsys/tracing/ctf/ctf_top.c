@@ -9,10 +9,61 @@
 #include <kernel_internal.h>
 #include <ctf_top.h>
 
+#define CTF_CLASS_ENABLED(cls)					\
+	(IS_ENABLED(CONFIG_TRACING_CTF_CLASS_##cls) &&		\
+	 tracing_class_is_enabled(TRACING_CLASS_##cls))
+
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP_DELTA
+static u32_t last_tstamp;
+
+u16_t ctf_top_timestamp_get(void)
+{
+	u32_t now = k_cycle_get_32();
+
+	/* The reader can only infer a single wrap of the 16-bit timestamp
+	 * between two events, resynchronize it with the full value if more
+	 * time has elapsed.
+	 */
+	if (now - last_tstamp > UINT16_MAX) {
+		const u16_t tstamp = (u16_t)now;
+
+		CTF_GATHER_FIELDS(
+			tstamp,
+			CTF_LITERAL(u8_t, CTF_EVENT_TIMESTAMP_SYNC),
+			now
+			);
+	}
+
+	last_tstamp = now;
+
+	return (u16_t)now;
+}
+#endif
+
+static bool ctf_call_is_enabled(unsigned int id)
+{
+	switch (id) {
+	case SYS_TRACE_ID_MUTEX_INIT:
+	case SYS_TRACE_ID_MUTEX_UNLOCK:
+	case SYS_TRACE_ID_MUTEX_LOCK:
+		return CTF_CLASS_ENABLED(MUTEX);
+	case SYS_TRACE_ID_SEMA_INIT:
+	case SYS_TRACE_ID_SEMA_GIVE:
+	case SYS_TRACE_ID_SEMA_TAKE:
+		return CTF_CLASS_ENABLED(SEMA);
+	default:
+		return CTF_CLASS_ENABLED(CALL);
+	}
+}
+
 void sys_trace_thread_switched_out(void)
 {
 	struct k_thread *thread = k_current_get();
 
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_switched_out((u32_t)(uintptr_t)thread);
 }
 
@@ -20,11 +71,19 @@ void sys_trace_thread_switched_in(void)
 {
 	struct k_thread *thread = k_current_get();
 
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_switched_in((u32_t)(uintptr_t)thread);
 }
 
 void sys_trace_thread_priority_set(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_priority_set((u32_t)(uintptr_t)thread,
 				    thread->base.prio);
 }
@@ -33,6 +92,10 @@ void sys_trace_thread_create(struct k_thread *thread)
 {
 	ctf_bounded_string_t name = { "Unnamed thread" };
 
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 #if defined(CONFIG_THREAD_NAME)
 	const char *tname = k_thread_name_get(thread);
 
@@ -60,31 +123,55 @@ void sys_trace_thread_create(struct k_thread *thread)
 
 void sys_trace_thread_abort(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_abort((u32_t)(uintptr_t)thread);
 }
 
 void sys_trace_thread_suspend(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_suspend((u32_t)(uintptr_t)thread);
 }
 
 void sys_trace_thread_resume(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_resume((u32_t)(uintptr_t)thread);
 }
 
 void sys_trace_thread_ready(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_ready((u32_t)(uintptr_t)thread);
 }
 
 void sys_trace_thread_pend(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 	ctf_top_thread_pend((u32_t)(uintptr_t)thread);
 }
 
 void sys_trace_thread_info(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 #if defined(CONFIG_THREAD_STACK_INFO)
 	ctf_top_thread_info(
 		(u32_t)(uintptr_t)thread,
@@ -96,6 +183,10 @@ void sys_trace_thread_info(struct k_thread *thread)
 
 void sys_trace_thread_name_set(struct k_thread *thread)
 {
+	if (!CTF_CLASS_ENABLED(THREAD)) {
+		return;
+	}
+
 #if defined(CONFIG_THREAD_NAME)
 	ctf_bounded_string_t name = { "Unnamed thread" };
 	const char *tname = k_thread_name_get(thread);
@@ -114,30 +205,54 @@ void sys_trace_thread_name_set(struct k_thread *thread)
 
 void sys_trace_isr_enter(void)
 {
+	if (!CTF_CLASS_ENABLED(ISR)) {
+		return;
+	}
+
 	ctf_top_isr_enter();
 }
 
 void sys_trace_isr_exit(void)
 {
+	if (!CTF_CLASS_ENABLED(ISR)) {
+		return;
+	}
+
 	ctf_top_isr_exit();
 }
 
 void sys_trace_isr_exit_to_scheduler(void)
 {
+	if (!CTF_CLASS_ENABLED(ISR)) {
+		return;
+	}
+
 	ctf_top_isr_exit_to_scheduler();
 }
 
 void sys_trace_idle(void)
 {
+	if (!CTF_CLASS_ENABLED(IDLE)) {
+		return;
+	}
+
 	ctf_top_idle();
 }
 
 void sys_trace_void(unsigned int id)
 {
+	if (!ctf_call_is_enabled(id)) {
+		return;
+	}
+
 	ctf_top_void(id);
 }
 
 void sys_trace_end_call(unsigned int id)
 {
+	if (!ctf_call_is_enabled(id)) {
+		return;
+	}
+
 	ctf_top_end_call(id);
 }
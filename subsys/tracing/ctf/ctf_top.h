@@ -41,7 +41,22 @@
 	tracing_format_raw_data(epacket, sizeof(epacket));		    \
 }
 
-#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+#if defined(CONFIG_TRACING_CTF_TIMESTAMP_DELTA)
+u16_t ctf_top_timestamp_get(void);
+
+/*
+ * The timestamp is taken in the critical section the event is put in, so
+ * that no interrupt puts an event or moves the last timestamp in between.
+ */
+#define CTF_EVENT(...)							    \
+	{								    \
+		unsigned int key = irq_lock();				    \
+		const u16_t tstamp = ctf_top_timestamp_get();		    \
+									    \
+		CTF_GATHER_FIELDS(tstamp, __VA_ARGS__)			    \
+		irq_unlock(key);					    \
+	}
+#elif defined(CONFIG_TRACING_CTF_TIMESTAMP)
 #define CTF_EVENT(...)							    \
 	{								    \
 		const u32_t tstamp = k_cycle_get_32();			    \
@@ -67,6 +82,7 @@
 #define CTF_LITERAL(type, value)  ((type) { (type)(value) })
 
 typedef enum {
+	CTF_EVENT_TIMESTAMP_SYNC        =  0x01,
 	CTF_EVENT_THREAD_SWITCHED_OUT   =  0x10,
 	CTF_EVENT_THREAD_SWITCHED_IN    =  0x11,
 	CTF_EVENT_THREAD_PRIORITY_SET   =  0x12,
@@ -113,6 +113,66 @@ u32_t tracing_buffer_get(u8_t *data, u32_t size);
  */
 u32_t tracing_cmd_buffer_alloc(u8_t **data);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Initialize per-CPU tracing buffers.
+ */
+void tracing_cpu_buffer_init(void);
+
+/**
+ * @brief Write one packet to the tracing buffer of the current CPU.
+ *
+ * In flight recorder mode the oldest packets are discarded to make room
+ * for the new one.
+ *
+ * @param data      Address of data.
+ * @param size      Data size (in bytes).
+ * @param was_empty Set to true if the buffer was empty before the write.
+ *
+ * @return true if the packet was written, false if it was dropped.
+ */
+bool tracing_cpu_buffer_put(const u8_t *data, u32_t size, bool *was_empty);
+
+/**
+ * @brief Get address of the first valid data in the buffer of a CPU.
+ *
+ * Not available in flight recorder mode.
+ *
+ * @param cpu  CPU index.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the buffer.
+ *
+ * @return Size of contiguous valid data, 0 if the buffer is empty.
+ */
+u32_t tracing_cpu_buffer_get_claim(unsigned int cpu, u8_t **data);
+
+/**
+ * @brief Indicate number of bytes read from the buffer of a CPU.
+ *
+ * @param cpu  CPU index.
+ * @param size Number of bytes read from claimed buffer.
+ */
+void tracing_cpu_buffer_get_finish(unsigned int cpu, u32_t size);
+
+/**
+ * @brief Check if the buffers of all CPUs are empty.
+ *
+ * @return true if no CPU has pending data.
+ */
+bool tracing_cpu_buffers_are_empty(void);
+
+/**
+ * @brief Pass the content of all per-CPU buffers to a handler.
+ *
+ * Packets are passed one at a time, oldest first, and the buffers are
+ * emptied. Each buffer is locked while it is flushed, producers of its
+ * CPU wait for the flush to end.
+ *
+ * @param handler Function called for each packet.
+ */
+void tracing_cpu_buffer_flush(void (*handler)(u8_t *data, u32_t length));
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <spinlock.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+#include <tracing_buffer.h>
+
+#define CPU_BUFFER_SIZE CONFIG_TRACING_BUFFER_PER_CPU_SIZE
+#define CPU_BUFFER_MASK (CPU_BUFFER_SIZE - 1)
+
+BUILD_ASSERT((CPU_BUFFER_SIZE & CPU_BUFFER_MASK) == 0,
+	     "TRACING_BUFFER_PER_CPU_SIZE must be a power of two");
+
+/* In flight recorder mode each packet is prefixed with its length so the
+ * oldest packet can be discarded as a whole.
+ */
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+#define RECORD_HDR_SIZE 1
+#else
+#define RECORD_HDR_SIZE 0
+#endif
+
+/*
+ * Single producer (the owning CPU, holding the buffer lock), single
+ * consumer (the tracing thread) ring. Indexes are free running and only
+ * masked on access, head is only written by the consumer and tail only by
+ * the producer, so the lock is only taken by another CPU for a flush.
+ */
+struct tracing_cpu_buffer {
+	struct k_spinlock lock;
+	atomic_t head;
+	atomic_t tail;
+	u8_t data[CPU_BUFFER_SIZE];
+};
+
+static struct tracing_cpu_buffer cpu_buffers[CONFIG_MP_NUM_CPUS];
+
+static void cpu_buffer_write(struct tracing_cpu_buffer *buf, u32_t pos,
+			     const u8_t *data, u32_t size)
+{
+	u32_t offset = pos & CPU_BUFFER_MASK;
+	u32_t first = MIN(size, CPU_BUFFER_SIZE - offset);
+
+	memcpy(&buf->data[offset], data, first);
+	memcpy(&buf->data[0], data + first, size - first);
+}
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+static void cpu_buffer_read(struct tracing_cpu_buffer *buf, u32_t pos,
+			    u8_t *data, u32_t size)
+{
+	u32_t offset = pos & CPU_BUFFER_MASK;
+	u32_t first = MIN(size, CPU_BUFFER_SIZE - offset);
+
+	memcpy(data, &buf->data[offset], first);
+	memcpy(data + first, &buf->data[0], size - first);
+}
+#endif
+
+void tracing_cpu_buffer_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		atomic_set(&cpu_buffers[i].head, 0);
+		atomic_set(&cpu_buffers[i].tail, 0);
+	}
+}
+
+bool tracing_cpu_buffer_put(const u8_t *data, u32_t size, bool *was_empty)
+{
+	struct tracing_cpu_buffer *buf;
+	u32_t head, tail, needed = size + RECORD_HDR_SIZE;
+	k_spinlock_key_t lock_key;
+	unsigned int key;
+
+	if (needed > CPU_BUFFER_SIZE ||
+	    (RECORD_HDR_SIZE != 0 && size > UINT8_MAX)) {
+		return false;
+	}
+
+	/* Stay on this CPU until its buffer is locked */
+	key = arch_irq_lock();
+	buf = &cpu_buffers[_current_cpu->id];
+	lock_key = k_spin_lock(&buf->lock);
+	head = atomic_get(&buf->head);
+	tail = atomic_get(&buf->tail);
+
+	*was_empty = (head == tail);
+
+	while (CPU_BUFFER_SIZE - (tail - head) < needed) {
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+		head += buf->data[head & CPU_BUFFER_MASK] + RECORD_HDR_SIZE;
+#else
+		k_spin_unlock(&buf->lock, lock_key);
+		arch_irq_unlock(key);
+		return false;
+#endif
+	}
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+	atomic_set(&buf->head, head);
+	buf->data[tail & CPU_BUFFER_MASK] = size;
+#endif
+	cpu_buffer_write(buf, tail + RECORD_HDR_SIZE, data, size);
+
+	/* Publish the packet only once it is completely written. */
+	atomic_set(&buf->tail, tail + needed);
+	k_spin_unlock(&buf->lock, lock_key);
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+u32_t tracing_cpu_buffer_get_claim(unsigned int cpu, u8_t **data)
+{
+	struct tracing_cpu_buffer *buf = &cpu_buffers[cpu];
+	u32_t head = atomic_get(&buf->head);
+	u32_t tail = atomic_get(&buf->tail);
+	u32_t offset = head & CPU_BUFFER_MASK;
+
+	*data = &buf->data[offset];
+
+	return MIN(tail - head, CPU_BUFFER_SIZE - offset);
+}
+
+void tracing_cpu_buffer_get_finish(unsigned int cpu, u32_t size)
+{
+	atomic_add(&cpu_buffers[cpu].head, size);
+}
+
+bool tracing_cpu_buffers_are_empty(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (atomic_get(&cpu_buffers[i].head) !=
+		    atomic_get(&cpu_buffers[i].tail)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void tracing_cpu_buffer_flush(void (*handler)(u8_t *data, u32_t length))
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct tracing_cpu_buffer *buf = &cpu_buffers[i];
+		k_spinlock_key_t key = k_spin_lock(&buf->lock);
+		u32_t head = atomic_get(&buf->head);
+		u32_t tail = atomic_get(&buf->tail);
+
+		while (head != tail) {
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+			u8_t packet[UINT8_MAX];
+			u32_t size = buf->data[head & CPU_BUFFER_MASK];
+
+			cpu_buffer_read(buf, head + RECORD_HDR_SIZE,
+					packet, size);
+			handler(packet, size);
+			head += size + RECORD_HDR_SIZE;
+#else
+			u32_t offset = head & CPU_BUFFER_MASK;
+			u32_t size = MIN(tail - head, CPU_BUFFER_SIZE - offset);
+
+			handler(&buf->data[offset], size);
+			head += size;
+#endif
+		}
+
+		atomic_set(&buf->head, head);
+		k_spin_unlock(&buf->lock, key);
+	}
+}
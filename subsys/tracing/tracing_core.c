@@ -12,6 +12,7 @@
 #include <tracing_core.h>
 #include <tracing_buffer.h>
 #include <tracing_backend.h>
+#include <tracing/tracing_format.h>
 
 #define TRACING_CMD_ENABLE  "enable"
 #define TRACING_CMD_DISABLE "disable"
@@ -35,6 +36,8 @@ static atomic_t tracing_state;
 static atomic_t tracing_packet_drop_num;
 static struct tracing_backend *working_backend;
 
+atomic_t z_tracing_class_mask = ATOMIC_INIT(TRACING_CLASS_ALL);
+
 #ifdef CONFIG_TRACING_ASYNC
 #define TRACING_THREAD_NAME "tracing_thread"
 
@@ -45,6 +48,54 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU) && \
+	!defined(CONFIG_TRACING_BUFFER_OVERWRITE)
+static bool tracing_cpu_buffers_idle(void)
+{
+	return tracing_cpu_buffers_are_empty();
+}
+
+/*
+ * A CPU is drained completely before the next one, so that a packet
+ * wrapping around the end of its buffer is not split by the data of
+ * another CPU. Packets are published whole, so the data up to the end of
+ * the buffer and the data from its start up to the tail are enough to
+ * stop on a packet boundary.
+ */
+static void tracing_cpu_buffers_drain(void)
+{
+	u8_t *transferring_buf;
+	u32_t transferring_length;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		for (int part = 0; part < 2; part++) {
+			transferring_length =
+				tracing_cpu_buffer_get_claim(i,
+							     &transferring_buf);
+			if (transferring_length == 0U) {
+				break;
+			}
+
+			tracing_buffer_handle(transferring_buf,
+					      transferring_length);
+			tracing_cpu_buffer_get_finish(i, transferring_length);
+		}
+	}
+}
+#else
+/* Without per-CPU buffers, or when they are kept as a flight recorder,
+ * the tracing thread only streams the shared buffer.
+ */
+static bool tracing_cpu_buffers_idle(void)
+{
+	return true;
+}
+
+static void tracing_cpu_buffers_drain(void)
+{
+}
+#endif
+
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	u8_t *transferring_buf;
@@ -55,9 +106,19 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 	tracing_buffer_max_length = tracing_buffer_capacity_get();
 
 	while (true) {
-		if (tracing_buffer_is_empty()) {
+		if (tracing_buffer_is_empty() && tracing_cpu_buffers_idle()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
-		} else {
+			continue;
+		}
+
+		/* Both parts of the shared buffer too, before the per-CPU
+		 * data is interleaved.
+		 */
+		for (int part = 0; part < 2; part++) {
+			if (tracing_buffer_is_empty()) {
+				break;
+			}
+
 			transferring_length =
 				tracing_buffer_get_claim(
 						&transferring_buf,
@@ -66,6 +127,8 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 					      transferring_length);
 			tracing_buffer_get_finish(transferring_length);
 		}
+
+		tracing_cpu_buffers_drain();
 	}
 }
 
@@ -85,6 +148,9 @@ static int tracing_init(struct device *arg)
 	ARG_UNUSED(arg);
 
 	tracing_buffer_init();
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	tracing_cpu_buffer_init();
+#endif
 
 	working_backend = tracing_backend_get(TRACING_BACKEND_NAME);
 	tracing_backend_init(working_backend);
@@ -152,3 +218,23 @@ void tracing_packet_drop_handle(void)
 {
 	atomic_inc(&tracing_packet_drop_num);
 }
+
+void tracing_filter_set(u32_t classes)
+{
+	atomic_set(&z_tracing_class_mask, classes);
+}
+
+u32_t tracing_filter_get(void)
+{
+	return atomic_get(&z_tracing_class_mask);
+}
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+void tracing_flight_recorder_dump(void)
+{
+	atomic_val_t state = atomic_set(&tracing_state, TRACING_DISABLE);
+
+	tracing_cpu_buffer_flush(tracing_buffer_handle);
+	atomic_set(&tracing_state, state);
+}
+#endif
@@ -41,13 +41,20 @@ void tracing_format_raw_data(u8_t *data, u32_t length)
 		return;
 	}
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	put_success = tracing_cpu_buffer_put(data, length,
+					     &before_put_is_empty);
+#else
 	TRACING_LOCK();
 	before_put_is_empty = tracing_buffer_is_empty();
 	put_success = tracing_format_raw_data_put(data, length);
 	TRACING_UNLOCK();
+#endif
 
 	if (put_success) {
-		tracing_trigger_output(before_put_is_empty);
+		if (!IS_ENABLED(CONFIG_TRACING_BUFFER_OVERWRITE)) {
+			tracing_trigger_output(before_put_is_empty);
+		}
 	} else {
 		tracing_packet_drop_handle();
 	}
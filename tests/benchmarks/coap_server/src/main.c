@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CoAP GET requests served per second over loopback, by a server copying
+ * the messages in and out of the stack, and by one parsing the requests
+ * where zsock_recv_zc() leaves them and sending the responses with
+ * zsock_sendto_zc(). Then the time to notify the observers of a resource,
+ * with the notification built for each of them, and built once for all
+ * of them with coap_resource_notify_packet().
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <errno.h>
+#include <string.h>
+
+#include <net/socket.h>
+#include <net/coap.h>
+
+#define N_REQUESTS 2000
+#define N_NOTIFICATIONS 100
+#define N_OBSERVERS 16
+#define SERVER_PORT 5683
+#define CLIENT_PORT 5684
+#define MAX_COAP_MSG_LEN 256
+#define STACK_SIZE 2048
+
+#define TEXT_PLAIN 0
+
+static const char * const bench_path[] = { "bench", NULL };
+static const char bench_payload[] = "0123456789abcdef0123456789abcdef";
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+static struct sockaddr_in client_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(CLIENT_PORT),
+};
+
+static int server_sock;
+static bool zerocopy;
+static bool reply_zerocopy;
+
+static u8_t request_buf[MAX_COAP_MSG_LEN];
+static u8_t response_buf[MAX_COAP_MSG_LEN];
+static u8_t notify_buf[MAX_COAP_MSG_LEN];
+
+static struct coap_observer observers[N_OBSERVERS];
+static int notified;
+
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(tx_done, 0, 1);
+
+static void send_done(const void *buf, size_t len, void *user_data)
+{
+	k_sem_give(&tx_done);
+}
+
+static int bench_get(struct coap_resource *resource,
+		     struct coap_packet *request,
+		     struct sockaddr *addr, socklen_t addr_len)
+{
+	struct coap_packet response;
+	struct coap_option accept;
+	u8_t token[8];
+	u8_t tkl;
+	int r;
+
+	/* Looked up by servers before they answer */
+	(void)coap_find_options(request, COAP_OPTION_ACCEPT, &accept, 1);
+
+	tkl = coap_header_get_token(request, token);
+
+	r = coap_packet_init(&response, response_buf, sizeof(response_buf),
+			     1, COAP_TYPE_ACK, tkl, token,
+			     COAP_RESPONSE_CODE_CONTENT,
+			     coap_header_get_id(request));
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(&response, COAP_OPTION_CONTENT_FORMAT,
+				   TEXT_PLAIN);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload_marker(&response);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload(&response, (u8_t *)bench_payload,
+				       sizeof(bench_payload));
+	if (r < 0) {
+		return r;
+	}
+
+	if (!reply_zerocopy) {
+		return sendto(server_sock, response.data, response.offset, 0,
+			      addr, addr_len);
+	}
+
+	r = zsock_sendto_zc(server_sock, response.data, response.offset, 0,
+			    addr, addr_len, send_done, NULL);
+	if (r < 0) {
+		return r;
+	}
+
+	/* The buffer is used again for the next response */
+	k_sem_take(&tx_done, K_FOREVER);
+
+	return r;
+}
+
+static struct coap_resource resources[] = {
+	{ .path = bench_path,
+	  .get = bench_get,
+	},
+	{ },
+};
+
+static void server(void)
+{
+	struct coap_option options[8];
+	struct coap_packet request;
+	struct zsock_zc_buf zc;
+	struct sockaddr from;
+	socklen_t from_len;
+	u8_t *data;
+	int len;
+
+	server_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (server_sock < 0 ||
+	    bind(server_sock, (struct sockaddr *)&server_addr,
+		 sizeof(server_addr)) < 0) {
+		printk("cannot create server socket (%d)\n", errno);
+		k_panic();
+	}
+
+	k_sem_give(&server_ready);
+
+	for (;;) {
+		/* A change of mode applies from the next request on */
+		reply_zerocopy = zerocopy;
+
+		if (reply_zerocopy) {
+			len = zsock_recv_zc(server_sock, &zc, 0);
+			if (len < 0) {
+				continue;
+			}
+
+			/* Requests are small enough to come in one part */
+			if (zc.more) {
+				len = 0;
+			}
+
+			/* Read only, by the parser */
+			data = (u8_t *)zc.data;
+
+			/* The client is the only peer */
+			memcpy(&from, &client_addr, sizeof(client_addr));
+			from_len = sizeof(client_addr);
+		} else {
+			from_len = sizeof(from);
+			len = recvfrom(server_sock, request_buf,
+				       sizeof(request_buf), 0, &from,
+				       &from_len);
+			data = request_buf;
+		}
+
+		if (len > 0 &&
+		    !coap_packet_parse(&request, data, len, options,
+				       ARRAY_SIZE(options))) {
+			(void)coap_handle_request(&request, resources, options,
+						  ARRAY_SIZE(options), &from,
+						  from_len);
+		}
+
+		if (reply_zerocopy) {
+			(void)zsock_recv_zc_release(server_sock, &zc);
+		}
+	}
+}
+
+K_THREAD_DEFINE(server_tid, STACK_SIZE, server, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(8), 0, 0);
+
+static void request_response(int sock)
+{
+	static u8_t buf[MAX_COAP_MSG_LEN];
+	struct coap_packet request;
+	int r;
+
+	r = coap_packet_init(&request, buf, sizeof(buf), 1, COAP_TYPE_CON,
+			     8, coap_next_token(), COAP_METHOD_GET,
+			     coap_next_id());
+	if (r < 0) {
+		goto fail;
+	}
+
+	r = coap_packet_append_option(&request, COAP_OPTION_URI_PATH,
+				      (const u8_t *)bench_path[0],
+				      strlen(bench_path[0]));
+	if (r < 0) {
+		goto fail;
+	}
+
+	r = coap_append_option_int(&request, COAP_OPTION_ACCEPT, TEXT_PLAIN);
+	if (r < 0) {
+		goto fail;
+	}
+
+	if (sendto(sock, request.data, request.offset, 0,
+		   (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0 ||
+	    recv(sock, buf, sizeof(buf), 0) <= 0) {
+		printk("no response (%d)\n", errno);
+		k_panic();
+	}
+
+	return;
+
+fail:
+	printk("cannot build request (%d)\n", r);
+	k_panic();
+}
+
+static u32_t requests_per_sec(int sock, bool zc)
+{
+	u32_t start, cycles;
+
+	zerocopy = zc;
+
+	/* Served in the mode the server was waiting in */
+	request_response(sock);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_REQUESTS; i++) {
+		request_response(sock);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return (u64_t)N_REQUESTS * sys_clock_hw_cycles_per_sec() / cycles;
+}
+
+static int build_notification(struct coap_packet *cpkt,
+			      struct coap_resource *resource,
+			      u8_t *token, u8_t tkl)
+{
+	int r;
+
+	r = coap_packet_init(cpkt, notify_buf, sizeof(notify_buf),
+			     1, COAP_TYPE_NON_CON, tkl, token,
+			     COAP_RESPONSE_CODE_CONTENT, coap_next_id());
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, resource->age);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+				   TEXT_PLAIN);
+	if (r < 0) {
+		return r;
+	}
+
+	r = coap_packet_append_payload_marker(cpkt);
+	if (r < 0) {
+		return r;
+	}
+
+	return coap_packet_append_payload(cpkt, (u8_t *)bench_payload,
+					  sizeof(bench_payload));
+}
+
+static void obs_notify(struct coap_resource *resource,
+		       struct coap_observer *observer)
+{
+	struct coap_packet cpkt;
+
+	if (!build_notification(&cpkt, resource, observer->token,
+				observer->tkl)) {
+		notified++;
+	}
+}
+
+static int obs_send(struct coap_resource *resource,
+		    struct coap_observer *observer,
+		    struct coap_packet *cpkt, void *user_data)
+{
+	notified++;
+
+	return 0;
+}
+
+static struct coap_resource notify_resource = {
+	.path = bench_path,
+	.notify = obs_notify,
+};
+
+static void notify_measure(void)
+{
+	struct coap_packet cpkt;
+	u32_t start, rebuilt, prebuilt;
+
+	for (int i = 0; i < N_OBSERVERS; i++) {
+		struct coap_observer *o = &observers[i];
+
+		/* Tokens of all the lengths, as clients choose them */
+		o->tkl = 1 + i % sizeof(o->token);
+		(void)memset(o->token, i, o->tkl);
+		memcpy(&o->addr, &client_addr, sizeof(client_addr));
+
+		coap_register_observer(&notify_resource, o);
+	}
+
+	notified = 0;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_NOTIFICATIONS; i++) {
+		(void)coap_resource_notify(&notify_resource);
+	}
+	rebuilt = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_NOTIFICATIONS; i++) {
+		notify_resource.age++;
+
+		if (build_notification(&cpkt, &notify_resource, NULL, 0) ||
+		    coap_resource_notify_packet(&notify_resource, &cpkt,
+						obs_send, NULL)) {
+			break;
+		}
+	}
+	prebuilt = k_cycle_get_32() - start;
+
+	if (notified != 2 * N_NOTIFICATIONS * N_OBSERVERS) {
+		printk("%d notifications out of %d\n", notified,
+		       2 * N_NOTIFICATIONS * N_OBSERVERS);
+	}
+
+	printk("notify %d observers  rebuilt %u us  prebuilt %u us\n",
+	       N_OBSERVERS, k_cyc_to_us_floor32(rebuilt / N_NOTIFICATIONS),
+	       k_cyc_to_us_floor32(prebuilt / N_NOTIFICATIONS));
+}
+
+void main(void)
+{
+	u32_t copy, zc;
+	int sock;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &client_addr.sin_addr);
+
+	k_sem_take(&server_ready, K_FOREVER);
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&client_addr,
+		 sizeof(client_addr)) < 0) {
+		printk("cannot create client socket (%d)\n", errno);
+		return;
+	}
+
+	copy = requests_per_sec(sock, false);
+	zc = requests_per_sec(sock, true);
+
+	printk("copy      %u requests/s\n", copy);
+	printk("zerocopy  %u requests/s\n", zc);
+
+	close(sock);
+
+	notify_measure();
+
+	printk("fin\n");
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * GET request rate against a HTTP server stand-in over loopback, which
+ * holds every response for SERVER_DELAY_MS as a link with that round trip
+ * time would. Connecting, every request is made on a connection of its
+ * own with http_client_req(), the way the blocking API is used. Pooled,
+ * the requests are pipelined on one connection kept open by the library,
+ * with up to CONFIG_HTTP_CLIENT_CONN_PIPELINE of them in flight.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <errno.h>
+#include <string.h>
+
+#include <net/socket.h>
+#include <net/http_client.h>
+
+#define REQUESTS 100
+#define SERVER_PORT 8080
+#define SERVER_DELAY_MS 5
+#define SERVER_STACK_SIZE 2048
+#define MAX_PENDING_RESPONSES 32
+#define WAIT_MS 1000
+
+static const char response[] =
+	"HTTP/1.1 200 OK\r\n"
+	"Content-Length: 32\r\n"
+	"\r\n"
+	"0123456789abcdef0123456789abcdef";
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+
+static u8_t server_buf[512];
+static u32_t pending_due[MAX_PENDING_RESPONSES];
+static int pending_head, pending_count;
+
+static struct http_request reqs[CONFIG_HTTP_CLIENT_CONN_PIPELINE];
+static u8_t recv_buf[512];
+static u32_t completed;
+
+/* Queues a response for every request, which all end with an empty
+ * line as none has a body. Returns false if too many are in flight.
+ */
+static bool server_parse(const u8_t *buf, size_t len, int *match)
+{
+	static const char end[] = "\r\n\r\n";
+
+	for (size_t i = 0; i < len; i++) {
+		*match = (buf[i] == end[*match]) ? *match + 1 :
+			 (buf[i] == end[0]);
+		if (*match < sizeof(end) - 1) {
+			continue;
+		}
+
+		*match = 0;
+
+		if (pending_count == MAX_PENDING_RESPONSES) {
+			return false;
+		}
+
+		pending_due[(pending_head + pending_count++) %
+			    MAX_PENDING_RESPONSES] =
+			k_uptime_get_32() + SERVER_DELAY_MS;
+	}
+
+	return true;
+}
+
+static void server_serve(int sock)
+{
+	struct pollfd fds = { .fd = sock, .events = POLLIN };
+	s32_t timeout;
+	ssize_t ret;
+	int match = 0;
+
+	pending_head = 0;
+	pending_count = 0;
+
+	while (true) {
+		timeout = -1;
+		if (pending_count > 0) {
+			timeout = MAX((s32_t)(pending_due[pending_head] -
+					      k_uptime_get_32()), 0);
+		}
+
+		if (poll(&fds, 1, timeout) < 0) {
+			return;
+		}
+
+		if (fds.revents & POLLIN) {
+			ret = recv(sock, server_buf, sizeof(server_buf), 0);
+			if (ret <= 0 || !server_parse(server_buf, ret, &match)) {
+				return;
+			}
+		}
+
+		while (pending_count > 0 &&
+		       (s32_t)(pending_due[pending_head] -
+			       k_uptime_get_32()) <= 0) {
+			if (send(sock, response, sizeof(response) - 1, 0) < 0) {
+				return;
+			}
+
+			pending_head = (pending_head + 1) %
+				       MAX_PENDING_RESPONSES;
+			pending_count--;
+		}
+	}
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	int client;
+
+	while ((client = accept(sock, NULL, NULL)) >= 0) {
+		server_serve(client);
+		close(client);
+	}
+}
+
+static void response_cb(struct http_response *rsp,
+			enum http_final_call final_data, void *user_data)
+{
+	if (final_data != HTTP_DATA_FINAL) {
+		return;
+	}
+
+	if (!rsp->message_complete || strcmp(rsp->http_status, "OK")) {
+		printk("request %u failed\n", completed);
+		k_panic();
+	}
+
+	completed++;
+}
+
+static void request_init(struct http_request *req)
+{
+	memset(req, 0, sizeof(*req));
+
+	req->method = HTTP_GET;
+	req->url = "/";
+	req->host = CONFIG_NET_CONFIG_MY_IPV4_ADDR;
+	req->protocol = "HTTP/1.1";
+	req->response = response_cb;
+	req->recv_buf = recv_buf;
+	req->recv_buf_len = sizeof(recv_buf);
+}
+
+static int run_connect(void)
+{
+	int sock, ret;
+
+	for (int i = 0; i < REQUESTS; i++) {
+		sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (sock < 0) {
+			return -errno;
+		}
+
+		if (connect(sock, (struct sockaddr *)&server_addr,
+			    sizeof(server_addr)) < 0) {
+			ret = -errno;
+			close(sock);
+			return ret;
+		}
+
+		ret = http_client_req(sock, &reqs[0], WAIT_MS, NULL);
+		close(sock);
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int run_pooled(void)
+{
+	u32_t sent = 0U;
+	int ret;
+
+	while (completed < REQUESTS) {
+		/* At most ARRAY_SIZE(reqs) requests are in flight, and they
+		 * complete in order, so the oldest slot is free again.
+		 */
+		if (sent < REQUESTS) {
+			ret = http_client_conn_req(
+				(struct sockaddr *)&server_addr,
+				sizeof(server_addr),
+				&reqs[sent % ARRAY_SIZE(reqs)], WAIT_MS,
+				NULL);
+			if (ret == 0) {
+				sent++;
+				continue;
+			}
+
+			if (ret != -EAGAIN) {
+				return ret;
+			}
+		}
+
+		ret = http_client_conn_input(WAIT_MS);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void run(const char *name, int (*fn)(void))
+{
+	u32_t start, elapsed;
+	int ret;
+
+	completed = 0U;
+	start = k_uptime_get_32();
+
+	ret = fn();
+	if (ret < 0 || completed != REQUESTS) {
+		printk("%s: failed after %u requests (%d)\n", name, completed,
+		       ret);
+		k_panic();
+	}
+
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+
+	printk("%-10s %4u reqs %6u ms %6u reqs/s\n", name, REQUESTS,
+	       elapsed, REQUESTS * 1000U / elapsed);
+}
+
+void main(void)
+{
+	int sock;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&server_addr,
+		 sizeof(server_addr)) < 0 ||
+	    listen(sock, 2) < 0) {
+		printk("cannot set up the server (%d)\n", errno);
+		return;
+	}
+
+	k_thread_create(&server_thread, server_stack, SERVER_STACK_SIZE,
+			server, INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	for (int i = 0; i < ARRAY_SIZE(reqs); i++) {
+		request_init(&reqs[i]);
+	}
+
+	run("connect", run_connect);
+	run("pooled", run_pooled);
+
+	http_client_conn_close_all();
+
+	printk("fin\n");
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * DESCRIPTION
+ * Latency histogram recording and reporting.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+
+#include "histogram.h"
+
+static unsigned int bucket_index(u32_t value)
+{
+	unsigned int msb;
+
+	if (value < HIST_SUB_BUCKETS) {
+		return value;
+	}
+
+	msb = 31U - __builtin_clz(value);
+
+	return (msb - HIST_SUB_BITS + 1U) * HIST_SUB_BUCKETS +
+	       ((value >> (msb - HIST_SUB_BITS)) & (HIST_SUB_BUCKETS - 1));
+}
+
+/* Largest value falling in a bucket */
+static u32_t bucket_upper(unsigned int idx)
+{
+	unsigned int shift;
+	u32_t lower;
+
+	if (idx < HIST_SUB_BUCKETS) {
+		return idx;
+	}
+
+	shift = idx / HIST_SUB_BUCKETS - 1U;
+	lower = (u32_t)(HIST_SUB_BUCKETS + idx % HIST_SUB_BUCKETS) << shift;
+
+	return lower + ((1U << shift) - 1U);
+}
+
+void hist_init(struct latency_hist *hist, const char *name)
+{
+	(void)memset(hist, 0, sizeof(*hist));
+	hist->name = name;
+	hist->min = UINT32_MAX;
+}
+
+void hist_record(struct latency_hist *hist, u32_t cycles)
+{
+	hist->count++;
+	hist->sum += cycles;
+	hist->min = MIN(hist->min, cycles);
+	hist->max = MAX(hist->max, cycles);
+	hist->buckets[bucket_index(cycles)]++;
+}
+
+u32_t hist_percentile(const struct latency_hist *hist, u32_t per_mille)
+{
+	u32_t rank = (u32_t)(((u64_t)hist->count * per_mille + 999U) / 1000U);
+	u32_t seen = 0U;
+
+	for (unsigned int i = 0; i < HIST_BUCKETS; i++) {
+		seen += hist->buckets[i];
+		if (seen >= rank && seen != 0U) {
+			return MIN(bucket_upper(i), hist->max);
+		}
+	}
+
+	return hist->max;
+}
+
+static u32_t cyc_to_ns(u32_t cycles)
+{
+	return (u32_t)k_cyc_to_ns_floor64(cycles);
+}
+
+/*
+ * One line per metric, all values in nanoseconds, parsed by the console
+ * harness for regression tracking.
+ */
+void hist_report(const struct latency_hist *hist, const char *load)
+{
+	if (hist->count == 0U) {
+		printk("LATENCY %s load=%s samples=0\n", hist->name, load);
+		return;
+	}
+
+	printk("LATENCY %s load=%s samples=%u min=%u avg=%u p50=%u p90=%u "
+	       "p99=%u p999=%u max=%u ns\n",
+	       hist->name, load, hist->count, cyc_to_ns(hist->min),
+	       cyc_to_ns((u32_t)(hist->sum / hist->count)),
+	       cyc_to_ns(hist_percentile(hist, 500)),
+	       cyc_to_ns(hist_percentile(hist, 900)),
+	       cyc_to_ns(hist_percentile(hist, 990)),
+	       cyc_to_ns(hist_percentile(hist, 999)),
+	       cyc_to_ns(hist->max));
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * DESCRIPTION
+ * Log-linear latency histograms: each power of two range is split in
+ * HIST_SUB_BUCKETS linear buckets, so percentiles are reported with a
+ * relative error below 1 / HIST_SUB_BUCKETS whatever the magnitude of the
+ * samples, with a fixed amount of memory.
+ */
+
+#ifndef _LATENCY_HISTOGRAM_H_
+#define _LATENCY_HISTOGRAM_H_
+
+#include <zephyr/types.h>
+
+#define HIST_SUB_BITS    3
+#define HIST_SUB_BUCKETS (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS     ((32 - HIST_SUB_BITS + 1) * HIST_SUB_BUCKETS)
+
+struct latency_hist {
+	const char *name;
+	u32_t count;
+	u32_t min;
+	u32_t max;
+	u64_t sum;
+	u32_t buckets[HIST_BUCKETS];
+};
+
+void hist_init(struct latency_hist *hist, const char *name);
+void hist_record(struct latency_hist *hist, u32_t cycles);
+u32_t hist_percentile(const struct latency_hist *hist, u32_t per_mille);
+void hist_report(const struct latency_hist *hist, const char *load);
+
+void latency_load_start(void);
+const char *latency_load_name(void);
+
+#endif /* _LATENCY_HISTOGRAM_H_ */
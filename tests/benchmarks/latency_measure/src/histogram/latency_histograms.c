@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Measure latency distributions
+ *
+ * Repeat the interrupt, wake up and timer latency measurements and record
+ * every sample in a histogram, optionally while background load runs.
+ */
+
+#include <zephyr.h>
+#include <irq_offload.h>
+#include <sys/printk.h>
+
+#include "histogram.h"
+
+#define N_SAMPLES CONFIG_LATENCY_HISTOGRAM_SAMPLES
+#define PERIOD_US CONFIG_LATENCY_HISTOGRAM_PERIOD_US
+
+#define WAKER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+/* Higher priority than the test thread, so it runs on interrupt exit */
+#define WAKER_PRIORITY 5
+
+static struct latency_hist hist;
+
+static volatile u32_t stamp;
+
+static K_THREAD_STACK_DEFINE(waker_stack, WAKER_STACK_SIZE);
+static struct k_thread waker_thread;
+
+K_SEM_DEFINE(wake_sema, 0, 1);
+K_SEM_DEFINE(woken_sema, 0, 1);
+K_SEM_DEFINE(timer_sema, 0, 1);
+
+static void int_to_isr_handler(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	hist_record(&hist, k_cycle_get_32() - stamp);
+}
+
+static void isr_to_thread_handler(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	stamp = k_cycle_get_32();
+	k_sem_give(&wake_sema);
+}
+
+static void waker_entry(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_sem_take(&wake_sema, K_FOREVER);
+		hist_record(&hist, k_cycle_get_32() - stamp);
+		k_sem_give(&woken_sema);
+	}
+}
+
+/* Time from raising a software interrupt to the start of its handler */
+static void int_to_isr(void)
+{
+	hist_init(&hist, "int_to_isr");
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		stamp = k_cycle_get_32();
+		irq_offload(int_to_isr_handler, NULL);
+	}
+}
+
+/* Time from an ISR giving a semaphore to the woken thread running */
+static void isr_to_thread(void)
+{
+	hist_init(&hist, "isr_to_thread");
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		irq_offload(isr_to_thread_handler, NULL);
+		k_sem_take(&woken_sema, K_FOREVER);
+	}
+}
+
+static u32_t timer_last;
+static bool timer_synced;
+
+static void timer_expiry(struct k_timer *timer)
+{
+	u32_t now = k_cycle_get_32();
+	u32_t period = *(u32_t *)k_timer_user_data_get(timer);
+	u32_t elapsed = now - timer_last;
+
+	timer_last = now;
+
+	/* The first expiry only sets the reference */
+	if (!timer_synced) {
+		timer_synced = true;
+		return;
+	}
+
+	hist_record(&hist, elapsed > period ? elapsed - period :
+		    period - elapsed);
+
+	if (hist.count == N_SAMPLES) {
+		k_timer_stop(timer);
+		k_sem_give(&timer_sema);
+	}
+}
+
+/*
+ * Deviation of the interval between two periodic timer expiries from the
+ * requested period, rounded to the tick the kernel can actually honour.
+ */
+static void timer_jitter(void)
+{
+	static struct k_timer timer;
+	u32_t period = (u32_t)k_ticks_to_cyc_floor64(
+		k_us_to_ticks_ceil32(PERIOD_US));
+
+	hist_init(&hist, "timer_jitter");
+	timer_synced = false;
+
+	k_timer_init(&timer, timer_expiry, NULL);
+	k_timer_user_data_set(&timer, &period);
+	k_timer_start(&timer, K_USEC(PERIOD_US), K_USEC(PERIOD_US));
+	k_sem_take(&timer_sema, K_FOREVER);
+}
+
+/* How much longer than requested a thread sleeps */
+static void sleep_overshoot(void)
+{
+	u32_t requested = (u32_t)k_us_to_cyc_floor64(PERIOD_US);
+
+	hist_init(&hist, "sleep_overshoot");
+
+	for (int i = 0; i < N_SAMPLES; i++) {
+		u32_t start = k_cycle_get_32();
+		u32_t elapsed;
+
+		k_usleep(PERIOD_US);
+		elapsed = k_cycle_get_32() - start;
+
+		hist_record(&hist, elapsed > requested ?
+			    elapsed - requested : 0U);
+	}
+}
+
+/**
+ *
+ * @brief The test main function
+ *
+ * @return N/A
+ */
+void latency_histograms(void)
+{
+	const char *load = latency_load_name();
+
+	printk("Latency distributions over %u samples, load: %s\n",
+	       N_SAMPLES, load);
+
+	k_thread_create(&waker_thread, waker_stack, WAKER_STACK_SIZE,
+			waker_entry, NULL, NULL, NULL,
+			WAKER_PRIORITY, 0, K_NO_WAIT);
+
+	latency_load_start();
+
+	int_to_isr();
+	hist_report(&hist, load);
+
+	isr_to_thread();
+	hist_report(&hist, load);
+
+	timer_jitter();
+	hist_report(&hist, load);
+
+	sleep_overshoot();
+	hist_report(&hist, load);
+
+	k_thread_abort(&waker_thread);
+}
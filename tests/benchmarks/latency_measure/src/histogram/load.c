@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * DESCRIPTION
+ * Background load generators. A single thread at the lowest application
+ * priority runs every enabled load in turn, so it only uses the CPU time
+ * left over by the measurements but keeps the drivers and subsystems it
+ * exercises busy. The network load sends datagrams to its own address
+ * which the loopback interface turns back into received traffic.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "histogram.h"
+
+#ifdef CONFIG_LATENCY_LOAD_LOG
+#include <logging/log.h>
+LOG_MODULE_REGISTER(latency_load, LOG_LEVEL_INF);
+#endif
+
+#ifdef CONFIG_LATENCY_LOAD_NET
+#include <errno.h>
+#include <net/socket.h>
+
+#define LOAD_PORT 4242
+#endif
+
+#ifdef CONFIG_LATENCY_LOAD_FLASH
+#include <storage/flash_map.h>
+
+#define FLASH_CHUNK 64
+#endif
+
+#define LOAD_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_DEFINE(load_stack, LOAD_STACK_SIZE);
+static struct k_thread load_thread;
+
+#ifdef CONFIG_LATENCY_LOAD_NET
+static int net_sock = -1;
+static struct sockaddr_in net_addr;
+
+static int net_load_init(void)
+{
+	net_addr.sin_family = AF_INET;
+	net_addr.sin_port = htons(LOAD_PORT);
+	(void)zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+			      &net_addr.sin_addr);
+
+	net_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (net_sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(net_sock, (struct sockaddr *)&net_addr,
+		       sizeof(net_addr)) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static void net_load(void)
+{
+	static u8_t buf[256];
+
+	(void)zsock_sendto(net_sock, buf, sizeof(buf), 0,
+			   (struct sockaddr *)&net_addr, sizeof(net_addr));
+
+	while (zsock_recv(net_sock, buf, sizeof(buf),
+			  ZSOCK_MSG_DONTWAIT) > 0) {
+	}
+}
+#endif
+
+#ifdef CONFIG_LATENCY_LOAD_FLASH
+static const struct flash_area *flash_fa;
+static off_t flash_off;
+
+static int flash_load_init(void)
+{
+	return flash_area_open(DT_FLASH_AREA_STORAGE_ID, &flash_fa);
+}
+
+static void flash_load(void)
+{
+	static const u8_t chunk[FLASH_CHUNK] = { 0x5a };
+
+	if (flash_off == 0) {
+		(void)flash_area_erase(flash_fa, 0, flash_fa->fa_size);
+	}
+
+	(void)flash_area_write(flash_fa, flash_off, chunk, sizeof(chunk));
+
+	flash_off += sizeof(chunk);
+	if (flash_off + sizeof(chunk) > flash_fa->fa_size) {
+		flash_off = 0;
+	}
+}
+#endif
+
+static void load_entry(void *p1, void *p2, void *p3)
+{
+	u32_t iteration = 0U;
+
+	while (true) {
+#ifdef CONFIG_LATENCY_LOAD_LOG
+		LOG_INF("background load iteration %u", iteration);
+#endif
+#ifdef CONFIG_LATENCY_LOAD_NET
+		net_load();
+#endif
+#ifdef CONFIG_LATENCY_LOAD_FLASH
+		flash_load();
+#endif
+		iteration++;
+	}
+}
+
+const char *latency_load_name(void)
+{
+	if (IS_ENABLED(CONFIG_LATENCY_LOAD_LOG) +
+	    IS_ENABLED(CONFIG_LATENCY_LOAD_NET) +
+	    IS_ENABLED(CONFIG_LATENCY_LOAD_FLASH) > 1) {
+		return "mixed";
+	} else if (IS_ENABLED(CONFIG_LATENCY_LOAD_LOG)) {
+		return "log";
+	} else if (IS_ENABLED(CONFIG_LATENCY_LOAD_NET)) {
+		return "net";
+	} else if (IS_ENABLED(CONFIG_LATENCY_LOAD_FLASH)) {
+		return "flash";
+	}
+
+	return "none";
+}
+
+void latency_load_start(void)
+{
+	if (!IS_ENABLED(CONFIG_LATENCY_LOAD_LOG) &&
+	    !IS_ENABLED(CONFIG_LATENCY_LOAD_NET) &&
+	    !IS_ENABLED(CONFIG_LATENCY_LOAD_FLASH)) {
+		return;
+	}
+
+#ifdef CONFIG_LATENCY_LOAD_NET
+	if (net_load_init() < 0) {
+		printk("network load setup failed\n");
+		return;
+	}
+#endif
+#ifdef CONFIG_LATENCY_LOAD_FLASH
+	if (flash_load_init() < 0) {
+		printk("flash load setup failed\n");
+		return;
+	}
+#endif
+
+	k_thread_create(&load_thread, load_stack, LOAD_STACK_SIZE,
+			load_entry, NULL, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(&load_thread, "latency_load");
+}
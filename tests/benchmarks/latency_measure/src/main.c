@@ -25,6 +25,7 @@ extern void int_to_thread_evt(void);
 extern void sema_lock_unlock(void);
 extern void mutex_lock_unlock(void);
 extern int coop_ctx_switch(void);
+extern void latency_histograms(void);
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
 	PRINT_BANNER();
@@ -32,6 +33,10 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	bench_test_init();
 
+#ifdef CONFIG_LATENCY_HISTOGRAM
+	latency_histograms();
+	print_dash_line();
+#else
 	int_to_thread();
 	print_dash_line();
 
@@ -49,6 +54,7 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 
 	coop_ctx_switch();
 	print_dash_line();
+#endif
 
 	TC_END_REPORT(error_count);
 }
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * QoS 1 publish rate against a broker stand-in over loopback, which holds
+ * every PUBACK for BROKER_DELAY_MS as a link with that round trip time
+ * would. Stop and wait, the application publishes the next message once
+ * the previous one is acknowledged. Windowed, the library keeps up to
+ * CONFIG_MQTT_INFLIGHT_MAX messages in flight.
+ * Reported are the rate and the number of reads the broker needed to
+ * take the messages in, which write coalescing brings down.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <errno.h>
+#include <string.h>
+
+#include <net/socket.h>
+#include <net/mqtt.h>
+
+#include "mqtt_internal.h"
+
+#define MESSAGES 200
+#define PAYLOAD_SIZE 32
+#define BROKER_PORT 1883
+#define BROKER_DELAY_MS 5
+#define BROKER_STACK_SIZE 2048
+#define MAX_PENDING_ACKS 32
+#define WAIT_MS 1000
+
+static const char topic[] = "bench/publish";
+
+static struct sockaddr_in broker_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(BROKER_PORT),
+};
+
+static u8_t broker_buf[1024];
+static u32_t broker_reads;
+
+static struct {
+	u16_t message_id;
+	u32_t due;
+} pending_acks[MAX_PENDING_ACKS];
+static int ack_head, ack_count;
+
+static K_THREAD_STACK_DEFINE(broker_stack, BROKER_STACK_SIZE);
+static struct k_thread broker_thread;
+
+static struct mqtt_client client;
+static u8_t rx_buf[128];
+static u8_t tx_buf[512];
+static u8_t inflight_buf[CONFIG_MQTT_INFLIGHT_MAX * 64];
+static u8_t payload[PAYLOAD_SIZE];
+static bool connected;
+static u32_t acked;
+
+static int broker_send(int sock, u8_t type, u16_t message_id)
+{
+	u8_t packet[] = { type, 2, message_id >> 8, message_id };
+
+	return send(sock, packet, sizeof(packet), 0);
+}
+
+/* Length of the complete packet at the start of buf, 0 if incomplete */
+static size_t packet_len(const u8_t *buf, size_t len)
+{
+	u32_t length = 0U;
+
+	for (int i = 1; i < len && i <= MQTT_MAX_LENGTH_BYTES; i++) {
+		length |= (buf[i] & MQTT_LENGTH_VALUE_MASK) <<
+			  (MQTT_LENGTH_SHIFT * (i - 1));
+
+		if (!(buf[i] & MQTT_LENGTH_CONTINUATION_BIT)) {
+			return (i + 1 + length <= len) ? i + 1 + length : 0;
+		}
+	}
+
+	return 0;
+}
+
+/* Returns false once the client disconnects */
+static bool broker_handle(int sock, const u8_t *packet)
+{
+	const u8_t *body = packet + 2;
+	u16_t topic_len;
+	int tail;
+
+	/* Remaining length takes one byte for all messages used here */
+	switch (packet[0] & 0xF0) {
+	case MQTT_PKT_TYPE_CONNECT:
+		broker_send(sock, MQTT_PKT_TYPE_CONNACK, 0);
+		break;
+
+	case MQTT_PKT_TYPE_PUBLISH:
+		if (ack_count == MAX_PENDING_ACKS) {
+			printk("too many messages in flight\n");
+			return false;
+		}
+
+		topic_len = (body[0] << 8) | body[1];
+		tail = (ack_head + ack_count++) % MAX_PENDING_ACKS;
+		pending_acks[tail].message_id = (body[2 + topic_len] << 8) |
+						body[3 + topic_len];
+		pending_acks[tail].due = k_uptime_get_32() + BROKER_DELAY_MS;
+		break;
+
+	case MQTT_PKT_TYPE_DISCONNECT:
+		return false;
+	}
+
+	return true;
+}
+
+static void broker(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	struct pollfd fds = { .events = POLLIN };
+	size_t buf_len = 0, len;
+	s32_t timeout;
+	bool running = true;
+	ssize_t ret;
+
+	fds.fd = accept(sock, NULL, NULL);
+
+	while (fds.fd >= 0 && running) {
+		timeout = -1;
+		if (ack_count > 0) {
+			timeout = MAX((s32_t)(pending_acks[ack_head].due -
+					      k_uptime_get_32()), 0);
+		}
+
+		if (poll(&fds, 1, timeout) < 0) {
+			break;
+		}
+
+		if (fds.revents & POLLIN) {
+			ret = recv(fds.fd, broker_buf + buf_len,
+				   sizeof(broker_buf) - buf_len, 0);
+			if (ret <= 0) {
+				break;
+			}
+
+			broker_reads++;
+			buf_len += ret;
+
+			while ((len = packet_len(broker_buf, buf_len)) > 0) {
+				running = broker_handle(fds.fd, broker_buf);
+				buf_len -= len;
+				memmove(broker_buf, broker_buf + len, buf_len);
+			}
+		}
+
+		while (ack_count > 0 &&
+		       (s32_t)(pending_acks[ack_head].due -
+			       k_uptime_get_32()) <= 0) {
+			broker_send(fds.fd, MQTT_PKT_TYPE_PUBACK,
+				    pending_acks[ack_head].message_id);
+			ack_head = (ack_head + 1) % MAX_PENDING_ACKS;
+			ack_count--;
+		}
+	}
+
+	if (fds.fd >= 0) {
+		close(fds.fd);
+	}
+}
+
+static void mqtt_evt_handler(struct mqtt_client *const c,
+			     const struct mqtt_evt *evt)
+{
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		connected = (evt->result == 0);
+		break;
+
+	case MQTT_EVT_PUBACK:
+		acked++;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* Coalesced messages make the time left 0, mqtt_input() writes them */
+static int wait_input(void)
+{
+	struct pollfd fds = {
+		.fd = client.transport.tcp.sock,
+		.events = POLLIN,
+	};
+
+	if (poll(&fds, 1, MIN(mqtt_keepalive_time_left(&client),
+			      WAIT_MS)) < 0) {
+		return -errno;
+	}
+
+	return mqtt_input(&client);
+}
+
+static int publish(u16_t message_id)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		.message.topic.topic.utf8 = (u8_t *)topic,
+		.message.topic.topic.size = sizeof(topic) - 1,
+		.message.payload.data = payload,
+		.message.payload.len = sizeof(payload),
+		.message_id = message_id,
+	};
+
+	return mqtt_publish(&client, &param);
+}
+
+static void run(const char *name, bool windowed)
+{
+	u32_t start, elapsed, sent = 0U;
+	int ret = 0;
+
+	client.inflight_buf = windowed ? inflight_buf : NULL;
+	client.inflight_buf_size = windowed ? sizeof(inflight_buf) : 0;
+
+	acked = 0U;
+	broker_reads = 0U;
+	start = k_uptime_get_32();
+
+	while (acked < MESSAGES && ret >= 0) {
+		if (sent < MESSAGES && (windowed || acked == sent)) {
+			/* With the window, the library numbers the messages */
+			ret = publish(windowed ? 0 : sent + 1);
+			if (ret == 0) {
+				sent++;
+				continue;
+			}
+
+			if (ret != -EAGAIN) {
+				break;
+			}
+		}
+
+		ret = wait_input();
+	}
+
+	if (ret < 0) {
+		printk("%s: failed at message %u (%d)\n", name, sent, ret);
+		k_panic();
+	}
+
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+
+	printk("%-10s %4u msgs %6u ms %6u msgs/s %5u reads\n", name,
+	       MESSAGES, elapsed, MESSAGES * 1000U / elapsed, broker_reads);
+}
+
+void main(void)
+{
+	int sock, ret;
+
+	memset(payload, 'x', sizeof(payload));
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &broker_addr.sin_addr);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&broker_addr,
+		 sizeof(broker_addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		printk("cannot set up the broker (%d)\n", errno);
+		return;
+	}
+
+	k_thread_create(&broker_thread, broker_stack, BROKER_STACK_SIZE,
+			broker, INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	mqtt_client_init(&client);
+	client.broker = &broker_addr;
+	client.evt_cb = mqtt_evt_handler;
+	client.client_id.utf8 = (u8_t *)"bench";
+	client.client_id.size = strlen("bench");
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.rx_buf = rx_buf;
+	client.rx_buf_size = sizeof(rx_buf);
+	client.tx_buf = tx_buf;
+	client.tx_buf_size = sizeof(tx_buf);
+	client.keepalive = 0U;
+
+	ret = mqtt_connect(&client);
+	if (ret < 0) {
+		printk("cannot connect (%d)\n", ret);
+		return;
+	}
+
+	while (!connected) {
+		if (wait_input() < 0) {
+			printk("no CONNACK\n");
+			return;
+		}
+	}
+
+	run("stop-wait", false);
+	run("window", true);
+
+	mqtt_disconnect(&client);
+	k_thread_join(&broker_thread, K_FOREVER);
+	close(sock);
+
+	printk("fin\n");
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cycles per byte of the internet checksum summed up 16 bits at a time,
+ * of a plain copy, and of the word wide copy and checksum the stack uses
+ * when data is written to a packet.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#include "net_private.h"
+
+#define ROUNDS 1000
+
+static const int lens[] = { 64, 512, 1500 };
+
+static u8_t src[1500];
+static u8_t dst[1500];
+static volatile u16_t result;
+
+/* The sum as it was computed before, one 16 bit word at a time */
+static u16_t sum16(const u8_t *data, size_t len)
+{
+	const u8_t *end = data + len - 1;
+	u16_t sum = 0U, tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+/* Hundredths of a cycle per byte */
+static u32_t cpb(u32_t cycles, int len)
+{
+	return (u64_t)cycles * 100U / ((u64_t)len * ROUNDS);
+}
+
+void main(void)
+{
+	u32_t start, c16, ccopy, csum;
+	int len;
+
+	for (int i = 0; i < sizeof(src); i++) {
+		src[i] = i * 7;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		len = lens[i];
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < ROUNDS; j++) {
+			result = sum16(src, len);
+		}
+		c16 = cpb(k_cycle_get_32() - start, len);
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < ROUNDS; j++) {
+			memcpy(dst, src, len);
+			result = dst[j % len];
+		}
+		ccopy = cpb(k_cycle_get_32() - start, len);
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < ROUNDS; j++) {
+			result = net_calc_chksum_copy(0U, dst, src, len);
+		}
+		csum = cpb(k_cycle_get_32() - start, len);
+
+		printk("%4d bytes  16 bit %u.%02u cycles/byte  "
+		       "memcpy %u.%02u cycles/byte  "
+		       "copy+sum %u.%02u cycles/byte\n", len,
+		       c16 / 100U, c16 % 100U, ccopy / 100U, ccopy % 100U,
+		       csum / 100U, csum % 100U);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per packet cost of finding the connection handler of a received UDP
+ * packet. A listener is bound to the server port, and all the other
+ * handlers are bound to a peer of that port. The oldest peer is timed,
+ * which is the last one a list scan reaches, and a packet from an unknown
+ * peer that only the listener takes.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#include "connection.h"
+
+#define N_LOOKUPS 1000
+#define SERVER_PORT 5683
+#define PEER_PORT_BASE 10000
+
+static const int conn_counts[] = { 1, 64, 512 };
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static u32_t hits;
+
+static int demux_dev_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void demux_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, "\x00\x00\x5e\x00\x53\x03", 6,
+			     NET_LINK_DUMMY);
+}
+
+static int demux_send(struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api demux_api = {
+	.iface_api.init = demux_iface_init,
+	.send = demux_send,
+};
+
+NET_DEVICE_INIT(conn_demux, "conn_demux",
+		demux_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&demux_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static enum net_verdict demux_cb(struct net_conn *conn,
+				 struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 union net_proto_header *proto_hdr,
+				 void *user_data)
+{
+	/* Keep the packet, it is input again */
+	hits++;
+
+	return NET_OK;
+}
+
+static int register_conns(int count)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+	};
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_addr = { { { 192, 0, 2, 2 } } },
+	};
+	int ret, i;
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+				(struct sockaddr *)&local, 0, SERVER_PORT,
+				demux_cb, NULL, &handles[0]);
+
+	for (i = 1; ret == 0 && i < count; i++) {
+		ret = net_conn_register(IPPROTO_UDP, AF_INET,
+					(struct sockaddr *)&remote,
+					(struct sockaddr *)&local,
+					PEER_PORT_BASE + i, SERVER_PORT,
+					demux_cb, NULL, &handles[i]);
+	}
+
+	return ret;
+}
+
+static u32_t time_lookup(struct net_pkt *pkt, u16_t src_port)
+{
+	struct net_ipv4_hdr ipv4 = {
+		.vhl = 0x45,
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+		.src = { { { 192, 0, 2, 2 } } },
+		.dst = { { { 192, 0, 2, 1 } } },
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(src_port),
+		.dst_port = htons(SERVER_PORT),
+	};
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4 };
+	union net_proto_header proto_hdr = { .udp = &udp };
+	u32_t start, cycles;
+
+	hits = 0U;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (hits != N_LOOKUPS) {
+		printk("port %u: %u of %u packets delivered\n", src_port,
+		       hits, N_LOOKUPS);
+	}
+
+	return cycles / N_LOOKUPS;
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	u32_t connected, listener;
+	struct net_pkt *pkt;
+	int i, count;
+
+	pkt = net_pkt_alloc_on_iface(iface, K_NO_WAIT);
+	if (!pkt) {
+		printk("cannot allocate packet\n");
+		return;
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+
+	for (int c = 0; c < ARRAY_SIZE(conn_counts); c++) {
+		count = conn_counts[c];
+
+		if (register_conns(count) < 0) {
+			printk("cannot register %d connections\n", count);
+			return;
+		}
+
+		/* With a single handler there is only the listener */
+		connected = time_lookup(pkt, count > 1 ? PEER_PORT_BASE + 1 :
+					PEER_PORT_BASE);
+		listener = time_lookup(pkt, PEER_PORT_BASE);
+
+		printk("%4d conns  connected %6u cycles  listener %6u cycles\n",
+		       count, connected, listener);
+
+		for (i = 0; i < count; i++) {
+			net_conn_unregister(handles[i]);
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+}
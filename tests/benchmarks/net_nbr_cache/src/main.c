@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cycles per neighbor lookup on the transmit path with 8 to 1024 ARP
+ * peers and 8 to 254 IPv6 neighbors: a linear walk over every entry as
+ * the caches were looked up before, and the hashed lookup done when a
+ * packet is sent.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#include <net/dummy.h>
+#include <net/ethernet.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "arp.h"
+#include "ipv6.h"
+
+#define ROUNDS 1000
+#define DESTINATIONS 256
+
+static const int arp_sizes[] = { 8, 64, 256, 1024 };
+static const int ipv6_sizes[] = { 8, 64, 254 };
+
+static struct in_addr my_addr = { { { 10, 0, 0, 1 } } };
+static struct in_addr netmask = { { { 255, 255, 0, 0 } } };
+
+static struct in_addr arp_peers[1024];
+static struct in6_addr ipv6_peers[254];
+static u16_t order[DESTINATIONS];
+static volatile void *result;
+
+static u32_t seed = 1U;
+
+struct linear_match {
+	struct net_if *iface;
+	const void *addr;
+	void *found;
+};
+
+static u32_t rand32(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int dummy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static int dummy_send(struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_nbr_cache, "net_nbr_cache", dummy_dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static void peer_lladdr(struct net_eth_addr *lladdr, int i)
+{
+	(void)memset(lladdr, 0, sizeof(*lladdr));
+
+	lladdr->addr[0] = 0x02;
+	lladdr->addr[4] = (i + 1) >> 8;
+	lladdr->addr[5] = i + 1;
+}
+
+/* Feed an ARP request from the peer, asking for our address, which adds
+ * the peer to the ARP table.
+ */
+static void arp_peer_add(struct net_if *iface, int i)
+{
+	struct net_eth_addr lladdr;
+	struct net_arp_hdr *hdr;
+	struct net_eth_hdr *eth;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_eth_hdr) +
+					sizeof(struct net_arp_hdr),
+					AF_UNSPEC, 0, K_SECONDS(1));
+	if (!pkt) {
+		printk("out of packets\n");
+		k_panic();
+	}
+
+	peer_lladdr(&lladdr, i);
+
+	arp_peers[i].s4_addr[0] = 10U;
+	arp_peers[i].s4_addr[2] = (i + 2) >> 8;
+	arp_peers[i].s4_addr[3] = i + 2;
+
+	eth = NET_ETH_HDR(pkt);
+	net_buf_add(pkt->buffer, sizeof(struct net_eth_hdr));
+	net_buf_pull(pkt->buffer, sizeof(struct net_eth_hdr));
+
+	(void)memset(&eth->dst, 0xff, sizeof(struct net_eth_addr));
+	memcpy(&eth->src, &lladdr, sizeof(struct net_eth_addr));
+	eth->type = htons(NET_ETH_PTYPE_ARP);
+
+	hdr = NET_ARP_HDR(pkt);
+	net_buf_add(pkt->buffer, sizeof(struct net_arp_hdr));
+
+	hdr->hwtype = htons(NET_ARP_HTYPE_ETH);
+	hdr->protocol = htons(NET_ETH_PTYPE_IP);
+	hdr->hwlen = sizeof(struct net_eth_addr);
+	hdr->protolen = sizeof(struct in_addr);
+	hdr->opcode = htons(NET_ARP_REQUEST);
+
+	memcpy(&hdr->src_hwaddr, &lladdr, sizeof(struct net_eth_addr));
+	(void)memset(&hdr->dst_hwaddr, 0, sizeof(struct net_eth_addr));
+	net_ipaddr_copy(&hdr->src_ipaddr, &arp_peers[i]);
+	net_ipaddr_copy(&hdr->dst_ipaddr, &my_addr);
+
+	if (net_arp_input(pkt, eth) != NET_OK) {
+		printk("cannot add ARP peer %d\n", i);
+		net_pkt_unref(pkt);
+	}
+}
+
+static void ipv6_peer_add(struct net_if *iface, int i)
+{
+	static struct net_eth_addr lladdrs[ARRAY_SIZE(ipv6_peers)];
+	struct net_linkaddr lladdr = {
+		.addr = lladdrs[i].addr,
+		.len = sizeof(lladdrs[i]),
+		.type = NET_LINK_DUMMY,
+	};
+
+	peer_lladdr(&lladdrs[i], i);
+
+	net_ipv6_addr_create(&ipv6_peers[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+
+	if (!net_ipv6_nbr_add(iface, &ipv6_peers[i], &lladdr, false,
+			      NET_IPV6_NBR_STATE_REACHABLE)) {
+		printk("cannot add neighbor %d\n", i);
+	}
+}
+
+static void order_init(int count)
+{
+	for (int i = 0; i < DESTINATIONS; i++) {
+		order[i] = rand32() % count;
+	}
+}
+
+static void arp_linear_cb(struct arp_entry *entry, void *user_data)
+{
+	struct linear_match *match = user_data;
+
+	if (!match->found && entry->iface == match->iface &&
+	    net_ipv4_addr_cmp(&entry->ip, match->addr)) {
+		match->found = entry;
+	}
+}
+
+static void ipv6_linear_cb(struct net_nbr *nbr, void *user_data)
+{
+	struct linear_match *match = user_data;
+
+	if (!match->found && nbr->iface == match->iface &&
+	    net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, match->addr)) {
+		match->found = nbr;
+	}
+}
+
+static void arp_measure(struct net_if *iface, struct net_pkt *pkt, int count)
+{
+	struct linear_match match = { .iface = iface };
+	u32_t start, clinear, chashed;
+
+	start = k_cycle_get_32();
+	for (int j = 0; j < ROUNDS; j++) {
+		match.addr = &arp_peers[order[j % DESTINATIONS]];
+		match.found = NULL;
+		net_arp_foreach(arp_linear_cb, &match);
+		result = match.found;
+	}
+	clinear = (k_cycle_get_32() - start) / ROUNDS;
+
+	start = k_cycle_get_32();
+	for (int j = 0; j < ROUNDS; j++) {
+		result = net_arp_prepare(pkt,
+					 &arp_peers[order[j % DESTINATIONS]],
+					 NULL);
+	}
+	chashed = (k_cycle_get_32() - start) / ROUNDS;
+
+	printk("arp  %4d peers  linear %u cycles  hashed %u cycles\n", count,
+	       clinear, chashed);
+}
+
+static void ipv6_measure(struct net_if *iface, int count)
+{
+	struct linear_match match = { .iface = iface };
+	u32_t start, clinear, chashed;
+
+	start = k_cycle_get_32();
+	for (int j = 0; j < ROUNDS; j++) {
+		match.addr = &ipv6_peers[order[j % DESTINATIONS]];
+		match.found = NULL;
+		net_ipv6_nbr_foreach(ipv6_linear_cb, &match);
+		result = match.found;
+	}
+	clinear = (k_cycle_get_32() - start) / ROUNDS;
+
+	start = k_cycle_get_32();
+	for (int j = 0; j < ROUNDS; j++) {
+		int peer = order[j % DESTINATIONS];
+
+		result = net_ipv6_nbr_lookup(iface, &ipv6_peers[peer]);
+	}
+	chashed = (k_cycle_get_32() - start) / ROUNDS;
+
+	printk("ipv6 %4d peers  linear %u cycles  hashed %u cycles\n", count,
+	       clinear, chashed);
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_lookup_by_dev(DEVICE_GET(net_nbr_cache));
+	struct net_pkt *pkt;
+	int count = 0;
+
+	net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	/* Only its link addresses are set when sent to a known peer */
+	pkt = net_pkt_alloc_with_buffer(iface, NET_IPV4H_LEN, AF_UNSPEC, 0,
+					K_NO_WAIT);
+	if (!pkt) {
+		printk("out of packets\n");
+		k_panic();
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(arp_sizes); i++) {
+		while (count < arp_sizes[i]) {
+			arp_peer_add(iface, count++);
+		}
+
+		order_init(count);
+		arp_measure(iface, pkt, count);
+	}
+
+	net_pkt_unref(pkt);
+
+	count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(ipv6_sizes); i++) {
+		while (count < ipv6_sizes[i]) {
+			ipv6_peer_add(iface, count++);
+		}
+
+		order_init(count);
+		ipv6_measure(iface, count);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cycles per fragment to reassemble streams of interleaved IPv4 packets
+ * cut in 2 to 16 fragments, received in order, in reverse order and
+ * shuffled, and the memory held by the reassembly just before the packets
+ * are complete.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#include <net/dummy.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "reassembly.h"
+
+#define ROUNDS 100
+#define STREAMS CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT
+#define DATA_LEN 1536
+#define MAX_FRAGS 16
+
+enum order {
+	IN_ORDER,
+	REVERSE,
+	SHUFFLED,
+	ORDERS
+};
+
+static const int frag_counts[] = { 2, 4, 8, 16 };
+
+static struct net_pkt *frags[STREAMS][MAX_FRAGS];
+static u8_t order[MAX_FRAGS];
+static u8_t data[NET_IPV4H_LEN + DATA_LEN];
+static int completed;
+static u32_t seed = 1U;
+
+struct held {
+	size_t bytes;
+};
+
+static u32_t rand32(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int dummy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static int dummy_send(struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_reassembly, "net_reassembly", dummy_dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static void reass_done(struct net_pkt *pkt)
+{
+	completed++;
+	net_pkt_unref(pkt);
+}
+
+static void held_cb(struct net_reass *reass, void *user_data)
+{
+	struct held *held = user_data;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+
+	NET_REASS_FOR_EACH_FRAG(reass, pkt) {
+		held->bytes += sizeof(*pkt);
+
+		for (buf = pkt->buffer; buf; buf = buf->frags) {
+			held->bytes += sizeof(*buf) + buf->size;
+		}
+	}
+}
+
+static void order_init(enum order how, int count)
+{
+	int i, j;
+	u8_t tmp;
+
+	for (i = 0; i < count; i++) {
+		order[i] = how == REVERSE ? count - 1 - i : i;
+	}
+
+	if (how != SHUFFLED) {
+		return;
+	}
+
+	for (i = count - 1; i > 0; i--) {
+		j = rand32() % (i + 1);
+		tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+static void frags_alloc(struct net_if *iface, int count)
+{
+	u16_t len = DATA_LEN / count;
+
+	for (int s = 0; s < STREAMS; s++) {
+		for (int i = 0; i < count; i++) {
+			struct net_pkt *pkt;
+
+			pkt = net_pkt_alloc_with_buffer(iface,
+							NET_IPV4H_LEN + len,
+							AF_UNSPEC, 0,
+							K_NO_WAIT);
+			if (!pkt) {
+				printk("out of packets\n");
+				k_panic();
+			}
+
+			net_pkt_set_family(pkt, AF_INET);
+
+			net_pkt_write(pkt, data, NET_IPV4H_LEN);
+			net_pkt_write(pkt, data + NET_IPV4H_LEN + i * len, len);
+
+			net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+			net_pkt_set_ipv4_fragment_offset(pkt, i * len);
+
+			frags[s][i] = pkt;
+		}
+	}
+}
+
+/* Feed the fragments of all the streams, one position at a time, and
+ * return the cycles spent in the reassembly.
+ */
+static u32_t frags_feed(int count, u16_t id, struct held *held)
+{
+	struct net_reass_key key = {
+		.proto = IPPROTO_UDP,
+		.family = AF_INET,
+	};
+	u32_t start, cycles = 0U;
+
+	for (int pos = 0; pos < count; pos++) {
+		int i = order[pos];
+
+		if (held && pos == count - 1) {
+			net_reass_foreach(AF_INET, held_cb, held);
+		}
+
+		start = k_cycle_get_32();
+
+		for (int s = 0; s < STREAMS; s++) {
+			key.src.s6_addr[3] = s;
+			key.id = id;
+
+			if (net_reass_add(&key, frags[s][i], i < count - 1,
+					  K_SECONDS(5), reass_done) != NET_OK) {
+				net_pkt_unref(frags[s][i]);
+			}
+		}
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	return cycles;
+}
+
+void main(void)
+{
+	struct net_if *iface;
+	u32_t cycles[ORDERS];
+	struct held held;
+	u16_t id = 0U;
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_reassembly));
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+
+	for (int c = 0; c < ARRAY_SIZE(frag_counts); c++) {
+		int count = frag_counts[c];
+
+		for (int how = 0; how < ORDERS; how++) {
+			cycles[how] = 0U;
+			completed = 0;
+
+			for (int r = 0; r < ROUNDS; r++) {
+				order_init(how, count);
+				frags_alloc(iface, count);
+				cycles[how] += frags_feed(count, id++, NULL);
+			}
+
+			if (completed != ROUNDS * STREAMS) {
+				printk("%d of %d packets reassembled\n",
+				       completed, ROUNDS * STREAMS);
+			}
+
+			cycles[how] /= ROUNDS * STREAMS * count;
+		}
+
+		held.bytes = 0;
+		order_init(SHUFFLED, count);
+		frags_alloc(iface, count);
+		frags_feed(count, id++, &held);
+
+		printk("%2d frags  in order %u  reverse %u  shuffled %u "
+		       "cycles/frag  held %zu bytes\n", count,
+		       cycles[IN_ORDER], cycles[REVERSE], cycles[SHUFFLED],
+		       held.bytes);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cycles per route lookup of a forwarding table growing from 16 to 2048
+ * routes: a linear longest prefix match over every entry as the routes
+ * were looked up before, the prefix trie, and the trie with the route
+ * cache hit by a repeated destination.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#include <net/dummy.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+#define ROUNDS 1000
+#define NEIGHBORS 16
+#define DESTINATIONS 256
+
+static const int sizes[] = { 16, 64, 256, 1024, 2048 };
+
+static struct in6_addr prefixes[2048];
+static u8_t prefix_lens[2048];
+static struct in6_addr nexthops[NEIGHBORS];
+static struct in6_addr dsts[DESTINATIONS];
+static volatile void *result;
+
+static u32_t seed = 1U;
+
+static u32_t rand32(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int dummy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static int dummy_send(struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_route_lpm, "net_route_lpm", dummy_dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+struct linear_match {
+	struct in6_addr *dst;
+	struct net_route_entry *found;
+};
+
+static void linear_cb(struct net_route_entry *entry, void *user_data)
+{
+	struct linear_match *match = user_data;
+
+	if ((!match->found || entry->prefix_len > match->found->prefix_len) &&
+	    net_ipv6_is_prefix(match->dst->s6_addr, entry->addr.s6_addr,
+			       entry->prefix_len)) {
+		match->found = entry;
+	}
+}
+
+/* Routes under 2001:db8::/32, unique in the next 16 bits, 48 to 64 bits
+ * long
+ */
+static void route_add(struct net_if *iface, int i)
+{
+	struct in6_addr *prefix = &prefixes[i];
+
+	prefix->s6_addr[0] = 0x20;
+	prefix->s6_addr[1] = 0x01;
+	prefix->s6_addr[2] = 0x0d;
+	prefix->s6_addr[3] = 0xb8;
+	prefix->s6_addr[4] = i >> 8;
+	prefix->s6_addr[5] = i;
+	prefix->s6_addr[6] = rand32() >> 16;
+	prefix->s6_addr[7] = rand32() >> 16;
+	prefix_lens[i] = 48U + rand32() % 17U;
+
+	if (!net_route_add(iface, prefix, prefix_lens[i],
+			   &nexthops[i % NEIGHBORS])) {
+		printk("cannot add route %d\n", i);
+	}
+}
+
+/* Destinations inside the routes added so far */
+static void dsts_init(int count)
+{
+	for (int i = 0; i < DESTINATIONS; i++) {
+		int route = rand32() % count;
+		u8_t len = prefix_lens[route];
+
+		for (int j = 0; j < 16; j++) {
+			dsts[i].s6_addr[j] = rand32() >> 16;
+		}
+
+		memcpy(dsts[i].s6_addr, prefixes[route].s6_addr, len / 8U);
+		if (len % 8U) {
+			u8_t mask = 0xff << (8U - len % 8U);
+
+			dsts[i].s6_addr[len / 8U] =
+				(prefixes[route].s6_addr[len / 8U] & mask) |
+				(dsts[i].s6_addr[len / 8U] & ~mask);
+		}
+	}
+}
+
+static void neighbors_add(struct net_if *iface)
+{
+	static u8_t lladdrs[NEIGHBORS][6];
+
+	for (int i = 0; i < NEIGHBORS; i++) {
+		struct net_linkaddr lladdr = {
+			.addr = lladdrs[i],
+			.len = sizeof(lladdrs[i]),
+			.type = NET_LINK_DUMMY,
+		};
+
+		lladdrs[i][0] = 0x02;
+		lladdrs[i][5] = i + 1;
+
+		net_ipv6_addr_create(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0,
+				     i + 1);
+
+		if (!net_ipv6_nbr_add(iface, &nexthops[i], &lladdr, true,
+				      NET_IPV6_NBR_STATE_REACHABLE)) {
+			printk("cannot add neighbor %d\n", i);
+		}
+	}
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_lookup_by_dev(DEVICE_GET(net_route_lpm));
+	u32_t start, clinear, ctrie, ccached;
+	struct linear_match match;
+	int count = 0;
+
+	neighbors_add(iface);
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		while (count < sizes[i]) {
+			route_add(iface, count++);
+		}
+
+		dsts_init(count);
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < ROUNDS; j++) {
+			match.dst = &dsts[j % DESTINATIONS];
+			match.found = NULL;
+			net_route_foreach(linear_cb, &match);
+			result = match.found;
+		}
+		clinear = (k_cycle_get_32() - start) / ROUNDS;
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < ROUNDS; j++) {
+			result = net_route_lookup(iface,
+						  &dsts[j % DESTINATIONS]);
+		}
+		ctrie = (k_cycle_get_32() - start) / ROUNDS;
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < ROUNDS; j++) {
+			result = net_route_lookup(iface, &dsts[0]);
+		}
+		ccached = (k_cycle_get_32() - start) / ROUNDS;
+
+		printk("%4d routes  linear %u cycles  trie %u cycles  "
+		       "cached %u cycles\n", count, clinear, ctrie, ccached);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Cost of waiting for one ready UDP socket among many idle ones, with
+ * poll() and with epoll_wait(). Each round sends a datagram to the next
+ * socket, waits until it has been queued, and only then times the wait,
+ * so the stack's own latency is left out.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+#define MAX_SOCKS 200
+#define N_ROUNDS 400
+#define PORT_BASE 10000
+
+static const int sock_counts[] = { 1, 16, 64, MAX_SOCKS };
+
+static int socks[MAX_SOCKS];
+static struct pollfd pollfds[MAX_SOCKS];
+static struct sockaddr_in addr = {
+	.sin_family = AF_INET,
+};
+
+static int sender;
+static int ep;
+
+static int open_socks(int count)
+{
+	struct epoll_event ev = { .events = EPOLLIN };
+
+	for (int i = 0; i < count; i++) {
+		socks[i] = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		addr.sin_port = htons(PORT_BASE + i);
+
+		if (socks[i] < 0 || bind(socks[i], (struct sockaddr *)&addr,
+					 sizeof(addr)) < 0) {
+			return -1;
+		}
+
+		pollfds[i].fd = socks[i];
+		pollfds[i].events = POLLIN;
+
+		ev.data.fd = socks[i];
+		if (epoll_ctl(ep, EPOLL_CTL_ADD, socks[i], &ev) < 0) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/* Queue a datagram on the i'th socket */
+static void make_ready(int i)
+{
+	char c = 0;
+
+	addr.sin_port = htons(PORT_BASE + i);
+	(void)sendto(sender, &c, 1, 0, (struct sockaddr *)&addr,
+		     sizeof(addr));
+
+	/* Blocks until the datagram has gone through the stack */
+	(void)recv(socks[i], &c, 1, MSG_PEEK);
+}
+
+static u32_t time_poll(int count)
+{
+	u32_t start, cycles = 0U;
+	char c;
+
+	for (int r = 0; r < N_ROUNDS; r++) {
+		make_ready(r % count);
+
+		start = k_cycle_get_32();
+		(void)poll(pollfds, count, -1);
+		cycles += k_cycle_get_32() - start;
+
+		(void)recv(socks[r % count], &c, 1, 0);
+	}
+
+	return cycles / N_ROUNDS;
+}
+
+static u32_t time_epoll(int count)
+{
+	struct epoll_event ev;
+	u32_t start, cycles = 0U;
+	char c;
+
+	for (int r = 0; r < N_ROUNDS; r++) {
+		make_ready(r % count);
+
+		start = k_cycle_get_32();
+		(void)epoll_wait(ep, &ev, 1, -1);
+		cycles += k_cycle_get_32() - start;
+
+		(void)recv(ev.data.fd, &c, 1, 0);
+	}
+
+	return cycles / N_ROUNDS;
+}
+
+void main(void)
+{
+	u32_t poll_cycles, epoll_cycles;
+	int count;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	ep = epoll_create1(0);
+	if (sender < 0 || ep < 0) {
+		printk("cannot create sockets (%d)\n", errno);
+		return;
+	}
+
+	for (int c = 0; c < ARRAY_SIZE(sock_counts); c++) {
+		count = sock_counts[c];
+
+		if (open_socks(count) < 0) {
+			printk("cannot open %d sockets (%d)\n", count, errno);
+			return;
+		}
+
+		poll_cycles = time_poll(count);
+		epoll_cycles = time_epoll(count);
+
+		printk("%4d sockets  poll %7u cycles  epoll %7u cycles\n",
+		       count, poll_cycles, epoll_cycles);
+
+		/* Closing also takes the sockets off the interest list */
+		for (int i = 0; i < count; i++) {
+			close(socks[i]);
+		}
+	}
+
+	close(ep);
+	close(sender);
+
+	printk("fin\n");
+}
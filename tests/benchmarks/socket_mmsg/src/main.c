@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Datagrams per second over the loopback interface from a user mode
+ * thread, with one sendto()/recv() system call pair per datagram, and
+ * with sendmmsg()/recvmmsg() moving a batch of datagrams per call.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+#define N_DGRAMS 4096
+#define BATCH 16
+#define DGRAM_LEN 32
+#define PORT 4242
+
+struct bench {
+	struct sockaddr_in addr;
+	int sender;
+	int receiver;
+	char buf[BATCH][DGRAM_LEN];
+	struct iovec iov[BATCH];
+	struct mmsghdr tx_msgs[BATCH];
+	struct mmsghdr rx_msgs[BATCH];
+};
+
+static u32_t rate(u32_t ms)
+{
+	return (u64_t)N_DGRAMS * MSEC_PER_SEC / MAX(ms, 1U);
+}
+
+static u32_t time_single(struct bench *b)
+{
+	u32_t start = k_uptime_get_32();
+
+	for (int i = 0; i < N_DGRAMS; i++) {
+		(void)sendto(b->sender, b->buf[0], DGRAM_LEN, 0,
+			     (struct sockaddr *)&b->addr, sizeof(b->addr));
+		(void)recv(b->receiver, b->buf[0], DGRAM_LEN, 0);
+	}
+
+	return k_uptime_get_32() - start;
+}
+
+static u32_t time_batch(struct bench *b)
+{
+	u32_t start = k_uptime_get_32();
+
+	for (int i = 0; i < N_DGRAMS / BATCH; i++) {
+		(void)sendmmsg(b->sender, b->tx_msgs, BATCH, 0);
+
+		/* Waits until the whole batch has gone through the stack */
+		(void)recvmmsg(b->receiver, b->rx_msgs, BATCH, 0);
+	}
+
+	return k_uptime_get_32() - start;
+}
+
+static void bench_user(void *p1, void *p2, void *p3)
+{
+	struct bench b = {
+		.addr = {
+			.sin_family = AF_INET,
+			.sin_port = htons(PORT),
+		},
+	};
+	u32_t single_ms, batch_ms;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &b.addr.sin_addr);
+
+	b.sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	b.receiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (b.sender < 0 || b.receiver < 0 ||
+	    bind(b.receiver, (struct sockaddr *)&b.addr, sizeof(b.addr)) < 0) {
+		printk("cannot create sockets (%d)\n", errno);
+		return;
+	}
+
+	/* Both vectors use the same buffers, the source addresses of the
+	 * received datagrams are not asked for.
+	 */
+	for (int i = 0; i < BATCH; i++) {
+		b.iov[i].iov_base = b.buf[i];
+		b.iov[i].iov_len = DGRAM_LEN;
+		b.tx_msgs[i].msg_hdr.msg_name = &b.addr;
+		b.tx_msgs[i].msg_hdr.msg_namelen = sizeof(b.addr);
+		b.tx_msgs[i].msg_hdr.msg_iov = &b.iov[i];
+		b.tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		b.rx_msgs[i].msg_hdr.msg_iov = &b.iov[i];
+		b.rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	single_ms = time_single(&b);
+	batch_ms = time_batch(&b);
+
+	printk("single %7u datagrams/s  batch %7u datagrams/s\n",
+	       rate(single_ms), rate(batch_ms));
+
+	close(b.receiver);
+	close(b.sender);
+
+	printk("fin\n");
+}
+
+void main(void)
+{
+	/* The system calls copy the message vectors to the kernel heap */
+	k_thread_system_pool_assign(k_current_get());
+
+	k_thread_user_mode_enter(bench_user, NULL, NULL, NULL);
+}
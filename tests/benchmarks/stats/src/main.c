@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <stats/stats.h>
+
+/* Statistics increment cost: one thread per CPU bumps the same counter,
+ * first in a regular group shared by all CPUs, then in a per-CPU group,
+ * and the average cost of an increment and the number of increments lost
+ * to races are reported for both.
+ */
+
+#define N_THREADS CONFIG_MP_NUM_CPUS
+#define N_INCS 100000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+STATS_SECT_START(bench_shared)
+STATS_SECT_ENTRY64(hits)
+STATS_SECT_END;
+
+STATS_NAME_START(bench_shared)
+STATS_NAME(bench_shared, hits)
+STATS_NAME_END(bench_shared);
+
+static STATS_SECT_DECL(bench_shared) bench_shared;
+
+STATS_PERCPU_SECT_START(bench_percpu)
+STATS_SECT_ENTRY64(hits)
+STATS_PERCPU_SECT_END;
+
+STATS_NAME_START(bench_percpu)
+STATS_PERCPU_NAME(bench_percpu, hits)
+STATS_NAME_END(bench_percpu);
+
+static STATS_SECT_DECL(bench_percpu) bench_percpu;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct k_thread threads[N_THREADS];
+static u32_t thread_cycles[N_THREADS];
+
+static void shared_entry(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	u32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < N_INCS; i++) {
+		STATS_INC(bench_shared, hits);
+	}
+
+	thread_cycles[id] = k_cycle_get_32() - start;
+}
+
+static void percpu_entry(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	u32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < N_INCS; i++) {
+		STATS_PERCPU_INC(bench_percpu, hits);
+	}
+
+	thread_cycles[id] = k_cycle_get_32() - start;
+}
+
+static void bench_run(const char *name, k_thread_entry_t entry,
+		      struct stats_hdr *hdr)
+{
+	u64_t total = 0U;
+	u64_t hits;
+
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+				INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += thread_cycles[i];
+	}
+
+	(void)stats_snapshot(hdr, &hits, 1, true);
+
+	printk("%-8s %6u cycles/inc, %llu lost\n", name,
+	       (u32_t)(total / (N_THREADS * N_INCS)),
+	       (u64_t)N_THREADS * N_INCS - hits);
+}
+
+void main(void)
+{
+	u64_t hits;
+	u32_t start;
+
+	(void)STATS_INIT_AND_REG(bench_shared, STATS_SIZE_64, "bench_shared");
+	(void)STATS_PERCPU_INIT_AND_REG(bench_percpu, STATS_SIZE_64,
+					"bench_percpu");
+
+	printk("%d threads, %d increments each\n", N_THREADS, N_INCS);
+
+	bench_run("shared", shared_entry, &bench_shared.s_hdr);
+	bench_run("percpu", percpu_entry, &bench_percpu.s_hdr);
+
+	start = k_cycle_get_32();
+	(void)stats_snapshot(&bench_percpu.s_hdr, &hits, 1, false);
+	printk("%-8s %6u cycles\n", "snapshot", k_cycle_get_32() - start);
+
+	printk("fin\n");
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Bulk TCP transfer between two sockets over a driver which loops the
+ * packets back, handing bursts of received segments to the stack with
+ * net_recv_data_batch(). With NET_GRO the segments of a burst reach TCP
+ * as one packet.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#define MTU 1500
+#define BATCH 16
+#define TCP_PSH 0x08
+#define TRANSFER_SIZE (256 * 1024)
+#define CHUNK_SIZE 4096
+#define STACK_SIZE 2048
+#define PORT 4242
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static u8_t tx_buf[CHUNK_SIZE];
+static u8_t rx_buf[CHUNK_SIZE];
+static u32_t tx_pkts;
+
+static struct net_pkt *batch[BATCH];
+static int batch_len;
+static K_MUTEX_DEFINE(batch_lock);
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static int loop_dev_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void loop_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, "\x00\x00\x5e\x00\x53\x01", 6,
+			     NET_LINK_DUMMY);
+}
+
+static void loop_recv_batch(struct net_if *iface)
+{
+	int ret = net_recv_data_batch(iface, batch, batch_len);
+
+	for (int i = MAX(ret, 0); i < batch_len; i++) {
+		net_pkt_unref(batch[i]);
+	}
+
+	batch_len = 0;
+}
+
+/* Loop the packet back as if it came from the peer. Data segments are
+ * collected until the sender pushes, anything else goes up at once.
+ */
+static int loop_send(struct device *dev, struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *ipv4_hdr = NET_IPV4_HDR(pkt);
+	struct net_tcp_hdr *tcp_hdr = (struct net_tcp_hdr *)(ipv4_hdr + 1);
+	bool data = net_pkt_get_len(pkt) > NET_IPV4TCPH_LEN;
+	struct net_pkt *cloned;
+	struct in_addr addr;
+
+	ARG_UNUSED(dev);
+
+	tx_pkts++;
+
+	net_ipaddr_copy(&addr, &ipv4_hdr->src);
+	net_ipaddr_copy(&ipv4_hdr->src, &ipv4_hdr->dst);
+	net_ipaddr_copy(&ipv4_hdr->dst, &addr);
+
+	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	if (!cloned) {
+		return -ENOMEM;
+	}
+
+	k_mutex_lock(&batch_lock, K_FOREVER);
+
+	batch[batch_len++] = cloned;
+
+	if (!data || (tcp_hdr->flags & TCP_PSH) || batch_len == BATCH) {
+		loop_recv_batch(net_pkt_iface(cloned));
+	}
+
+	k_mutex_unlock(&batch_lock);
+
+	return 0;
+}
+
+static struct dummy_api loop_api = {
+	.iface_api.init = loop_iface_init,
+	.send = loop_send,
+};
+
+NET_DEVICE_INIT(tcp_gro_loop, "tcp_gro_loop",
+		loop_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&loop_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), MTU);
+
+static void server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	size_t received = 0;
+	int client;
+	ssize_t len;
+
+	client = accept(sock, NULL, NULL);
+
+	while (client >= 0 && received < TRANSFER_SIZE) {
+		len = recv(client, rx_buf, sizeof(rx_buf), 0);
+		if (len <= 0) {
+			break;
+		}
+
+		received += len;
+	}
+
+	if (client >= 0) {
+		close(client);
+	}
+
+	k_sem_give(&server_done);
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	u32_t start, cycles, ms, cpb;
+	size_t offset = 0;
+	int sock, client;
+	ssize_t len;
+
+	net_if_ipv4_addr_add(net_if_get_default(), &my_addr, NET_ADDR_MANUAL,
+			     0);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 || bind(sock, (struct sockaddr *)&addr,
+			     sizeof(addr)) < 0 || listen(sock, 1) < 0) {
+		printk("cannot create server socket (%d)\n", errno);
+		return;
+	}
+
+	k_thread_create(&server_thread, server_stack, STACK_SIZE, server,
+			INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	addr.sin_addr = peer_addr;
+	client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (client < 0 || connect(client, (struct sockaddr *)&addr,
+				  sizeof(addr)) < 0) {
+		printk("cannot connect (%d)\n", errno);
+		return;
+	}
+
+	/* Let the handshake complete */
+	k_msleep(100);
+
+	tx_pkts = 0U;
+	start = k_uptime_get_32();
+	cycles = k_cycle_get_32();
+
+	while (offset < TRANSFER_SIZE) {
+		len = send(client, tx_buf,
+			   MIN(sizeof(tx_buf), TRANSFER_SIZE - offset), 0);
+		if (len < 0) {
+			/* Buffers are still held by unacknowledged data */
+			k_msleep(1);
+			continue;
+		}
+
+		offset += len;
+	}
+
+	k_sem_take(&server_done, K_FOREVER);
+
+	cycles = k_cycle_get_32() - cycles;
+	ms = MAX(k_uptime_get_32() - start, 1U);
+
+	/* Hundredths of a cycle per byte */
+	cpb = (u64_t)cycles * 100U / TRANSFER_SIZE;
+
+	printk("gro %s  %7u segments/s  %u.%02u cycles/byte\n",
+	       IS_ENABLED(CONFIG_NET_GRO) ? "on" : "off",
+	       (u32_t)((u64_t)tx_pkts * MSEC_PER_SEC / ms),
+	       cpb / 100U, cpb % 100U);
+
+	close(client);
+	close(sock);
+	k_thread_join(&server_thread, K_FOREVER);
+
+	printk("fin\n");
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * TCP throughput and packets per byte over a loopback interface. Both
+ * ends of the connection live on this stack, so every packet is counted
+ * once: data segments from the client and acknowledgments from the
+ * server.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#define MTU 1500
+#define STACK_SIZE 2048
+#define RX_BUF_SIZE 2048
+#define DONE_TIMEOUT K_SECONDS(60)
+
+#define BULK_SIZE (512 * 1024)
+#define BULK_WRITE 1024
+#define SMALL_SIZE (32 * 1024)
+#define SMALL_WRITE 32
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static u16_t server_port = 5001;
+
+static u32_t data_pkts;
+static u32_t ack_pkts;
+
+static u8_t tx_buf[BULK_WRITE];
+static u8_t rx_buf[RX_BUF_SIZE];
+static size_t expected;
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static int loop_dev_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void loop_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, "\x00\x00\x5e\x00\x53\x02", 6,
+			     NET_LINK_DUMMY);
+}
+
+/* Count the segment, then loop it back as if it came from the peer */
+static int loop_send(struct device *dev, struct net_pkt *pkt)
+{
+	u8_t *tcp = pkt->buffer->data + NET_IPV4H_LEN;
+	struct net_pkt *cloned;
+	struct in_addr addr;
+
+	ARG_UNUSED(dev);
+
+	/* The data offset is the high nibble of the 13th header byte */
+	if (net_pkt_get_len(pkt) > NET_IPV4H_LEN + (tcp[12] >> 4) * 4) {
+		data_pkts++;
+	} else {
+		ack_pkts++;
+	}
+
+	net_ipaddr_copy(&addr, &NET_IPV4_HDR(pkt)->src);
+	net_ipaddr_copy(&NET_IPV4_HDR(pkt)->src, &NET_IPV4_HDR(pkt)->dst);
+	net_ipaddr_copy(&NET_IPV4_HDR(pkt)->dst, &addr);
+
+	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	if (!cloned) {
+		return -ENOMEM;
+	}
+
+	if (net_recv_data(net_pkt_iface(cloned), cloned) < 0) {
+		net_pkt_unref(cloned);
+	}
+
+	return 0;
+}
+
+static struct dummy_api loop_api = {
+	.iface_api.init = loop_iface_init,
+	.send = loop_send,
+};
+
+NET_DEVICE_INIT(tcp_loop, "tcp_loop",
+		loop_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&loop_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), MTU);
+
+static void server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	size_t received = 0;
+	int client;
+	ssize_t len;
+
+	client = accept(sock, NULL, NULL);
+
+	while (client >= 0 && received < expected) {
+		len = recv(client, rx_buf, sizeof(rx_buf), 0);
+		if (len <= 0) {
+			break;
+		}
+
+		received += len;
+	}
+
+	if (client >= 0) {
+		close(client);
+	}
+
+	k_sem_give(&server_done);
+}
+
+static void run(const char *name, int optname, size_t size, size_t chunk)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(++server_port),
+	};
+	int sock, client, one = 1, zero = 0;
+	u32_t start, elapsed, pkts;
+	size_t offset = 0;
+	ssize_t len;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 || bind(sock, (struct sockaddr *)&addr,
+			     sizeof(addr)) < 0 || listen(sock, 1) < 0) {
+		printk("%s: cannot set up the server (%d)\n", name, errno);
+		return;
+	}
+
+	expected = size;
+	k_thread_create(&server_thread, server_stack, STACK_SIZE, server,
+			INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	addr.sin_addr = peer_addr;
+	if (client < 0 || connect(client, (struct sockaddr *)&addr,
+				  sizeof(addr)) < 0) {
+		printk("%s: cannot connect (%d)\n", name, errno);
+		return;
+	}
+
+	if (optname && setsockopt(client, IPPROTO_TCP, optname, &one,
+				  sizeof(one)) < 0) {
+		printk("%s: setsockopt failed (%d)\n", name, errno);
+	}
+
+	/* Let the handshake complete */
+	k_msleep(100);
+
+	data_pkts = 0U;
+	ack_pkts = 0U;
+	start = k_uptime_get_32();
+
+	while (offset < size) {
+		len = send(client, tx_buf, MIN(chunk, size - offset), 0);
+		if (len < 0) {
+			/* Buffers are held by unacknowledged data */
+			k_msleep(1);
+			continue;
+		}
+
+		offset += len;
+	}
+
+	if (optname == TCP_CORK) {
+		/* Let the last partial segment go */
+		setsockopt(client, IPPROTO_TCP, TCP_CORK, &zero, sizeof(zero));
+	}
+
+	if (k_sem_take(&server_done, DONE_TIMEOUT) < 0) {
+		printk("%s: timed out\n", name);
+	}
+
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+	pkts = data_pkts + ack_pkts;
+
+	printk("%-8s %7zu bytes %6u ms %6u kB/s %6u data %6u ack "
+	       "%u.%02u pkts/kB\n", name, size, elapsed,
+	       (u32_t)(size / elapsed), data_pkts, ack_pkts,
+	       (u32_t)(pkts * 1024U / size),
+	       (u32_t)(pkts * 102400U / size % 100U));
+
+	close(client);
+	close(sock);
+	k_thread_join(&server_thread, K_FOREVER);
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+
+	if (!net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0)) {
+		printk("cannot add address\n");
+		return;
+	}
+
+	memset(tx_buf, 0xa5, sizeof(tx_buf));
+
+	run("bulk", 0, BULK_SIZE, BULK_WRITE);
+	run("nagle", 0, SMALL_SIZE, SMALL_WRITE);
+	run("nodelay", TCP_NODELAY, SMALL_SIZE, SMALL_WRITE);
+	run("cork", TCP_CORK, SMALL_SIZE, SMALL_WRITE);
+
+	printk("fin\n");
+}
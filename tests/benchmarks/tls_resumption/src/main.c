@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Time of a TLS client handshake over loopback, with the full ECDHE-PSK
+ * key exchange on every connection, and with the session cached and
+ * resumed from the second connection on. Whether sessions are resumed is
+ * tested in tests/net/socket/tls_resumption.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <errno.h>
+
+#include <net/socket.h>
+#include <net/tls_credentials.h>
+
+#define ROUNDS 20
+#define PORT 4243
+#define PSK_TAG 1
+#define STACK_SIZE 8192
+
+static const unsigned char psk[] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+static const char psk_id[] = "tls_resumption";
+
+/* TLS-ECDHE-PSK-WITH-AES-128-CBC-SHA256 */
+static const int ciphersuites[] = { 0xC037 };
+
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static int tls_socket(int cache)
+{
+	sec_tag_t tag = PSK_TAG;
+	int sock;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	if (sock < 0) {
+		printk("cannot create socket (%d)\n", errno);
+		k_panic();
+	}
+
+	if (setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST, &tag,
+		       sizeof(tag)) < 0 ||
+	    setsockopt(sock, SOL_TLS, TLS_CIPHERSUITE_LIST, ciphersuites,
+		       sizeof(ciphersuites)) < 0 ||
+	    setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE, &cache,
+		       sizeof(cache)) < 0) {
+		printk("cannot set TLS options (%d)\n", errno);
+		k_panic();
+	}
+
+	return sock;
+}
+
+/* Accept the connections, the handshake is done by accept(). The server
+ * keeps sessions in all the rounds, whether the client asks to resume
+ * them or not.
+ */
+static void server(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	int sock, client;
+
+	sock = tls_socket(TLS_SESSION_CACHE_ENABLED);
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		printk("cannot listen (%d)\n", errno);
+		k_panic();
+	}
+
+	k_sem_give(&server_ready);
+
+	for (;;) {
+		client = accept(sock, NULL, NULL);
+		if (client >= 0) {
+			close(client);
+		}
+
+		k_sem_give(&server_done);
+	}
+}
+
+K_THREAD_DEFINE(server_tid, STACK_SIZE, server, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(8), 0, 0);
+
+/* Connect once, return the cycles the handshake took */
+static u32_t handshake(int cache)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	u32_t start, cycles;
+	int sock;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	sock = tls_socket(cache);
+
+	start = k_cycle_get_32();
+
+	if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot connect (%d)\n", errno);
+		k_panic();
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	close(sock);
+	k_sem_take(&server_done, K_FOREVER);
+
+	return cycles;
+}
+
+static u32_t measure(int cache)
+{
+	u32_t cycles = 0U;
+
+	/* The first handshake is a full one in both cases */
+	for (int i = 0; i <= ROUNDS; i++) {
+		u32_t round = handshake(cache);
+
+		if (i > 0) {
+			cycles += round;
+		}
+	}
+
+	return k_cyc_to_us_floor32(cycles / ROUNDS);
+}
+
+void main(void)
+{
+	u32_t full, resumed;
+
+	if (tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK, psk,
+			       sizeof(psk)) < 0 ||
+	    tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK_ID, psk_id,
+			       sizeof(psk_id) - 1) < 0) {
+		printk("cannot add credentials\n");
+		k_panic();
+	}
+
+	k_sem_take(&server_ready, K_FOREVER);
+
+	full = measure(TLS_SESSION_CACHE_DISABLED);
+	resumed = measure(TLS_SESSION_CACHE_ENABLED);
+
+	printk("full handshake     %u us\n", full);
+	printk("resumed handshake  %u us\n", resumed);
+
+	printk("fin\n");
+}
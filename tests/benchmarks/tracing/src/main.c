@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <tracing/tracing.h>
+#include <tracing/tracing_format.h>
+
+/* Tracing overhead microbenchmark: call the tracing hooks in bursts that
+ * fit in the tracing buffer, let the tracing thread drain the buffer
+ * between bursts, and report the average number of cycles per event.
+ */
+
+#define N_BURSTS 32
+#define N_EVENTS 32
+
+/* Time for the tracing thread to stream out a burst of events */
+#define DRAIN_MS (2 * CONFIG_TRACING_THREAD_WAIT_THRESHOLD)
+
+typedef void (*bench_fn_t)(void);
+
+static void bench_thread_ready(void)
+{
+	sys_trace_thread_ready(k_current_get());
+}
+
+static void bench_sema_give(void)
+{
+	sys_trace_void(SYS_TRACE_ID_SEMA_GIVE);
+}
+
+static u32_t bench_run(bench_fn_t fn)
+{
+	u64_t total = 0U;
+
+	for (int i = 0; i < N_BURSTS; i++) {
+		u32_t start = k_cycle_get_32();
+
+		for (int j = 0; j < N_EVENTS; j++) {
+			fn();
+		}
+
+		total += k_cycle_get_32() - start;
+
+		k_msleep(DRAIN_MS);
+	}
+
+	return (u32_t)(total / (N_BURSTS * N_EVENTS));
+}
+
+void main(void)
+{
+	u32_t filter = tracing_filter_get();
+	u32_t cycles;
+
+	/* Let the tracing thread flush the boot events */
+	k_msleep(DRAIN_MS);
+
+	cycles = bench_run(bench_thread_ready);
+	printk("thread_ready %6u cycles/event\n", cycles);
+
+	cycles = bench_run(bench_sema_give);
+	printk("sema_give    %6u cycles/event\n", cycles);
+
+	tracing_filter_set(filter & ~TRACING_CLASS_THREAD);
+	cycles = bench_run(bench_thread_ready);
+	tracing_filter_set(filter);
+	printk("filtered     %6u cycles/event\n", cycles);
+
+#ifdef CONFIG_TRACING_BUFFER_OVERWRITE
+	tracing_flight_recorder_dump();
+#endif
+
+	printk("fin\n");
+}
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Websocket frame rate against a server stand-in over loopback. Sending,
+ * the client masks every frame it sends as RFC 6455 requires, the server
+ * only counts the bytes. Receiving, the server sends one message split in
+ * fragments of the given size and the client reads it as it arrives.
+ * Reported are the frames per second and the payload throughput.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <errno.h>
+#include <string.h>
+
+#include <net/socket.h>
+#include <net/http_client.h>
+#include <net/websocket.h>
+#include <sys/base64.h>
+#include <mbedtls/sha1.h>
+
+#include "websocket_internal.h"
+
+#define FRAMES 256
+#define MAX_PAYLOAD_SIZE 1024
+#define SERVER_PORT 8080
+#define SERVER_STACK_SIZE 2048
+#define WS_KEY_FIELD "Sec-WebSocket-Key: "
+
+static const size_t payload_sizes[] = { 64, MAX_PAYLOAD_SIZE };
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+
+static K_SEM_DEFINE(server_done, 0, 1);
+static K_SEM_DEFINE(server_go, 0, 1);
+
+static u8_t server_buf[MAX_HEADER_LEN + MAX_PAYLOAD_SIZE];
+static u8_t tmp_buf[512];
+static u8_t payload[MAX_PAYLOAD_SIZE];
+static u8_t recv_buf[MAX_PAYLOAD_SIZE];
+
+static int server_handshake(int sock)
+{
+	u8_t sha1[WS_SHA1_OUTPUT_LEN];
+	char key[32 + sizeof(WS_MAGIC)];
+	char accept[32];
+	char *start, *end;
+	size_t len = 0, olen;
+	ssize_t ret;
+
+	do {
+		ret = recv(sock, server_buf + len, sizeof(server_buf) - len - 1,
+			   0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		len += ret;
+		server_buf[len] = '\0';
+	} while (!strstr((char *)server_buf, "\r\n\r\n"));
+
+	start = strstr((char *)server_buf, WS_KEY_FIELD);
+	if (!start) {
+		return -EINVAL;
+	}
+
+	start += sizeof(WS_KEY_FIELD) - 1;
+	end = strstr(start, "\r\n");
+	if (!end) {
+		return -EINVAL;
+	}
+
+	len = end - start;
+	if (len > sizeof(key) - sizeof(WS_MAGIC)) {
+		return -EINVAL;
+	}
+
+	memcpy(key, start, len);
+	memcpy(key + len, WS_MAGIC, sizeof(WS_MAGIC) - 1);
+
+	mbedtls_sha1_ret((const unsigned char *)key,
+			 len + sizeof(WS_MAGIC) - 1, sha1);
+
+	if (base64_encode((u8_t *)accept, sizeof(accept) - 1, &olen, sha1,
+			  sizeof(sha1)) < 0) {
+		return -EINVAL;
+	}
+
+	accept[olen] = '\0';
+
+	len = snprintk((char *)server_buf, sizeof(server_buf),
+		       "HTTP/1.1 101 Switching Protocols\r\n"
+		       "Upgrade: websocket\r\n"
+		       "Connection: Upgrade\r\n"
+		       "Sec-WebSocket-Accept: %s\r\n\r\n", accept);
+
+	return send(sock, server_buf, len, 0) < 0 ? -EIO : 0;
+}
+
+/* Takes in FRAMES masked frames of the given payload size */
+static int server_count(int sock, size_t size)
+{
+	size_t header_len = MIN_HEADER_LEN + (size < 126 ? 0 : 2) + 4;
+	size_t expected = FRAMES * (header_len + size);
+	ssize_t ret;
+
+	while (expected > 0) {
+		ret = recv(sock, server_buf, MIN(sizeof(server_buf), expected),
+			   0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		expected -= ret;
+	}
+
+	return 0;
+}
+
+/* Sends one binary message as FRAMES unmasked fragments */
+static int server_send(int sock, size_t size)
+{
+	size_t header_len = MIN_HEADER_LEN;
+
+	if (size < 126) {
+		server_buf[1] = size;
+	} else {
+		server_buf[1] = 126;
+		server_buf[2] = size >> 8;
+		server_buf[3] = size;
+		header_len += 2;
+	}
+
+	memset(server_buf + header_len, 'x', size);
+
+	for (int i = 0; i < FRAMES; i++) {
+		server_buf[0] = (i == 0) ? WEBSOCKET_OPCODE_DATA_BINARY :
+					   WEBSOCKET_OPCODE_CONTINUE;
+		if (i == FRAMES - 1) {
+			server_buf[0] |= BIT(7);
+		}
+
+		if (send(sock, server_buf, header_len + size, 0) < 0) {
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	int client;
+
+	client = accept(sock, NULL, NULL);
+	if (client < 0 || server_handshake(client) < 0) {
+		printk("server: no websocket handshake\n");
+		goto out;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+		if (server_count(client, payload_sizes[i]) < 0) {
+			printk("server: frames lost\n");
+			goto out;
+		}
+
+		k_sem_give(&server_done);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+		k_sem_take(&server_go, K_FOREVER);
+
+		if (server_send(client, payload_sizes[i]) < 0) {
+			printk("server: cannot send\n");
+			goto out;
+		}
+	}
+
+	/* Wait for the client to close */
+	while (recv(client, server_buf, sizeof(server_buf), 0) > 0) {
+	}
+
+out:
+	if (client >= 0) {
+		close(client);
+	}
+}
+
+static void report(const char *name, size_t size, u32_t cycles)
+{
+	u64_t elapsed_us = MAX((u64_t)cycles * USEC_PER_SEC /
+			       sys_clock_hw_cycles_per_sec(), 1);
+	u32_t mbps_x100 = (u64_t)FRAMES * size * 100U / elapsed_us;
+
+	printk("%s %5zu B %5u frames %8u frames/s %4u.%02u MB/s\n", name,
+	       size, FRAMES, (u32_t)(FRAMES * USEC_PER_SEC / elapsed_us),
+	       mbps_x100 / 100U, mbps_x100 % 100U);
+}
+
+static void run_send(int ws_sock, size_t size)
+{
+	u32_t start = k_cycle_get_32();
+	int ret;
+
+	for (int i = 0; i < FRAMES; i++) {
+		ret = websocket_send_msg(ws_sock, payload, size,
+					 WEBSOCKET_OPCODE_DATA_BINARY, true,
+					 true, NET_WAIT_FOREVER);
+		if (ret != size) {
+			printk("send: failed at frame %d (%d)\n", i, ret);
+			k_panic();
+		}
+	}
+
+	k_sem_take(&server_done, K_FOREVER);
+
+	report("send", size, k_cycle_get_32() - start);
+}
+
+static void run_recv(int ws_sock, size_t size)
+{
+	u32_t start = k_cycle_get_32();
+	u32_t message_type = 0U;
+	u64_t remaining;
+	size_t total = 0;
+	int ret;
+
+	k_sem_give(&server_go);
+
+	while (total < FRAMES * size) {
+		ret = websocket_recv_msg(ws_sock, recv_buf, sizeof(recv_buf),
+					 &message_type, &remaining,
+					 NET_WAIT_FOREVER);
+		if (ret == -EAGAIN) {
+			continue;
+		}
+
+		if (ret <= 0 || !(message_type & WEBSOCKET_FLAG_BINARY)) {
+			printk("recv: failed after %zu bytes (%d)\n", total,
+			       ret);
+			k_panic();
+		}
+
+		total += ret;
+	}
+
+	if (!(message_type & WEBSOCKET_FLAG_FINAL) || remaining > 0) {
+		printk("recv: message not complete\n");
+		k_panic();
+	}
+
+	report("recv", size, k_cycle_get_32() - start);
+}
+
+void main(void)
+{
+	struct websocket_request req;
+	int sock, http_sock, ws_sock;
+
+	memset(payload, 'x', sizeof(payload));
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&server_addr,
+		 sizeof(server_addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		printk("cannot set up the server (%d)\n", errno);
+		return;
+	}
+
+	k_thread_create(&server_thread, server_stack, SERVER_STACK_SIZE,
+			server, INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	http_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (http_sock < 0 ||
+	    connect(http_sock, (struct sockaddr *)&server_addr,
+		    sizeof(server_addr)) < 0) {
+		printk("cannot connect (%d)\n", errno);
+		return;
+	}
+
+	memset(&req, 0, sizeof(req));
+
+	req.host = CONFIG_NET_CONFIG_MY_IPV4_ADDR;
+	req.url = "/";
+	req.tmp_buf = tmp_buf;
+	req.tmp_buf_len = sizeof(tmp_buf);
+
+	ws_sock = websocket_connect(http_sock, &req, NET_WAIT_FOREVER, NULL);
+	if (ws_sock < 0) {
+		printk("no websocket (%d)\n", ws_sock);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+		run_send(ws_sock, payload_sizes[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+		run_recv(ws_sock, payload_sizes[i]);
+	}
+
+	websocket_disconnect(ws_sock);
+	k_thread_join(&server_thread, K_FOREVER);
+	close(sock);
+
+	printk("fin\n");
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <debug/thread_runtime_stats.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define BUSY_US 20000
+#define WINDOW_MS CONFIG_TRACING_CPU_STATS_WINDOW
+
+static K_THREAD_STACK_DEFINE(busy_stack, STACK_SIZE);
+static struct k_thread busy_thread;
+
+static void busy_entry(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(BUSY_US);
+}
+
+/**
+ * @brief Tests for thread runtime statistics
+ * @defgroup kernel_runtime_stats_tests Runtime statistics
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+/**
+ * @brief Test that a busy thread accumulates execution cycles
+ *
+ * @ingroup kernel_runtime_stats_tests
+ *
+ * @see k_thread_runtime_stats_get()
+ */
+void test_thread_execution_cycles(void)
+{
+	struct k_thread_runtime_stats stats;
+	u64_t busy_cycles = k_us_to_cyc_floor64(BUSY_US);
+
+	k_thread_create(&busy_thread, busy_stack, STACK_SIZE,
+			busy_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_name_set(&busy_thread, "busy");
+	k_thread_join(&busy_thread, K_FOREVER);
+
+	zassert_equal(k_thread_runtime_stats_get(&busy_thread, &stats), 0,
+		      NULL);
+	zassert_true(stats.execution_cycles >= busy_cycles,
+		     "busy thread accounted %llu cycles, expected %llu",
+		     stats.execution_cycles, busy_cycles);
+	zassert_true(stats.switch_count >= 1U, NULL);
+}
+
+/**
+ * @brief Test that the current thread sees its own running time
+ *
+ * @ingroup kernel_runtime_stats_tests
+ *
+ * @see k_thread_runtime_stats_get()
+ */
+void test_current_thread_monotonic(void)
+{
+	struct k_thread_runtime_stats before, after;
+
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &before), 0,
+		      NULL);
+	k_busy_wait(1000);
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &after), 0,
+		      NULL);
+
+	zassert_true(after.execution_cycles > before.execution_cycles, NULL);
+}
+
+/**
+ * @brief Test windowed utilisation
+ *
+ * Keep the CPU busy for a whole window and check that both the thread and
+ * the system utilisation of the last window are close to 100 %, then sleep
+ * for a whole window and check that utilisation drops.
+ *
+ * @ingroup kernel_runtime_stats_tests
+ *
+ * @see k_thread_runtime_stats_get(), k_cpu_runtime_stats_get()
+ */
+void test_window_utilisation(void)
+{
+	struct k_thread_runtime_stats stats;
+	struct cpu_runtime_stats cpu;
+
+	/* Align on a window boundary, then spin for two windows so the last
+	 * complete one is fully busy.
+	 */
+	k_msleep(WINDOW_MS);
+	k_busy_wait(2 * WINDOW_MS * USEC_PER_MSEC);
+
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &stats), 0,
+		      NULL);
+	zassert_equal(k_cpu_runtime_stats_get(&cpu), 0, NULL);
+	zassert_true(stats.window_length > 0U, NULL);
+	zassert_true(stats.window_percent >= 80U, "thread usage %u %%",
+		     stats.window_percent);
+	zassert_true(cpu.window_percent >= 80U, "cpu usage %u %%",
+		     cpu.window_percent);
+
+	k_msleep(2 * WINDOW_MS);
+
+	zassert_equal(k_cpu_runtime_stats_get(&cpu), 0, NULL);
+	zassert_true(cpu.window_percent <= 20U, "cpu usage %u %%",
+		     cpu.window_percent);
+	zassert_true(cpu.idle_cycles > 0U, NULL);
+}
+
+/**
+ * @brief Test parameter validation
+ *
+ * @ingroup kernel_runtime_stats_tests
+ *
+ * @see k_thread_runtime_stats_get(), isr_runtime_stats_get()
+ */
+void test_invalid_params(void)
+{
+	struct k_thread_runtime_stats stats;
+	struct isr_runtime_stats isr;
+
+	zassert_equal(k_thread_runtime_stats_get(NULL, &stats), -EINVAL, NULL);
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), NULL),
+		      -EINVAL, NULL);
+	zassert_equal(k_cpu_runtime_stats_get(NULL), -EINVAL, NULL);
+	zassert_true(isr_runtime_stats_lines() >= 1U, NULL);
+	zassert_equal(isr_runtime_stats_get(isr_runtime_stats_lines(), &isr),
+		      -EINVAL, NULL);
+	zassert_equal(isr_runtime_stats_get(0, &isr), 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(runtime_stats,
+			 ztest_unit_test(test_thread_execution_cycles),
+			 ztest_unit_test(test_current_thread_monotonic),
+			 ztest_1cpu_unit_test(test_window_utilisation),
+			 ztest_unit_test(test_invalid_params));
+	ztest_run_test_suite(runtime_stats);
+}
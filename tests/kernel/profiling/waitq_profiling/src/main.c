@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <debug/waitq_profiling.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define HOLD_MS 20
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+K_MUTEX_DEFINE(test_mutex);
+K_SEM_DEFINE(test_sem, 0, 1);
+K_SEM_DEFINE(idle_sem, 1, 1);
+
+/* One more object than can be profiled */
+static struct k_sem evict_sems[CONFIG_WAITQ_PROFILING_SLOTS + 1];
+
+static void mutex_waiter(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_mutex_unlock(&test_mutex);
+}
+
+/**
+ * @brief Tests for kernel object contention profiling
+ * @defgroup kernel_waitq_profiling_tests Contention profiling
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+/**
+ * @brief Test that blocking on a contended mutex is recorded
+ *
+ * Hold the mutex while another thread blocks on it, then check the number
+ * of contentions, the accumulated wait time and the top waiter.
+ *
+ * @ingroup kernel_waitq_profiling_tests
+ *
+ * @see waitq_profile_get()
+ */
+void test_mutex_contention(void)
+{
+	struct waitq_profile profile;
+	u64_t hold_cycles = k_ms_to_cyc_floor64(HOLD_MS / 2);
+
+	waitq_profile_reset();
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE,
+			mutex_waiter, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_msleep(HOLD_MS);
+	k_mutex_unlock(&test_mutex);
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&test_mutex, &profile), 0, NULL);
+	zassert_equal(profile.wait_q, &test_mutex.wait_q, NULL);
+	zassert_equal(profile.contentions, 1U, NULL);
+	zassert_equal(profile.timeouts, 0U, NULL);
+	zassert_true(profile.total_wait_cycles >= hold_cycles,
+		     "waited %llu cycles, expected %llu",
+		     profile.total_wait_cycles, hold_cycles);
+	zassert_equal(profile.max_wait_cycles, profile.total_wait_cycles,
+		      NULL);
+	zassert_equal(profile.top[0].thread, &waiter_thread, NULL);
+	zassert_equal(profile.top[0].count, 1U, NULL);
+}
+
+/**
+ * @brief Test that waits ending with a timeout are counted
+ *
+ * @ingroup kernel_waitq_profiling_tests
+ *
+ * @see waitq_profile_get()
+ */
+void test_sem_timeout(void)
+{
+	struct waitq_profile profile;
+
+	waitq_profile_reset();
+
+	zassert_equal(k_sem_take(&test_sem, K_MSEC(HOLD_MS)), -EAGAIN, NULL);
+	zassert_equal(k_sem_take(&test_sem, K_MSEC(HOLD_MS)), -EAGAIN, NULL);
+
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&test_sem, &profile), 0, NULL);
+	zassert_equal(profile.contentions, 2U, NULL);
+	zassert_equal(profile.timeouts, 2U, NULL);
+	zassert_equal(profile.top[0].thread, k_current_get(), NULL);
+	zassert_equal(profile.top[0].count, 2U, NULL);
+	zassert_is_null(profile.top[1].thread, NULL);
+}
+
+/**
+ * @brief Test that uncontended objects and reset profiles are not reported
+ *
+ * @ingroup kernel_waitq_profiling_tests
+ *
+ * @see waitq_profile_get(), waitq_profile_reset()
+ */
+void test_uncontended(void)
+{
+	struct waitq_profile profile;
+
+	zassert_equal(k_sem_take(&idle_sem, K_NO_WAIT), 0, NULL);
+	k_sem_give(&idle_sem);
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&idle_sem, &profile), -ENOENT,
+		      NULL);
+
+	zassert_equal(k_sem_take(&test_sem, K_MSEC(1)), -EAGAIN, NULL);
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&test_sem, &profile), 0, NULL);
+
+	waitq_profile_reset();
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&test_sem, &profile), -ENOENT,
+		      NULL);
+}
+
+/**
+ * @brief Test that a full table evicts the least contended profile
+ *
+ * Time out on more semaphores than there are slots, the first one for
+ * longer than the others. It and the last one must still be profiled,
+ * and the eviction must be counted.
+ *
+ * @ingroup kernel_waitq_profiling_tests
+ *
+ * @see waitq_profile_evictions()
+ */
+void test_eviction(void)
+{
+	struct waitq_profile profile;
+	int last = ARRAY_SIZE(evict_sems) - 1;
+
+	waitq_profile_reset();
+
+	for (int i = 0; i <= last; i++) {
+		k_sem_init(&evict_sems[i], 0, 1);
+	}
+
+	zassert_equal(k_sem_take(&evict_sems[0], K_MSEC(HOLD_MS)), -EAGAIN,
+		      NULL);
+
+	for (int i = 1; i <= last; i++) {
+		zassert_equal(k_sem_take(&evict_sems[i], K_MSEC(1)), -EAGAIN,
+			      NULL);
+	}
+
+	zassert_true(waitq_profile_evictions() > 0, NULL);
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&evict_sems[0], &profile), 0,
+		      NULL);
+	zassert_equal(K_OBJ_WAIT_PROFILE_GET(&evict_sems[last], &profile), 0,
+		      NULL);
+	zassert_equal(profile.timeouts, 1, NULL);
+
+	waitq_profile_reset();
+	zassert_equal(waitq_profile_evictions(), 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(waitq_profiling,
+			 ztest_1cpu_unit_test(test_mutex_contention),
+			 ztest_unit_test(test_sem_timeout),
+			 ztest_unit_test(test_uncontended),
+			 ztest_unit_test(test_eviction));
+	ztest_run_test_suite(waitq_profiling);
+}
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_ARP_LOG_LEVEL);
 #include <ztest.h>
 
 #include "arp.h"
+#include "route.h"
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
@@ -641,9 +642,75 @@ void test_arp(void)
 	}
 }
 
+/* Check that an ARP request for dst is sent to expected */
+static void arp_route_check(struct net_if *iface, struct in_addr *dst,
+			    struct in_addr *expected)
+{
+	struct in_addr src = { { { 192, 168, 0, 1 } } };
+	struct net_ipv4_hdr *ipv4;
+	struct net_arp_hdr *arp_hdr;
+	struct net_pkt *pkt, *req;
+
+	net_arp_clear_cache(iface);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	net_pkt_lladdr_src(pkt)->addr = (u8_t *)net_if_get_link_addr(iface);
+	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipaddr_copy(&ipv4->src, &src);
+	net_ipaddr_copy(&ipv4->dst, dst);
+
+	req = net_arp_prepare(pkt, &NET_IPV4_HDR(pkt)->dst, NULL);
+	zassert_not_null(req, "ARP request not created");
+	zassert_not_equal(req, pkt, "ARP cache should not find anything");
+
+	arp_hdr = NET_ARP_HDR(req);
+
+	zassert_true(net_ipv4_addr_cmp(&arp_hdr->dst_ipaddr, expected),
+		     "ARP IP dst %s, should be %s",
+		     net_sprint_ipv4_addr(&arp_hdr->dst_ipaddr),
+		     net_sprint_ipv4_addr(expected));
+
+	net_pkt_unref(req);
+	net_pkt_unref(pkt);
+
+	/* Drops the reference that the pending request holds */
+	net_arp_clear_cache(iface);
+}
+
+void test_arp_route(void)
+{
+	struct in_addr dst_far = { { { 10, 11, 12, 13 } } };
+	struct in_addr dst_far2 = { { { 172, 16, 14, 186 } } };
+	struct in_addr prefix = { { { 10, 0, 0, 0 } } };
+	struct in_addr gw = { { { 192, 168, 0, 42 } } };
+	struct in_addr route_gw = { { { 192, 168, 0, 43 } } };
+	struct net_route_entry_ipv4 *route;
+	struct net_if *iface = net_if_get_default();
+
+	route = net_route_ipv4_add(iface, &prefix, 8, &route_gw);
+	zassert_not_null(route, "Cannot add route");
+
+	/* Through the gateway of the route if one matches, the default
+	 * gateway of the interface otherwise.
+	 */
+	arp_route_check(iface, &dst_far, &route_gw);
+	arp_route_check(iface, &dst_far2, &gw);
+
+	zassert_equal(net_route_ipv4_del(route), 0, "Cannot delete route");
+
+	arp_route_check(iface, &dst_far, &gw);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_arp_fn,
-		ztest_unit_test(test_arp));
+		ztest_unit_test(test_arp),
+		ztest_unit_test(test_arp_route));
 	ztest_run_test_suite(test_arp_fn);
 }
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_UDP_LOG_LEVEL);
+
+#include <ztest.h>
+#include <sys/byteorder.h>
+
+#include <net/dummy.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+#include <net/udp.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define MAX_LEN 300
+#define DATA_LEN 200
+#define PORT 4242
+
+static struct in_addr src_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr dst_addr = { { { 192, 0, 2, 2 } } };
+
+static u8_t src_buf[MAX_LEN + 4];
+static u8_t dst_buf[MAX_LEN + 4];
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int dummy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static int dummy_send(struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_chksum_test, "net_chksum_test", dummy_dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* The sum as RFC 1071 defines it, one 16 bit word at a time */
+static u16_t ref_sum(u16_t sum, const u8_t *data, size_t len)
+{
+	u32_t acc = sum;
+
+	for (size_t i = 0; i < len; i += 2) {
+		acc += data[i] << 8;
+		if (i + 1 < len) {
+			acc += data[i + 1];
+		}
+
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return acc;
+}
+
+static void fill(u8_t *buf, size_t len, u32_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		seed = seed * 1103515245U + 12345U;
+		buf[i] = seed >> 16;
+	}
+}
+
+/**
+ * @brief Every length and alignment sums up and copies as RFC 1071 says
+ */
+static void test_chksum_copy(void)
+{
+	u16_t sum;
+
+	for (int offset = 0; offset < 4; offset++) {
+		for (size_t len = 0; len <= MAX_LEN; len++) {
+			fill(src_buf, sizeof(src_buf), len);
+			memset(dst_buf, 0, sizeof(dst_buf));
+
+			sum = net_calc_chksum_copy(0x1234, dst_buf + offset,
+						   src_buf + offset, len);
+
+			zassert_equal(sum, ref_sum(0x1234, src_buf + offset,
+						   len),
+				      "wrong sum, offset %d length %zu",
+				      offset, len);
+			zassert_mem_equal(dst_buf + offset, src_buf + offset,
+					  len, "wrong copy, length %zu", len);
+		}
+	}
+}
+
+static struct net_pkt *udp_pkt(bool sum_on_write)
+{
+	struct net_if *iface = net_if_lookup_by_dev(
+					DEVICE_GET(net_chksum_test));
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, NET_UDPH_LEN + DATA_LEN,
+					AF_INET, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "out of packets");
+
+	zassert_equal(net_ipv4_create(pkt, &src_addr, &dst_addr), 0,
+		      "cannot add IPv4 header");
+	zassert_equal(net_udp_create(pkt, htons(PORT), htons(PORT)), 0,
+		      "cannot add UDP header");
+
+	/* Two pieces so that the second one starts at an odd offset */
+	if (sum_on_write) {
+		zassert_equal(net_pkt_write_chksum(pkt, src_buf, 51), 0,
+			      "cannot write data");
+		zassert_equal(net_pkt_write_chksum(pkt, src_buf + 51,
+						   DATA_LEN - 51), 0,
+			      "cannot write data");
+	} else {
+		zassert_equal(net_pkt_write(pkt, src_buf, DATA_LEN), 0,
+			      "cannot write data");
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv4_finalize(pkt, IPPROTO_UDP), 0,
+		      "cannot finalize");
+
+	return pkt;
+}
+
+/**
+ * @brief The UDP checksum is the same with the data summed up on writing
+ */
+static void test_chksum_pkt(void)
+{
+	struct net_udp_hdr hdr, hdr_sum;
+	struct net_pkt *pkt, *pkt_sum;
+
+	fill(src_buf, DATA_LEN, 42);
+
+	pkt = udp_pkt(false);
+	pkt_sum = udp_pkt(true);
+
+	zassert_true(pkt->buffer->frags != NULL, "data is not fragmented");
+	zassert_equal(net_pkt_data_chksum_len(pkt_sum), DATA_LEN,
+		      "data not summed up");
+
+	zassert_not_null(net_udp_get_hdr(pkt, &hdr), "no UDP header");
+	zassert_not_null(net_udp_get_hdr(pkt_sum, &hdr_sum), "no UDP header");
+
+	zassert_equal(hdr.chksum, hdr_sum.chksum, "checksums differ");
+
+	/* Both verify as received */
+	zassert_equal(net_calc_verify_chksum_udp(pkt), 0, "bad checksum");
+	zassert_equal(net_calc_verify_chksum_udp(pkt_sum), 0, "bad checksum");
+
+	net_pkt_unref(pkt);
+	net_pkt_unref(pkt_sum);
+}
+
+/**
+ * @brief A checksum updated for a changed word is the one summed up again
+ */
+static void test_chksum_update(void)
+{
+	u16_t *word = (u16_t *)(src_buf + 10);
+	u16_t chksum, old_val;
+
+	fill(src_buf, 20, 7);
+
+	/* The checksum and the word as they are in the packet */
+	chksum = sys_cpu_to_be16((u16_t)~ref_sum(0, src_buf, 20));
+
+	for (int i = 0; i < 1000; i++) {
+		old_val = *word;
+		*word = sys_cpu_to_be16(i * 65U);
+
+		chksum = net_calc_chksum_update(chksum, old_val, *word);
+
+		zassert_equal(chksum,
+			      sys_cpu_to_be16((u16_t)~ref_sum(0, src_buf, 20)),
+			      "wrong checksum for %d", i);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_checksum,
+			 ztest_unit_test(test_chksum_copy),
+			 ztest_unit_test(test_chksum_pkt),
+			 ztest_unit_test(test_chksum_update));
+
+	ztest_run_test_suite(net_checksum);
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/byteorder.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "ipv4.h"
+#include "tcp_internal.h"
+#include "net_gro.h"
+
+#define SEG_LEN 100
+#define SEQ 0xfffffff0
+#define PORT 4242
+
+static struct in_addr src_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+
+/* What was passed on to IP, one entry per packet */
+struct rx_pkt {
+	size_t len;
+	u32_t seq;
+	u8_t flags;
+	bool chksum_ok;
+	bool data_ok;
+};
+
+static struct rx_pkt received[8];
+static int received_count;
+
+static struct net_gro gro;
+
+static u8_t pattern(size_t offset)
+{
+	return (u8_t)(offset % 251);
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int dummy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static int dummy_send(struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_gro_test, "net_gro_test", dummy_dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static void deliver(struct net_pkt *pkt, bool is_loopback)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct rx_pkt *info = &received[received_count];
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_tcp_hdr *tcp_hdr;
+	u8_t byte;
+
+	zassert_true(received_count < ARRAY_SIZE(received),
+		     "too many packets");
+
+	info->chksum_ok = net_calc_chksum_ipv4(pkt) == 0U;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	zassert_not_null(ipv4_hdr, "no IPv4 header");
+	zassert_equal(ntohs(ipv4_hdr->len), net_pkt_get_len(pkt),
+		      "wrong IPv4 length");
+	net_pkt_acknowledge_data(pkt, &ipv4_access);
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "no TCP header");
+	info->seq = sys_get_be32(tcp_hdr->seq);
+	info->flags = tcp_hdr->flags;
+	net_pkt_acknowledge_data(pkt, &tcp_access);
+
+	info->len = net_pkt_remaining_data(pkt);
+	info->data_ok = true;
+
+	for (size_t i = 0; i < info->len; i++) {
+		net_pkt_read_u8(pkt, &byte);
+		if (byte != pattern(info->seq - SEQ + i)) {
+			info->data_ok = false;
+		}
+	}
+
+	received_count++;
+
+	net_pkt_unref(pkt);
+}
+
+/* Segment number n of the connection as it comes from the driver */
+static struct net_pkt *segment(int n, u8_t flags, size_t len)
+{
+	struct net_if *iface = net_if_lookup_by_dev(DEVICE_GET(net_gro_test));
+	struct net_tcp_hdr tcp_hdr = {
+		.src_port = htons(PORT),
+		.dst_port = htons(PORT),
+		.offset = (sizeof(tcp_hdr) / 4U) << 4,
+		.flags = flags,
+		.wnd = { 0x10, 0x00 },
+	};
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(tcp_hdr) + len,
+					AF_INET, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "out of packets");
+
+	sys_put_be32(SEQ + n * SEG_LEN, tcp_hdr.seq);
+
+	zassert_equal(net_ipv4_create(pkt, &src_addr, &my_addr), 0,
+		      "cannot add IPv4 header");
+	zassert_equal(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)), 0,
+		      "cannot add TCP header");
+
+	for (size_t i = 0; i < len; i++) {
+		net_pkt_write_u8(pkt, pattern(n * SEG_LEN + i));
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv4_finalize(pkt, IPPROTO_TCP), 0,
+		      "cannot finalize");
+
+	/* Received packets carry no attributes of their own */
+	net_pkt_set_family(pkt, AF_UNSPEC);
+	net_pkt_set_ip_hdr_len(pkt, 0);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void receive(struct net_pkt *pkt, enum net_verdict expected)
+{
+	enum net_verdict verdict = net_gro_receive(&gro, pkt, false);
+
+	zassert_equal(verdict, expected, "verdict %d", verdict);
+
+	if (verdict == NET_CONTINUE) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static void test_setup(void)
+{
+	received_count = 0;
+	net_gro_init(&gro, deliver);
+}
+
+/**
+ * @brief In order segments are passed on as one packet
+ */
+static void test_gro_merge(void)
+{
+	receive(segment(0, NET_TCP_ACK, SEG_LEN), NET_OK);
+	receive(segment(1, NET_TCP_ACK, SEG_LEN), NET_OK);
+	receive(segment(2, NET_TCP_ACK, SEG_LEN), NET_OK);
+
+	zassert_equal(received_count, 0, "packet passed on too early");
+
+	/* The push ends the packet without waiting for the flush */
+	receive(segment(3, NET_TCP_PSH | NET_TCP_ACK, SEG_LEN / 2), NET_OK);
+
+	zassert_equal(received_count, 1, "packet not passed on");
+	zassert_equal(received[0].len, 3 * SEG_LEN + SEG_LEN / 2,
+		      "wrong length %zu", received[0].len);
+	zassert_equal(received[0].seq, SEQ, "wrong sequence");
+	zassert_true(received[0].flags & NET_TCP_PSH, "no PSH");
+	zassert_true(received[0].chksum_ok, "wrong IPv4 checksum");
+	zassert_true(received[0].data_ok, "wrong data");
+
+	net_gro_flush(&gro);
+	zassert_equal(received_count, 1, "packet passed on twice");
+}
+
+/**
+ * @brief A missing segment splits the packets, the order stays
+ */
+static void test_gro_gap(void)
+{
+	receive(segment(0, NET_TCP_ACK, SEG_LEN), NET_OK);
+	receive(segment(1, NET_TCP_ACK, SEG_LEN), NET_OK);
+	receive(segment(3, NET_TCP_ACK, SEG_LEN), NET_OK);
+
+	zassert_equal(received_count, 1, "pending packet not passed on");
+
+	receive(segment(4, NET_TCP_ACK, SEG_LEN), NET_OK);
+	net_gro_flush(&gro);
+
+	zassert_equal(received_count, 2, "packets missing");
+	zassert_equal(received[0].seq, SEQ, "wrong order");
+	zassert_equal(received[0].len, 2 * SEG_LEN, "wrong length");
+	zassert_equal(received[1].seq, SEQ + 3 * SEG_LEN, "wrong order");
+	zassert_equal(received[1].len, 2 * SEG_LEN, "wrong length");
+	zassert_true(received[1].data_ok, "wrong data");
+}
+
+/**
+ * @brief Control segments are not merged but come after the pending data
+ */
+static void test_gro_control(void)
+{
+	receive(segment(0, NET_TCP_ACK, SEG_LEN), NET_OK);
+	receive(segment(1, NET_TCP_FIN | NET_TCP_ACK, 0), NET_CONTINUE);
+
+	zassert_equal(received_count, 1, "pending packet not passed on");
+	zassert_equal(received[0].len, SEG_LEN, "wrong length");
+}
+
+/**
+ * @brief A corrupted segment is left to TCP to drop
+ */
+static void test_gro_bad_chksum(void)
+{
+	struct net_pkt *pkt = segment(1, NET_TCP_ACK, SEG_LEN);
+	struct net_buf *last = net_buf_frag_last(pkt->buffer);
+
+	receive(segment(0, NET_TCP_ACK, SEG_LEN), NET_OK);
+
+	last->data[last->len - 1] ^= 0xff;
+	receive(pkt, NET_CONTINUE);
+
+	zassert_equal(received_count, 1, "pending packet not passed on");
+	zassert_equal(received[0].len, SEG_LEN, "corrupted data merged");
+}
+
+static int batch_ret;
+
+static void batch_from_isr(void *arg)
+{
+	struct net_pkt *pkt = arg;
+	struct net_if *iface = net_if_lookup_by_dev(DEVICE_GET(net_gro_test));
+
+	batch_ret = net_recv_data_batch(iface, &pkt, 1);
+}
+
+/**
+ * @brief Batches are only taken from threads, as they lock the scheduler
+ */
+static void test_batch_isr(void)
+{
+	struct net_pkt *pkt = segment(0, NET_TCP_ACK, SEG_LEN);
+
+	irq_offload(batch_from_isr, pkt);
+
+	zassert_equal(batch_ret, -EINVAL, "batch taken from an ISR (%d)",
+		      batch_ret);
+
+	/* The caller still owns the packet */
+	net_pkt_unref(pkt);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_gro,
+			 ztest_unit_test_setup_teardown(test_gro_merge,
+							test_setup,
+							unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_gro_gap,
+							test_setup,
+							unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_gro_control,
+							test_setup,
+							unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_gro_bad_chksum,
+							test_setup,
+							unit_test_noop),
+			 ztest_unit_test(test_batch_isr));
+
+	ztest_run_test_suite(net_gro);
+}
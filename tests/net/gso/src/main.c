@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <ztest.h>
+#include <random/rand32.h>
+#include <sys/byteorder.h>
+
+#include <net/ethernet.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+#include "net_gso.h"
+
+#define DATA_LEN 1000
+#define SEG_LEN 300
+#define N_SEGS ((DATA_LEN + SEG_LEN - 1) / SEG_LEN)
+#define SEQ 0x7ffffff0
+#define PORT 4242
+
+#define WAIT_TIME K_MSEC(100)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr dst_addr = { { { 192, 0, 2, 2 } } };
+
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr dst_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+/* Link address of dst_addr6 in the neighbor cache */
+static struct net_eth_addr dst_lladdr = {
+	{ 0x00, 0x00, 0x5e, 0x00, 0x53, 0xfe }
+};
+
+struct eth_context {
+	u8_t mac_addr[6];
+	enum ethernet_hw_caps caps;
+};
+
+/* What the driver got, one entry per packet */
+struct sent_pkt {
+	struct net_eth_addr src;
+	struct net_eth_addr dst;
+	u16_t type;
+	size_t len;
+	u16_t ip_len;
+	u32_t seq;
+	u8_t flags;
+	bool data_ok;
+};
+
+static struct sent_pkt sent[N_SEGS + 1];
+static int sent_count;
+
+static K_SEM_DEFINE(sent_sem, 0, UINT_MAX);
+
+static u8_t pattern(size_t offset)
+{
+	return (u8_t)(offset % 251);
+}
+
+static void eth_iface_init(struct net_if *iface)
+{
+	struct eth_context *context = net_if_get_device(iface)->driver_data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr), NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(struct device *dev, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(eth_access, struct net_eth_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct sent_pkt *info = &sent[sent_count];
+	struct net_eth_hdr *eth_hdr;
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_ipv6_hdr *ipv6_hdr;
+	struct net_tcp_hdr *tcp_hdr;
+	u8_t byte;
+
+	zassert_true(sent_count < ARRAY_SIZE(sent), "too many packets");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	eth_hdr = (struct net_eth_hdr *)net_pkt_get_data(pkt, &eth_access);
+	zassert_not_null(eth_hdr, "no Ethernet header");
+	memcpy(&info->src, &eth_hdr->src, sizeof(info->src));
+	memcpy(&info->dst, &eth_hdr->dst, sizeof(info->dst));
+	info->type = ntohs(eth_hdr->type);
+	net_pkt_acknowledge_data(pkt, &eth_access);
+
+	if (info->type == NET_ETH_PTYPE_IPV6) {
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		zassert_not_null(ipv6_hdr, "no IPv6 header");
+		info->ip_len = ntohs(ipv6_hdr->len);
+		net_pkt_acknowledge_data(pkt, &ipv6_access);
+	} else {
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		zassert_not_null(ipv4_hdr, "no IPv4 header");
+		info->ip_len = ntohs(ipv4_hdr->len);
+		net_pkt_acknowledge_data(pkt, &ipv4_access);
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	zassert_not_null(tcp_hdr, "no TCP header");
+	info->seq = sys_get_be32(tcp_hdr->seq);
+	info->flags = tcp_hdr->flags;
+	net_pkt_acknowledge_data(pkt, &tcp_access);
+
+	info->len = net_pkt_remaining_data(pkt);
+	info->data_ok = true;
+
+	for (size_t i = 0; i < info->len; i++) {
+		net_pkt_read_u8(pkt, &byte);
+		if (byte != pattern(info->seq - SEQ + i)) {
+			info->data_ok = false;
+		}
+	}
+
+	sent_count++;
+	k_sem_give(&sent_sem);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_caps(struct device *dev)
+{
+	struct eth_context *context = dev->driver_data;
+
+	return context->caps;
+}
+
+static struct ethernet_api eth_api = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_caps,
+	.send = eth_tx,
+};
+
+static int eth_init(struct device *dev)
+{
+	struct eth_context *context = dev->driver_data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	memcpy(context->mac_addr, "\x00\x00\x5e\x00\x53", 5);
+	context->mac_addr[5] = sys_rand32_get();
+
+	return 0;
+}
+
+static struct eth_context eth_sw_context;
+static struct eth_context eth_tso_context = {
+	.caps = ETHERNET_HW_TSO,
+};
+
+ETH_NET_DEVICE_INIT(eth_gso_sw, "eth_gso_sw", eth_init,
+		    device_pm_control_nop, &eth_sw_context, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+ETH_NET_DEVICE_INIT(eth_gso_tso, "eth_gso_tso", eth_init,
+		    device_pm_control_nop, &eth_tso_context, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_api, NET_ETH_MTU);
+
+/* A TCP packet with DATA_LEN bytes to be sent in SEG_LEN segments */
+static struct net_pkt *super_pkt(struct device *dev, sa_family_t family)
+{
+	struct net_if *iface = net_if_lookup_by_dev(dev);
+	struct net_tcp_hdr tcp_hdr = {
+		.src_port = htons(PORT),
+		.dst_port = htons(PORT),
+		.offset = (sizeof(tcp_hdr) / 4U) << 4,
+		.flags = NET_TCP_PSH | NET_TCP_ACK,
+		.wnd = { 0x10, 0x00 },
+	};
+	struct net_pkt *pkt;
+
+	zassert_not_null(iface, "no interface");
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(tcp_hdr) + DATA_LEN,
+					family, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "out of packets");
+
+	sys_put_be32(SEQ, tcp_hdr.seq);
+
+	if (family == AF_INET6) {
+		zassert_equal(net_ipv6_create(pkt, &my_addr6, &dst_addr6), 0,
+			      "cannot add IPv6 header");
+	} else {
+		zassert_equal(net_ipv4_create(pkt, &my_addr, &dst_addr), 0,
+			      "cannot add IPv4 header");
+	}
+
+	zassert_equal(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)), 0,
+		      "cannot add TCP header");
+
+	for (int i = 0; i < DATA_LEN; i++) {
+		net_pkt_write_u8(pkt, pattern(i));
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET6) {
+		zassert_equal(net_ipv6_finalize(pkt, IPPROTO_TCP), 0,
+			      "cannot finalize");
+	} else {
+		zassert_equal(net_ipv4_finalize(pkt, IPPROTO_TCP), 0,
+			      "cannot finalize");
+	}
+
+	net_pkt_set_gso_size(pkt, SEG_LEN);
+
+	return pkt;
+}
+
+/* Every segment is the next SEG_LEN bytes of the data, ip_hdr_len is the
+ * part of the headers counted in the IP length field
+ */
+static void check_segments(size_t ip_hdr_len)
+{
+	size_t offset;
+
+	for (int i = 0; i < N_SEGS; i++) {
+		offset = i * SEG_LEN;
+
+		zassert_equal(sent[i].len, MIN(SEG_LEN, DATA_LEN - offset),
+			      "segment %d has %zu bytes", i, sent[i].len);
+		zassert_equal(sent[i].ip_len, ip_hdr_len + NET_TCPH_LEN +
+			      sent[i].len, "wrong IP length");
+		zassert_equal(sent[i].seq, SEQ + offset, "wrong sequence");
+		zassert_true(sent[i].data_ok, "wrong data in segment %d", i);
+
+		/* Only the last segment pushes */
+		zassert_equal(!!(sent[i].flags & NET_TCP_PSH), i == N_SEGS - 1,
+			      "wrong PSH in segment %d", i);
+		zassert_true(sent[i].flags & NET_TCP_ACK, "no ACK");
+	}
+}
+
+static void wait_sent(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&sent_sem, WAIT_TIME), 0,
+			      "packet %d not sent", i);
+	}
+
+	zassert_equal(k_sem_take(&sent_sem, WAIT_TIME), -EAGAIN,
+		      "too many packets");
+}
+
+/**
+ * @brief The packet is cut into segments when it is sent
+ */
+static void test_gso_segments(void)
+{
+	struct net_linkaddr *lladdr;
+
+	sent_count = 0;
+	zassert_equal(net_send_data(super_pkt(DEVICE_GET(eth_gso_sw),
+					      AF_INET)), 0,
+		      "send failed");
+
+	wait_sent(N_SEGS);
+
+	check_segments(NET_IPV4H_LEN);
+
+	lladdr = net_if_get_link_addr(
+			net_if_lookup_by_dev(DEVICE_GET(eth_gso_sw)));
+
+	for (int i = 0; i < N_SEGS; i++) {
+		zassert_equal(sent[i].type, NET_ETH_PTYPE_IP, "not IPv4");
+		zassert_mem_equal(&sent[i].src, lladdr->addr,
+				  sizeof(sent[i].src),
+				  "wrong source in segment %d", i);
+	}
+}
+
+/**
+ * @brief IPv6 segments go to the link address of the neighbor
+ */
+static void test_gso_segments_ipv6(void)
+{
+	struct net_if *iface = net_if_lookup_by_dev(DEVICE_GET(eth_gso_sw));
+	struct net_linkaddr lladdr = {
+		.addr = dst_lladdr.addr,
+		.len = sizeof(dst_lladdr),
+		.type = NET_LINK_ETHERNET,
+	};
+
+	zassert_not_null(net_if_ipv6_prefix_add(iface, &my_addr6, 64,
+						NET_IPV6_ND_INFINITE_LIFETIME),
+			 "cannot add prefix");
+	zassert_not_null(net_ipv6_nbr_add(iface, &dst_addr6, &lladdr, false,
+					  NET_IPV6_NBR_STATE_REACHABLE),
+			 "cannot add neighbor");
+
+	sent_count = 0;
+	zassert_equal(net_send_data(super_pkt(DEVICE_GET(eth_gso_sw),
+					      AF_INET6)), 0,
+		      "send failed");
+
+	wait_sent(N_SEGS);
+
+	check_segments(0);
+
+	for (int i = 0; i < N_SEGS; i++) {
+		zassert_equal(sent[i].type, NET_ETH_PTYPE_IPV6, "not IPv6");
+		zassert_mem_equal(&sent[i].src,
+				  net_if_get_link_addr(iface)->addr,
+				  sizeof(sent[i].src),
+				  "wrong source in segment %d", i);
+		zassert_mem_equal(&sent[i].dst, &dst_lladdr,
+				  sizeof(sent[i].dst),
+				  "wrong destination in segment %d", i);
+	}
+}
+
+/**
+ * @brief A device with TSO gets the packet as is
+ */
+static void test_gso_tso(void)
+{
+	sent_count = 0;
+	zassert_equal(net_send_data(super_pkt(DEVICE_GET(eth_gso_tso),
+					      AF_INET)), 0,
+		      "send failed");
+
+	wait_sent(1);
+
+	zassert_equal(sent[0].len, DATA_LEN, "packet was segmented");
+	zassert_equal(sent[0].seq, SEQ, "wrong sequence");
+	zassert_true(sent[0].data_ok, "wrong data");
+}
+
+/**
+ * @brief Slices refer to the data and keep their buffers
+ */
+static void test_gso_slice(void)
+{
+	struct net_pkt *pkt = super_pkt(DEVICE_GET(eth_gso_sw), AF_INET);
+	struct net_buf *slice, *frag;
+	size_t offset = NET_IPV4H_LEN + NET_TCPH_LEN + 100;
+	size_t i = 0;
+
+	slice = net_gso_slice(pkt->buffer, offset, DATA_LEN - 100);
+	zassert_not_null(slice, "out of slices");
+	zassert_equal(net_buf_frags_len(slice), DATA_LEN - 100,
+		      "wrong slice length");
+
+	/* The data stays while the packet is gone */
+	net_pkt_unref(pkt);
+
+	for (frag = slice; frag; frag = frag->frags) {
+		for (size_t j = 0; j < frag->len; j++, i++) {
+			zassert_equal(frag->data[j], pattern(100 + i),
+				      "wrong data at %zu", i);
+		}
+	}
+
+	zassert_equal(i, DATA_LEN - 100, "data missing");
+
+	net_buf_unref(slice);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_gso,
+			 ztest_unit_test(test_gso_segments),
+			 ztest_unit_test(test_gso_segments_ipv6),
+			 ztest_unit_test(test_gso_tso),
+			 ztest_unit_test(test_gso_slice));
+
+	ztest_run_test_suite(net_gso);
+}
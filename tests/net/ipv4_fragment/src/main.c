@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <ztest.h>
+#include <sys/byteorder.h>
+
+#include <net/dummy.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define PORT 4242
+#define FRAG_LEN 80
+#define DGRAM_LEN (3 * FRAG_LEN)
+/* Larger than an Ethernet MTU, in fragments that fill one */
+#define LARGE_FRAG_LEN (1500 - NET_IPV4H_LEN)
+#define LARGE_DGRAM_LEN 3000
+#define SEND_LEN 200
+#define MTU 100
+#define WAIT_TIME K_MSEC(500)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_a = { { { 192, 0, 2, 10 } } };
+static struct in_addr peer_b = { { { 192, 0, 2, 11 } } };
+static struct in_addr peer_c = { { { 192, 0, 2, 12 } } };
+static struct in_addr peer_d = { { { 192, 0, 2, 13 } } };
+
+/* The UDP datagram the fragments are cut from, of dgram_len bytes */
+static u8_t dgram[LARGE_DGRAM_LEN];
+static u16_t dgram_len = DGRAM_LEN;
+
+static struct net_if *iface;
+static K_SEM_DEFINE(recv_sem, 0, UINT_MAX);
+static K_SEM_DEFINE(send_sem, 0, UINT_MAX);
+static bool recv_ok;
+
+struct sent_frag {
+	u16_t len;
+	u16_t flags;
+	u16_t id;
+};
+
+static struct sent_frag sent[8];
+static int sent_count;
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static u8_t mac[] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int dummy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static int dummy_send(struct device *dev, struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)pkt->buffer->data;
+
+	if (sent_count < ARRAY_SIZE(sent)) {
+		sent[sent_count].len = ntohs(hdr->len);
+		sent[sent_count].flags = sys_get_be16(hdr->offset);
+		sent[sent_count].id = sys_get_be16(hdr->id);
+		sent_count++;
+	}
+
+	k_sem_give(&send_sem);
+
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_ipv4_frag_test, "net_ipv4_frag_test", dummy_dev_init,
+		device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), MTU);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	static u8_t data[LARGE_DGRAM_LEN];
+
+	net_pkt_cursor_init(pkt);
+
+	recv_ok = net_pkt_get_len(pkt) == NET_IPV4H_LEN + dgram_len &&
+		!net_pkt_skip(pkt, NET_IPV4H_LEN) &&
+		!net_pkt_read(pkt, data, dgram_len) &&
+		!memcmp(data, dgram, dgram_len);
+
+	net_pkt_unref(pkt);
+	k_sem_give(&recv_sem);
+
+	return NET_OK;
+}
+
+/* Fragment of the datagram as it is handed over by net_ipv4_input() */
+static enum net_verdict frag_recv(const struct in_addr *src, u16_t id,
+				  u16_t offset, u16_t len, bool more)
+{
+	struct net_ipv4_hdr hdr = {
+		.vhl = 0x45,
+		.len = htons(NET_IPV4H_LEN + len),
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+	};
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+
+	sys_put_be16(id, hdr.id);
+	sys_put_be16(offset / 8U | (more ? NET_IPV4_MF : 0), hdr.offset);
+	net_ipaddr_copy(&hdr.src, src);
+	net_ipaddr_copy(&hdr.dst, &my_addr);
+
+	/* Sized as is, AF_INET would cut it to the IPv4 minimum MTU */
+	pkt = net_pkt_alloc_with_buffer(iface, NET_IPV4H_LEN + len, AF_UNSPEC,
+					0, K_NO_WAIT);
+	zassert_not_null(pkt, "out of packets");
+
+	net_pkt_set_family(pkt, AF_INET);
+
+	zassert_equal(net_pkt_write(pkt, &hdr, sizeof(hdr)), 0,
+		      "cannot write header");
+	zassert_equal(net_pkt_write(pkt, dgram + offset, len), 0,
+		      "cannot write data");
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, NET_IPV4H_LEN);
+
+	verdict = net_ipv4_handle_fragment_hdr(pkt, &hdr);
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
+static void check_received(bool expected)
+{
+	int ret = k_sem_take(&recv_sem, WAIT_TIME);
+
+	if (expected) {
+		zassert_equal(ret, 0, "datagram not received");
+		zassert_true(recv_ok, "wrong datagram received");
+	} else {
+		zassert_not_equal(ret, 0, "datagram received");
+	}
+
+	recv_ok = false;
+}
+
+static void test_setup(void)
+{
+	static struct net_conn_handle *handle;
+	struct sockaddr local_addr = { 0 };
+	struct net_udp_hdr *udp = (struct net_udp_hdr *)dgram;
+	int ret;
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_ipv4_frag_test));
+	zassert_not_null(iface, "no interface");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL,
+					      0),
+			 "cannot add address");
+
+	for (int i = 0; i < LARGE_DGRAM_LEN; i++) {
+		dgram[i] = i;
+	}
+
+	udp->src_port = htons(PORT);
+	udp->dst_port = htons(PORT);
+	udp->len = htons(DGRAM_LEN);
+	udp->chksum = 0U;
+
+	net_ipaddr_copy(&net_sin(&local_addr)->sin_addr, &my_addr);
+	local_addr.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, NULL, &local_addr, 0, PORT,
+			       udp_data_received, NULL, &handle);
+	zassert_equal(ret, 0, "cannot register UDP handler");
+}
+
+/**
+ * @brief Fragments received in order make up the datagram
+ */
+static void test_reass_in_order(void)
+{
+	zassert_equal(frag_recv(&peer_a, 1, 0, FRAG_LEN, true), NET_OK, "");
+	zassert_equal(frag_recv(&peer_a, 1, FRAG_LEN, FRAG_LEN, true), NET_OK,
+		      "");
+	zassert_equal(frag_recv(&peer_a, 1, 2 * FRAG_LEN, FRAG_LEN, false),
+		      NET_OK, "");
+
+	check_received(true);
+}
+
+/**
+ * @brief Fragments received in any order make up the datagram
+ */
+static void test_reass_out_of_order(void)
+{
+	zassert_equal(frag_recv(&peer_a, 2, 2 * FRAG_LEN, FRAG_LEN, false),
+		      NET_OK, "");
+	zassert_equal(frag_recv(&peer_a, 2, 0, FRAG_LEN, true), NET_OK, "");
+	check_received(false);
+
+	zassert_equal(frag_recv(&peer_a, 2, FRAG_LEN, FRAG_LEN, true), NET_OK,
+		      "");
+	check_received(true);
+}
+
+/**
+ * @brief A fragment received twice is only used once
+ */
+static void test_reass_duplicate(void)
+{
+	zassert_equal(frag_recv(&peer_b, 3, FRAG_LEN, FRAG_LEN, true), NET_OK,
+		      "");
+	zassert_equal(frag_recv(&peer_b, 3, FRAG_LEN, FRAG_LEN, true), NET_OK,
+		      "");
+	zassert_equal(frag_recv(&peer_b, 3, 0, FRAG_LEN, true), NET_OK, "");
+	zassert_equal(frag_recv(&peer_b, 3, 2 * FRAG_LEN, FRAG_LEN, false),
+		      NET_OK, "");
+
+	check_received(true);
+	check_received(false);
+}
+
+/**
+ * @brief An overlapping fragment drops the packet being reassembled
+ */
+static void test_reass_overlap(void)
+{
+	zassert_equal(frag_recv(&peer_c, 4, 0, FRAG_LEN, true), NET_OK, "");
+	zassert_equal(frag_recv(&peer_c, 4, FRAG_LEN / 2, FRAG_LEN, true),
+		      NET_DROP, "overlapping fragment accepted");
+
+	/* The first fragment is gone with the rest */
+	zassert_equal(frag_recv(&peer_c, 4, FRAG_LEN, FRAG_LEN, true), NET_OK,
+		      "");
+	zassert_equal(frag_recv(&peer_c, 4, 2 * FRAG_LEN, FRAG_LEN, false),
+		      NET_OK, "");
+
+	check_received(false);
+}
+
+/**
+ * @brief One source cannot have more packets reassembled than allowed
+ */
+static void test_reass_per_src(void)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IP_REASSEMBLY_MAX_PER_SRC; i++) {
+		zassert_equal(frag_recv(&peer_d, 10 + i, 0, FRAG_LEN, true),
+			      NET_OK, "fragment %d not accepted", i);
+	}
+
+	zassert_equal(frag_recv(&peer_d, 10 + i, 0, FRAG_LEN, true), NET_DROP,
+		      "too many packets from one source");
+
+	/* Other sources are not affected */
+	zassert_equal(frag_recv(&peer_a, 5, 0, FRAG_LEN, true), NET_OK, "");
+	zassert_equal(frag_recv(&peer_a, 5, FRAG_LEN, 2 * FRAG_LEN, false),
+		      NET_OK, "");
+	check_received(true);
+}
+
+/**
+ * @brief A datagram larger than an Ethernet MTU is reassembled
+ */
+static void test_reass_large(void)
+{
+	struct net_udp_hdr *udp = (struct net_udp_hdr *)dgram;
+	u16_t offset;
+
+	dgram_len = LARGE_DGRAM_LEN;
+	udp->len = htons(LARGE_DGRAM_LEN);
+
+	for (offset = 0U; offset + LARGE_FRAG_LEN < LARGE_DGRAM_LEN;
+	     offset += LARGE_FRAG_LEN) {
+		zassert_equal(frag_recv(&peer_b, 6, offset, LARGE_FRAG_LEN,
+					true), NET_OK,
+			      "fragment at %u not accepted", offset);
+	}
+
+	zassert_equal(frag_recv(&peer_b, 6, offset, LARGE_DGRAM_LEN - offset,
+				false), NET_OK, "last fragment not accepted");
+
+	check_received(true);
+
+	dgram_len = DGRAM_LEN;
+	udp->len = htons(DGRAM_LEN);
+}
+
+/**
+ * @brief A packet larger than the MTU is sent in fragments
+ */
+static void test_send_fragmented(void)
+{
+	struct net_pkt *pkt;
+	u16_t offset = 0U;
+	int i;
+
+	pkt = net_pkt_alloc_with_buffer(iface, NET_UDPH_LEN + SEND_LEN,
+					AF_INET, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "out of packets");
+
+	zassert_equal(net_ipv4_create(pkt, &my_addr, &peer_a), 0,
+		      "cannot add IPv4 header");
+	zassert_equal(net_udp_create(pkt, htons(PORT), htons(PORT)), 0,
+		      "cannot add UDP header");
+	zassert_equal(net_pkt_write(pkt, dgram, SEND_LEN), 0,
+		      "cannot write data");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv4_finalize(pkt, IPPROTO_UDP), 0,
+		      "cannot finalize");
+
+	sent_count = 0;
+	zassert_true(net_send_data(pkt) >= 0, "cannot send");
+
+	for (i = 0; i < 3; i++) {
+		zassert_equal(k_sem_take(&send_sem, WAIT_TIME), 0,
+			      "fragment %d not sent", i);
+	}
+
+	zassert_equal(sent_count, 3, "wrong number of fragments");
+
+	for (i = 0; i < sent_count; i++) {
+		zassert_true(sent[i].len <= MTU, "fragment %d too long", i);
+		zassert_equal((sent[i].flags & NET_IPV4_OFFSET_MASK) * 8U,
+			      offset, "wrong offset of fragment %d", i);
+		zassert_equal(!!(sent[i].flags & NET_IPV4_MF),
+			      i < sent_count - 1, "wrong MF of fragment %d", i);
+		zassert_equal(sent[i].id, sent[0].id, "wrong id");
+
+		offset += sent[i].len - NET_IPV4H_LEN;
+	}
+
+	zassert_equal(offset, NET_UDPH_LEN + SEND_LEN, "data missing");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_ipv4_fragment,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_reass_in_order),
+			 ztest_unit_test(test_reass_out_of_order),
+			 ztest_unit_test(test_reass_duplicate),
+			 ztest_unit_test(test_reass_overlap),
+			 ztest_unit_test(test_reass_per_src),
+			 ztest_unit_test(test_reass_large),
+			 ztest_unit_test(test_send_fragmented));
+
+	ztest_run_test_suite(net_ipv4_fragment);
+}
@@ -475,6 +475,51 @@ static void test_nbr_lookup_ok(void)
 			 net_sprint_ipv6_addr(&peer_addr));
 }
 
+/**
+ * @brief IPv6 neighbor removal leaves the other neighbors in the cache
+ */
+static void test_nbr_rm(void)
+{
+	struct in6_addr dst_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0x12, 0x3 } } };
+	struct net_nbr *nbr;
+	struct net_linkaddr_storage llstorage;
+	struct net_linkaddr lladdr;
+
+	llstorage.addr[0] = 0x01;
+	llstorage.addr[1] = 0x02;
+	llstorage.addr[2] = 0x33;
+	llstorage.addr[3] = 0x44;
+	llstorage.addr[4] = 0x05;
+	llstorage.addr[5] = 0x12;
+
+	lladdr.len = 6U;
+	lladdr.addr = llstorage.addr;
+	lladdr.type = NET_LINK_ETHERNET;
+
+	nbr = net_ipv6_nbr_add(net_if_get_default(), &dst_addr, &lladdr,
+			       false, NET_IPV6_NBR_STATE_STALE);
+	zassert_not_null(nbr, "Cannot add peer %s to neighbor cache\n",
+			 net_sprint_ipv6_addr(&dst_addr));
+
+	zassert_equal_ptr(net_ipv6_nbr_lookup(net_if_get_default(),
+					      &dst_addr), nbr,
+			  "Neighbor %s not found in cache\n",
+			  net_sprint_ipv6_addr(&dst_addr));
+
+	zassert_true(net_ipv6_nbr_rm(net_if_get_default(), &dst_addr),
+		     "Cannot remove %s from neighbor cache\n",
+		     net_sprint_ipv6_addr(&dst_addr));
+
+	zassert_is_null(net_ipv6_nbr_lookup(net_if_get_default(), &dst_addr),
+			"Neighbor %s found in cache\n",
+			net_sprint_ipv6_addr(&dst_addr));
+	zassert_not_null(net_ipv6_nbr_lookup(net_if_get_default(),
+					     &peer_addr),
+			 "Neighbor %s not found in cache\n",
+			 net_sprint_ipv6_addr(&peer_addr));
+}
+
 /**
  * @brief IPv6 send NS extra options
  */
@@ -1356,6 +1401,7 @@ void test_main(void)
 			 ztest_unit_test(test_add_neighbor),
 			 ztest_unit_test(test_add_max_neighbors),
 			 ztest_unit_test(test_nbr_lookup_ok),
+			 ztest_unit_test(test_nbr_rm),
 			 ztest_unit_test(test_send_ns_extra_options),
 			 ztest_unit_test(test_send_ns_no_options),
 			 ztest_unit_test(test_rs_message),
@@ -2042,6 +2042,171 @@ static void test_recv_ipv6_fragment(void)
 	zassert_true(ret == NET_OK, "IPv6 frag2 reassembly failed");
 }
 
+/* Larger than an Ethernet MTU, in fragments that fill the IPv6 minimum
+ * MTU
+ */
+#define LARGE_DGRAM_LEN 3000
+#define LARGE_FRAG_LEN (NET_IPV6_MTU - NET_IPV6H_LEN - NET_IPV6_FRAGH_LEN)
+#define LARGE_PORT 4353
+
+/* The UDP datagram the fragments are cut from */
+static u8_t large_dgram[LARGE_DGRAM_LEN];
+static bool large_recv_ok;
+static K_SEM_DEFINE(large_recv, 0, 1);
+
+static enum net_verdict large_data_received(struct net_conn *conn,
+					    struct net_pkt *pkt,
+					    union net_ip_header *ip_hdr,
+					    union net_proto_header *proto_hdr,
+					    void *user_data)
+{
+	static u8_t data[LARGE_DGRAM_LEN];
+
+	net_pkt_cursor_init(pkt);
+
+	large_recv_ok = net_pkt_get_len(pkt) ==
+			NET_IPV6H_LEN + LARGE_DGRAM_LEN &&
+		!net_pkt_skip(pkt, NET_IPV6H_LEN) &&
+		!net_pkt_read(pkt, data, LARGE_DGRAM_LEN) &&
+		!memcmp(data, large_dgram, LARGE_DGRAM_LEN);
+
+	net_pkt_unref(pkt);
+	k_sem_give(&large_recv);
+
+	return NET_OK;
+}
+
+/* Build the datagram from my_addr2 to my_addr1 with its checksum */
+static void large_dgram_init(void)
+{
+	struct net_pkt *pkt;
+	int i;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, LARGE_DGRAM_LEN - NET_UDPH_LEN,
+					AF_INET6, IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	zassert_equal(net_ipv6_create(pkt, &my_addr2, &my_addr1), 0,
+		      "Cannot add IPv6 header");
+	zassert_equal(net_udp_create(pkt, htons(LARGE_PORT),
+				     htons(LARGE_PORT)), 0,
+		      "Cannot add UDP header");
+
+	for (i = NET_UDPH_LEN; i < LARGE_DGRAM_LEN; i++) {
+		zassert_equal(net_pkt_write_u8(pkt, i), 0,
+			      "Cannot append data");
+	}
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_ipv6_finalize(pkt, IPPROTO_UDP), 0,
+		      "Cannot finalize");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	zassert_equal(net_pkt_skip(pkt, NET_IPV6H_LEN), 0, "Cannot skip");
+	zassert_equal(net_pkt_read(pkt, large_dgram, LARGE_DGRAM_LEN), 0,
+		      "Cannot read datagram");
+
+	net_pkt_unref(pkt);
+}
+
+static void large_frag_recv(u16_t offset, u16_t len, bool more)
+{
+	struct net_ipv6_hdr hdr = {
+		.vtc = 0x60,
+		.len = htons(NET_IPV6_FRAGH_LEN + len),
+		.nexthdr = NET_IPV6_NEXTHDR_FRAG,
+		.hop_limit = 64,
+	};
+	struct net_pkt_cursor backup;
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+
+	net_ipaddr_copy(&hdr.src, &my_addr2);
+	net_ipaddr_copy(&hdr.dst, &my_addr1);
+
+	pkt = net_pkt_alloc_with_buffer(iface1, NET_IPV6H_LEN +
+					NET_IPV6_FRAGH_LEN + len,
+					AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV6H_LEN);
+	net_pkt_cursor_init(pkt);
+
+	zassert_equal(net_pkt_write(pkt, &hdr, sizeof(hdr)), 0,
+		      "IPv6 header append failed");
+
+	/* net_ipv6_handle_fragment_hdr() is called with the next header
+	 * of the fragment header read
+	 */
+	zassert_equal(net_pkt_write_u8(pkt, IPPROTO_UDP), 0,
+		      "IPv6 fragment header append failed");
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	zassert_equal(net_pkt_write_u8(pkt, 0), 0,
+		      "IPv6 fragment header append failed");
+	zassert_equal(net_pkt_write_be16(pkt, offset | (more ? 1 : 0)), 0,
+		      "IPv6 fragment header append failed");
+	zassert_equal(net_pkt_write_be32(pkt, 0x4c415247), 0,
+		      "IPv6 fragment header append failed");
+	zassert_equal(net_pkt_write(pkt, large_dgram + offset, len), 0,
+		      "Data append failed");
+
+	net_pkt_set_ipv6_hdr_prev(pkt, offsetof(struct net_ipv6_hdr,
+						nexthdr));
+	net_pkt_set_ipv6_fragment_start(pkt, NET_IPV6H_LEN);
+	net_pkt_set_overwrite(pkt, true);
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	verdict = net_ipv6_handle_fragment_hdr(pkt, &hdr,
+					       NET_IPV6_NEXTHDR_FRAG);
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	zassert_equal(verdict, NET_OK, "Fragment at %u not accepted",
+		      offset);
+}
+
+static void test_recv_ipv6_fragment_large(void)
+{
+	static struct net_conn_handle *handle;
+	struct sockaddr remote_addr = { 0 };
+	struct sockaddr local_addr = { 0 };
+	u16_t offset;
+	int ret;
+
+	net_ipaddr_copy(&net_sin6(&local_addr)->sin6_addr, &my_addr1);
+	local_addr.sa_family = AF_INET6;
+
+	net_ipaddr_copy(&net_sin6(&remote_addr)->sin6_addr, &my_addr2);
+	remote_addr.sa_family = AF_INET6;
+
+	ret = net_udp_register(AF_INET6, &remote_addr, &local_addr,
+			       LARGE_PORT, LARGE_PORT, large_data_received,
+			       NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler");
+
+	large_dgram_init();
+
+	for (offset = 0U; offset + LARGE_FRAG_LEN < LARGE_DGRAM_LEN;
+	     offset += LARGE_FRAG_LEN) {
+		large_frag_recv(offset, LARGE_FRAG_LEN, true);
+	}
+
+	large_frag_recv(offset, LARGE_DGRAM_LEN - offset, false);
+
+	zassert_equal(k_sem_take(&large_recv, WAIT_TIME), 0,
+		      "Datagram not received");
+	zassert_true(large_recv_ok, "Wrong datagram received");
+
+	net_udp_unregister(handle);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_ipv6_fragment_test,
@@ -2058,7 +2223,8 @@ void test_main(void)
 			 ztest_unit_test(test_send_ipv6_fragment),
 			 ztest_unit_test(test_send_ipv6_fragment_large_hbho),
 			 ztest_unit_test(test_send_ipv6_fragment_without_hbho),
-			 ztest_unit_test(test_recv_ipv6_fragment)
+			 ztest_unit_test(test_recv_ipv6_fragment),
+			 ztest_unit_test(test_recv_ipv6_fragment_large)
 			 );
 
 	ztest_run_test_suite(net_ipv6_fragment_test);
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_test, LOG_LEVEL_DBG);
 #include <sys/printk.h>
 #include <kernel.h>
 
+#include <net/buf.h>
 #include <net/coap.h>
 
 #include <tc_util.h>
@@ -378,6 +379,185 @@ done:
 	return result;
 }
 
+static int check_uri_options(const struct coap_packet *cpkt)
+{
+	static const char * const path[] = { "a", "bb", "ccc" };
+	struct coap_option options[4];
+	int i, count;
+
+	count = coap_find_options(cpkt, COAP_OPTION_URI_PATH, options,
+				  ARRAY_SIZE(options));
+	if (count != ARRAY_SIZE(path)) {
+		TC_PRINT("Unexpected number of path options (%d)\n", count);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (options[i].len != strlen(path[i]) ||
+		    memcmp(options[i].value, path[i], options[i].len)) {
+			TC_PRINT("Path option %d doesn't match\n", i);
+			return -EINVAL;
+		}
+	}
+
+	count = coap_find_options(cpkt, COAP_OPTION_URI_QUERY, options, 1);
+	if (count != 1 || options[0].len != 3U ||
+	    memcmp(options[0].value, "x=1", 3)) {
+		TC_PRINT("Query option doesn't match\n");
+		return -EINVAL;
+	}
+
+	count = coap_find_options(cpkt, COAP_OPTION_CONTENT_FORMAT, options,
+				  ARRAY_SIZE(options));
+	if (count != 1 || coap_option_value_to_int(&options[0]) != 50U) {
+		TC_PRINT("Content format option doesn't match\n");
+		return -EINVAL;
+	}
+
+	count = coap_find_options(cpkt, COAP_OPTION_ETAG, options,
+				  ARRAY_SIZE(options));
+	if (count) {
+		TC_PRINT("There shouldn't be any ETAG option in the packet\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int test_find_options(void)
+{
+	struct coap_packet cpkt;
+	u8_t payload[] = "payload";
+	u8_t *data;
+	int result = TC_FAIL;
+	int r;
+
+	data = (u8_t *)k_malloc(COAP_BUF_SIZE);
+	if (!data) {
+		goto done;
+	}
+
+	r = coap_packet_init(&cpkt, data, COAP_BUF_SIZE,
+			     1, COAP_TYPE_CON, 0, NULL,
+			     COAP_METHOD_POST, 0x1234);
+	if (r < 0) {
+		TC_PRINT("Could not initialize packet\n");
+		goto done;
+	}
+
+	r = coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+				       (u8_t *)"a", 1);
+	r |= coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+				       (u8_t *)"bb", 2);
+	r |= coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+				       (u8_t *)"ccc", 3);
+	r |= coap_append_option_int(&cpkt, COAP_OPTION_CONTENT_FORMAT, 50);
+	r |= coap_packet_append_option(&cpkt, COAP_OPTION_URI_QUERY,
+				       (u8_t *)"x=1", 3);
+	r |= coap_packet_append_option(&cpkt, COAP_OPTION_URI_QUERY,
+				       (u8_t *)"y=2", 3);
+	r |= coap_packet_append_payload_marker(&cpkt);
+	r |= coap_packet_append_payload(&cpkt, payload, sizeof(payload));
+	if (r) {
+		TC_PRINT("Could not build packet\n");
+		goto done;
+	}
+
+	/* Options of the packet being built */
+	if (check_uri_options(&cpkt)) {
+		goto done;
+	}
+
+	r = coap_packet_parse(&cpkt, data, cpkt.offset, NULL, 0);
+	if (r) {
+		TC_PRINT("Could not parse packet\n");
+		goto done;
+	}
+
+	/* Options of the packet received */
+	if (check_uri_options(&cpkt)) {
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	k_free(data);
+
+	TC_END_RESULT(result);
+
+	return result;
+}
+
+NET_BUF_POOL_DEFINE(coap_buf_pool, 2, COAP_BUF_SIZE, 0, NULL);
+
+static int test_packet_buf(void)
+{
+	u8_t result_pdu[] = { 0x40, 0x45, 0x12, 0x34, 0xc0, 0xff };
+	u8_t payload[] = "payload";
+	struct coap_packet cpkt;
+	struct net_buf *buf, *frag;
+	int result = TC_FAIL;
+	int r;
+
+	buf = net_buf_alloc(&coap_buf_pool, K_NO_WAIT);
+	frag = net_buf_alloc(&coap_buf_pool, K_NO_WAIT);
+	if (!buf || !frag) {
+		TC_PRINT("Out of buffers\n");
+		goto done;
+	}
+
+	net_buf_add_mem(frag, payload, sizeof(payload));
+
+	r = coap_packet_init(&cpkt, net_buf_tail(buf), net_buf_tailroom(buf),
+			     1, COAP_TYPE_CON, 0, NULL,
+			     COAP_RESPONSE_CODE_CONTENT, 0x1234);
+	if (r < 0) {
+		TC_PRINT("Could not initialize packet\n");
+		goto done;
+	}
+
+	r = coap_append_option_int(&cpkt, COAP_OPTION_CONTENT_FORMAT, 0);
+	if (r < 0) {
+		TC_PRINT("Could not append option\n");
+		goto done;
+	}
+
+	r = coap_packet_buf_commit(&cpkt, buf, frag);
+	frag = NULL;
+	if (r < 0) {
+		TC_PRINT("Could not complete packet (%d)\n", r);
+		goto done;
+	}
+
+	if (buf->len != sizeof(result_pdu) ||
+	    memcmp(buf->data, result_pdu, sizeof(result_pdu))) {
+		TC_PRINT("Header and options don't match reference\n");
+		goto done;
+	}
+
+	if (!buf->frags || net_buf_frags_len(buf->frags) != sizeof(payload) ||
+	    memcmp(buf->frags->data, payload, sizeof(payload))) {
+		TC_PRINT("Payload doesn't match reference\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	if (frag) {
+		net_buf_unref(frag);
+	}
+
+	if (buf) {
+		net_buf_unref(buf);
+	}
+
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static int test_parse_malformed_opt(void)
 {
 	u8_t opt[] = { 0x55, 0xA5, 0x12, 0x34, 't', 'o', 'k', 'e', 'n',
@@ -1345,6 +1525,127 @@ done:
 	return result;
 }
 
+static const char notify_payload[] = "Counter: 1";
+static u16_t notify_ids[NUM_OBSERVERS];
+static int notify_count;
+
+static int notify_packet_send(struct coap_resource *resource,
+			      struct coap_observer *observer,
+			      struct coap_packet *cpkt, void *user_data)
+{
+	struct coap_packet notification;
+	struct coap_option option;
+	const u8_t *payload;
+	u8_t token[8];
+	u16_t len;
+	u8_t tkl;
+	int r;
+
+	/* What the observer receives */
+	r = coap_packet_parse(&notification, cpkt->data, cpkt->offset,
+			      NULL, 0);
+	if (r < 0) {
+		TC_PRINT("Could not parse notification\n");
+		return r;
+	}
+
+	tkl = coap_header_get_token(&notification, token);
+	if (tkl != observer->tkl || memcmp(token, observer->token, tkl)) {
+		TC_PRINT("Token doesn't match the observer\n");
+		return -EINVAL;
+	}
+
+	r = coap_find_options(&notification, COAP_OPTION_OBSERVE, &option, 1);
+	if (r != 1 || coap_option_value_to_int(&option) != resource->age) {
+		TC_PRINT("Observe option doesn't match the resource age\n");
+		return -EINVAL;
+	}
+
+	payload = coap_packet_get_payload(&notification, &len);
+	if (len != sizeof(notify_payload) ||
+	    memcmp(payload, notify_payload, len)) {
+		TC_PRINT("Payload doesn't match reference\n");
+		return -EINVAL;
+	}
+
+	notify_ids[notify_count++] = coap_header_get_id(&notification);
+
+	return 0;
+}
+
+static int test_notify_packet(void)
+{
+	static const char * const path[] = { "n", NULL };
+	struct coap_resource resource = { .path = path };
+	struct coap_observer obs[NUM_OBSERVERS] = {
+		{ .token = "abcdefgh", .tkl = 8 },
+		{ .tkl = 0 },
+		{ .token = "ab", .tkl = 2 },
+	};
+	struct coap_packet cpkt;
+	u8_t *data;
+	int result = TC_FAIL;
+	int i, r;
+
+	data = (u8_t *)k_malloc(COAP_BUF_SIZE);
+	if (!data) {
+		goto done;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(obs); i++) {
+		net_ipaddr_copy(&obs[i].addr, (struct sockaddr *)&dummy_addr);
+		coap_register_observer(&resource, &obs[i]);
+	}
+
+	resource.age++;
+
+	r = coap_packet_init(&cpkt, data, COAP_BUF_SIZE,
+			     1, COAP_TYPE_NON_CON, 4, (u8_t *)"tokn",
+			     COAP_RESPONSE_CODE_CONTENT, 0);
+	if (r < 0) {
+		TC_PRINT("Could not initialize packet\n");
+		goto done;
+	}
+
+	r = coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, resource.age);
+	r |= coap_append_option_int(&cpkt, COAP_OPTION_CONTENT_FORMAT, 0);
+	r |= coap_packet_append_payload_marker(&cpkt);
+	r |= coap_packet_append_payload(&cpkt, (u8_t *)notify_payload,
+					sizeof(notify_payload));
+	if (r) {
+		TC_PRINT("Could not build notification\n");
+		goto done;
+	}
+
+	notify_count = 0;
+
+	r = coap_resource_notify_packet(&resource, &cpkt, notify_packet_send,
+					NULL);
+	if (r < 0) {
+		TC_PRINT("Could not notify resource\n");
+		goto done;
+	}
+
+	if (notify_count != ARRAY_SIZE(obs)) {
+		TC_PRINT("Not all the observers were notified\n");
+		goto done;
+	}
+
+	if (notify_ids[0] == notify_ids[1] || notify_ids[1] == notify_ids[2]) {
+		TC_PRINT("Notifications sent with the same message ID\n");
+		goto done;
+	}
+
+	result = TC_PASS;
+
+done:
+	k_free(data);
+
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static int resource_reply_cb(const struct coap_packet *response,
 			     struct coap_reply *reply,
 			     const struct sockaddr *from)
@@ -1470,12 +1771,15 @@ static const struct {
 		test_parse_malformed_opt_len_ext },
 	{ "Parse malformed empty payload with marker",
 		test_parse_malformed_marker, },
+	{ "Find options test", test_find_options, },
+	{ "Build PDU in net_buf test", test_packet_buf, },
 	{ "Test match path uri", test_match_path_uri, },
 	{ "Test block sized 1 transfer", test_block1_size, },
 	{ "Test block sized 2 transfer", test_block2_size, },
 	{ "Test retransmission", test_retransmit_second_round, },
 	{ "Test observer server", test_observer_server, },
 	{ "Test observer client", test_observer_client, },
+	{ "Test observer notification packet", test_notify_packet, },
 };
 
 void main(void)
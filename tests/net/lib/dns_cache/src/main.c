@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+
+#include <ztest.h>
+
+#include <net/socket.h>
+#include <net/dns_resolve.h>
+
+#define DNS_PORT 15353
+#define DNS_TIMEOUT 500 /* ms */
+#define WAIT_TIME K_MSEC(DNS_TIMEOUT + 300)
+
+#define STACK_SIZE 1024
+#define THREAD_PRIORITY K_PRIO_COOP(8)
+
+#define DNS_HEADER_LEN 12
+#define DNS_TYPE_A 1
+
+struct host {
+	const char *name;
+	u8_t addr[4];
+	u32_t ttl;
+};
+
+/* The name the local DNS server fails to resolve */
+#define FAILING_NAME "fail.zephyr.test"
+
+/* A name that exists without an address (NODATA) */
+#define NODATA_NAME "noaddr.zephyr.test"
+
+/* The names the local DNS server knows about, the others do not exist */
+static const struct host hosts[] = {
+	{ "ok.zephyr.test", { 192, 0, 2, 10 }, 60 },
+	{ "short.zephyr.test", { 192, 0, 2, 11 }, 1 },
+	{ "a.zephyr.test", { 192, 0, 2, 20 }, 60 },
+	{ "b.zephyr.test", { 192, 0, 2, 21 }, 60 },
+	{ "c.zephyr.test", { 192, 0, 2, 22 }, 60 },
+	{ "d.zephyr.test", { 192, 0, 2, 23 }, 60 },
+	{ "e.zephyr.test", { 192, 0, 2, 24 }, 60 },
+};
+
+static u8_t dns_buf[512];
+static atomic_t queries;
+
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(query_done, 0, 1);
+
+static int query_status;
+static struct in_addr query_addr;
+
+static const struct host *host_find(const char *name)
+{
+	for (int i = 0; i < ARRAY_SIZE(hosts); i++) {
+		if (!strcmp(hosts[i].name, name)) {
+			return &hosts[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Turn the query in dns_buf into its answer, a single A record, no
+ * record, no such name or a server failure.
+ */
+static int dns_answer(int len)
+{
+	const struct host *host;
+	char name[64];
+	int pos = DNS_HEADER_LEN;
+	int name_len = 0;
+	u16_t qtype;
+
+	while (pos < len && dns_buf[pos] != 0U) {
+		int label = dns_buf[pos++];
+
+		if (name_len + label + 1 >= sizeof(name) ||
+		    pos + label > len) {
+			return -EINVAL;
+		}
+
+		if (name_len) {
+			name[name_len++] = '.';
+		}
+
+		memcpy(name + name_len, dns_buf + pos, label);
+		name_len += label;
+		pos += label;
+	}
+
+	name[name_len] = '\0';
+
+	/* Root label, type and class */
+	pos += 1;
+	if (pos + 4 > len) {
+		return -EINVAL;
+	}
+
+	qtype = (dns_buf[pos] << 8) | dns_buf[pos + 1];
+	pos += 4;
+
+	host = qtype == DNS_TYPE_A ? host_find(name) : NULL;
+
+	/* Response, recursion desired and available, no error, no such
+	 * name or server failure, one question and as many answers as found.
+	 */
+	dns_buf[2] = 0x81;
+
+	if (host || !strcmp(name, NODATA_NAME)) {
+		dns_buf[3] = 0x80;
+	} else if (!strcmp(name, FAILING_NAME)) {
+		dns_buf[3] = 0x82;
+	} else {
+		dns_buf[3] = 0x83;
+	}
+
+	(void)memset(dns_buf + 6, 0, 6);
+	dns_buf[7] = host ? 1 : 0;
+
+	if (!host) {
+		return pos;
+	}
+
+	/* Pointer to the question name, type A, class IN */
+	dns_buf[pos++] = 0xc0;
+	dns_buf[pos++] = DNS_HEADER_LEN;
+	dns_buf[pos++] = 0;
+	dns_buf[pos++] = 1;
+	dns_buf[pos++] = 0;
+	dns_buf[pos++] = 1;
+
+	sys_put_be32(host->ttl, dns_buf + pos);
+	pos += 4;
+
+	dns_buf[pos++] = 0;
+	dns_buf[pos++] = sizeof(host->addr);
+	memcpy(dns_buf + pos, host->addr, sizeof(host->addr));
+	pos += sizeof(host->addr);
+
+	return pos;
+}
+
+static void dns_server(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(DNS_PORT),
+	};
+	struct sockaddr client;
+	socklen_t client_len;
+	int sock, len;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		LOG_ERR("Cannot create socket (%d)", errno);
+		return;
+	}
+
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		LOG_ERR("Cannot bind (%d)", errno);
+		return;
+	}
+
+	k_sem_give(&server_ready);
+
+	while (true) {
+		client_len = sizeof(client);
+
+		len = recvfrom(sock, dns_buf, sizeof(dns_buf) - 16, 0,
+			       &client, &client_len);
+		if (len < DNS_HEADER_LEN) {
+			continue;
+		}
+
+		atomic_inc(&queries);
+
+		len = dns_answer(len);
+		if (len < 0) {
+			continue;
+		}
+
+		(void)sendto(sock, dns_buf, len, 0, &client, client_len);
+	}
+}
+
+K_THREAD_DEFINE(dns_server_thread_id, STACK_SIZE,
+		dns_server, NULL, NULL, NULL,
+		THREAD_PRIORITY, 0, 0);
+
+static void query_cb(enum dns_resolve_status status,
+		     struct dns_addrinfo *info, void *user_data)
+{
+	if (status == DNS_EAI_INPROGRESS && info) {
+		query_addr = net_sin(&info->ai_addr)->sin_addr;
+		return;
+	}
+
+	query_status = status;
+	k_sem_give(&query_done);
+}
+
+/* Resolve the name and return the number of queries it sent upstream */
+static int resolve(const char *name, int expected_status)
+{
+	int before = atomic_get(&queries);
+	int ret;
+
+	query_status = 0;
+	(void)memset(&query_addr, 0, sizeof(query_addr));
+
+	ret = dns_get_addr_info(name, DNS_QUERY_TYPE_A, NULL, query_cb, NULL,
+				DNS_TIMEOUT);
+	zassert_equal(ret, 0, "Cannot resolve %s (%d)", name, ret);
+
+	zassert_equal(k_sem_take(&query_done, WAIT_TIME), 0,
+		      "No answer for %s", name);
+	zassert_equal(query_status, expected_status,
+		      "Invalid status %d for %s", query_status, name);
+
+	if (expected_status == DNS_EAI_ALLDONE) {
+		zassert_mem_equal(&query_addr, host_find(name)->addr,
+				  sizeof(query_addr), "Invalid address");
+	}
+
+	/* Different uptimes to order the entries by their last use */
+	k_msleep(2);
+
+	return atomic_get(&queries) - before;
+}
+
+static void test_setup(void)
+{
+	zassert_equal(k_sem_take(&server_ready, WAIT_TIME), 0,
+		      "DNS server not started");
+}
+
+static void test_cache_hit(void)
+{
+	zassert_equal(resolve("ok.zephyr.test", DNS_EAI_ALLDONE), 1,
+		      "Name not queried");
+	zassert_equal(resolve("ok.zephyr.test", DNS_EAI_ALLDONE), 0,
+		      "Name not cached");
+}
+
+static void test_cache_ttl(void)
+{
+	zassert_equal(resolve("short.zephyr.test", DNS_EAI_ALLDONE), 1,
+		      "Name not queried");
+	zassert_equal(resolve("short.zephyr.test", DNS_EAI_ALLDONE), 0,
+		      "Name not cached");
+
+	k_msleep(MSEC_PER_SEC + 100);
+
+	zassert_equal(resolve("short.zephyr.test", DNS_EAI_ALLDONE), 1,
+		      "Name cached past its time to live");
+}
+
+static void test_cache_negative(void)
+{
+	zassert_equal(resolve("missing.zephyr.test", DNS_EAI_NODATA), 1,
+		      "Name not queried");
+	zassert_equal(resolve("missing.zephyr.test", DNS_EAI_NODATA), 0,
+		      "Missing name not cached");
+}
+
+static void test_cache_nodata(void)
+{
+	/* NOERROR without answers, the name has no address of the type */
+	zassert_equal(resolve(NODATA_NAME, DNS_EAI_NODATA), 1,
+		      "Name not queried");
+	zassert_equal(resolve(NODATA_NAME, DNS_EAI_NODATA), 0,
+		      "Name without address not cached");
+}
+
+static void test_cache_servfail(void)
+{
+	/* A server failure may not last, unlike a missing name */
+	zassert_equal(resolve(FAILING_NAME, DNS_EAI_NODATA), 1,
+		      "Name not queried");
+	zassert_equal(resolve(FAILING_NAME, DNS_EAI_NODATA), 1,
+		      "Server failure cached");
+}
+
+static void test_cache_lru(void)
+{
+	dns_resolve_cache_flush();
+
+	zassert_equal(resolve("a.zephyr.test", DNS_EAI_ALLDONE), 1, "");
+	zassert_equal(resolve("b.zephyr.test", DNS_EAI_ALLDONE), 1, "");
+	zassert_equal(resolve("c.zephyr.test", DNS_EAI_ALLDONE), 1, "");
+	zassert_equal(resolve("d.zephyr.test", DNS_EAI_ALLDONE), 1, "");
+
+	/* Used again, so b is now the least recently used */
+	zassert_equal(resolve("a.zephyr.test", DNS_EAI_ALLDONE), 0, "");
+
+	zassert_equal(resolve("e.zephyr.test", DNS_EAI_ALLDONE), 1, "");
+
+	zassert_equal(resolve("a.zephyr.test", DNS_EAI_ALLDONE), 0,
+		      "Recently used name evicted");
+	zassert_equal(resolve("b.zephyr.test", DNS_EAI_ALLDONE), 1,
+		      "Least recently used name not evicted");
+}
+
+static void test_cache_flush(void)
+{
+	(void)resolve("ok.zephyr.test", DNS_EAI_ALLDONE);
+	zassert_equal(resolve("ok.zephyr.test", DNS_EAI_ALLDONE), 0,
+		      "Name not cached");
+
+	dns_resolve_cache_flush();
+
+	zassert_equal(resolve("ok.zephyr.test", DNS_EAI_ALLDONE), 1,
+		      "Name still cached after flush");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(dns_cache,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_cache_hit),
+			 ztest_unit_test(test_cache_ttl),
+			 ztest_unit_test(test_cache_negative),
+			 ztest_unit_test(test_cache_nodata),
+			 ztest_unit_test(test_cache_servfail),
+			 ztest_unit_test(test_cache_lru),
+			 ztest_unit_test(test_cache_flush));
+
+	ztest_run_test_suite(dns_cache);
+}
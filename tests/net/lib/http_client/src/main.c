@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_HTTP_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <ztest.h>
+
+#include <net/socket.h>
+#include <net/http_client.h>
+
+#define SERVER_PORT 8080
+#define WAIT_MS 1000
+#define SHORT_TIMEOUT_MS 200
+
+#define STACK_SIZE 2048
+#define THREAD_PRIORITY K_PRIO_PREEMPT(8)
+
+#define MAX_REQUESTS 3
+
+#define RESPONSE(body_len, body)		\
+	"HTTP/1.1 200 OK\r\n"			\
+	"Content-Length: " #body_len "\r\n"	\
+	"\r\n"					\
+	body
+
+struct result {
+	char body[16];
+	size_t body_len;
+	char status[HTTP_STATUS_STR_SIZE];
+	int order;
+	bool final;
+	bool complete;
+};
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+/* What the server does with the next connection, set by each test */
+static void (*server_handler)(int sock);
+
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(server_done, 0, 1);
+static K_SEM_DEFINE(server_release, 0, 1);
+
+/* Requests the server received on the connection */
+static char server_buf[512];
+static size_t server_len;
+
+static struct http_request reqs[MAX_REQUESTS];
+static struct result results[MAX_REQUESTS];
+static int finished;
+
+static const char *chunks[] = { "hello", " world" };
+static int chunk_idx;
+
+/* Receive until the given string was seen count times */
+static int server_recv(int sock, const char *end, int count)
+{
+	const char *pos;
+	ssize_t ret;
+	int seen;
+
+	server_len = 0;
+
+	while (true) {
+		server_buf[server_len] = '\0';
+
+		for (seen = 0, pos = server_buf;
+		     (pos = strstr(pos, end)) != NULL;
+		     seen++, pos += strlen(end)) {
+		}
+
+		if (seen >= count) {
+			return 0;
+		}
+
+		if (server_len == sizeof(server_buf) - 1) {
+			return -ENOMEM;
+		}
+
+		ret = recv(sock, server_buf + server_len,
+			   sizeof(server_buf) - 1 - server_len, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		server_len += ret;
+	}
+}
+
+static void server_send(int sock, const char *data, size_t len)
+{
+	(void)send(sock, data, len, 0);
+}
+
+static void server(void)
+{
+	struct sockaddr_in addr = server_addr;
+	int sock, client;
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		LOG_ERR("Cannot set up the server (%d)", errno);
+		return;
+	}
+
+	k_sem_give(&server_ready);
+
+	while ((client = accept(sock, NULL, NULL)) >= 0) {
+		server_handler(client);
+		close(client);
+		k_sem_give(&server_done);
+	}
+}
+
+K_THREAD_DEFINE(server_thread_id, STACK_SIZE,
+		server, NULL, NULL, NULL,
+		THREAD_PRIORITY, 0, 0);
+
+static void response_cb(struct http_response *rsp,
+			enum http_final_call final_data, void *user_data)
+{
+	struct result *result = user_data;
+	size_t len;
+
+	if (rsp->body_start && rsp->data_len) {
+		len = MIN(rsp->data_len,
+			  sizeof(result->body) - 1 - result->body_len);
+		memcpy(result->body + result->body_len, rsp->body_start, len);
+		result->body_len += len;
+	}
+
+	if (final_data != HTTP_DATA_FINAL) {
+		return;
+	}
+
+	strncpy(result->status, rsp->http_status, sizeof(result->status) - 1);
+	result->complete = rsp->message_complete;
+	result->final = true;
+	result->order = finished++;
+}
+
+static int chunk_cb(struct http_request *req, const u8_t **data,
+		    void *user_data)
+{
+	if (chunk_idx == ARRAY_SIZE(chunks)) {
+		return 0;
+	}
+
+	*data = (const u8_t *)chunks[chunk_idx];
+
+	return strlen(chunks[chunk_idx++]);
+}
+
+static void send_req(int i, enum http_method method, const char *url,
+		     s32_t timeout)
+{
+	int ret;
+
+	memset(&reqs[i], 0, sizeof(reqs[i]));
+
+	reqs[i].method = method;
+	reqs[i].url = url;
+	reqs[i].host = CONFIG_NET_CONFIG_MY_IPV4_ADDR;
+	reqs[i].protocol = "HTTP/1.1";
+	reqs[i].response = response_cb;
+
+	ret = http_client_conn_req((struct sockaddr *)&server_addr,
+				   sizeof(server_addr), &reqs[i], timeout,
+				   &results[i]);
+	zassert_equal(ret, 0, "Cannot send request %d (%d)", i, ret);
+}
+
+/* Process the responses until the first count requests are finished */
+static void wait_final(int count)
+{
+	u32_t start = k_uptime_get_32();
+	int ret;
+
+	while (finished < count) {
+		zassert_true(k_uptime_get_32() - start < WAIT_MS,
+			     "Only %d of %d requests finished", finished,
+			     count);
+
+		ret = http_client_conn_input(WAIT_MS);
+		zassert_true(ret >= 0, "Input failed (%d)", ret);
+	}
+}
+
+static void check_result(int i, int order, const char *body)
+{
+	zassert_true(results[i].final, "Request %d not finished", i);
+	zassert_true(results[i].complete, "Request %d not complete", i);
+	zassert_equal(results[i].order, order, "Request %d finished as %d",
+		      i, results[i].order);
+	zassert_equal(results[i].body_len, strlen(body),
+		      "Request %d body length %zu", i, results[i].body_len);
+	zassert_mem_equal(results[i].body, body, strlen(body),
+			  "Request %d wrong body", i);
+	zassert_equal(strcmp(results[i].status, "OK"), 0,
+		      "Request %d status %s", i, results[i].status);
+}
+
+static void test_start(void (*handler)(int sock))
+{
+	memset(results, 0, sizeof(results));
+	finished = 0;
+	server_handler = handler;
+}
+
+static void test_end(void)
+{
+	http_client_conn_close_all();
+
+	zassert_equal(k_sem_take(&server_done, K_MSEC(WAIT_MS)), 0,
+		      "Server did not finish");
+}
+
+static void test_setup(void)
+{
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+
+	zassert_equal(k_sem_take(&server_ready, K_MSEC(WAIT_MS)), 0,
+		      "Server not started");
+}
+
+/* The three responses, split in the middle of the second one */
+static void server_pipelined(int sock)
+{
+	static const char responses[] =
+		RESPONSE(3, "one") RESPONSE(3, "two") RESPONSE(5, "three");
+	size_t split = sizeof(RESPONSE(3, "one")) + 20;
+
+	if (server_recv(sock, "\r\n\r\n", 3) < 0) {
+		return;
+	}
+
+	server_send(sock, responses, split);
+	k_msleep(50);
+	server_send(sock, responses + split, sizeof(responses) - 1 - split);
+
+	/* Wait for the client to close */
+	(void)server_recv(sock, "\r\n\r\n", 4);
+}
+
+/**
+ * @brief Pipelined responses go to their requests in order, also when
+ * they arrive split over several reads.
+ */
+static void test_pipelined(void)
+{
+	test_start(server_pipelined);
+
+	send_req(0, HTTP_GET, "/1", WAIT_MS);
+	send_req(1, HTTP_GET, "/2", WAIT_MS);
+	send_req(2, HTTP_GET, "/3", WAIT_MS);
+
+	wait_final(3);
+
+	check_result(0, 0, "one");
+	check_result(1, 1, "two");
+	check_result(2, 2, "three");
+
+	test_end();
+}
+
+static void server_close(int sock)
+{
+	static const char response[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Connection: close\r\n"
+		"Content-Length: 3\r\n"
+		"\r\n"
+		"one";
+
+	if (server_recv(sock, "\r\n\r\n", 3) < 0) {
+		return;
+	}
+
+	server_send(sock, response, sizeof(response) - 1);
+}
+
+/**
+ * @brief A response closing the connection ends the requests sent after
+ * it without a response.
+ */
+static void test_connection_close(void)
+{
+	test_start(server_close);
+
+	send_req(0, HTTP_GET, "/1", WAIT_MS);
+	send_req(1, HTTP_GET, "/2", WAIT_MS);
+	send_req(2, HTTP_GET, "/3", WAIT_MS);
+
+	wait_final(3);
+
+	check_result(0, 0, "one");
+
+	for (int i = 1; i < 3; i++) {
+		zassert_true(results[i].final, "Request %d not finished", i);
+		zassert_false(results[i].complete, "Request %d complete", i);
+		zassert_equal(results[i].body_len, 0, "Request %d has a body",
+			      i);
+	}
+
+	test_end();
+}
+
+static void server_stall(int sock)
+{
+	static const char response[] = RESPONSE(10, "abc");
+
+	if (server_recv(sock, "\r\n\r\n", 1) < 0) {
+		return;
+	}
+
+	server_send(sock, response, sizeof(response) - 1);
+
+	(void)k_sem_take(&server_release, K_MSEC(WAIT_MS));
+}
+
+/**
+ * @brief A response later than its timeout ends the request, keeping
+ * what was received of it.
+ */
+static void test_timeout(void)
+{
+	test_start(server_stall);
+
+	send_req(0, HTTP_GET, "/1", SHORT_TIMEOUT_MS);
+
+	wait_final(1);
+
+	zassert_true(results[0].final, "Request not finished");
+	zassert_false(results[0].complete, "Request complete");
+	zassert_equal(strcmp(results[0].status, "OK"), 0,
+		      "Status not kept (%s)", results[0].status);
+	zassert_mem_equal(results[0].body, "abc", 3, "Wrong body");
+
+	k_sem_give(&server_release);
+
+	test_end();
+}
+
+static void server_chunked(int sock)
+{
+	static const char response[] = RESPONSE(2, "ok");
+
+	if (server_recv(sock, "0\r\n\r\n", 1) < 0) {
+		return;
+	}
+
+	server_send(sock, response, sizeof(response) - 1);
+
+	(void)server_recv(sock, "\r\n\r\n", 100);
+}
+
+/**
+ * @brief A body from the chunk callback is sent with chunked transfer
+ * encoding.
+ */
+static void test_chunked(void)
+{
+	static const char body[] =
+		"5\r\nhello\r\n"
+		"6\r\n world\r\n"
+		"0\r\n\r\n";
+	const char *pos;
+
+	test_start(server_chunked);
+
+	chunk_idx = 0;
+
+	memset(&reqs[0], 0, sizeof(reqs[0]));
+	reqs[0].method = HTTP_POST;
+	reqs[0].url = "/upload";
+	reqs[0].host = CONFIG_NET_CONFIG_MY_IPV4_ADDR;
+	reqs[0].protocol = "HTTP/1.1";
+	reqs[0].response = response_cb;
+	reqs[0].chunk_cb = chunk_cb;
+
+	zassert_equal(http_client_conn_req((struct sockaddr *)&server_addr,
+					   sizeof(server_addr), &reqs[0],
+					   WAIT_MS, &results[0]), 0,
+		      "Cannot send request");
+
+	wait_final(1);
+
+	check_result(0, 0, "ok");
+
+	zassert_not_null(strstr(server_buf, "Transfer-Encoding: chunked\r\n"),
+			 "No chunked encoding header");
+
+	pos = strstr(server_buf, "\r\n\r\n");
+	zassert_not_null(pos, "No end of headers");
+	pos += 4;
+
+	zassert_equal(server_len - (pos - server_buf), sizeof(body) - 1,
+		      "Wrong body length");
+	zassert_mem_equal(pos, body, sizeof(body) - 1, "Wrong body");
+
+	test_end();
+}
+
+static void server_head(int sock)
+{
+	/* The response to HEAD has the length the body would have */
+	static const char responses[] =
+		RESPONSE(5, "") RESPONSE(5, "hello");
+
+	if (server_recv(sock, "\r\n\r\n", 2) < 0) {
+		return;
+	}
+
+	server_send(sock, responses, sizeof(responses) - 1);
+
+	(void)server_recv(sock, "\r\n\r\n", 3);
+}
+
+/**
+ * @brief The response to a HEAD request has no body, the response after
+ * it on the connection is not taken for it.
+ */
+static void test_head(void)
+{
+	test_start(server_head);
+
+	send_req(0, HTTP_HEAD, "/", WAIT_MS);
+	send_req(1, HTTP_GET, "/", WAIT_MS);
+
+	wait_final(2);
+
+	check_result(0, 0, "");
+	check_result(1, 1, "hello");
+
+	test_end();
+}
+
+static void server_error(int sock)
+{
+	static const char responses[] =
+		"HTTP/1.1 500 Internal Server Error\r\n"
+		"Content-Length: 4\r\n"
+		"\r\n"
+		"fail"
+		RESPONSE(2, "ok");
+
+	if (server_recv(sock, "\r\n\r\n", 2) < 0) {
+		return;
+	}
+
+	server_send(sock, responses, sizeof(responses) - 1);
+
+	(void)server_recv(sock, "\r\n\r\n", 3);
+}
+
+/**
+ * @brief The body of an error response is taken for that response, not
+ * for the one after it on the connection.
+ */
+static void test_error_body(void)
+{
+	test_start(server_error);
+
+	send_req(0, HTTP_GET, "/1", WAIT_MS);
+	send_req(1, HTTP_GET, "/2", WAIT_MS);
+
+	wait_final(2);
+
+	zassert_true(results[0].final, "Request not finished");
+	zassert_true(results[0].complete, "Request not complete");
+	zassert_equal(results[0].order, 0, "Request finished as %d",
+		      results[0].order);
+	zassert_equal(strcmp(results[0].status, "Internal Server Error"), 0,
+		      "Wrong status %s", results[0].status);
+	zassert_equal(results[0].body_len, 4, "Body length %zu",
+		      results[0].body_len);
+	zassert_mem_equal(results[0].body, "fail", 4, "Wrong body");
+
+	check_result(1, 1, "ok");
+
+	test_end();
+}
+
+static void server_chunked_reply(int sock)
+{
+	static const char responses[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"\r\n"
+		"5\r\nfirst\r\n"
+		"0\r\n\r\n"
+		RESPONSE(6, "second");
+
+	if (server_recv(sock, "\r\n\r\n", 2) < 0) {
+		return;
+	}
+
+	server_send(sock, responses, sizeof(responses) - 1);
+
+	(void)server_recv(sock, "\r\n\r\n", 3);
+}
+
+/**
+ * @brief A chunked reply to POST, with no Content-Length, is read whole
+ * before the response after it on the connection.
+ */
+static void test_post_chunked_reply(void)
+{
+	test_start(server_chunked_reply);
+
+	send_req(0, HTTP_POST, "/1", WAIT_MS);
+	send_req(1, HTTP_GET, "/2", WAIT_MS);
+
+	wait_final(2);
+
+	check_result(0, 0, "first");
+	check_result(1, 1, "second");
+
+	test_end();
+}
+
+void test_main(void)
+{
+	ztest_test_suite(http_client,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_pipelined),
+			 ztest_unit_test(test_connection_close),
+			 ztest_unit_test(test_timeout),
+			 ztest_unit_test(test_chunked),
+			 ztest_unit_test(test_head),
+			 ztest_unit_test(test_error_body),
+			 ztest_unit_test(test_post_chunked_reply));
+
+	ztest_run_test_suite(http_client);
+}
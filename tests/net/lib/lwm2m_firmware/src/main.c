@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Firmware pushed over loopback to the Firmware Update object of the
+ * LwM2M engine, in Block1 PUTs of 512 bytes to /5/0/0. The test thread
+ * plays the LwM2M server. Streamed, the engine writes every block to the
+ * secondary image slot from where it is in the request. Buffered, the
+ * application copies the package in through a pre-write buffer, keeps all
+ * of it in RAM and writes it to the slot at the end. Both must leave the
+ * package in the slot. The transfer rate, the buffers held by the transfer
+ * path and the peak stack use of the engine thread are printed.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_LWM2M_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <ztest.h>
+
+#include <net/socket.h>
+#include <net/coap.h>
+#include <net/lwm2m.h>
+#include <dfu/flash_img.h>
+#include <storage/flash_map.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+
+#define IMAGE_SIZE (128 * 1024)
+#define BLOCK_SIZE 512
+#define SERVER_PORT 5683
+#define MAX_COAP_MSG_LEN (BLOCK_SIZE + 64)
+
+static const char * const package_path[] = { "5", "0", "0", NULL };
+static u8_t token[] = { 0xf1, 0x2e, 0x3d, 0x4c };
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+static int server_sock = -1;
+
+static struct lwm2m_ctx client;
+static struct sockaddr client_addr;
+static socklen_t client_addr_len;
+
+static u8_t image[IMAGE_SIZE];
+static u8_t request_buf[MAX_COAP_MSG_LEN];
+static u8_t response_buf[MAX_COAP_MSG_LEN];
+static u8_t slot_buf[BLOCK_SIZE];
+
+/* What the application needs to take the package in by itself */
+static u8_t block_buf[BLOCK_SIZE];
+static u8_t package_buf[IMAGE_SIZE];
+static size_t package_len;
+static struct flash_img_context flash_img;
+
+static void *package_get_buf(u16_t obj_inst_id, u16_t res_id,
+			     u16_t res_inst_id, size_t *data_len)
+{
+	*data_len = sizeof(block_buf);
+
+	return block_buf;
+}
+
+static int package_buffer_cb(u16_t obj_inst_id, u16_t res_id,
+			     u16_t res_inst_id, u8_t *data, u16_t data_len,
+			     bool last_block, size_t total_size)
+{
+	const struct flash_area *fa;
+	int ret;
+
+	if (package_len + data_len > sizeof(package_buf)) {
+		return -ENOSPC;
+	}
+
+	memcpy(package_buf + package_len, data, data_len);
+	package_len += data_len;
+
+	if (!last_block) {
+		return 0;
+	}
+
+	ret = flash_img_init(&flash_img);
+	if (ret < 0) {
+		return -EIO;
+	}
+
+	fa = flash_img.flash_area;
+
+	ret = flash_area_erase(fa, 0, fa->fa_size);
+	if (ret == 0) {
+		ret = flash_img_buffered_write(&flash_img, package_buf,
+					       package_len, true);
+	}
+
+	if (ret < 0) {
+		flash_area_close(fa);
+		return -EIO;
+	}
+
+	package_len = 0;
+
+	return 0;
+}
+
+static void engine_stack_cb(const struct k_thread *thread, void *user_data)
+{
+	size_t *used = user_data;
+	size_t unused;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	if (name && !strcmp(name, "lwm2m-sock-recv") &&
+	    !k_thread_stack_space_get(thread, &unused)) {
+		*used = thread->stack_info.size - unused;
+	}
+}
+
+/* Highest stack use of the engine thread so far */
+static size_t engine_stack_used(void)
+{
+	size_t used = 0;
+
+	k_thread_foreach(engine_stack_cb, &used);
+
+	return used;
+}
+
+static void send_block(struct coap_packet *request,
+		       struct coap_block_context *ctx)
+{
+	size_t len;
+	int r;
+
+	r = coap_packet_init(request, request_buf, sizeof(request_buf), 1,
+			     COAP_TYPE_CON, sizeof(token), token,
+			     COAP_METHOD_PUT, coap_next_id());
+	zassert_equal(r, 0, "cannot init request (%d)", r);
+
+	for (int i = 0; package_path[i]; i++) {
+		r = coap_packet_append_option(request, COAP_OPTION_URI_PATH,
+					      (const u8_t *)package_path[i],
+					      strlen(package_path[i]));
+		zassert_equal(r, 0, "cannot append path (%d)", r);
+	}
+
+	r = coap_append_option_int(request, COAP_OPTION_CONTENT_FORMAT,
+				   LWM2M_FORMAT_APP_OCTET_STREAM);
+	zassert_equal(r, 0, "cannot append content format (%d)", r);
+
+	r = coap_append_block1_option(request, ctx);
+	zassert_equal(r, 0, "cannot append block1 (%d)", r);
+
+	if (ctx->current == 0) {
+		r = coap_append_size1_option(request, ctx);
+		zassert_equal(r, 0, "cannot append size1 (%d)", r);
+	}
+
+	r = coap_packet_append_payload_marker(request);
+	zassert_equal(r, 0, "cannot append payload marker (%d)", r);
+
+	/* Packages larger than the image are the image over and over */
+	len = MIN(BLOCK_SIZE, ctx->total_size - ctx->current);
+
+	r = coap_packet_append_payload(request,
+				       image + ctx->current % sizeof(image),
+				       len);
+	zassert_equal(r, 0, "cannot append payload (%d)", r);
+
+	r = sendto(server_sock, request->data, request->offset, 0,
+		   &client_addr, client_addr_len);
+	zassert_true(r > 0, "cannot send block %zu (%d)", ctx->current, errno);
+}
+
+static u8_t recv_response(void)
+{
+	struct coap_packet response;
+	int len;
+
+	len = recv(server_sock, response_buf, sizeof(response_buf), 0);
+	zassert_true(len > 0, "no response (%d)", errno);
+	zassert_equal(coap_packet_parse(&response, response_buf, len,
+					NULL, 0), 0, "invalid response");
+
+	return coap_header_get_code(&response);
+}
+
+/* Pushes the image, returns the transfer rate in KiB/s */
+static u32_t transfer(void)
+{
+	struct coap_packet request;
+	struct coap_block_context ctx;
+	u32_t start, cycles;
+	u8_t code;
+
+	coap_block_transfer_init(&ctx, COAP_BLOCK_512, sizeof(image));
+
+	start = k_cycle_get_32();
+
+	do {
+		send_block(&request, &ctx);
+
+		code = recv_response();
+		zassert_true(code == COAP_RESPONSE_CODE_CONTINUE ||
+			     code == COAP_RESPONSE_CODE_CHANGED,
+			     "block %zu refused (%u.%02u)", ctx.current,
+			     COAP_RESPONSE_CODE_CLASS(code),
+			     COAP_RESPONSE_CODE_DETAIL(code));
+	} while (code == COAP_RESPONSE_CODE_CONTINUE &&
+		 coap_next_block(&request, &ctx));
+
+	cycles = MAX(k_cycle_get_32() - start, 1U);
+
+	zassert_equal(code, COAP_RESPONSE_CODE_CHANGED,
+		      "last block not acknowledged");
+	zassert_equal(lwm2m_firmware_get_update_state(), STATE_DOWNLOADED,
+		      "package not downloaded");
+
+	/* Ready for the next package */
+	lwm2m_firmware_set_update_result(RESULT_DEFAULT);
+
+	return (u64_t)sizeof(image) * sys_clock_hw_cycles_per_sec() /
+	       (1024U * cycles);
+}
+
+static void slot_erase(void)
+{
+	const struct flash_area *fa;
+
+	zassert_equal(flash_area_open(DT_FLASH_AREA_IMAGE_1_ID, &fa), 0,
+		      "cannot open the image slot");
+	zassert_equal(flash_area_erase(fa, 0, fa->fa_size), 0,
+		      "cannot erase the image slot");
+	flash_area_close(fa);
+}
+
+static void slot_check(void)
+{
+	const struct flash_area *fa;
+
+	zassert_equal(flash_area_open(DT_FLASH_AREA_IMAGE_1_ID, &fa), 0,
+		      "cannot open the image slot");
+
+	for (size_t off = 0; off < sizeof(image); off += sizeof(slot_buf)) {
+		zassert_equal(flash_area_read(fa, off, slot_buf,
+					      sizeof(slot_buf)), 0,
+			      "cannot read the image slot");
+		zassert_mem_equal(slot_buf, image + off, sizeof(slot_buf),
+				  "package differs at %zu", off);
+	}
+
+	flash_area_close(fa);
+}
+
+static void test_setup(void)
+{
+	char url[32];
+	int ret;
+
+	for (int i = 0; i < sizeof(image); i++) {
+		image[i] = i * 7U;
+	}
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+
+	server_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "socket open failed");
+
+	ret = bind(server_sock, (struct sockaddr *)&server_addr,
+		   sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+
+	/* The engine talks to this socket as its LwM2M server */
+	snprintk(url, sizeof(url), "coap://%s:%d",
+		 CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT);
+
+	client.sec_obj_inst = 0;
+
+	zassert_equal(lwm2m_engine_set_string("0/0/0", url), 0,
+		      "cannot set the server URI");
+	zassert_equal(lwm2m_engine_start(&client), 0,
+		      "cannot start the engine");
+
+	client_addr_len = sizeof(client_addr);
+	ret = getsockname(client.sock_fd, &client_addr, &client_addr_len);
+	zassert_equal(ret, 0, "no client address (%d)", errno);
+
+	/* Only its port is known, the engine binds to any address */
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &net_sin(&client_addr)->sin_addr);
+}
+
+static void test_registry(void)
+{
+	char url[32];
+	u8_t state;
+
+	zassert_equal(lwm2m_engine_get_u8("5/0/3", &state), 0,
+		      "cannot read the update state");
+	zassert_equal(state, lwm2m_firmware_get_update_state(),
+		      "wrong update state");
+
+	zassert_equal(lwm2m_engine_get_u8("5/1/3", &state), -ENOENT,
+		      "missing instance found");
+	zassert_equal(lwm2m_engine_get_u8("4242/0/0", &state), -ENOENT,
+		      "missing object found");
+	zassert_equal(lwm2m_engine_get_u8("5/0/4242", &state), -ENOENT,
+		      "missing resource found");
+
+	/* A new instance is found next to the others of its object */
+	zassert_equal(lwm2m_engine_create_obj_inst("0/1"), 0,
+		      "cannot create instance");
+	zassert_equal(lwm2m_engine_set_string("0/1/0", "coap://[::1]"), 0,
+		      "cannot write the new instance");
+	zassert_equal(lwm2m_engine_get_string("0/1/0", url, sizeof(url)), 0,
+		      "cannot read the new instance");
+	zassert_equal(strcmp(url, "coap://[::1]"), 0, "wrong value read");
+	zassert_equal(lwm2m_engine_get_string("0/0/0", url, sizeof(url)), 0,
+		      "cannot read the first instance");
+	zassert_equal(strncmp(url, "coap://", 7), 0, "wrong value read");
+
+	zassert_equal(lwm2m_delete_obj_inst(0, 1), 0,
+		      "cannot delete instance");
+	zassert_equal(lwm2m_engine_get_string("0/1/0", url, sizeof(url)),
+		      -ENOENT, "deleted instance found");
+	zassert_equal(lwm2m_engine_get_string("0/0/0", url, sizeof(url)), 0,
+		      "first instance lost");
+}
+
+static void test_streamed(void)
+{
+	u32_t rate;
+
+	slot_erase();
+
+	rate = transfer();
+	slot_check();
+
+	TC_PRINT("streamed  %u KiB/s  buffers %zu bytes  "
+		 "engine stack %zu bytes\n",
+		 rate, sizeof(flash_img), engine_stack_used());
+}
+
+/* After the streamed transfer, the stack high-water mark only goes up */
+static void test_buffered(void)
+{
+	lwm2m_engine_set_data_cb_t flash_write_cb;
+	u32_t rate;
+
+	slot_erase();
+
+	flash_write_cb = lwm2m_firmware_get_write_cb();
+	lwm2m_engine_register_pre_write_callback("5/0/0", package_get_buf);
+	lwm2m_firmware_set_write_cb(package_buffer_cb);
+
+	rate = transfer();
+
+	lwm2m_engine_register_pre_write_callback("5/0/0", NULL);
+	lwm2m_firmware_set_write_cb(flash_write_cb);
+
+	slot_check();
+
+	TC_PRINT("buffered  %u KiB/s  buffers %zu bytes  "
+		 "engine stack %zu bytes\n",
+		 rate,
+		 sizeof(block_buf) + sizeof(package_buf) + sizeof(flash_img),
+		 engine_stack_used());
+}
+
+static void test_too_large(void)
+{
+	const struct flash_area *fa;
+	struct coap_packet request;
+	struct coap_block_context ctx;
+	u8_t code;
+
+	zassert_equal(flash_area_open(DT_FLASH_AREA_IMAGE_1_ID, &fa), 0,
+		      "cannot open the image slot");
+	coap_block_transfer_init(&ctx, COAP_BLOCK_512,
+				 fa->fa_size + BLOCK_SIZE);
+	flash_area_close(fa);
+
+	/* Refused on the first block, from its Size1 option */
+	send_block(&request, &ctx);
+
+	code = recv_response();
+	zassert_equal(code, COAP_RESPONSE_CODE_REQUEST_TOO_LARGE,
+		      "package not refused (%u.%02u)",
+		      COAP_RESPONSE_CODE_CLASS(code),
+		      COAP_RESPONSE_CODE_DETAIL(code));
+	zassert_equal(lwm2m_firmware_get_update_result(), RESULT_NO_STORAGE,
+		      "wrong update result");
+	zassert_equal(lwm2m_firmware_get_update_state(), STATE_IDLE,
+		      "wrong update state");
+
+	lwm2m_firmware_set_update_result(RESULT_DEFAULT);
+
+	/* The next package is taken in from the start of the slot */
+	slot_erase();
+
+	transfer();
+	slot_check();
+}
+
+static void test_teardown(void)
+{
+	lwm2m_engine_context_close(&client);
+	close(server_sock);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lwm2m_firmware,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_registry),
+			 ztest_unit_test(test_streamed),
+			 ztest_unit_test(test_buffered),
+			 ztest_unit_test(test_too_large),
+			 ztest_unit_test(test_teardown));
+
+	ztest_run_test_suite(lwm2m_firmware);
+}
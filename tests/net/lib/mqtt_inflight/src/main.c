@@ -0,0 +1,545 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_MQTT_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <ztest.h>
+
+#include <net/socket.h>
+#include <net/mqtt.h>
+#include <settings/settings.h>
+
+#include "mqtt_internal.h"
+
+#define BROKER_PORT 1883
+#define WAIT_MS 1000
+#define NO_DATA_MS 100
+
+static const char topic[] = "test/inflight";
+static const char payload[] = "payload";
+
+static struct sockaddr_in broker_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(BROKER_PORT),
+};
+
+/* The broker is played by the test thread, on the accepted connection */
+static int broker_sock = -1;
+static int peer = -1;
+
+static struct mqtt_client client;
+static u8_t rx_buf[128];
+static u8_t tx_buf[128];
+static u8_t inflight_buf[CONFIG_MQTT_INFLIGHT_MAX * 64];
+
+static int evt_count[MQTT_EVT_PINGRESP + 1];
+static u16_t evt_message_id;
+static bool connected;
+
+/* Settings kept in RAM, so that they survive the client being reset */
+struct ram_setting {
+	char name[32];
+	u8_t value[64];
+	size_t len;
+};
+
+static struct ram_setting ram_settings[CONFIG_MQTT_INFLIGHT_MAX];
+
+static struct ram_setting *ram_setting_find(const char *name)
+{
+	for (int i = 0; i < ARRAY_SIZE(ram_settings); i++) {
+		if (!strcmp(ram_settings[i].name, name)) {
+			return &ram_settings[i];
+		}
+	}
+
+	return NULL;
+}
+
+static ssize_t ram_read(void *cb_arg, void *data, size_t len)
+{
+	struct ram_setting *setting = cb_arg;
+
+	len = MIN(len, setting->len);
+	memcpy(data, setting->value, len);
+
+	return len;
+}
+
+static int ram_load(struct settings_store *cs,
+		    const struct settings_load_arg *arg)
+{
+	for (int i = 0; i < ARRAY_SIZE(ram_settings); i++) {
+		if (ram_settings[i].name[0] == '\0') {
+			continue;
+		}
+
+		settings_call_set_handler(ram_settings[i].name,
+					  ram_settings[i].len, ram_read,
+					  &ram_settings[i], arg);
+	}
+
+	return 0;
+}
+
+static int ram_save(struct settings_store *cs, const char *name,
+		    const char *value, size_t val_len)
+{
+	struct ram_setting *setting = ram_setting_find(name);
+
+	if (value == NULL || val_len == 0) {
+		if (setting != NULL) {
+			memset(setting, 0, sizeof(*setting));
+		}
+
+		return 0;
+	}
+
+	if (setting == NULL) {
+		setting = ram_setting_find("");
+	}
+
+	if (setting == NULL || val_len > sizeof(setting->value) ||
+	    strlen(name) >= sizeof(setting->name)) {
+		return -ENOMEM;
+	}
+
+	strcpy(setting->name, name);
+	memcpy(setting->value, value, val_len);
+	setting->len = val_len;
+
+	return 0;
+}
+
+static const struct settings_store_itf ram_itf = {
+	.csi_load = ram_load,
+	.csi_save = ram_save,
+};
+
+static struct settings_store ram_store = {
+	.cs_itf = &ram_itf,
+};
+
+int settings_backend_init(void)
+{
+	settings_dst_register(&ram_store);
+	settings_src_register(&ram_store);
+
+	return 0;
+}
+
+static void mqtt_evt_handler(struct mqtt_client *const c,
+			     const struct mqtt_evt *evt)
+{
+	evt_count[evt->type]++;
+
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		connected = (evt->result == 0);
+		break;
+
+	case MQTT_EVT_DISCONNECT:
+		connected = false;
+		break;
+
+	case MQTT_EVT_PUBACK:
+		evt_message_id = evt->param.puback.message_id;
+		break;
+
+	case MQTT_EVT_PUBREC:
+		evt_message_id = evt->param.pubrec.message_id;
+		break;
+
+	case MQTT_EVT_PUBCOMP:
+		evt_message_id = evt->param.pubcomp.message_id;
+		break;
+
+	default:
+		break;
+	}
+}
+
+static int wait_data(int sock, int timeout)
+{
+	struct pollfd fds = { .fd = sock, .events = POLLIN };
+
+	return poll(&fds, 1, timeout);
+}
+
+static int broker_recv_all(u8_t *buf, size_t len)
+{
+	ssize_t ret;
+
+	while (len > 0) {
+		if (wait_data(peer, WAIT_MS) <= 0) {
+			return -ETIMEDOUT;
+		}
+
+		ret = recv(peer, buf, len, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		buf += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/* Receive one packet, the remaining length of all the packets used here
+ * takes one byte.
+ */
+static void broker_recv(u8_t *packet, u8_t type)
+{
+	zassert_equal(broker_recv_all(packet, 2), 0, "No packet received");
+	zassert_true(packet[1] < 0x80, "Unexpected packet length");
+	zassert_equal(broker_recv_all(packet + 2, packet[1]), 0,
+		      "Packet truncated");
+	zassert_equal(packet[0] & 0xF0, type, "Unexpected packet 0x%02x",
+		      packet[0]);
+}
+
+static void broker_send(u8_t type, u16_t message_id)
+{
+	u8_t packet[] = { type, 2, message_id >> 8, message_id };
+
+	zassert_equal(send(peer, packet, sizeof(packet), 0), sizeof(packet),
+		      "Cannot send 0x%02x", type);
+}
+
+/* Receive a PUBLISH, return its message ID */
+static u16_t broker_recv_publish(bool dup)
+{
+	u8_t packet[64];
+	u16_t topic_len;
+
+	broker_recv(packet, MQTT_PKT_TYPE_PUBLISH);
+	zassert_equal(!!(packet[0] & MQTT_HEADER_DUP_MASK), dup,
+		      "Wrong DUP flag");
+
+	topic_len = (packet[2] << 8) | packet[3];
+	zassert_equal(topic_len, sizeof(topic) - 1, "Wrong topic");
+
+	return (packet[4 + topic_len] << 8) | packet[5 + topic_len];
+}
+
+static void broker_no_data(void)
+{
+	zassert_equal(wait_data(peer, NO_DATA_MS), 0, "Unexpected packet");
+}
+
+static void client_input(void)
+{
+	zassert_true(wait_data(client.transport.tcp.sock, WAIT_MS) > 0,
+		     "No data for the client");
+	zassert_equal(mqtt_input(&client), 0, "mqtt_input failed");
+}
+
+static int publish(enum mqtt_qos qos, u16_t message_id)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = qos,
+		.message.topic.topic.utf8 = (u8_t *)topic,
+		.message.topic.topic.size = sizeof(topic) - 1,
+		.message.payload.data = (u8_t *)payload,
+		.message.payload.len = sizeof(payload) - 1,
+		.message_id = message_id,
+	};
+
+	return mqtt_publish(&client, &param);
+}
+
+static int inflight_count(void)
+{
+	int count = 0;
+
+	for (int i = 0; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		if (client.internal.inflight[i].len > 0) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static int settings_count(void)
+{
+	int count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(ram_settings); i++) {
+		if (ram_settings[i].name[0] != '\0') {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/* Reset the client the way a reboot would */
+static void client_reset(void)
+{
+	mqtt_client_init(&client);
+	client.broker = &broker_addr;
+	client.evt_cb = mqtt_evt_handler;
+	client.client_id.utf8 = (u8_t *)"inflight";
+	client.client_id.size = strlen("inflight");
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.rx_buf = rx_buf;
+	client.rx_buf_size = sizeof(rx_buf);
+	client.tx_buf = tx_buf;
+	client.tx_buf_size = sizeof(tx_buf);
+	client.inflight_buf = inflight_buf;
+	client.inflight_buf_size = sizeof(inflight_buf);
+	client.keepalive = 0U;
+}
+
+static void client_connect(bool clean_session, bool session_present)
+{
+	u8_t packet[64];
+	u8_t connack[] = { MQTT_PKT_TYPE_CONNACK, 2, session_present, 0 };
+
+	client.clean_session = clean_session;
+	zassert_equal(mqtt_connect(&client), 0, "Cannot connect");
+
+	peer = accept(broker_sock, NULL, NULL);
+	zassert_true(peer >= 0, "Cannot accept (%d)", errno);
+
+	broker_recv(packet, MQTT_PKT_TYPE_CONNECT);
+	zassert_equal(send(peer, connack, sizeof(connack), 0),
+		      sizeof(connack), "Cannot send CONNACK");
+
+	client_input();
+	zassert_true(connected, "Not connected");
+}
+
+static void client_disconnect(void)
+{
+	mqtt_abort(&client);
+
+	if (peer >= 0) {
+		close(peer);
+		peer = -1;
+	}
+}
+
+static void test_setup(void)
+{
+	memset(ram_settings, 0, sizeof(ram_settings));
+	memset(evt_count, 0, sizeof(evt_count));
+
+	client_reset();
+	client_connect(true, false);
+}
+
+static void test_teardown(void)
+{
+	client_disconnect();
+}
+
+static void test_retransmit(void)
+{
+	u16_t message_id;
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+		      "Cannot publish");
+	message_id = broker_recv_publish(false);
+	zassert_not_equal(message_id, 0, "No message ID allocated");
+
+	/* Not due yet */
+	mqtt_live(&client);
+	broker_no_data();
+
+	k_msleep(CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT);
+	mqtt_live(&client);
+	zassert_equal(broker_recv_publish(true), message_id,
+		      "Another message sent again");
+
+	broker_send(MQTT_PKT_TYPE_PUBACK, message_id);
+	client_input();
+
+	zassert_equal(evt_count[MQTT_EVT_PUBACK], 1, "No PUBACK event");
+	zassert_equal(evt_message_id, message_id, "Wrong PUBACK message ID");
+	zassert_equal(inflight_count(), 0, "Message still in flight");
+
+	/* Acknowledged, it is not sent again */
+	k_msleep(CONFIG_MQTT_INFLIGHT_RETRY_TIMEOUT);
+	mqtt_live(&client);
+	broker_no_data();
+}
+
+static void test_qos2(void)
+{
+	u8_t packet[8];
+	u16_t message_id;
+
+	zassert_equal(publish(MQTT_QOS_2_EXACTLY_ONCE, 0), 0,
+		      "Cannot publish");
+	message_id = broker_recv_publish(false);
+
+	broker_send(MQTT_PKT_TYPE_PUBREC, message_id);
+	client_input();
+
+	/* The library releases the message, the application must not */
+	zassert_equal(evt_count[MQTT_EVT_PUBREC], 0, "PUBREC notified");
+	broker_recv(packet, MQTT_PKT_TYPE_PUBREL);
+	zassert_equal((packet[2] << 8) | packet[3], message_id,
+		      "Wrong PUBREL message ID");
+	broker_no_data();
+	zassert_equal(inflight_count(), 1, "PUBREL not kept in flight");
+
+	/* A PUBREC sent again means the PUBREL was lost */
+	broker_send(MQTT_PKT_TYPE_PUBREC, message_id);
+	client_input();
+	broker_recv(packet, MQTT_PKT_TYPE_PUBREL);
+	zassert_equal((packet[2] << 8) | packet[3], message_id,
+		      "Wrong PUBREL message ID");
+
+	broker_send(MQTT_PKT_TYPE_PUBCOMP, message_id);
+	client_input();
+
+	zassert_equal(evt_count[MQTT_EVT_PUBREC], 0, "PUBREC notified");
+	zassert_equal(evt_count[MQTT_EVT_PUBCOMP], 1, "No PUBCOMP event");
+	zassert_equal(evt_message_id, message_id, "Wrong PUBCOMP message ID");
+	zassert_equal(inflight_count(), 0, "Message still in flight");
+}
+
+static void test_message_id_reuse(void)
+{
+	u16_t ids[CONFIG_MQTT_INFLIGHT_MAX];
+	u8_t packet[64];
+
+	/* The allocation wraps around, skipping 0 and the IDs in flight */
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 1), 0,
+		      "Cannot publish");
+	zassert_equal(broker_recv_publish(false), 1, "Wrong message ID");
+
+	client.internal.last_message_id = UINT16_MAX;
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+		      "Cannot publish");
+	zassert_equal(broker_recv_publish(false), 2, "ID in flight reused");
+
+	for (int i = 2; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+			      "Cannot publish");
+		ids[i] = broker_recv_publish(false);
+	}
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), -EAGAIN,
+		      "Window not full");
+	zassert_equal(publish(MQTT_QOS_0_AT_MOST_ONCE, 0), 0,
+		      "QoS 0 held back by the window");
+	broker_recv(packet, MQTT_PKT_TYPE_PUBLISH);
+
+	/* Once acknowledged, an ID can be used again */
+	broker_send(MQTT_PKT_TYPE_PUBACK, 1);
+	client_input();
+	zassert_equal(inflight_count(), CONFIG_MQTT_INFLIGHT_MAX - 1,
+		      "Message not released");
+
+	client.internal.last_message_id = UINT16_MAX;
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+		      "Cannot publish");
+	zassert_equal(broker_recv_publish(false), 1, "ID 1 not reused");
+
+	broker_send(MQTT_PKT_TYPE_PUBACK, 1);
+	broker_send(MQTT_PKT_TYPE_PUBACK, 2);
+	for (int i = 2; i < CONFIG_MQTT_INFLIGHT_MAX; i++) {
+		broker_send(MQTT_PKT_TYPE_PUBACK, ids[i]);
+	}
+
+	while (inflight_count() > 0) {
+		client_input();
+	}
+
+	zassert_equal(evt_count[MQTT_EVT_PUBACK], CONFIG_MQTT_INFLIGHT_MAX + 1,
+		      "PUBACK events missing");
+}
+
+static void test_resume_from_settings(void)
+{
+	u16_t message_id;
+
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+		      "Cannot publish");
+	message_id = broker_recv_publish(false);
+	zassert_equal(settings_count(), 1, "Message not saved");
+
+	/* Lost with the connection and the memory of the client */
+	client_disconnect();
+	client_reset();
+	zassert_equal(inflight_count(), 0, "Window not reset");
+
+	zassert_equal(mqtt_inflight_restore(&client), 0, "Cannot restore");
+	zassert_equal(inflight_count(), 1, "Message not restored");
+
+	client_connect(false, true);
+	zassert_equal(broker_recv_publish(true), message_id,
+		      "Restored message not sent again");
+
+	broker_send(MQTT_PKT_TYPE_PUBACK, message_id);
+	client_input();
+
+	zassert_equal(evt_count[MQTT_EVT_PUBACK], 1, "No PUBACK event");
+	zassert_equal(inflight_count(), 0, "Message still in flight");
+	zassert_equal(settings_count(), 0, "Message not deleted");
+}
+
+static void test_resume_no_session(void)
+{
+	zassert_equal(publish(MQTT_QOS_1_AT_LEAST_ONCE, 0), 0,
+		      "Cannot publish");
+	broker_recv_publish(false);
+
+	client_disconnect();
+	client_reset();
+	zassert_equal(mqtt_inflight_restore(&client), 0, "Cannot restore");
+
+	/* The broker has no session, the message is dropped */
+	client_connect(false, false);
+	broker_no_data();
+
+	zassert_equal(inflight_count(), 0, "Message still in flight");
+	zassert_equal(settings_count(), 0, "Message not deleted");
+}
+
+void test_main(void)
+{
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &broker_addr.sin_addr);
+
+	broker_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(broker_sock >= 0, "Cannot create the broker socket");
+	zassert_equal(bind(broker_sock, (struct sockaddr *)&broker_addr,
+			   sizeof(broker_addr)), 0, "Cannot bind");
+	zassert_equal(listen(broker_sock, 1), 0, "Cannot listen");
+
+	zassert_equal(settings_subsys_init(), 0, "Cannot init settings");
+
+	ztest_test_suite(mqtt_inflight,
+			 ztest_unit_test_setup_teardown(test_retransmit,
+							test_setup,
+							test_teardown),
+			 ztest_unit_test_setup_teardown(test_qos2,
+							test_setup,
+							test_teardown),
+			 ztest_unit_test_setup_teardown(test_message_id_reuse,
+							test_setup,
+							test_teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_resume_from_settings,
+				 test_setup, test_teardown),
+			 ztest_unit_test_setup_teardown(test_resume_no_session,
+							test_setup,
+							test_teardown));
+
+	ztest_run_test_suite(mqtt_inflight);
+}
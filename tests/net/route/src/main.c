@@ -472,6 +472,175 @@ static void route_del_many(void)
 	}
 }
 
+static void route_lookup_longest(void)
+{
+	struct in6_addr in_64 = dest_addr, in_48 = dest_addr;
+	struct in6_addr outside = dest_addr;
+	struct net_route_entry *route_48, *route_64, *route_128;
+
+	in_64.s6_addr[15] ^= 0x01;
+	in_48.s6_addr[7] ^= 0x01;
+	outside.s6_addr[5] ^= 0x01;
+
+	/* Nested prefixes of one address are separate routes */
+	route_48 = net_route_add(my_iface, &dest_addr, 48, &peer_addr);
+	route_128 = net_route_add(my_iface, &dest_addr, 128, &peer_addr);
+	route_64 = net_route_add(my_iface, &dest_addr, 64, &peer_addr);
+
+	zassert_not_null(route_48, "Route add failed");
+	zassert_not_null(route_64, "Route add failed");
+	zassert_not_null(route_128, "Route add failed");
+	zassert_true(route_48 != route_64 && route_64 != route_128,
+		     "Nested route replaced");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route_128,
+			  "Longest prefix not found");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_64), route_64,
+			  "Longest prefix not found");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_48), route_48,
+			  "Longest prefix not found");
+	zassert_is_null(net_route_lookup(my_iface, &outside),
+			"Route found outside of the prefixes");
+	zassert_is_null(net_route_lookup(peer_iface, &dest_addr),
+			"Route found for other interface");
+
+	/* A deleted route is not found any more, also not from the cache */
+	zassert_false(net_route_del(route_128), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), route_64,
+			  "Deleted route found");
+
+	zassert_false(net_route_del(route_64), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in_64), route_48,
+			  "Deleted route found");
+
+	zassert_false(net_route_del(route_48), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Deleted route found");
+}
+
+static void route_ipv4_add_del(void)
+{
+	struct in_addr prefix = { { { 10, 0, 0, 0 } } };
+	struct in_addr dst = { { { 10, 1, 2, 3 } } };
+	struct in_addr gw = { { { 192, 0, 2, 1 } } };
+	struct in_addr gw2 = { { { 192, 0, 2, 2 } } };
+	struct net_route_entry_ipv4 *route;
+
+	zassert_is_null(net_route_ipv4_add(my_iface, &prefix, 33, &gw),
+			"Route with too long prefix added");
+
+	route = net_route_ipv4_add(my_iface, &prefix, 8, &gw);
+	zassert_not_null(route, "Route add failed");
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &dst), route,
+			  "Route not found");
+	zassert_true(net_ipv4_addr_cmp(&route->gw, &gw), "Wrong gateway");
+
+	/* The same prefix again only changes the gateway */
+	zassert_equal_ptr(net_route_ipv4_add(my_iface, &prefix, 8, &gw2),
+			  route, "Route not updated");
+	zassert_true(net_ipv4_addr_cmp(&route->gw, &gw2),
+		     "Gateway not updated");
+
+	zassert_equal(net_route_ipv4_del(route), 0, "Route del failed");
+	zassert_equal(net_route_ipv4_del(route), -EINVAL,
+		      "Route del again succeeded");
+	zassert_is_null(net_route_ipv4_lookup(my_iface, &dst),
+			"Deleted route found");
+}
+
+static void route_ipv4_lookup_longest(void)
+{
+	struct in_addr prefix = { { { 10, 1, 2, 3 } } };
+	struct in_addr in_24 = { { { 10, 1, 2, 4 } } };
+	struct in_addr in_16 = { { { 10, 1, 3, 3 } } };
+	struct in_addr in_8 = { { { 10, 2, 2, 3 } } };
+	struct in_addr outside = { { { 11, 1, 2, 3 } } };
+	struct in_addr gw_8 = { { { 192, 0, 2, 8 } } };
+	struct in_addr gw_16 = { { { 192, 0, 2, 16 } } };
+	struct in_addr gw_24 = { { { 192, 0, 2, 24 } } };
+	struct in_addr gw_32 = { { { 192, 0, 2, 32 } } };
+	struct net_route_entry_ipv4 *route_8, *route_16, *route_24, *route_32;
+	struct net_route_entry_ipv4 *route;
+
+	route_16 = net_route_ipv4_add(my_iface, &prefix, 16, &gw_16);
+	route_32 = net_route_ipv4_add(my_iface, &prefix, 32, &gw_32);
+	route_8 = net_route_ipv4_add(my_iface, &prefix, 8, &gw_8);
+	route_24 = net_route_ipv4_add(my_iface, &prefix, 24, &gw_24);
+
+	zassert_not_null(route_8, "Route add failed");
+	zassert_not_null(route_16, "Route add failed");
+	zassert_not_null(route_24, "Route add failed");
+	zassert_not_null(route_32, "Route add failed");
+
+	zassert_is_null(net_route_ipv4_add(my_iface, &outside, 8, &gw_8),
+			"Route added to a full table");
+
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &prefix), route_32,
+			  "Longest prefix not found");
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &in_24), route_24,
+			  "Longest prefix not found");
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &in_16), route_16,
+			  "Longest prefix not found");
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &in_8), route_8,
+			  "Longest prefix not found");
+	zassert_is_null(net_route_ipv4_lookup(my_iface, &outside),
+			"Route found outside of the prefixes");
+
+	/* ARP sends to the gateway of the route that is found */
+	route = net_route_ipv4_lookup(my_iface, &in_24);
+	zassert_true(net_ipv4_addr_cmp(&route->gw, &gw_24),
+		     "Wrong gateway");
+
+	zassert_is_null(net_route_ipv4_lookup(peer_iface, &prefix),
+			"Route found for other interface");
+	zassert_equal_ptr(net_route_ipv4_lookup(NULL, &prefix), route_32,
+			  "Route not found for any interface");
+
+	zassert_equal(net_route_ipv4_del(route_32), 0, "Route del failed");
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &prefix), route_24,
+			  "Deleted route found");
+
+	zassert_equal(net_route_ipv4_del(route_16), 0, "Route del failed");
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &in_16), route_8,
+			  "Deleted route found");
+
+	zassert_equal(net_route_ipv4_del(route_24), 0, "Route del failed");
+	zassert_equal(net_route_ipv4_del(route_8), 0, "Route del failed");
+	zassert_is_null(net_route_ipv4_lookup(my_iface, &prefix),
+			"Deleted route found");
+}
+
+static void route_ipv4_iface(void)
+{
+	struct in_addr prefix = { { { 10, 0, 0, 0 } } };
+	struct in_addr dst = { { { 10, 1, 2, 3 } } };
+	struct in_addr gw = { { { 192, 0, 2, 1 } } };
+	struct in_addr gw_peer = { { { 198, 51, 100, 1 } } };
+	struct net_route_entry_ipv4 *route, *route_peer;
+
+	/* The same prefix on two interfaces are two routes */
+	route = net_route_ipv4_add(my_iface, &prefix, 8, &gw);
+	route_peer = net_route_ipv4_add(peer_iface, &prefix, 8, &gw_peer);
+
+	zassert_not_null(route, "Route add failed");
+	zassert_not_null(route_peer, "Route add failed");
+	zassert_not_equal(route, route_peer, "Route of other iface replaced");
+
+	zassert_equal_ptr(net_route_ipv4_lookup(my_iface, &dst), route,
+			  "Route not found");
+	zassert_equal_ptr(net_route_ipv4_lookup(peer_iface, &dst), route_peer,
+			  "Route not found");
+	zassert_true(net_ipv4_addr_cmp(&route->gw, &gw), "Gateway changed");
+
+	zassert_equal(net_route_ipv4_del(route), 0, "Route del failed");
+	zassert_is_null(net_route_ipv4_lookup(my_iface, &dst),
+			"Deleted route found");
+	zassert_equal_ptr(net_route_ipv4_lookup(peer_iface, &dst), route_peer,
+			  "Route of other iface deleted");
+
+	zassert_equal(net_route_ipv4_del(route_peer), 0, "Route del failed");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -491,6 +660,10 @@ void test_main(void)
 			ztest_unit_test(route_del_nexthop_again),
 			ztest_unit_test(populate_nbr_cache),
 			ztest_unit_test(route_add_many),
-			ztest_unit_test(route_del_many));
+			ztest_unit_test(route_del_many),
+			ztest_unit_test(route_lookup_longest),
+			ztest_unit_test(route_ipv4_add_del),
+			ztest_unit_test(route_ipv4_lookup_longest),
+			ztest_unit_test(route_ipv4_iface));
 	ztest_run_test_suite(test_route);
 }
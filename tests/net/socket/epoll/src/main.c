@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <ztest_assert.h>
+
+#include <net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define TEST_STR_SMALL "test"
+
+#define SERVER_PORT 4242
+#define SERVER2_PORT 4243
+#define TCP_SERVER_PORT 4244
+#define CLIENT_PORT 9898
+
+#define WAIT_MS 100
+
+static int c_sock;
+static int s_sock;
+static int s2_sock;
+static struct sockaddr_in s_addr;
+
+static void send_one(void)
+{
+	ssize_t len;
+
+	len = sendto(c_sock, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1, 0,
+		     (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(len, sizeof(TEST_STR_SMALL) - 1, "send failed");
+}
+
+static void recv_one(void)
+{
+	char buf[sizeof(TEST_STR_SMALL)];
+	ssize_t len;
+
+	len = recv(s_sock, buf, sizeof(buf), MSG_DONTWAIT);
+	zassert_equal(len, sizeof(TEST_STR_SMALL) - 1, "recv failed");
+}
+
+static void check_wait(int ep, int timeout, int expected)
+{
+	struct epoll_event events[2];
+	int res;
+
+	res = epoll_wait(ep, events, ARRAY_SIZE(events), timeout);
+	zassert_equal(res, expected, "%d events, expected %d", res,
+		      expected);
+
+	if (expected > 0) {
+		zassert_equal(events[0].data.fd, s_sock, "wrong socket");
+		zassert_equal(events[0].events, EPOLLIN, "wrong events");
+	}
+}
+
+static void test_setup(void)
+{
+	struct sockaddr_in addr;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &c_sock, &addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+	zassert_equal(bind(s_sock, (struct sockaddr *)&s_addr,
+			   sizeof(s_addr)), 0, "bind failed");
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER2_PORT,
+			    &s2_sock, &addr);
+	zassert_equal(bind(s2_sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "bind failed");
+}
+
+/**
+ * @brief A level triggered socket is reported while it has data
+ */
+static void test_epoll_level(void)
+{
+	struct epoll_event ev = { .events = EPOLLIN };
+	int ep;
+
+	ep = epoll_create1(0);
+	zassert_true(ep >= 0, "epoll_create1 failed");
+
+	ev.data.fd = s_sock;
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s_sock, &ev), 0,
+		      "adding socket failed");
+	ev.data.fd = s2_sock;
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s2_sock, &ev), 0,
+		      "adding socket failed");
+
+	check_wait(ep, 0, 0);
+
+	send_one();
+	check_wait(ep, WAIT_MS, 1);
+	check_wait(ep, 0, 1);
+
+	recv_one();
+	check_wait(ep, 0, 0);
+
+	zassert_equal(close(ep), 0, "close failed");
+}
+
+/**
+ * @brief An edge triggered socket is reported once per arrival
+ */
+static void test_epoll_edge(void)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLET,
+		.data.fd = s_sock,
+	};
+	int ep;
+
+	ep = epoll_create1(0);
+	zassert_true(ep >= 0, "epoll_create1 failed");
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s_sock, &ev), 0,
+		      "adding socket failed");
+
+	send_one();
+	check_wait(ep, WAIT_MS, 1);
+	check_wait(ep, 0, 0);
+
+	send_one();
+	check_wait(ep, WAIT_MS, 1);
+
+	recv_one();
+	recv_one();
+	check_wait(ep, 0, 0);
+
+	zassert_equal(close(ep), 0, "close failed");
+}
+
+/**
+ * @brief A one shot socket is reported once until it is modified
+ */
+static void test_epoll_oneshot(void)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLONESHOT,
+		.data.fd = s_sock,
+	};
+	int ep;
+
+	ep = epoll_create1(0);
+	zassert_true(ep >= 0, "epoll_create1 failed");
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s_sock, &ev), 0,
+		      "adding socket failed");
+
+	send_one();
+	check_wait(ep, WAIT_MS, 1);
+
+	send_one();
+	check_wait(ep, WAIT_MS, 0);
+
+	ev.events = EPOLLIN;
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_MOD, s_sock, &ev), 0,
+		      "modifying socket failed");
+	check_wait(ep, 0, 1);
+
+	recv_one();
+	recv_one();
+
+	zassert_equal(close(ep), 0, "close failed");
+}
+
+/**
+ * @brief Interest list errors, and sockets leaving it
+ */
+static void test_epoll_ctl(void)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN,
+		.data.fd = s_sock,
+	};
+	int ep;
+
+	ep = epoll_create1(0);
+	zassert_true(ep >= 0, "epoll_create1 failed");
+
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s_sock, &ev), 0,
+		      "adding socket failed");
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s_sock, &ev), -1,
+		      "socket added twice");
+	zassert_equal(errno, EEXIST, "wrong errno %d", errno);
+
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_MOD, s2_sock, &ev), -1,
+		      "unknown socket modified");
+	zassert_equal(errno, ENOENT, "wrong errno %d", errno);
+
+	zassert_equal(epoll_ctl(s_sock, EPOLL_CTL_ADD, s2_sock, &ev), -1,
+		      "socket used as epoll instance");
+	zassert_equal(errno, EINVAL, "wrong errno %d", errno);
+
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, ep, &ev), -1,
+		      "epoll instance added to itself");
+	zassert_equal(errno, EPERM, "wrong errno %d", errno);
+
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_DEL, s_sock, NULL), 0,
+		      "removing socket failed");
+
+	send_one();
+	check_wait(ep, WAIT_MS, 0);
+	recv_one();
+
+	/* A closed socket leaves the interest list */
+	ev.data.fd = s2_sock;
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, s2_sock, &ev), 0,
+		      "adding socket failed");
+	zassert_equal(close(s2_sock), 0, "close failed");
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_DEL, s2_sock, NULL), -1,
+		      "closed socket removed");
+	zassert_equal(errno, EBADF, "wrong errno %d", errno);
+
+	zassert_equal(close(ep), 0, "close failed");
+	zassert_equal(close(s_sock), 0, "close failed");
+	zassert_equal(close(c_sock), 0, "close failed");
+}
+
+/**
+ * @brief A socket the peer closed is reported as hung up
+ */
+static void test_epoll_hup(void)
+{
+	struct sockaddr_in addr, peer;
+	socklen_t peer_len = sizeof(peer);
+	struct epoll_event ev = { .events = EPOLLIN };
+	struct epoll_event events[1];
+	char buf[sizeof(TEST_STR_SMALL)];
+	int listener, client, sock;
+	int ep, res;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, TCP_SERVER_PORT,
+			    &listener, &addr);
+	zassert_equal(bind(listener, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "bind failed");
+	zassert_equal(listen(listener, 1), 0, "listen failed");
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client, &peer);
+	zassert_equal(connect(client, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+
+	sock = accept(listener, (struct sockaddr *)&peer, &peer_len);
+	zassert_true(sock >= 0, "accept failed");
+
+	ep = epoll_create1(0);
+	zassert_true(ep >= 0, "epoll_create1 failed");
+	ev.data.fd = sock;
+	zassert_equal(epoll_ctl(ep, EPOLL_CTL_ADD, sock, &ev), 0,
+		      "adding socket failed");
+
+	zassert_equal(send(client, TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1,
+			   0), sizeof(TEST_STR_SMALL) - 1, "send failed");
+	zassert_equal(close(client), 0, "close failed");
+
+	res = epoll_wait(ep, events, ARRAY_SIZE(events), WAIT_MS);
+	zassert_equal(res, 1, "%d events, expected 1", res);
+	zassert_equal(events[0].events, EPOLLIN, "hang up before the data");
+
+	zassert_equal(recv(sock, buf, sizeof(buf), 0),
+		      sizeof(TEST_STR_SMALL) - 1, "recv failed");
+	zassert_equal(recv(sock, buf, sizeof(buf), 0), 0, "no EOF");
+
+	/* Reported even though only EPOLLIN is asked for */
+	res = epoll_wait(ep, events, ARRAY_SIZE(events), WAIT_MS);
+	zassert_equal(res, 1, "%d events, expected 1", res);
+	zassert_equal(events[0].events, EPOLLIN | EPOLLHUP, "no hang up");
+
+	zassert_equal(close(ep), 0, "close failed");
+	zassert_equal(close(sock), 0, "close failed");
+	zassert_equal(close(listener), 0, "close failed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_epoll,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_epoll_level),
+			 ztest_unit_test(test_epoll_edge),
+			 ztest_unit_test(test_epoll_oneshot),
+			 ztest_unit_test(test_epoll_ctl),
+			 ztest_unit_test(test_epoll_hup));
+
+	ztest_run_test_suite(socket_epoll);
+}
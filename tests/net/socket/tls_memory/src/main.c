@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * mbedTLS heap held by idle TLS connections over loopback, both of their
+ * ends counted, and the peak reached while they were set up. The numbers
+ * are printed, and the heap must go back to where it was once the
+ * connections are closed.
+ *
+ * The connections are made with a PSK first, then with certificates. The
+ * certificates and keys are freed once a connection is set up, so the
+ * idle connections hold less than the credentials over what they hold
+ * with a PSK.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <ztest.h>
+
+#include <net/socket.h>
+#include <net/tls_credentials.h>
+
+#include <mbedtls/memory_buffer_alloc.h>
+#include <mbedtls/x509_crt.h>
+#include <mbedtls/pk.h>
+
+#define CONNECTIONS 4
+#define PSK_PORT 4244
+#define X509_PORT 4245
+#define PSK_TAG 1
+#define CA_TAG 2
+#define SERVER_TAG 3
+#define STACK_SIZE 8192
+
+/* Takes more than one record with the small record buffers */
+#define DATA_LEN 3000
+
+/* The SSL context, session and transform of a connection, next to its
+ * input and output record buffers
+ */
+#define SOCKET_OVERHEAD 4096
+
+static const unsigned char psk[] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+static const char psk_id[] = "tls_memory";
+
+/* Self-signed for localhost, the client trusts it as its CA */
+static const unsigned char server_certificate[] = {
+#include "echo-apps-cert.der.inc"
+};
+
+/* This is the private key in pkcs#8 format. */
+static const unsigned char private_key[] = {
+#include "echo-apps-key.der.inc"
+};
+
+static const sec_tag_t psk_tags[] = { PSK_TAG };
+static const sec_tag_t client_tags[] = { CA_TAG };
+static const sec_tag_t server_tags[] = { SERVER_TAG };
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+};
+
+/* Accepted from in turn, the PSK connections are closed before the
+ * certificate ones are made
+ */
+static int listeners[2];
+static int clients[CONNECTIONS];
+static int accepted[CONNECTIONS];
+
+static u8_t data[DATA_LEN];
+static u8_t recv_buf[DATA_LEN];
+
+/* Heap in use before the connections and once they are idle */
+static size_t heap_base;
+static size_t heap_idle;
+
+/* Heap held by an idle PSK connection, both of its ends */
+static size_t psk_pair;
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(server_accepted, 0, CONNECTIONS);
+
+static int tls_socket(const sec_tag_t *tags, size_t tags_size)
+{
+	int sock;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	zassert_true(sock >= 0, "socket open failed (%d)", errno);
+
+	zassert_equal(setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST, tags,
+				 tags_size), 0,
+		      "cannot set TLS options (%d)", errno);
+
+	return sock;
+}
+
+static int tls_listener(u16_t port, const sec_tag_t *tags,
+			size_t tags_size)
+{
+	int sock, ret;
+
+	sock = tls_socket(tags, tags_size);
+
+	server_addr.sin_port = htons(port);
+
+	ret = bind(sock, (struct sockaddr *)&server_addr,
+		   sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+
+	ret = listen(sock, 1);
+	zassert_equal(ret, 0, "listen failed (%d)", errno);
+
+	return sock;
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	k_sem_give(&server_ready);
+
+	for (int l = 0; l < ARRAY_SIZE(listeners); l++) {
+		for (int i = 0; i < CONNECTIONS; i++) {
+			accepted[i] = accept(listeners[l], NULL, NULL);
+			if (accepted[i] < 0) {
+				return;
+			}
+
+			k_sem_give(&server_accepted);
+		}
+	}
+}
+
+static size_t heap_used(void)
+{
+	size_t used, blocks;
+
+	mbedtls_memory_buffer_alloc_cur_get(&used, &blocks);
+
+	return used;
+}
+
+static void test_setup(void)
+{
+	int ret;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = i;
+	}
+
+	ret = tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK, psk,
+				 sizeof(psk));
+	zassert_equal(ret, 0, "cannot add PSK (%d)", ret);
+
+	ret = tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK_ID, psk_id,
+				 sizeof(psk_id) - 1);
+	zassert_equal(ret, 0, "cannot add PSK identity (%d)", ret);
+
+	ret = tls_credential_add(CA_TAG, TLS_CREDENTIAL_CA_CERTIFICATE,
+				 server_certificate,
+				 sizeof(server_certificate));
+	zassert_equal(ret, 0, "cannot add CA certificate (%d)", ret);
+
+	ret = tls_credential_add(SERVER_TAG,
+				 TLS_CREDENTIAL_SERVER_CERTIFICATE,
+				 server_certificate,
+				 sizeof(server_certificate));
+	zassert_equal(ret, 0, "cannot add server certificate (%d)", ret);
+
+	ret = tls_credential_add(SERVER_TAG, TLS_CREDENTIAL_PRIVATE_KEY,
+				 private_key, sizeof(private_key));
+	zassert_equal(ret, 0, "cannot add private key (%d)", ret);
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+
+	listeners[0] = tls_listener(PSK_PORT, psk_tags, sizeof(psk_tags));
+	listeners[1] = tls_listener(X509_PORT, server_tags,
+				    sizeof(server_tags));
+
+	k_thread_create(&server_thread, server_stack, STACK_SIZE,
+			server, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	k_sem_take(&server_ready, K_FOREVER);
+}
+
+/* Connect, and return the heap held by each idle connection with both
+ * of its ends
+ */
+static size_t connect_all(u16_t port, const sec_tag_t *tags,
+			  size_t tags_size, const char *hostname)
+{
+	size_t peak, blocks, per_socket;
+
+	heap_base = heap_used();
+	mbedtls_memory_buffer_alloc_max_reset();
+
+	server_addr.sin_port = htons(port);
+
+	for (int i = 0; i < CONNECTIONS; i++) {
+		clients[i] = tls_socket(tags, tags_size);
+
+		if (hostname) {
+			zassert_equal(setsockopt(clients[i], SOL_TLS,
+						 TLS_HOSTNAME, hostname,
+						 strlen(hostname)), 0,
+				      "cannot set hostname (%d)", errno);
+		}
+
+		zassert_equal(connect(clients[i],
+				      (struct sockaddr *)&server_addr,
+				      sizeof(server_addr)), 0,
+			      "cannot connect (%d)", errno);
+		zassert_equal(k_sem_take(&server_accepted, K_FOREVER), 0,
+			      "not accepted");
+	}
+
+	heap_idle = heap_used();
+	mbedtls_memory_buffer_alloc_max_get(&peak, &blocks);
+
+	per_socket = (heap_idle - heap_base) / (2 * CONNECTIONS);
+
+	TC_PRINT("%d connections  heap %zu bytes  %zu bytes/socket  "
+		 "peak %zu bytes\n", CONNECTIONS, heap_idle - heap_base,
+		 per_socket, peak - heap_base);
+
+	/* The handshake state is released once a connection is set up */
+	zassert_true(peak > heap_idle, "handshake memory kept");
+	zassert_true(per_socket <= 2 * CONFIG_MBEDTLS_SSL_MAX_CONTENT_LEN +
+		     SOCKET_OVERHEAD, "%zu bytes held per socket",
+		     per_socket);
+
+	return (heap_idle - heap_base) / CONNECTIONS;
+}
+
+static void test_connect(void)
+{
+	psk_pair = connect_all(PSK_PORT, psk_tags, sizeof(psk_tags), NULL);
+}
+
+static void recv_all(int sock)
+{
+	size_t len = 0;
+	ssize_t ret;
+
+	memset(recv_buf, 0, sizeof(recv_buf));
+
+	while (len < sizeof(recv_buf)) {
+		ret = recv(sock, recv_buf + len, sizeof(recv_buf) - len, 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		len += ret;
+	}
+
+	zassert_mem_equal(recv_buf, data, sizeof(data), "wrong data");
+}
+
+static void send_all(int sock)
+{
+	size_t len = 0;
+	ssize_t ret;
+
+	while (len < sizeof(data)) {
+		ret = send(sock, data + len, sizeof(data) - len, 0);
+		zassert_true(ret > 0, "send failed (%d)", errno);
+		len += ret;
+	}
+}
+
+/* Records larger than the buffers are neither sent nor asked for, and
+ * the connections take no more memory for the data they carry
+ */
+static void test_traffic(void)
+{
+	for (int i = 0; i < CONNECTIONS; i++) {
+		send_all(clients[i]);
+		recv_all(accepted[i]);
+
+		send_all(accepted[i]);
+		recv_all(clients[i]);
+	}
+
+	zassert_equal(heap_used(), heap_idle, "heap grew with the traffic");
+}
+
+static void test_close(void)
+{
+	for (int i = 0; i < CONNECTIONS; i++) {
+		zassert_equal(close(clients[i]), 0, "close failed");
+		zassert_equal(close(accepted[i]), 0, "close failed");
+	}
+
+	zassert_equal(heap_used(), heap_base, "heap not released");
+}
+
+/* Heap taken by the credentials that both ends of a connection parse:
+ * the certificate and key of the server, and the CA of the client
+ */
+static size_t credentials_size(void)
+{
+	mbedtls_x509_crt own_cert, ca_chain;
+	mbedtls_pk_context priv_key;
+	size_t base, size;
+	int ret;
+
+	base = heap_used();
+
+	mbedtls_x509_crt_init(&own_cert);
+	mbedtls_x509_crt_init(&ca_chain);
+	mbedtls_pk_init(&priv_key);
+
+	ret = mbedtls_x509_crt_parse(&own_cert, server_certificate,
+				     sizeof(server_certificate));
+	zassert_equal(ret, 0, "cannot parse certificate (-%x)", -ret);
+
+	ret = mbedtls_x509_crt_parse(&ca_chain, server_certificate,
+				     sizeof(server_certificate));
+	zassert_equal(ret, 0, "cannot parse certificate (-%x)", -ret);
+
+	ret = mbedtls_pk_parse_key(&priv_key, private_key,
+				   sizeof(private_key), NULL, 0);
+	zassert_equal(ret, 0, "cannot parse key (-%x)", -ret);
+
+	size = heap_used() - base;
+
+	mbedtls_x509_crt_free(&own_cert);
+	mbedtls_x509_crt_free(&ca_chain);
+	mbedtls_pk_free(&priv_key);
+
+	return size;
+}
+
+/* The client keeps the certificate of the server in its session, past
+ * that a connection holds what it does with a PSK
+ */
+static void test_x509_connect(void)
+{
+	size_t credentials = credentials_size();
+	size_t pair;
+
+	pair = connect_all(X509_PORT, client_tags, sizeof(client_tags),
+			   "localhost");
+
+	TC_PRINT("certificates  %zu bytes/connection over PSK  "
+		 "credentials %zu bytes\n", pair - psk_pair, credentials);
+
+	zassert_true(pair < psk_pair + credentials,
+		     "credentials kept after the handshake");
+}
+
+static void test_x509_close(void)
+{
+	test_close();
+
+	for (int l = 0; l < ARRAY_SIZE(listeners); l++) {
+		close(listeners[l]);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_tls_memory,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_connect),
+			 ztest_unit_test(test_traffic),
+			 ztest_unit_test(test_close),
+			 ztest_unit_test(test_x509_connect),
+			 ztest_unit_test(test_traffic),
+			 ztest_unit_test(test_x509_close));
+
+	ztest_run_test_suite(socket_tls_memory);
+}
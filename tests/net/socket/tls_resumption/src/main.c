@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * TLS session resumption over loopback. Each end of the TLS sockets is
+ * tested against a plain mbedTLS peer, which tells whether a handshake
+ * resumed a session: the peer server from its session cache and ticket
+ * callbacks, the peer client from the master secret of the session,
+ * which only a full handshake changes.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <ztest.h>
+
+#include <net/socket.h>
+#include <net/tls_credentials.h>
+#include <random/rand32.h>
+
+#include <mbedtls/ssl.h>
+#include <mbedtls/net_sockets.h>
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include <mbedtls/ssl_cache.h>
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
+
+/* Port of the peer server, and of the listeners of the TLS sockets */
+#define PEER_PORT 4245
+#define SERVER_PORT 4246
+#define OTHER_SERVER_PORT 4247
+
+#define PSK_TAG 1
+/* Same credentials under another tag, sessions are not shared with it */
+#define OTHER_PSK_TAG 2
+
+#define STACK_SIZE 8192
+
+static const unsigned char psk[] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+static const char psk_id[] = "tls_resumption";
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+};
+
+static mbedtls_ssl_config peer_server_conf;
+static mbedtls_ssl_config peer_client_conf;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static mbedtls_ssl_cache_context peer_cache;
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context peer_tickets;
+#endif
+
+/* Whether the last handshake of the peer server resumed a session */
+static bool peer_resumed;
+static int peer_ret;
+
+static K_THREAD_STACK_DEFINE(peer_stack, STACK_SIZE);
+static struct k_thread peer_thread;
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_THREAD_STACK_DEFINE(other_server_stack, STACK_SIZE);
+static struct k_thread other_server_thread;
+
+static K_SEM_DEFINE(peer_done, 0, 1);
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static int rng(void *ctx, unsigned char *buf, size_t len)
+{
+	ARG_UNUSED(ctx);
+
+	sys_rand_get(buf, len);
+
+	return 0;
+}
+
+static int bio_send(void *ctx, const unsigned char *buf, size_t len)
+{
+	ssize_t ret = send(POINTER_TO_INT(ctx), buf, len, 0);
+
+	return ret < 0 ? MBEDTLS_ERR_NET_SEND_FAILED : ret;
+}
+
+static int bio_recv(void *ctx, unsigned char *buf, size_t len)
+{
+	ssize_t ret = recv(POINTER_TO_INT(ctx), buf, len, 0);
+
+	return ret < 0 ? MBEDTLS_ERR_NET_RECV_FAILED : ret;
+}
+
+static int peer_handshake(mbedtls_ssl_context *ssl, int sock)
+{
+	int ret;
+
+	mbedtls_ssl_set_bio(ssl, INT_TO_POINTER(sock), bio_send, bio_recv,
+			    NULL);
+
+	do {
+		ret = mbedtls_ssl_handshake(ssl);
+	} while (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+		 ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+
+	return ret;
+}
+
+/* A session is resumed from the cache or from a ticket only if found */
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int peer_cache_get(void *data, mbedtls_ssl_session *session)
+{
+	int ret = mbedtls_ssl_cache_get(data, session);
+
+	if (ret == 0) {
+		peer_resumed = true;
+	}
+
+	return ret;
+}
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int peer_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+			     unsigned char *buf, size_t len)
+{
+	int ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+
+	if (ret == 0) {
+		peer_resumed = true;
+	}
+
+	return ret;
+}
+#endif
+
+static void peer_conf_init(mbedtls_ssl_config *conf, int endpoint)
+{
+	int ret;
+
+	mbedtls_ssl_config_init(conf);
+
+	ret = mbedtls_ssl_config_defaults(conf, endpoint,
+					  MBEDTLS_SSL_TRANSPORT_STREAM,
+					  MBEDTLS_SSL_PRESET_DEFAULT);
+	zassert_equal(ret, 0, "cannot set up mbedTLS (-%x)", -ret);
+
+	mbedtls_ssl_conf_rng(conf, rng, NULL);
+
+	ret = mbedtls_ssl_conf_psk(conf, psk, sizeof(psk),
+				   (const unsigned char *)psk_id,
+				   sizeof(psk_id) - 1);
+	zassert_equal(ret, 0, "cannot set PSK (-%x)", -ret);
+}
+
+/* Plain mbedTLS server for the TLS client sockets */
+static void peer_server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	mbedtls_ssl_context ssl;
+	int client;
+
+	for (;;) {
+		client = accept(sock, NULL, NULL);
+		if (client < 0) {
+			continue;
+		}
+
+		peer_resumed = false;
+
+		mbedtls_ssl_init(&ssl);
+
+		peer_ret = mbedtls_ssl_setup(&ssl, &peer_server_conf);
+		if (peer_ret == 0) {
+			peer_ret = peer_handshake(&ssl, client);
+		}
+
+		k_sem_give(&peer_done);
+
+		mbedtls_ssl_free(&ssl);
+		close(client);
+	}
+}
+
+/* Accept the connections to a TLS listener, the handshake is done by
+ * accept().
+ */
+static void server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	int client;
+
+	for (;;) {
+		client = accept(sock, NULL, NULL);
+		if (client >= 0) {
+			close(client);
+		}
+
+		k_sem_give(&server_done);
+	}
+}
+
+static int tls_socket(int cache, sec_tag_t tag)
+{
+	int sock;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	zassert_true(sock >= 0, "socket open failed (%d)", errno);
+
+	zassert_equal(setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST, &tag,
+				 sizeof(tag)), 0,
+		      "cannot set TLS options (%d)", errno);
+	zassert_equal(setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE, &cache,
+				 sizeof(cache)), 0,
+		      "cannot set TLS options (%d)", errno);
+
+	return sock;
+}
+
+static void start_server(int sock, u16_t port, k_thread_entry_t entry,
+			 struct k_thread *thread, k_thread_stack_t *stack)
+{
+	struct sockaddr_in addr = server_addr;
+
+	addr.sin_port = htons(port);
+
+	zassert_equal(bind(sock, (struct sockaddr *)&addr, sizeof(addr)), 0,
+		      "bind failed (%d)", errno);
+	zassert_equal(listen(sock, 1), 0, "listen failed (%d)", errno);
+
+	k_thread_create(thread, stack, STACK_SIZE, entry,
+			INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+}
+
+static void add_credentials(sec_tag_t tag)
+{
+	int ret;
+
+	ret = tls_credential_add(tag, TLS_CREDENTIAL_PSK, psk, sizeof(psk));
+	zassert_equal(ret, 0, "cannot add PSK (%d)", ret);
+
+	ret = tls_credential_add(tag, TLS_CREDENTIAL_PSK_ID, psk_id,
+				 sizeof(psk_id) - 1);
+	zassert_equal(ret, 0, "cannot add PSK identity (%d)", ret);
+}
+
+static void test_setup(void)
+{
+	int sock;
+
+	add_credentials(PSK_TAG);
+	add_credentials(OTHER_PSK_TAG);
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		  &server_addr.sin_addr);
+
+	peer_conf_init(&peer_client_conf, MBEDTLS_SSL_IS_CLIENT);
+	peer_conf_init(&peer_server_conf, MBEDTLS_SSL_IS_SERVER);
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+	mbedtls_ssl_cache_init(&peer_cache);
+	mbedtls_ssl_conf_session_cache(&peer_server_conf, &peer_cache,
+				       peer_cache_get, mbedtls_ssl_cache_set);
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&peer_tickets);
+
+	zassert_equal(mbedtls_ssl_ticket_setup(&peer_tickets, rng, NULL,
+					       MBEDTLS_CIPHER_AES_256_GCM,
+					       3600), 0,
+		      "cannot set up tickets");
+
+	mbedtls_ssl_conf_session_tickets_cb(&peer_server_conf,
+					    mbedtls_ssl_ticket_write,
+					    peer_ticket_parse, &peer_tickets);
+#endif
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed (%d)", errno);
+
+	start_server(sock, PEER_PORT, peer_server, &peer_thread, peer_stack);
+
+	start_server(tls_socket(TLS_SESSION_CACHE_ENABLED, PSK_TAG),
+		     SERVER_PORT, server, &server_thread, server_stack);
+	start_server(tls_socket(TLS_SESSION_CACHE_ENABLED, OTHER_PSK_TAG),
+		     OTHER_SERVER_PORT, server, &other_server_thread,
+		     other_server_stack);
+}
+
+/* Connect a TLS socket to the peer server, return whether the handshake
+ * resumed a session
+ */
+static bool client_handshake(int cache, sec_tag_t tag, const char *hostname,
+			     bool purge)
+{
+	struct sockaddr_in addr = server_addr;
+	int sock;
+
+	addr.sin_port = htons(PEER_PORT);
+
+	sock = tls_socket(cache, tag);
+
+	if (hostname != NULL) {
+		zassert_equal(setsockopt(sock, SOL_TLS, TLS_HOSTNAME,
+					 hostname, strlen(hostname)), 0,
+			      "cannot set hostname (%d)", errno);
+	}
+
+	if (purge) {
+		zassert_equal(setsockopt(sock, SOL_TLS,
+					 TLS_SESSION_CACHE_PURGE, NULL, 0), 0,
+			      "cannot purge sessions (%d)", errno);
+	}
+
+	zassert_equal(connect(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "cannot connect (%d)", errno);
+	zassert_equal(k_sem_take(&peer_done, K_FOREVER), 0, "no handshake");
+	zassert_equal(peer_ret, 0, "handshake failed (-%x)", -peer_ret);
+
+	zassert_equal(close(sock), 0, "close failed");
+
+	return peer_resumed;
+}
+
+static void test_client_resume(void)
+{
+	int on = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_false(client_handshake(on, PSK_TAG, NULL, false),
+		      "first handshake resumed");
+	zassert_true(client_handshake(on, PSK_TAG, NULL, false),
+		     "session not resumed");
+	zassert_true(client_handshake(on, PSK_TAG, NULL, false),
+		     "session not resumed");
+}
+
+static void test_client_cache_disabled(void)
+{
+	int off = TLS_SESSION_CACHE_DISABLED;
+
+	/* The cache still holds the session of test_client_resume() */
+	zassert_false(client_handshake(off, PSK_TAG, NULL, false),
+		      "session resumed with the cache disabled");
+	zassert_false(client_handshake(off, PSK_TAG, NULL, false),
+		      "session resumed with the cache disabled");
+}
+
+static void test_client_purge(void)
+{
+	int on = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_true(client_handshake(on, PSK_TAG, NULL, false),
+		     "session not resumed");
+	zassert_false(client_handshake(on, PSK_TAG, NULL, true),
+		      "purged session resumed");
+	zassert_true(client_handshake(on, PSK_TAG, NULL, false),
+		     "session not resumed after purge");
+}
+
+static void test_client_hostname(void)
+{
+	int on = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_false(client_handshake(on, PSK_TAG, "a.example", false),
+		      "session resumed with a new hostname");
+	zassert_true(client_handshake(on, PSK_TAG, "a.example", false),
+		     "session not resumed with the same hostname");
+	zassert_false(client_handshake(on, PSK_TAG, "b.example", false),
+		      "session resumed with another hostname");
+	zassert_false(client_handshake(on, PSK_TAG, NULL, false),
+		      "session resumed without a hostname");
+}
+
+static void test_client_sec_tag(void)
+{
+	int on = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_true(client_handshake(on, PSK_TAG, NULL, false),
+		     "session not resumed with the same sec_tag");
+	zassert_false(client_handshake(on, OTHER_PSK_TAG, NULL, false),
+		      "session resumed with another sec_tag");
+}
+
+/* Connect the peer client to a TLS listener, offering session if resume
+ * is set, and keep the session established in it. Return whether the
+ * session was resumed.
+ */
+static bool server_handshake(u16_t port, mbedtls_ssl_session *session,
+			     bool resume)
+{
+	struct sockaddr_in addr = server_addr;
+	unsigned char master[sizeof(session->master)];
+	mbedtls_ssl_context ssl;
+	int sock, ret;
+
+	addr.sin_port = htons(port);
+
+	memcpy(master, session->master, sizeof(master));
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed (%d)", errno);
+
+	zassert_equal(connect(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "cannot connect (%d)", errno);
+
+	mbedtls_ssl_init(&ssl);
+
+	ret = mbedtls_ssl_setup(&ssl, &peer_client_conf);
+	zassert_equal(ret, 0, "cannot set up TLS (-%x)", -ret);
+
+	if (resume) {
+		ret = mbedtls_ssl_set_session(&ssl, session);
+		zassert_equal(ret, 0, "cannot set session (-%x)", -ret);
+	}
+
+	ret = peer_handshake(&ssl, sock);
+	zassert_equal(ret, 0, "handshake failed (-%x)", -ret);
+
+	mbedtls_ssl_session_free(session);
+	mbedtls_ssl_session_init(session);
+
+	ret = mbedtls_ssl_get_session(&ssl, session);
+	zassert_equal(ret, 0, "cannot get session (-%x)", -ret);
+
+	mbedtls_ssl_free(&ssl);
+	close(sock);
+
+	zassert_equal(k_sem_take(&server_done, K_FOREVER), 0, "not accepted");
+
+	return resume && !memcmp(master, session->master, sizeof(master));
+}
+
+static void test_server_resume(void)
+{
+	mbedtls_ssl_session session;
+
+	mbedtls_ssl_session_init(&session);
+
+	server_handshake(SERVER_PORT, &session, false);
+
+	zassert_true(server_handshake(SERVER_PORT, &session, true),
+		     "session not resumed");
+	zassert_true(server_handshake(SERVER_PORT, &session, true),
+		     "session not resumed");
+
+	mbedtls_ssl_session_free(&session);
+}
+
+/* Sessions of a listener are not resumed by one with other credentials */
+static void test_server_sec_tag(void)
+{
+	mbedtls_ssl_session session;
+
+	mbedtls_ssl_session_init(&session);
+
+	server_handshake(SERVER_PORT, &session, false);
+
+	zassert_false(server_handshake(OTHER_SERVER_PORT, &session, true),
+		      "session resumed with another sec_tag");
+	zassert_true(server_handshake(OTHER_SERVER_PORT, &session, true),
+		     "session not resumed");
+	zassert_false(server_handshake(SERVER_PORT, &session, true),
+		      "session resumed with another sec_tag");
+
+	mbedtls_ssl_session_free(&session);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_tls_resumption,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_client_resume),
+			 ztest_unit_test(test_client_cache_disabled),
+			 ztest_unit_test(test_client_purge),
+			 ztest_unit_test(test_client_hostname),
+			 ztest_unit_test(test_client_sec_tag),
+			 ztest_unit_test(test_server_resume),
+			 ztest_unit_test(test_server_sec_tag));
+
+	ztest_run_test_suite(socket_tls_resumption);
+}
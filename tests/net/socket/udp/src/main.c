@@ -409,6 +409,112 @@ static void comm_sendmsg_recvfrom(int client_sock,
 	}
 }
 
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr[3];
+	struct mmsghdr msgs[3];
+	struct iovec tx_iov[3];
+	struct iovec rx_iov[4];
+	char rx_buf[3][sizeof(TEST_STR_SMALL)];
+	char rx_tail[sizeof(TEST_STR_SMALL)];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock,
+		  (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* The last datagram is sent from two buffers */
+	tx_iov[0].iov_base = TEST_STR_SMALL;
+	tx_iov[0].iov_len = STRLEN(TEST_STR_SMALL);
+	tx_iov[1].iov_base = TEST_STR_SMALL;
+	tx_iov[1].iov_len = 2;
+	tx_iov[2].iov_base = TEST_STR_SMALL + 2;
+	tx_iov[2].iov_len = STRLEN(TEST_STR_SMALL) - 2;
+
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgs[i].msg_hdr.msg_iov = &tx_iov[i < 2 ? 0 : 1];
+		msgs[i].msg_hdr.msg_iovlen = i < 2 ? 1 : 2;
+	}
+
+	rv = sendmmsg(client_sock, msgs, ARRAY_SIZE(msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(msgs), "sendmmsg failed");
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "wrong length sent");
+	}
+
+	/* The second datagram is received in two buffers */
+	rx_iov[0].iov_base = rx_buf[0];
+	rx_iov[0].iov_len = sizeof(rx_buf[0]);
+	rx_iov[1].iov_base = rx_buf[1];
+	rx_iov[1].iov_len = 1;
+	rx_iov[2].iov_base = rx_tail;
+	rx_iov[2].iov_len = sizeof(rx_tail);
+	rx_iov[3].iov_base = rx_buf[2];
+	rx_iov[3].iov_len = sizeof(rx_buf[2]);
+
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].msg_hdr.msg_name = &addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+		msgs[i].msg_hdr.msg_iov = &rx_iov[i == 0 ? 0 : i * 2 - 1];
+		msgs[i].msg_hdr.msg_iovlen = i == 1 ? 2 : 1;
+	}
+
+	rv = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(msgs), "recvmmsg failed");
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "wrong length received");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen, sizeof(addr[i]),
+			      "wrong address length");
+		zassert_equal(addr[i].sin_port, client_addr.sin_port,
+			      "wrong source port");
+	}
+
+	zassert_mem_equal(rx_buf[0], TEST_STR_SMALL, STRLEN(TEST_STR_SMALL),
+			  "wrong data");
+	zassert_mem_equal(rx_buf[1], TEST_STR_SMALL, 1, "wrong data");
+	zassert_mem_equal(rx_tail, TEST_STR_SMALL + 1,
+			  STRLEN(TEST_STR_SMALL) - 1, "wrong data");
+	zassert_mem_equal(rx_buf[2], TEST_STR_SMALL, STRLEN(TEST_STR_SMALL),
+			  "wrong data");
+
+	rv = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), MSG_DONTWAIT);
+	zassert_equal(rv, -1, "datagrams left");
+	zassert_equal(errno, EAGAIN, "wrong errno %d", errno);
+
+	/* An empty vector is not an error */
+	rv = sendmmsg(client_sock, msgs, 0, 0);
+	zassert_equal(rv, 0, "sendmmsg with no message failed");
+	rv = recvmmsg(server_sock, msgs, 0, MSG_DONTWAIT);
+	zassert_equal(rv, 0, "recvmmsg with no message failed");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_v4_sendmsg_recvfrom(void)
 {
 	int rv;
@@ -918,6 +1024,8 @@ void test_main(void)
 			 ztest_unit_test(test_v6_bind_sendto),
 			 ztest_unit_test(test_so_priority),
 			 ztest_unit_test(test_so_txtime),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom),
 			 ztest_unit_test(test_v6_sendmsg_recvfrom),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom_connected),
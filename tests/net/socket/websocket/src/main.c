@@ -269,6 +269,51 @@ static void test_recv_two_msg(void)
 	test_recv_2(sizeof(frame1) + FRAME1_HDR_SIZE / 2);
 }
 
+/* Text message "test message" sent as two fragments, the second one is a
+ * continuation frame with the FIN bit set. Neither is masked.
+ */
+static const unsigned char frame3[] = {
+	0x01, 0x05, 't', 'e', 's', 't', ' ',
+	0x80, 0x07, 'm', 'e', 's', 's', 'a', 'g', 'e'
+};
+
+#define FRAME3_FIRST_LEN 7
+
+static void test_recv_fragmented_msg(void)
+{
+	struct websocket_context ctx;
+	u32_t msg_type = -1;
+	u64_t remaining = -1;
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.tmp_buf = temp_recv_buf;
+	ctx.tmp_buf_len = sizeof(temp_recv_buf);
+
+	memcpy(feed_buf, &frame3, sizeof(frame3));
+
+	ret = test_recv_buf(&feed_buf[0], FRAME3_FIRST_LEN, &ctx, &msg_type,
+			    &remaining, recv_buf, sizeof(recv_buf));
+	zassert_equal(ret, 5, "1st fragment not read (ret %d)", ret);
+	zassert_equal(msg_type, WEBSOCKET_FLAG_TEXT,
+		      "1st fragment type invalid (0x%x)", msg_type);
+
+	ret = test_recv_buf(&feed_buf[FRAME3_FIRST_LEN],
+			    sizeof(frame3) - FRAME3_FIRST_LEN, &ctx, &msg_type,
+			    &remaining, recv_buf + 5, sizeof(recv_buf) - 5);
+	zassert_equal(ret, 7, "2nd fragment not read (ret %d)", ret);
+	zassert_equal(msg_type, WEBSOCKET_FLAG_TEXT | WEBSOCKET_FLAG_FINAL,
+		      "2nd fragment type invalid (0x%x)", msg_type);
+
+	zassert_mem_equal(recv_buf, frame1_msg, sizeof(frame1_msg) - 1,
+			  "Invalid message, should be '%s' was '%s'",
+			  frame1_msg, recv_buf);
+
+	zassert_equal(remaining, 0, "Msg not empty");
+	zassert_equal(ctx.fragment_type, 0, "Fragmented message not done");
+}
+
 int verify_sent_and_received_msg(struct msghdr *msg, bool split_msg)
 {
 	static struct websocket_context ctx;
@@ -389,6 +434,7 @@ void test_main(void)
 			 ztest_unit_test(test_recv_12_byte),
 			 ztest_unit_test(test_recv_whole_msg),
 			 ztest_unit_test(test_recv_two_msg),
+			 ztest_unit_test(test_recv_fragmented_msg),
 			 ztest_unit_test(test_send_and_recv_lorem_ipsum),
 			 ztest_unit_test(test_recv_two_large_split_msg)
 		);
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <ztest_assert.h>
+
+#include <net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define TEST_STR_SMALL "test"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+#define WAIT_MS 100
+
+/* Does not fit in one CONFIG_NET_BUF_DATA_SIZE buffer */
+#define BIG_LEN 300
+
+static int c_sock;
+static int s_sock;
+static struct sockaddr_in s_addr;
+
+static u8_t big[BIG_LEN];
+
+static K_SEM_DEFINE(sent, 0, 1);
+static const void *sent_buf;
+static size_t sent_len;
+
+static void send_done(const void *buf, size_t len, void *user_data)
+{
+	zassert_equal_ptr(user_data, &sent, "wrong user data");
+
+	sent_buf = buf;
+	sent_len = len;
+	k_sem_give(&sent);
+}
+
+static void send_zc(const void *buf, size_t len)
+{
+	ssize_t ret;
+
+	ret = zsock_sendto_zc(c_sock, buf, len, 0,
+			      (struct sockaddr *)&s_addr, sizeof(s_addr),
+			      send_done, &sent);
+	zassert_equal(ret, len, "send failed");
+}
+
+/* Called after the data was received and released, as the receiver may
+ * hold the sender's buffer until then.
+ */
+static void wait_sent(const void *buf, size_t len)
+{
+	zassert_equal(k_sem_take(&sent, K_MSEC(WAIT_MS)), 0,
+		      "send not completed");
+	zassert_equal_ptr(sent_buf, buf, "wrong buffer completed");
+	zassert_equal(sent_len, len, "wrong length completed");
+}
+
+static void test_setup(void)
+{
+	struct sockaddr_in addr;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &c_sock, &addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+	zassert_equal(bind(s_sock, (struct sockaddr *)&s_addr,
+			   sizeof(s_addr)), 0, "bind failed");
+
+	for (int i = 0; i < sizeof(big); i++) {
+		big[i] = i;
+	}
+}
+
+/**
+ * @brief Data sent and received in place
+ */
+static void test_zc_small(void)
+{
+	struct zsock_zc_buf zc, again;
+	ssize_t len;
+
+	send_zc(TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1);
+
+	len = zsock_recv_zc(s_sock, &zc, 0);
+	zassert_equal(len, sizeof(TEST_STR_SMALL) - 1, "recv failed");
+	zassert_equal(zc.len, len, "wrong length");
+	zassert_false(zc.more, "datagram not complete");
+	zassert_mem_equal(zc.data, TEST_STR_SMALL, len, "wrong data");
+
+	/* Until released, the same data is handed out */
+	len = zsock_recv_zc(s_sock, &again, 0);
+	zassert_equal(len, zc.len, "recv failed");
+	zassert_equal_ptr(again.data, zc.data, "other data received");
+
+	zassert_equal(zsock_recv_zc_release(s_sock, &zc), 0,
+		      "release failed");
+
+	wait_sent(TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1);
+
+	len = zsock_recv_zc(s_sock, &zc, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(len, -1, "data left");
+	zassert_equal(errno, EAGAIN, "wrong errno %d", errno);
+}
+
+/**
+ * @brief A datagram spanning several buffers is received in parts
+ */
+static void test_zc_big(void)
+{
+	struct zsock_zc_buf zc;
+	size_t total = 0;
+	int parts = 0;
+	ssize_t len;
+
+	send_zc(big, sizeof(big));
+
+	do {
+		len = zsock_recv_zc(s_sock, &zc, 0);
+		zassert_true(len > 0, "recv failed");
+		zassert_true(total + len <= sizeof(big), "too much data");
+		zassert_mem_equal(zc.data, big + total, len, "wrong data");
+
+		total += len;
+		parts++;
+
+		zassert_equal(zsock_recv_zc_release(s_sock, &zc), 0,
+			      "release failed");
+	} while (zc.more);
+
+	zassert_equal(total, sizeof(big), "data missing");
+	zassert_true(parts > 1, "datagram not split");
+
+	wait_sent(big, sizeof(big));
+}
+
+/**
+ * @brief A datagram larger than the MTU is not sent, nor completed
+ */
+static void test_zc_too_big(void)
+{
+	static u8_t huge[NET_IPV4_MTU];
+	ssize_t ret;
+
+	ret = zsock_sendto_zc(c_sock, huge, sizeof(huge), 0,
+			      (struct sockaddr *)&s_addr, sizeof(s_addr),
+			      send_done, &sent);
+	zassert_equal(ret, -1, "datagram sent");
+	zassert_equal(errno, EMSGSIZE, "wrong errno %d", errno);
+
+	zassert_equal(k_sem_take(&sent, K_MSEC(WAIT_MS)), -EAGAIN,
+		      "failed send completed");
+}
+
+/**
+ * @brief Only the data at the head of the queue can be released
+ */
+static void test_zc_release(void)
+{
+	struct zsock_zc_buf zc, wrong;
+	char buf[sizeof(TEST_STR_SMALL)];
+	ssize_t len;
+
+	send_zc(TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1);
+
+	len = zsock_recv_zc(s_sock, &zc, 0);
+	zassert_equal(len, sizeof(TEST_STR_SMALL) - 1, "recv failed");
+
+	wrong = zc;
+	wrong.data = buf;
+	zassert_equal(zsock_recv_zc_release(s_sock, &wrong), -1,
+		      "wrong data released");
+	zassert_equal(errno, EINVAL, "wrong errno %d", errno);
+
+	/* Releasing a part leaves the rest of the datagram */
+	zc.len = 1;
+	zassert_equal(zsock_recv_zc_release(s_sock, &zc), 0,
+		      "release failed");
+
+	len = recv(s_sock, buf, sizeof(buf), MSG_DONTWAIT);
+	zassert_equal(len, sizeof(TEST_STR_SMALL) - 2, "recv failed");
+	zassert_mem_equal(buf, TEST_STR_SMALL + 1, len, "wrong data");
+
+	wait_sent(TEST_STR_SMALL, sizeof(TEST_STR_SMALL) - 1);
+
+	zassert_equal(close(s_sock), 0, "close failed");
+	zassert_equal(close(c_sock), 0, "close failed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(socket_zerocopy,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_zc_small),
+			 ztest_unit_test(test_zc_big),
+			 ztest_unit_test(test_zc_too_big),
+			 ztest_unit_test(test_zc_release));
+
+	ztest_run_test_suite(socket_zerocopy);
+}
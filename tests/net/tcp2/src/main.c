@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <ztest.h>
+#include <net/socket.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#define MTU 1280
+#define TRANSFER_SIZE (64 * 1024)
+#define CHUNK_SIZE 1024
+#define TRANSFER_TIMEOUT K_SECONDS(60)
+#define STACK_SIZE 2048
+
+/* Packets at least this long carry data, pure ACKs with options are
+ * shorter
+ */
+#define DATA_PKT_MIN_LEN (NET_IPV4H_LEN + NET_TCPH_LEN + 40 + 1)
+
+/* Both sockets live on this stack, the driver makes the packets sent to
+ * the peer address come back from it.
+ */
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static u16_t server_port = 4242;
+
+static int loss_every;
+static int data_pkts;
+static int dropped;
+
+static u8_t tx_buf[CHUNK_SIZE];
+static u8_t rx_buf[CHUNK_SIZE];
+static size_t received;
+static bool corrupted;
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static int lossy_dev_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void lossy_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, "\x00\x00\x5e\x00\x53\x01", 6,
+			     NET_LINK_DUMMY);
+}
+
+/* Loop the packet back as if it came from the peer, dropping every
+ * loss_every'th data segment.
+ */
+static int lossy_send(struct device *dev, struct net_pkt *pkt)
+{
+	struct net_pkt *cloned;
+	struct in_addr addr;
+
+	ARG_UNUSED(dev);
+
+	if (loss_every && net_pkt_get_len(pkt) >= DATA_PKT_MIN_LEN &&
+	    (++data_pkts % loss_every) == 0) {
+		dropped++;
+		return 0;
+	}
+
+	net_ipaddr_copy(&addr, &NET_IPV4_HDR(pkt)->src);
+	net_ipaddr_copy(&NET_IPV4_HDR(pkt)->src, &NET_IPV4_HDR(pkt)->dst);
+	net_ipaddr_copy(&NET_IPV4_HDR(pkt)->dst, &addr);
+
+	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	if (!cloned) {
+		return -ENOMEM;
+	}
+
+	if (net_recv_data(net_pkt_iface(cloned), cloned) < 0) {
+		net_pkt_unref(cloned);
+	}
+
+	/* Let the receiving thread run now */
+	k_yield();
+
+	return 0;
+}
+
+static struct dummy_api lossy_api = {
+	.iface_api.init = lossy_iface_init,
+	.send = lossy_send,
+};
+
+NET_DEVICE_INIT(tcp2_lossy, "tcp2_lossy",
+		lossy_dev_init, device_pm_control_nop, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&lossy_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), MTU);
+
+static u8_t pattern(size_t offset)
+{
+	return (u8_t)(offset % 251);
+}
+
+static void server(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	int client;
+	ssize_t len;
+
+	client = accept(sock, NULL, NULL);
+
+	while (client >= 0 && received < TRANSFER_SIZE) {
+		len = recv(client, rx_buf, sizeof(rx_buf), 0);
+		if (len <= 0) {
+			break;
+		}
+
+		for (int i = 0; i < len; i++) {
+			if (rx_buf[i] != pattern(received + i)) {
+				corrupted = true;
+			}
+		}
+
+		received += len;
+	}
+
+	if (client >= 0) {
+		close(client);
+	}
+
+	k_sem_give(&server_done);
+}
+
+static void transfer(int every)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(server_port),
+	};
+	int sock, client, i;
+	size_t offset = 0;
+	u32_t start, elapsed;
+	ssize_t len;
+
+	/* A fresh port per transfer, closed connections may linger */
+	server_port++;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed");
+	zassert_equal(bind(sock, (struct sockaddr *)&addr, sizeof(addr)), 0,
+		      "bind failed");
+	zassert_equal(listen(sock, 1), 0, "listen failed");
+
+	received = 0;
+	corrupted = false;
+	k_thread_create(&server_thread, server_stack, STACK_SIZE, server,
+			INT_TO_POINTER(sock), NULL, NULL,
+			K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(client >= 0, "socket open failed");
+
+	addr.sin_addr = peer_addr;
+	zassert_equal(connect(client, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+
+	/* Let the handshake complete */
+	k_msleep(100);
+
+	data_pkts = 0;
+	dropped = 0;
+	loss_every = every;
+	start = k_uptime_get_32();
+
+	while (offset < TRANSFER_SIZE) {
+		len = MIN(sizeof(tx_buf), TRANSFER_SIZE - offset);
+
+		for (i = 0; i < len; i++) {
+			tx_buf[i] = pattern(offset + i);
+		}
+
+		len = send(client, tx_buf, len, 0);
+		if (len < 0) {
+			/* Buffers are still held by unacknowledged data */
+			zassert_equal(errno, ENOMEM, "send failed (%d)", errno);
+			k_msleep(10);
+			continue;
+		}
+
+		offset += len;
+	}
+
+	/* The data still queued or in flight is delivered after close */
+	close(client);
+
+	zassert_equal(k_sem_take(&server_done, TRANSFER_TIMEOUT), 0,
+		      "transfer timed out, %zu bytes received", received);
+	elapsed = MAX(k_uptime_get_32() - start, 1U);
+	loss_every = 0;
+
+	printk("loss 1/%d: %u bytes in %u ms, %u kB/s, "
+	       "%d of %d data segments dropped\n", every, TRANSFER_SIZE,
+	       elapsed, TRANSFER_SIZE / elapsed, dropped, data_pkts);
+
+	zassert_equal(received, TRANSFER_SIZE, "short transfer");
+	zassert_false(corrupted, "data corrupted");
+	zassert_true(every == 0 || dropped > 0, "no segment dropped");
+
+	close(sock);
+	k_thread_join(&server_thread, K_FOREVER);
+}
+
+static void test_setup(void)
+{
+	struct net_if *iface = net_if_get_default();
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "cannot add address");
+}
+
+/**
+ * @brief Bulk transfer over a loss free link, the throughput baseline
+ */
+static void test_transfer(void)
+{
+	transfer(0);
+}
+
+/**
+ * @brief Bulk transfer with every 10th data segment lost
+ *
+ * Exercises retransmission timeout, fast retransmit and out of order
+ * reassembly: the data must arrive complete and in order.
+ */
+static void test_transfer_loss(void)
+{
+	transfer(10);
+}
+
+/**
+ * @brief Bulk transfer with every 4th data segment lost
+ */
+static void test_transfer_heavy_loss(void)
+{
+	transfer(4);
+}
+
+/**
+ * @brief TCP_NODELAY and TCP_CORK are stored per socket
+ */
+static void test_sockopt(void)
+{
+	int sock, val;
+	socklen_t len;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed");
+
+	val = 1;
+	zassert_equal(setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &val,
+				 sizeof(val)), 0, "setting TCP_NODELAY failed");
+	zassert_equal(setsockopt(sock, IPPROTO_TCP, TCP_CORK, &val,
+				 sizeof(val)), 0, "setting TCP_CORK failed");
+
+	val = 0;
+	len = sizeof(val);
+	zassert_equal(getsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &val, &len),
+		      0, "getting TCP_NODELAY failed");
+	zassert_equal(val, 1, "TCP_NODELAY not set");
+	zassert_equal(len, sizeof(val), "wrong option length");
+
+	val = 0;
+	zassert_equal(setsockopt(sock, IPPROTO_TCP, TCP_CORK, &val,
+				 sizeof(val)), 0, "clearing TCP_CORK failed");
+	val = 1;
+	zassert_equal(getsockopt(sock, IPPROTO_TCP, TCP_CORK, &val, &len),
+		      0, "getting TCP_CORK failed");
+	zassert_equal(val, 0, "TCP_CORK not cleared");
+
+	zassert_equal(setsockopt(sock, IPPROTO_TCP, TCP_CORK, &val, 1), -1,
+		      "short option accepted");
+	zassert_equal(errno, EINVAL, "wrong errno %d", errno);
+
+	close(sock);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tcp2,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_transfer),
+			 ztest_unit_test(test_transfer_loss),
+			 ztest_unit_test(test_transfer_heavy_loss),
+			 ztest_unit_test(test_sockopt));
+	ztest_run_test_suite(tcp2);
+}
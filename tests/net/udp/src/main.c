@@ -427,7 +427,7 @@ void test_udp(void)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface = net_if_get_default();
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *ud_rport, *ud_any;
 	int ret, i = 0;
 	bool st;
 
@@ -624,6 +624,7 @@ void test_udp(void)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 42423);
 
 	ud = REGISTER(AF_UNSPEC, NULL, NULL, 1234, 0);
+	ud_rport = ud;
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42422);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 42422);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42422);
@@ -636,6 +637,22 @@ void test_udp(void)
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 12345, 42421);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 	TEST_IPV6_LONG_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
+	ud_any = ud;
+
+	/* The most specific handler gets the packet, whatever the order
+	 * the handlers were registered in and the bucket they hash to
+	 */
+	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1234, 4244);
+	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4244);
+	TEST_IPV4_OK(ud_any, &in4addr_peer, &in4addr_my, 1235, 4244);
+	UNREGISTER(ud);
+	TEST_IPV4_OK(ud_rport, &in4addr_peer, &in4addr_my, 1234, 4244);
+
+	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1234, 4244);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4244);
+	TEST_IPV6_OK(ud_any, &in6addr_peer, &in6addr_my, 1235, 4244);
+	UNREGISTER(ud);
+	TEST_IPV6_OK(ud_rport, &in6addr_peer, &in6addr_my, 1234, 4244);
 
 	/* Remote addr same as local addr, these two will never match */
 	REGISTER(AF_INET6, &my_addr6, NULL, 1234, 4242);
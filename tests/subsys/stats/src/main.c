@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <ztest.h>
+#include <irq_offload.h>
+#include <stats/stats.h>
+
+#define N_THREADS CONFIG_MP_NUM_CPUS
+#define N_INCS 10000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+STATS_SECT_START(test_regular)
+STATS_SECT_ENTRY32(hits)
+STATS_SECT_ENTRY32(misses)
+STATS_SECT_END;
+
+STATS_NAME_START(test_regular)
+STATS_NAME(test_regular, hits)
+STATS_NAME(test_regular, misses)
+STATS_NAME_END(test_regular);
+
+static STATS_SECT_DECL(test_regular) test_regular;
+
+STATS_PERCPU_SECT_START(test_percpu)
+STATS_SECT_ENTRY64(hits)
+STATS_SECT_ENTRY64(misses)
+STATS_PERCPU_SECT_END;
+
+STATS_NAME_START(test_percpu)
+STATS_PERCPU_NAME(test_percpu, hits)
+STATS_PERCPU_NAME(test_percpu, misses)
+STATS_NAME_END(test_percpu);
+
+static STATS_SECT_DECL(test_percpu) test_percpu;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+static struct k_thread threads[N_THREADS];
+
+struct walk_entry {
+	const char *name;
+	u64_t value;
+};
+
+/* Reads the entry at hdr + off, as the shell and mcumgr do */
+static int walk_cb(struct stats_hdr *hdr, void *arg, const char *name,
+		   u16_t off)
+{
+	struct walk_entry **entry = arg;
+	u8_t *ptr = (u8_t *)hdr + off;
+
+	(*entry)->name = name;
+
+	switch (hdr->s_size) {
+	case sizeof(u32_t):
+		(*entry)->value = *(u32_t *)ptr;
+		break;
+	case sizeof(u64_t):
+		(*entry)->value = *(u64_t *)ptr;
+		break;
+	default:
+		zassert_unreachable("wrong entry size %u", hdr->s_size);
+	}
+
+	zassert_equal((*entry)->value, stats_get(hdr, off),
+		      "entry not read as stats_get() does");
+	(*entry)++;
+
+	return 0;
+}
+
+/* Entries as seen by the stat show command, by name. The entries of a
+ * per-CPU group are the sums of the copies of all CPUs.
+ */
+static void check_walk(struct stats_hdr *hdr, u64_t hits, u64_t misses)
+{
+	struct walk_entry entries[2];
+	struct walk_entry *entry = entries;
+
+	zassert_equal(stats_walk(hdr, walk_cb, &entry), 0, "walk failed");
+	zassert_equal(entry - entries, 2, "wrong number of entries");
+
+	zassert_true(!strcmp(entries[0].name, "hits"), "wrong name");
+	zassert_equal(entries[0].value, hits, "wrong hits");
+	zassert_true(!strcmp(entries[1].name, "misses"), "wrong name");
+	zassert_equal(entries[1].value, misses, "wrong misses");
+}
+
+static void test_register(void)
+{
+	zassert_equal(STATS_INIT_AND_REG(test_regular, STATS_SIZE_32,
+					 "test_regular"), 0,
+		      "cannot register regular group");
+	zassert_equal(STATS_PERCPU_INIT_AND_REG(test_percpu, STATS_SIZE_64,
+						"test_percpu"), 0,
+		      "cannot register per-CPU group");
+
+	zassert_equal_ptr(stats_group_find("test_regular"),
+			  &test_regular.s_hdr, "regular group not found");
+	zassert_equal_ptr(stats_group_find("test_percpu"),
+			  &test_percpu.s_hdr, "per-CPU group not found");
+	zassert_equal(test_percpu.s_hdr.s_cnt, 2, "wrong number of entries");
+
+	zassert_equal(stats_register("test_percpu", &test_regular.s_hdr),
+		      -EALREADY, "duplicate name registered");
+}
+
+static void test_regular_snapshot(void)
+{
+	u64_t values[3];
+
+	STATS_INCN(test_regular, hits, 3);
+	STATS_INC(test_regular, misses);
+
+	check_walk(&test_regular.s_hdr, 3, 1);
+
+	/* No more entries are read than the group has */
+	zassert_equal(stats_snapshot(&test_regular.s_hdr, values,
+				     ARRAY_SIZE(values), true), 2,
+		      "wrong number of entries read");
+	zassert_equal(values[0], 3, "wrong hits");
+	zassert_equal(values[1], 1, "wrong misses");
+
+	check_walk(&test_regular.s_hdr, 0, 0);
+}
+
+/* The copies of the CPUs do not share a cache line with anything else */
+static void test_percpu_layout(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		zassert_equal((uintptr_t)&test_percpu.s_cpu[i] %
+			      STATS_PERCPU_ALIGN, 0, "copy %d not aligned", i);
+	}
+}
+
+static void percpu_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < N_INCS; i++) {
+		STATS_PERCPU_INC(test_percpu, hits);
+	}
+}
+
+/* Each thread runs on whatever CPU it is scheduled on, no increment may
+ * be lost either way
+ */
+static void test_percpu_threads(void)
+{
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				percpu_entry, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < N_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	check_walk(&test_percpu.s_hdr, (u64_t)N_THREADS * N_INCS, 0);
+
+	stats_reset(&test_percpu.s_hdr);
+	check_walk(&test_percpu.s_hdr, 0, 0);
+}
+
+static void percpu_isr(void *arg)
+{
+	STATS_PERCPU_INCN(test_percpu, misses, POINTER_TO_UINT(arg));
+}
+
+static void test_percpu_isr(void)
+{
+	STATS_PERCPU_INC(test_percpu, misses);
+	irq_offload(percpu_isr, UINT_TO_POINTER(2));
+
+	check_walk(&test_percpu.s_hdr, 0, 3);
+}
+
+static void test_percpu_clear(void)
+{
+	STATS_PERCPU_INCN(test_percpu, hits, 5);
+
+	/* Only the entry given is zeroed */
+	STATS_PERCPU_CLEAR(test_percpu, misses);
+	check_walk(&test_percpu.s_hdr, 5, 0);
+}
+
+static void test_percpu_snapshot(void)
+{
+	u64_t values[2];
+
+	STATS_PERCPU_INC(test_percpu, misses);
+
+	zassert_equal(stats_snapshot(&test_percpu.s_hdr, values,
+				     ARRAY_SIZE(values), false), 2,
+		      "wrong number of entries read");
+	zassert_equal(values[0], 5, "wrong hits");
+	zassert_equal(values[1], 1, "wrong misses");
+	check_walk(&test_percpu.s_hdr, 5, 1);
+
+	/* Fewer entries are read if there is no room for more */
+	values[1] = 0;
+	zassert_equal(stats_snapshot(&test_percpu.s_hdr, values, 1, true), 1,
+		      "wrong number of entries read");
+	zassert_equal(values[0], 5, "wrong hits");
+	zassert_equal(values[1], 0, "entry read past the array");
+
+	/* Reset all entries, also the ones not read */
+	check_walk(&test_percpu.s_hdr, 0, 0);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(stats,
+			 ztest_unit_test(test_register),
+			 ztest_unit_test(test_regular_snapshot),
+			 ztest_unit_test(test_percpu_layout),
+			 ztest_unit_test(test_percpu_threads),
+			 ztest_unit_test(test_percpu_isr),
+			 ztest_unit_test(test_percpu_clear),
+			 ztest_unit_test(test_percpu_snapshot));
+
+	ztest_run_test_suite(stats);
+}
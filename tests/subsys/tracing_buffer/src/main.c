@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-CPU tracing buffers, driven directly with all event classes
+ * filtered out, so that the only packets in the buffers are the ones of
+ * the test. The tracing thread is not woken up by these packets.
+ */
+
+#include <string.h>
+#include <ztest.h>
+#include <kernel_structs.h>
+#include <tracing/tracing_format.h>
+#include <tracing_buffer.h>
+
+#define BUFFER_SIZE CONFIG_TRACING_BUFFER_PER_CPU_SIZE
+
+/* Time for the tracing thread to stream out the boot events */
+#define DRAIN_MS 100
+
+static u8_t packet[BUFFER_SIZE];
+static u8_t out[BUFFER_SIZE];
+
+static void fill(u8_t *data, u32_t size, u8_t seed)
+{
+	for (u32_t i = 0; i < size; i++) {
+		data[i] = seed + i;
+	}
+}
+
+static bool put(u32_t size, u8_t seed)
+{
+	bool was_empty;
+
+	fill(packet, size, seed);
+
+	return tracing_cpu_buffer_put(packet, size, &was_empty);
+}
+
+static void test_setup(void)
+{
+	tracing_filter_set(0);
+	zassert_equal(tracing_filter_get(), 0, "filter not set");
+	zassert_false(tracing_class_is_enabled(TRACING_CLASS_THREAD),
+		      "class not filtered");
+
+	k_msleep(DRAIN_MS);
+
+	tracing_cpu_buffer_init();
+	zassert_true(tracing_cpu_buffers_are_empty(), "buffers not empty");
+}
+
+static void test_too_large(void)
+{
+	bool was_empty;
+
+	zassert_false(tracing_cpu_buffer_put(packet, BUFFER_SIZE + 1,
+					     &was_empty),
+		      "packet larger than the buffer written");
+	zassert_true(tracing_cpu_buffers_are_empty(), "buffers not empty");
+}
+
+#ifndef CONFIG_TRACING_BUFFER_OVERWRITE
+static unsigned int cpu_id(void)
+{
+	return _current_cpu->id;
+}
+
+/* Claims data up to the end of the buffer, then from its start */
+static u32_t get(u8_t *data, u32_t size)
+{
+	u32_t len = 0U, claimed;
+	u8_t *claim;
+
+	while (len < size) {
+		claimed = tracing_cpu_buffer_get_claim(cpu_id(), &claim);
+		if (claimed == 0U) {
+			break;
+		}
+
+		claimed = MIN(claimed, size - len);
+		memcpy(data + len, claim, claimed);
+		tracing_cpu_buffer_get_finish(cpu_id(), claimed);
+		len += claimed;
+	}
+
+	return len;
+}
+
+static void test_wrap(void)
+{
+	u32_t size = BUFFER_SIZE * 5 / 8;
+	u8_t *claim;
+	bool was_empty;
+
+	fill(packet, size, 1);
+	zassert_true(tracing_cpu_buffer_put(packet, size, &was_empty),
+		      "packet dropped");
+	zassert_true(was_empty, "buffer not empty before");
+	zassert_equal(get(out, size), size, "packet not read back");
+	zassert_mem_equal(out, packet, size, "wrong packet");
+
+	/* The second packet wraps around the end of the buffer */
+	fill(packet, size, 2);
+	zassert_true(tracing_cpu_buffer_put(packet, size, &was_empty),
+		      "packet dropped");
+	zassert_true(was_empty, "buffer not empty before");
+	zassert_equal(tracing_cpu_buffer_get_claim(cpu_id(), &claim),
+		      BUFFER_SIZE - size, "claim past the end of the buffer");
+	zassert_equal(get(out, size), size, "packet not read back");
+	zassert_mem_equal(out, packet, size, "wrong packet");
+
+	zassert_true(tracing_cpu_buffers_are_empty(), "buffers not empty");
+}
+
+static void test_full(void)
+{
+	u32_t size = BUFFER_SIZE * 5 / 8;
+	bool was_empty;
+
+	zassert_true(put(size, 3), "packet dropped");
+
+	/* A packet is dropped whole if it does not fit */
+	fill(packet, BUFFER_SIZE - size + 1, 4);
+	zassert_false(tracing_cpu_buffer_put(packet, BUFFER_SIZE - size + 1,
+					     &was_empty),
+		      "packet written past the head");
+	zassert_false(was_empty, "buffer empty before");
+
+	zassert_true(put(BUFFER_SIZE - size, 5), "packet dropped");
+	zassert_equal(get(out, BUFFER_SIZE), BUFFER_SIZE,
+		      "buffer not read back");
+
+	fill(packet, size, 3);
+	zassert_mem_equal(out, packet, size, "wrong first packet");
+	fill(packet, BUFFER_SIZE - size, 5);
+	zassert_mem_equal(out + size, packet, BUFFER_SIZE - size,
+			  "wrong second packet");
+
+	zassert_true(tracing_cpu_buffers_are_empty(), "buffers not empty");
+}
+#else
+/* Packets take one byte more for their length */
+#define PACKET_SIZE 10
+#define MAX_PACKETS 8
+#define PACKETS_KEPT (BUFFER_SIZE / (PACKET_SIZE + 1))
+
+static u32_t flushed_len[MAX_PACKETS];
+static u8_t flushed_first[MAX_PACKETS];
+static int flushed;
+
+static void flush_handler(u8_t *data, u32_t length)
+{
+	zassert_true(flushed < MAX_PACKETS, "too many packets flushed");
+
+	/* A packet is passed whole, with its own content */
+	fill(out, length, data[0]);
+	zassert_mem_equal(data, out, length, "packet torn");
+
+	flushed_len[flushed] = length;
+	flushed_first[flushed] = data[0];
+	flushed++;
+}
+
+static void test_overwrite(void)
+{
+	flushed = 0;
+
+	for (int i = 0; i < MAX_PACKETS; i++) {
+		zassert_true(put(PACKET_SIZE, i * PACKET_SIZE),
+			     "packet dropped");
+	}
+
+	tracing_cpu_buffer_flush(flush_handler);
+
+	/* The oldest packets made room for the newest, whole */
+	zassert_equal(flushed, PACKETS_KEPT, "wrong number of packets");
+
+	for (int i = 0; i < flushed; i++) {
+		zassert_equal(flushed_len[i], PACKET_SIZE, "wrong length");
+		zassert_equal(flushed_first[i],
+			      (MAX_PACKETS - PACKETS_KEPT + i) * PACKET_SIZE,
+			      "packet %d out of order", i);
+	}
+
+	zassert_true(tracing_cpu_buffers_are_empty(), "buffers not empty");
+}
+
+static void test_dump(void)
+{
+	zassert_true(put(PACKET_SIZE, 0), "packet dropped");
+	zassert_false(tracing_cpu_buffers_are_empty(), "packet not kept");
+
+	tracing_flight_recorder_dump();
+
+	zassert_true(tracing_cpu_buffers_are_empty(), "buffers not sent");
+}
+#endif
+
+static void test_teardown(void)
+{
+	tracing_filter_set(TRACING_CLASS_ALL);
+}
+
+void test_main(void)
+{
+#ifndef CONFIG_TRACING_BUFFER_OVERWRITE
+	ztest_test_suite(tracing_buffer,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_too_large),
+			 ztest_unit_test(test_wrap),
+			 ztest_unit_test(test_full),
+			 ztest_unit_test(test_teardown));
+#else
+	ztest_test_suite(tracing_buffer,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_too_large),
+			 ztest_unit_test(test_overwrite),
+			 ztest_unit_test(test_dump),
+			 ztest_unit_test(test_teardown));
+#endif
+
+	ztest_run_test_suite(tracing_buffer);
+}